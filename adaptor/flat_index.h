@@ -0,0 +1,142 @@
+#ifndef MICROSTL_FLAT_INDEX_H
+#define MICROSTL_FLAT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "../iterator/type_traits.h"
+#include "../algorithm/algobase.h"
+#include "../functor/functional.h"
+#include "../container/vector.h"
+
+/**
+ * flat_map / flat_set 共用的有序 key 数组查找：
+ *
+ * - 默认使用无分支的二分查找
+ * - 算术类型的 key 配合默认比较器、且元素不少于 FLAT_EYTZINGER_MIN_SIZE 个时，额外维护一份 Eytzinger 布局的 key：
+ *      - 按完全二叉树的层序存放（下标从 1 开始，k 的子节点为 2k 与 2k + 1），查找路径上前几层集中在开头几条 cache line，
+ *        且第 k 个节点往下 log2(64 / sizeof(Key)) 层的后代连续存放，可以提前预取
+ *      - 另外保存每个位置在有序数组中的下标，查找结束后换算回有序数组中的位置
+ *      - 只在批量修改（区间构造、批量插入、rebuild_index）之后重建；单个元素的插入与删除使索引失效，
+ *        之后退化为二分查找，这样单点修改的代价不会翻倍，只读时也不需要加锁
+ */
+
+namespace MicroSTL {
+
+    static const size_t FLAT_EYTZINGER_MIN_SIZE = 1024;
+
+    template<typename Key, typename Compare>
+    struct _flat_eytzinger {
+        using type = false_type;
+    };
+
+    template<typename Key>
+    struct _flat_eytzinger<Key, less<Key>> {
+        using type = typename arithmetic_traits<Key>::is_arithmetic;
+    };
+
+    template<typename Key>
+    struct _flat_eytzinger<Key, greater<Key>> {
+        using type = typename arithmetic_traits<Key>::is_arithmetic;
+    };
+
+    template<typename Key, typename Compare>
+    class _flat_index {
+    protected:
+        using use_eytzinger = typename _flat_eytzinger<Key, Compare>::type;
+
+        // 下标 0 不使用
+        vector<Key> layout;
+        vector<uint32_t> ranks;
+
+        /**
+         * 中序遍历层序下标，依次填入有序数组中的元素
+         */
+        void fill(const Key *keys, size_t size, size_t node, size_t &next) {
+            if (node > size) {
+                return;
+            }
+            fill(keys, size, 2 * node, next);
+            layout[node] = keys[next];
+            ranks[node] = static_cast<uint32_t>(next);
+            ++next;
+            fill(keys, size, 2 * node + 1, next);
+        }
+
+        void build(const Key *keys, size_t size, true_type) {
+            if (size < FLAT_EYTZINGER_MIN_SIZE || size > UINT32_MAX) {
+                return;
+            }
+            layout.resize(size + 1, Key());
+            ranks.resize(size + 1, 0);
+            size_t next = 0;
+            fill(keys, size, 1, next);
+        }
+
+        void build(const Key *, size_t, false_type) {}
+
+        /**
+         * 沿层序下降，less 为 true 时进入右子树；结束时 k 的二进制表示末尾的 1 对应最后几次向右，
+         * 去掉这些 1 与紧接着的 0 即得到最后一次向左的节点，也就是答案
+         */
+        template<typename Less>
+        size_t search(size_t size, Less less) const {
+            const Key *data = layout.data();
+            const size_t prefetch_stride = 64 / sizeof(Key) > 0 ? 64 / sizeof(Key) : 1;
+            size_t k = 1;
+            while (k <= size) {
+                __builtin_prefetch(data + k * prefetch_stride);
+                k = 2 * k + less(data[k]);
+            }
+            k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+            return k == 0 ? size : ranks[k];
+        }
+
+    public:
+        bool valid(size_t size) const {
+            return size != 0 && layout.size() == size + 1;
+        }
+
+        void clear() {
+            layout.clear();
+            ranks.clear();
+        }
+
+        void rebuild(const Key *keys, size_t size) {
+            clear();
+            build(keys, size, use_eytzinger());
+        }
+
+        void swap(_flat_index &obj) {
+            layout.swap(obj.layout);
+            ranks.swap(obj.ranks);
+        }
+
+        /**
+         * 有序数组 keys 中第一个不小于 k 的下标
+         */
+        size_t lower_bound(const Key *keys, size_t size, const Key &k, const Compare &comp) const {
+            if (valid(size)) {
+                return search(size, [&](const Key &x) {
+                    return comp(x, k);
+                });
+            }
+            return _branchless_partition_point(size, [&](size_t i) {
+                return comp(keys[i], k);
+            });
+        }
+
+        size_t upper_bound(const Key *keys, size_t size, const Key &k, const Compare &comp) const {
+            if (valid(size)) {
+                return search(size, [&](const Key &x) {
+                    return !comp(k, x);
+                });
+            }
+            return _branchless_partition_point(size, [&](size_t i) {
+                return !comp(k, keys[i]);
+            });
+        }
+    };
+}
+
+#endif //MICROSTL_FLAT_INDEX_H
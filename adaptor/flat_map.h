@@ -0,0 +1,450 @@
+#ifndef MICROSTL_FLAT_MAP_H
+#define MICROSTL_FLAT_MAP_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "flat_index.h"
+#include "../algorithm/algo.h"
+#include "../utility/pair.h"
+
+/**
+ * 基于有序 vector 的 map，key 唯一，key 与 value 分别存放在两个 vector 中（SoA）：
+ *
+ * - 查找只访问 key 数组，value 再大也不会稀释 cache；查找方式与 flat_set 相同
+ * - 迭代器解引用得到 pair<const Key &, T &>，-> 通过临时的代理对象实现
+ * - 单个元素的插入与删除需要移动其后的所有元素，O(n)，适合读多写少的场景
+ * - 批量插入先追加到末尾，按 key 稳定排序后与原有元素一次归并并去重，同一个 key 保留最先出现的元素
+ * - 插入与删除会使所有迭代器失效
+ */
+
+namespace MicroSTL {
+
+    // --------------------- 迭代器 --------------------------
+
+    template<typename Key, typename T, typename ValuePointer>
+    struct _flat_map_iterator {
+        using iterator_category = random_access_iterator_tag;
+        using value_type = pair<Key, T>;
+        using difference_type = ptrdiff_t;
+        using reference = pair<const Key &, decltype(*ValuePointer())>;
+        using iterator = _flat_map_iterator<Key, T, T *>;
+
+        /**
+         * operator-> 需要返回指针，这里返回持有 reference 的代理对象
+         */
+        struct pointer {
+            reference ref;
+
+            reference *operator->() {
+                return &ref;
+            }
+        };
+
+        const Key *key;
+        ValuePointer value;
+
+        _flat_map_iterator() : key(nullptr), value(nullptr) {}
+
+        _flat_map_iterator(const Key *key, ValuePointer value) : key(key), value(value) {}
+
+        _flat_map_iterator(const iterator &obj) : key(obj.key), value(obj.value) {}
+
+        reference operator*() const {
+            return reference(*key, *value);
+        }
+
+        pointer operator->() const {
+            return pointer{**this};
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        _flat_map_iterator &operator++() {
+            ++key;
+            ++value;
+            return *this;
+        }
+
+        _flat_map_iterator operator++(int) {
+            _flat_map_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        _flat_map_iterator &operator--() {
+            --key;
+            --value;
+            return *this;
+        }
+
+        _flat_map_iterator operator--(int) {
+            _flat_map_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        _flat_map_iterator &operator+=(difference_type n) {
+            key += n;
+            value += n;
+            return *this;
+        }
+
+        _flat_map_iterator &operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        _flat_map_iterator operator+(difference_type n) const {
+            return _flat_map_iterator(key + n, value + n);
+        }
+
+        _flat_map_iterator operator-(difference_type n) const {
+            return _flat_map_iterator(key - n, value - n);
+        }
+
+        difference_type operator-(const _flat_map_iterator &obj) const {
+            return key - obj.key;
+        }
+
+        bool operator==(const _flat_map_iterator &obj) const {
+            return key == obj.key;
+        }
+
+        bool operator!=(const _flat_map_iterator &obj) const {
+            return key != obj.key;
+        }
+
+        bool operator<(const _flat_map_iterator &obj) const {
+            return key < obj.key;
+        }
+    };
+
+    // --------------------- flat_map --------------------------
+
+    template<typename Key, typename T, typename Compare = less<Key>>
+    class flat_map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = pair<Key, T>;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using iterator = _flat_map_iterator<Key, T, T *>;
+        using const_iterator = _flat_map_iterator<Key, T, const T *>;
+        using reference = typename iterator::reference;
+        using const_reference = typename const_iterator::reference;
+
+    protected:
+        vector<Key> key_array;
+        vector<T> value_array;
+        _flat_index<Key, Compare> index;
+        Compare comp;
+
+        size_type lower_index(const key_type &k) const {
+            return index.lower_bound(key_array.data(), key_array.size(), k, comp);
+        }
+
+        iterator make_iterator(size_type position) {
+            return iterator(key_array.data() + position, value_array.data() + position);
+        }
+
+        const_iterator make_iterator(size_type position) const {
+            return const_iterator(key_array.data() + position, value_array.data() + position);
+        }
+
+        /**
+         * 在 position 处插入 key 与 value，两个数组保持等长
+         */
+        void insert_at(size_type position, const Key &k, const T &value) {
+            key_array.insert(key_array.begin() + position, k);
+            try {
+                value_array.insert(value_array.begin() + position, value);
+            } catch (...) {
+                key_array.erase(key_array.begin() + position);
+                throw;
+            }
+            index.clear();
+        }
+
+        /**
+         * [0, old_size) 有序且唯一，[old_size, size()) 为新追加的元素。
+         * 只对新元素的下标排序，归并时把 key 与 value 一起搬到新数组中
+         */
+        void merge_appended(size_type old_size) {
+            size_type size = key_array.size();
+            Key *keys = key_array.data();
+            T *values = value_array.data();
+
+            vector<size_type> order;
+            order.reserve(size - old_size);
+            for (size_type i = old_size; i < size; ++i) {
+                order.push_back(i);
+            }
+            MicroSTL::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return comp(keys[a], keys[b]);
+            });
+
+            vector<Key> merged_keys;
+            vector<T> merged_values;
+            merged_keys.reserve(size);
+            merged_values.reserve(size);
+            size_type i = 0;
+            size_type j = 0;
+            size_type appended = order.size();
+            while (i < old_size || j < appended) {
+                // 相等时保留原有元素，新元素与已输出的最后一个元素相等时跳过
+                if (j == appended || (i < old_size && !comp(keys[order[j]], keys[i]))) {
+                    if (j < appended && !comp(keys[i], keys[order[j]])) {
+                        ++j;
+                    }
+                    merged_keys.emplace_back(std::move(keys[i]));
+                    merged_values.emplace_back(std::move(values[i]));
+                    ++i;
+                } else if (merged_keys.size() == 0 || comp(merged_keys.back(), keys[order[j]])) {
+                    merged_keys.emplace_back(std::move(keys[order[j]]));
+                    merged_values.emplace_back(std::move(values[order[j]]));
+                    ++j;
+                } else {
+                    ++j;
+                }
+            }
+            key_array.swap(merged_keys);
+            value_array.swap(merged_values);
+        }
+
+    public:
+        flat_map() : key_array(), value_array(), index(), comp() {}
+
+        explicit flat_map(const Compare &comp) : key_array(), value_array(), index(), comp(comp) {}
+
+        template<typename InputIterator>
+        flat_map(InputIterator first, InputIterator last) : key_array(), value_array(), index(), comp() {
+            insert(first, last);
+        }
+
+        flat_map(const flat_map &obj) = default;
+
+        flat_map(flat_map &&obj) noexcept: key_array(std::move(obj.key_array)), value_array(std::move(obj.value_array)),
+                                           index(std::move(obj.index)), comp(obj.comp) {}
+
+        flat_map &operator=(const flat_map &obj) = default;
+
+        flat_map &operator=(flat_map &&obj) noexcept {
+            key_array = std::move(obj.key_array);
+            value_array = std::move(obj.value_array);
+            index = std::move(obj.index);
+            comp = obj.comp;
+            return *this;
+        }
+
+        iterator begin() {
+            return make_iterator(0);
+        }
+
+        const_iterator begin() const {
+            return make_iterator(0);
+        }
+
+        iterator end() {
+            return make_iterator(key_array.size());
+        }
+
+        const_iterator end() const {
+            return make_iterator(key_array.size());
+        }
+
+        bool empty() const {
+            return key_array.empty();
+        }
+
+        size_type size() const {
+            return key_array.size();
+        }
+
+        void reserve(size_type new_capacity) {
+            key_array.reserve(new_capacity);
+            value_array.reserve(new_capacity);
+        }
+
+        key_compare key_comp() const {
+            return comp;
+        }
+
+        /**
+         * 有序的 key 数组与对应的 value 数组
+         */
+        const vector<Key> &keys() const {
+            return key_array;
+        }
+
+        const vector<T> &values() const {
+            return value_array;
+        }
+
+        // --------------------- 访问 --------------------------
+
+        T &operator[](const key_type &k) {
+            size_type position = lower_index(k);
+            if (position == key_array.size() || comp(k, key_array[position])) {
+                insert_at(position, k, T());
+            }
+            return value_array[position];
+        }
+
+        T &at(const key_type &k) {
+            size_type position = lower_index(k);
+            if (position == key_array.size() || comp(k, key_array[position])) {
+                throw std::out_of_range("flat_map::at");
+            }
+            return value_array[position];
+        }
+
+        const T &at(const key_type &k) const {
+            size_type position = lower_index(k);
+            if (position == key_array.size() || comp(k, key_array[position])) {
+                throw std::out_of_range("flat_map::at");
+            }
+            return value_array[position];
+        }
+
+        // --------------------- 插入 --------------------------
+
+        /**
+         * key 不存在时插入 T(args...)
+         */
+        template<typename... Args>
+        pair<iterator, bool> try_emplace(const key_type &k, Args &&... args) {
+            size_type position = lower_index(k);
+            if (position < key_array.size() && !comp(k, key_array[position])) {
+                return pair<iterator, bool>(make_iterator(position), false);
+            }
+            insert_at(position, k, T(std::forward<Args>(args)...));
+            return pair<iterator, bool>(make_iterator(position), true);
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            return try_emplace(value.first, value.second);
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            value_type value(std::forward<Args>(args)...);
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        /**
+         * 批量插入，区间元素需要有 first 与 second，已存在的 key 不会被覆盖
+         */
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            size_type old_size = key_array.size();
+            for (; first != last; ++first) {
+                key_array.push_back((*first).first);
+                value_array.push_back((*first).second);
+            }
+            if (key_array.size() != old_size) {
+                merge_appended(old_size);
+            }
+            rebuild_index();
+        }
+
+        /**
+         * 单点修改后索引失效，大量查找之前可以手动重建
+         */
+        void rebuild_index() {
+            index.rebuild(key_array.data(), key_array.size());
+        }
+
+        // --------------------- 删除 --------------------------
+
+        iterator erase(const_iterator position) {
+            size_type offset = position.key - key_array.data();
+            key_array.erase(key_array.begin() + offset);
+            value_array.erase(value_array.begin() + offset);
+            index.clear();
+            return make_iterator(offset);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            size_type from = first.key - key_array.data();
+            size_type to = last.key - key_array.data();
+            key_array.erase(key_array.begin() + from, key_array.begin() + to);
+            value_array.erase(value_array.begin() + from, value_array.begin() + to);
+            index.clear();
+            return make_iterator(from);
+        }
+
+        size_type erase(const key_type &k) {
+            const_iterator position = find(k);
+            if (position == end()) {
+                return 0;
+            }
+            erase(position);
+            return 1;
+        }
+
+        void clear() {
+            key_array.clear();
+            value_array.clear();
+            index.clear();
+        }
+
+        void swap(flat_map &obj) {
+            key_array.swap(obj.key_array);
+            value_array.swap(obj.value_array);
+            index.swap(obj.index);
+            MicroSTL::swap(comp, obj.comp);
+        }
+
+        // --------------------- 查找 --------------------------
+
+        iterator lower_bound(const key_type &k) {
+            return make_iterator(lower_index(k));
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return make_iterator(lower_index(k));
+        }
+
+        iterator upper_bound(const key_type &k) {
+            return make_iterator(index.upper_bound(key_array.data(), key_array.size(), k, comp));
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return make_iterator(index.upper_bound(key_array.data(), key_array.size(), k, comp));
+        }
+
+        pair<iterator, iterator> equal_range(const key_type &k) {
+            return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        iterator find(const key_type &k) {
+            size_type position = lower_index(k);
+            if (position == key_array.size() || comp(k, key_array[position])) {
+                return end();
+            }
+            return make_iterator(position);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return const_cast<flat_map *>(this)->find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return find(k) == end() ? 0 : 1;
+        }
+
+        bool contains(const key_type &k) const {
+            return find(k) != end();
+        }
+    };
+}
+
+#endif //MICROSTL_FLAT_MAP_H
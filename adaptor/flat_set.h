@@ -0,0 +1,251 @@
+#ifndef MICROSTL_FLAT_SET_H
+#define MICROSTL_FLAT_SET_H
+
+#include <cstddef>
+#include <utility>
+#include "flat_index.h"
+#include "../algorithm/algo.h"
+
+/**
+ * 基于有序 vector 的集合，元素唯一：
+ *
+ * - 元素连续存放，查找为二分查找（算术类型的 key 在批量修改后使用 Eytzinger 索引），遍历就是顺序扫描数组
+ * - 单个元素的插入与删除需要移动其后的所有元素，O(n)，适合读多写少的场景
+ * - 批量插入先追加到末尾并排序，再与原有元素一次归并并去重，O(n + m log m)
+ * - 插入与删除会使所有迭代器失效
+ */
+
+namespace MicroSTL {
+
+    template<typename Key, typename Compare = less<Key>>
+    class flat_set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        // 元素即 key，不允许通过迭代器修改；直接使用底层数组的指针，不随 vector 的加固级别改变
+        using iterator = const Key *;
+        using const_iterator = const Key *;
+
+    protected:
+        vector<Key> keys;
+        _flat_index<Key, Compare> index;
+        Compare comp;
+
+        size_type lower_index(const key_type &k) const {
+            return index.lower_bound(keys.data(), keys.size(), k, comp);
+        }
+
+        /**
+         * [0, old_size) 有序且唯一，[old_size, size()) 为新追加的元素
+         */
+        void merge_appended(size_type old_size) {
+            Key *data = keys.data();
+            size_type size = keys.size();
+            MicroSTL::sort(data + old_size, data + size, comp);
+
+            if (old_size == 0 || comp(data[old_size - 1], data[old_size])) {
+                // 新元素都大于原有元素，只需要对新追加的部分原地去重
+                size_type result = old_size;
+                for (size_type i = old_size; i < size; ++i) {
+                    if (result == old_size || comp(data[result - 1], data[i])) {
+                        if (result != i) {
+                            data[result] = std::move(data[i]);
+                        }
+                        ++result;
+                    }
+                }
+                keys.erase(keys.begin() + result, keys.end());
+                return;
+            }
+
+            vector<Key> merged;
+            merged.reserve(size);
+            size_type i = 0;
+            size_type j = old_size;
+            while (i < old_size || j < size) {
+                // 相等时保留原有元素，新元素与已输出的最后一个元素相等时跳过
+                if (j == size || (i < old_size && !comp(data[j], data[i]))) {
+                    if (j < size && !comp(data[i], data[j])) {
+                        ++j;
+                    }
+                    merged.emplace_back(std::move(data[i++]));
+                } else if (merged.size() == 0 || comp(merged.back(), data[j])) {
+                    merged.emplace_back(std::move(data[j++]));
+                } else {
+                    ++j;
+                }
+            }
+            keys.swap(merged);
+        }
+
+    public:
+        flat_set() : keys(), index(), comp() {}
+
+        explicit flat_set(const Compare &comp) : keys(), index(), comp(comp) {}
+
+        template<typename InputIterator>
+        flat_set(InputIterator first, InputIterator last) : keys(), index(), comp() {
+            insert(first, last);
+        }
+
+        flat_set(const flat_set &obj) = default;
+
+        flat_set(flat_set &&obj) noexcept: keys(std::move(obj.keys)), index(std::move(obj.index)), comp(obj.comp) {}
+
+        flat_set &operator=(const flat_set &obj) = default;
+
+        flat_set &operator=(flat_set &&obj) noexcept {
+            keys = std::move(obj.keys);
+            index = std::move(obj.index);
+            comp = obj.comp;
+            return *this;
+        }
+
+        const_iterator begin() const {
+            return keys.data();
+        }
+
+        const_iterator end() const {
+            return keys.data() + keys.size();
+        }
+
+        bool empty() const {
+            return keys.empty();
+        }
+
+        size_type size() const {
+            return keys.size();
+        }
+
+        size_type capacity() const {
+            return keys.capacity();
+        }
+
+        void reserve(size_type new_capacity) {
+            keys.reserve(new_capacity);
+        }
+
+        key_compare key_comp() const {
+            return comp;
+        }
+
+        /**
+         * 底层的有序数组
+         */
+        const vector<Key> &data() const {
+            return keys;
+        }
+
+        // --------------------- 插入 --------------------------
+
+        pair<iterator, bool> insert(const value_type &value) {
+            size_type position = lower_index(value);
+            if (position < keys.size() && !comp(value, keys[position])) {
+                return pair<iterator, bool>(keys.data() + position, false);
+            }
+            keys.insert(keys.begin() + position, value);
+            index.clear();
+            return pair<iterator, bool>(keys.data() + position, true);
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        /**
+         * 批量插入，与原有元素相等的新元素被忽略
+         */
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            size_type old_size = keys.size();
+            for (; first != last; ++first) {
+                keys.push_back(*first);
+            }
+            if (keys.size() != old_size) {
+                merge_appended(old_size);
+            }
+            rebuild_index();
+        }
+
+        /**
+         * 单点修改后索引失效，大量查找之前可以手动重建
+         */
+        void rebuild_index() {
+            index.rebuild(keys.data(), keys.size());
+        }
+
+        // --------------------- 删除 --------------------------
+
+        iterator erase(const_iterator position) {
+            size_type offset = position - keys.data();
+            keys.erase(keys.begin() + offset);
+            index.clear();
+            return keys.data() + offset;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            size_type offset = first - keys.data();
+            keys.erase(keys.begin() + offset, keys.begin() + (last - keys.data()));
+            index.clear();
+            return keys.data() + offset;
+        }
+
+        size_type erase(const key_type &k) {
+            const_iterator position = find(k);
+            if (position == end()) {
+                return 0;
+            }
+            erase(position);
+            return 1;
+        }
+
+        void clear() {
+            keys.clear();
+            index.clear();
+        }
+
+        void swap(flat_set &obj) {
+            keys.swap(obj.keys);
+            index.swap(obj.index);
+            MicroSTL::swap(comp, obj.comp);
+        }
+
+        // --------------------- 查找 --------------------------
+
+        const_iterator lower_bound(const key_type &k) const {
+            return keys.data() + lower_index(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return keys.data() + index.upper_bound(keys.data(), keys.size(), k, comp);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        const_iterator find(const key_type &k) const {
+            size_type position = lower_index(k);
+            if (position == keys.size() || comp(k, keys[position])) {
+                return end();
+            }
+            return keys.data() + position;
+        }
+
+        size_type count(const key_type &k) const {
+            return find(k) == end() ? 0 : 1;
+        }
+
+        bool contains(const key_type &k) const {
+            return find(k) != end();
+        }
+    };
+}
+
+#endif //MICROSTL_FLAT_SET_H
@@ -0,0 +1,128 @@
+#ifndef MICROSTL_PRIORITY_QUEUE_H
+#define MICROSTL_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <utility>
+#include "../algorithm/heap.h"
+#include "../container/vector.h"
+#include "../functor/functional.h"
+
+/**
+ * priority_queue 适配器，底层容器默认为 MicroSTL::vector，默认为大顶堆
+ *
+ * - Arity 为堆的分叉数，在编译期确定：
+ *      - Arity = 2 为经典的二叉堆
+ *      - Arity = 4 时堆高减半，同一父节点的子节点位于相邻的内存，pop 的 cache miss 明显更少，
+ *        适合定时器、调度器这类 pop 频繁的队列
+ * - push_range 批量插入：新增元素较多时直接追加后整体 O(n) 建堆，较少时逐个上浮
+ */
+
+namespace MicroSTL {
+
+    template<typename T,
+            typename Sequence = vector<T>,
+            typename Compare = less<typename Sequence::value_type>,
+            size_t Arity = 2>
+    class priority_queue {
+        static_assert(Arity >= 2, "priority_queue 的分叉数至少为 2");
+
+    public:
+        using value_type = typename Sequence::value_type;
+        using size_type = typename Sequence::size_type;
+        using reference = typename Sequence::reference;
+        using const_reference = typename Sequence::const_reference;
+        using container_type = Sequence;
+        using value_compare = Compare;
+
+        static constexpr size_t arity = Arity;
+
+    protected:
+        Sequence c;
+        Compare comp;
+
+    public:
+        priority_queue() : c(), comp() {}
+
+        explicit priority_queue(const Compare &x) : c(), comp(x) {}
+
+        template<typename InputIterator>
+        priority_queue(InputIterator first, InputIterator last, const Compare &x = Compare()) : c(), comp(x) {
+            push_range(first, last);
+        }
+
+        bool empty() const {
+            return c.empty();
+        }
+
+        size_type size() const {
+            return c.size();
+        }
+
+        const_reference top() const {
+            return c.front();
+        }
+
+        void push(const value_type &x) {
+            c.push_back(x);
+            _push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        void push(value_type &&x) {
+            c.emplace_back(std::move(x));
+            _push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        template<typename... Args>
+        void emplace(Args &&... args) {
+            c.emplace_back(std::forward<Args>(args)...);
+            _push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        void pop() {
+            _pop_heap<Arity>(c.begin(), c.end(), comp);
+            c.pop_back();
+        }
+
+        /**
+         * 批量插入 [first, last)
+         *
+         * 逐个上浮的代价约为 k * log(n + k)，整体建堆的代价约为 n + k，取较小者
+         */
+        template<typename InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            size_type old_size = c.size();
+            for (; first != last; ++first) {
+                c.push_back(*first);
+            }
+            size_type new_size = c.size();
+            size_type added = new_size - old_size;
+            if (added == 0) {
+                return;
+            }
+            if (added * _log2(new_size) >= new_size) {
+                _make_heap<Arity>(c.begin(), c.end(), comp);
+            } else {
+                for (size_type i = old_size + 1; i <= new_size; ++i) {
+                    _push_heap<Arity>(c.begin(), c.begin() + i, comp);
+                }
+            }
+        }
+
+        void swap(priority_queue &obj) {
+            c.swap(obj.c);
+            MicroSTL::swap(comp, obj.comp);
+        }
+
+    private:
+        static size_type _log2(size_type n) {
+            size_type k = 0;
+            while (n > 1) {
+                n >>= 1;
+                ++k;
+            }
+            return k;
+        }
+    };
+}
+
+#endif //MICROSTL_PRIORITY_QUEUE_H
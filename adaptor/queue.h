@@ -0,0 +1,80 @@
+#ifndef MICROSTL_QUEUE_H
+#define MICROSTL_QUEUE_H
+
+#include <utility>
+#include "../container/deque.h"
+
+/**
+ * 先进先出队列适配器，底层容器默认为 MicroSTL::deque
+ *
+ * - 底层容器需要提供 front、back、push_back、emplace_back、pop_front
+ * - deque 两端操作均为 O(1) 且不会整体搬移元素，适合作为工作队列
+ */
+
+namespace MicroSTL {
+
+    template<typename T, typename Sequence = deque<T>>
+    class queue {
+    public:
+        using value_type = typename Sequence::value_type;
+        using size_type = typename Sequence::size_type;
+        using reference = typename Sequence::reference;
+        using const_reference = typename Sequence::const_reference;
+        using container_type = Sequence;
+
+    protected:
+        Sequence c;
+
+    public:
+        queue() : c() {}
+
+        explicit queue(const Sequence &c) : c(c) {}
+
+        bool empty() const {
+            return c.empty();
+        }
+
+        size_type size() const {
+            return c.size();
+        }
+
+        reference front() {
+            return c.front();
+        }
+
+        const_reference front() const {
+            return c.front();
+        }
+
+        reference back() {
+            return c.back();
+        }
+
+        const_reference back() const {
+            return c.back();
+        }
+
+        void push(const value_type &x) {
+            c.push_back(x);
+        }
+
+        void push(value_type &&x) {
+            c.push_back(std::move(x));
+        }
+
+        template<typename... Args>
+        void emplace(Args &&... args) {
+            c.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop() {
+            c.pop_front();
+        }
+
+        void swap(queue &obj) {
+            c.swap(obj.c);
+        }
+    };
+}
+
+#endif //MICROSTL_QUEUE_H
@@ -0,0 +1,68 @@
+#ifndef MICROSTL_STACK_H
+#define MICROSTL_STACK_H
+
+#include <utility>
+#include "../container/deque.h"
+
+/**
+ * 后进先出栈适配器，底层容器默认为 MicroSTL::deque
+ *
+ * - 底层容器需要提供 back、push_back、emplace_back、pop_back，也可以使用 MicroSTL::vector
+ * - deque 增长时不会复制已有元素，栈中元素的引用在 push 之后仍然有效
+ */
+
+namespace MicroSTL {
+
+    template<typename T, typename Sequence = deque<T>>
+    class stack {
+    public:
+        using value_type = typename Sequence::value_type;
+        using size_type = typename Sequence::size_type;
+        using reference = typename Sequence::reference;
+        using const_reference = typename Sequence::const_reference;
+        using container_type = Sequence;
+
+    protected:
+        Sequence c;
+
+    public:
+        stack() : c() {}
+
+        explicit stack(const Sequence &c) : c(c) {}
+
+        bool empty() const {
+            return c.empty();
+        }
+
+        size_type size() const {
+            return c.size();
+        }
+
+        reference top() {
+            return c.back();
+        }
+
+        const_reference top() const {
+            return c.back();
+        }
+
+        void push(const value_type &x) {
+            c.push_back(x);
+        }
+
+        template<typename... Args>
+        void emplace(Args &&... args) {
+            c.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop() {
+            c.pop_back();
+        }
+
+        void swap(stack &obj) {
+            c.swap(obj.c);
+        }
+    };
+}
+
+#endif //MICROSTL_STACK_H
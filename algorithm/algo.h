@@ -0,0 +1,700 @@
+#ifndef MICROSTL_ALGO_H
+#define MICROSTL_ALGO_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../iterator/type_traits.h"
+#include "../functor/functional.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "algobase.h"
+#include "heap.h"
+
+/**
+ * sort 系列算法，只接受 RandomAccessIterator：
+ *
+ * - sort：pattern-defeating quicksort（pdqsort）
+ *      - 区间长度 < 24 时使用插入排序
+ *      - 长度 > 128 时使用 ninther（九数取中）选择 pivot，否则三数取中
+ *      - 如果 pivot 与左侧的上一个 pivot 相等，则把所有相等的元素一次性划分到左边，重复元素多的输入退化为 O(n)
+ *      - 如果划分前区间已经有序，尝试有限次数的插入排序，有序/逆序输入退化为 O(n)
+ *      - 划分极度不平衡时打乱几个元素以破坏"杀手"输入的模式，不平衡次数超过 log(n) 则改用堆排序，保证 O(nlogn)
+ *      - 对于算术类型 + 默认比较器，使用 BlockQuicksort 的无分支划分，比较结果只参与偏移量计算，避免分支预测失败
+ * - stable_sort：归并排序，临时缓冲区由 Alloc<T> 分配，大小为 n / 2
+ * - partial_sort：堆选择 + 堆排序
+ * - nth_element：introselect，复用 pdqsort 的划分过程，递归过深时改用堆选择
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 小于该长度的区间使用插入排序
+     */
+    static const ptrdiff_t SORT_INSERTION_THRESHOLD = 24;
+    /**
+     * 大于该长度的区间使用 ninther 选择 pivot
+     */
+    static const ptrdiff_t SORT_NINTHER_THRESHOLD = 128;
+    /**
+     * partial insertion sort 最多允许移动的元素个数，超过则放弃
+     */
+    static const size_t SORT_PARTIAL_INSERTION_LIMIT = 8;
+    /**
+     * 无分支划分时每一轮扫描的元素个数，偏移量使用 unsigned char 存储
+     */
+    static const size_t SORT_BLOCK_SIZE = 64;
+    /**
+     * stable_sort 中直接使用插入排序的区间长度
+     */
+    static const ptrdiff_t STABLE_SORT_CHUNK = 32;
+
+    // --------------------- 是否使用无分支划分 --------------------------
+
+    /**
+     * 只有算术类型配合默认比较器时，比较才足够廉价且没有副作用，可以把比较结果直接当作整数使用
+     */
+    template<typename T, typename Compare>
+    struct _branchless_partition {
+        using type = false_type;
+    };
+
+    template<typename T>
+    struct _branchless_partition<T, less<T>> {
+        using type = typename arithmetic_traits<T>::is_arithmetic;
+    };
+
+    template<typename T>
+    struct _branchless_partition<T, greater<T>> {
+        using type = typename arithmetic_traits<T>::is_arithmetic;
+    };
+
+    // --------------------- 堆选择（partial_sort 与 nth_element 的兜底方案） --------------------------
+
+    /**
+     * 将 [first, last) 中最小的 middle - first 个元素有序地放入 [first, middle)
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _heap_select_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+                      Compare comp) {
+        _make_heap<2>(first, middle, comp);
+        for (RandomAccessIterator iter = middle; iter < last; ++iter) {
+            if (comp(*iter, *first)) {
+                _pop_heap<2>(first, middle, iter, comp);
+            }
+        }
+        _sort_heap<2>(first, middle, comp);
+    }
+
+    // --------------------- 插入排序 --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (first == last) {
+            return;
+        }
+        for (RandomAccessIterator current = first + 1; current != last; ++current) {
+            RandomAccessIterator sift = current;
+            RandomAccessIterator sift_prev = current - 1;
+            // 先比较一次，已经在正确位置上的元素无需移动
+            if (comp(*sift, *sift_prev)) {
+                T tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_prev);
+                } while (sift != first && comp(tmp, *--sift_prev));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    /**
+     * 要求 first - 1 处存在一个不大于区间内任意元素的值作为哨兵，省去边界判断
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _unguarded_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (first == last) {
+            return;
+        }
+        for (RandomAccessIterator current = first + 1; current != last; ++current) {
+            RandomAccessIterator sift = current;
+            RandomAccessIterator sift_prev = current - 1;
+            if (comp(*sift, *sift_prev)) {
+                T tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_prev);
+                } while (comp(tmp, *--sift_prev));
+                *sift = std::move(tmp);
+            }
+        }
+    }
+
+    /**
+     * 尝试用插入排序完成排序，移动次数超过 SORT_PARTIAL_INSERTION_LIMIT 则放弃并返回 false
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline bool
+    _partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (first == last) {
+            return true;
+        }
+        size_t limit = 0;
+        for (RandomAccessIterator current = first + 1; current != last; ++current) {
+            RandomAccessIterator sift = current;
+            RandomAccessIterator sift_prev = current - 1;
+            if (comp(*sift, *sift_prev)) {
+                T tmp = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_prev);
+                } while (sift != first && comp(tmp, *--sift_prev));
+                *sift = std::move(tmp);
+                limit += current - sift;
+            }
+            if (limit > SORT_PARTIAL_INSERTION_LIMIT) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // --------------------- 选择 pivot --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _sort2(RandomAccessIterator a, RandomAccessIterator b, Compare comp) {
+        if (comp(*b, *a)) {
+            MicroSTL::iter_swap(a, b);
+        }
+    }
+
+    /**
+     * 排序后 *a <= *b <= *c
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare comp) {
+        _sort2(a, b, comp);
+        _sort2(b, c, comp);
+        _sort2(a, b, comp);
+    }
+
+    /**
+     * 把 pivot 放到 *first，并保证 *(last - 1) >= pivot，作为划分时向右扫描的哨兵
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    _choose_pivot(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        Distance size = last - first;
+        Distance half = size / 2;
+        if (size > SORT_NINTHER_THRESHOLD) {
+            _sort3(first, first + half, last - 1, comp);
+            _sort3(first + 1, first + (half - 1), last - 2, comp);
+            _sort3(first + 2, first + (half + 1), last - 3, comp);
+            _sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            MicroSTL::iter_swap(first, first + half);
+        } else {
+            _sort3(first + half, first, last - 1, comp);
+        }
+    }
+
+    // --------------------- 划分 --------------------------
+
+    /**
+     * 以 *first 为 pivot 进行划分：[first, pivot) < pivot <= [pivot + 1, last)
+     * 返回 pivot 最终的位置；already_partitioned 表示划分前区间是否已经满足条件（没有发生交换）
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline RandomAccessIterator
+    _partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+                     bool &already_partitioned, false_type) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        T pivot = std::move(*first);
+        RandomAccessIterator left = first;
+        RandomAccessIterator right = last;
+
+        // _choose_pivot 保证了右侧存在哨兵
+        while (comp(*++left, pivot));
+
+        // 如果左侧第一个元素就 >= pivot，那么右侧不一定有哨兵
+        if (left - 1 == first) {
+            while (left < right && !comp(*--right, pivot));
+        } else {
+            while (!comp(*--right, pivot));
+        }
+
+        already_partitioned = left >= right;
+
+        while (left < right) {
+            MicroSTL::iter_swap(left, right);
+            while (comp(*++left, pivot));
+            while (!comp(*--right, pivot));
+        }
+
+        RandomAccessIterator pivot_pos = left - 1;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    /**
+     * 将 offsets 记录的左右两侧放错位置的元素两两交换
+     * 如果左右个数相等，使用普通的交换；否则使用轮换，每个元素只移动一次
+     */
+    template<typename RandomAccessIterator>
+    inline void
+    _swap_offsets(RandomAccessIterator first, RandomAccessIterator last,
+                  unsigned char *offsets_l, unsigned char *offsets_r, size_t num, bool use_swaps) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (use_swaps) {
+            for (size_t i = 0; i < num; ++i) {
+                MicroSTL::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+            }
+        } else if (num > 0) {
+            RandomAccessIterator l = first + offsets_l[0];
+            RandomAccessIterator r = last - offsets_r[0];
+            T tmp = std::move(*l);
+            *l = std::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = std::move(*l);
+                r = last - offsets_r[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+
+    /**
+     * 无分支划分（BlockQuicksort）：
+     * - 每次从左右两端各扫描 SORT_BLOCK_SIZE 个元素，把放错位置的元素的偏移量写入缓冲区
+     *      - 写偏移量是无条件的，比较结果只决定计数器是否 +1，循环体内没有分支
+     * - 再把左右两侧缓冲区中的元素两两交换
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline RandomAccessIterator
+    _partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+                     bool &already_partitioned, true_type) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        T pivot = std::move(*first);
+        RandomAccessIterator left = first;
+        RandomAccessIterator right = last;
+
+        while (comp(*++left, pivot));
+
+        if (left - 1 == first) {
+            while (left < right && !comp(*--right, pivot));
+        } else {
+            while (!comp(*--right, pivot));
+        }
+
+        already_partitioned = left >= right;
+
+        if (!already_partitioned) {
+            MicroSTL::iter_swap(left, right);
+            ++left;
+
+            alignas(64) unsigned char offsets_l[SORT_BLOCK_SIZE];
+            alignas(64) unsigned char offsets_r[SORT_BLOCK_SIZE];
+
+            RandomAccessIterator offsets_l_base = left;
+            RandomAccessIterator offsets_r_base = right;
+            size_t num_l = 0;
+            size_t num_r = 0;
+            size_t start_l = 0;
+            size_t start_r = 0;
+
+            while (left < right) {
+                // 只有缓冲区用尽的一侧需要继续扫描
+                size_t num_unknown = right - left;
+                size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                if (left_split >= SORT_BLOCK_SIZE) {
+                    for (size_t i = 0; i < SORT_BLOCK_SIZE;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*left, pivot);
+                        ++left;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*left, pivot);
+                        ++left;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*left, pivot);
+                        ++left;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*left, pivot);
+                        ++left;
+                    }
+                } else {
+                    for (size_t i = 0; i < left_split;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !comp(*left, pivot);
+                        ++left;
+                    }
+                }
+
+                if (right_split >= SORT_BLOCK_SIZE) {
+                    for (size_t i = 0; i < SORT_BLOCK_SIZE;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--right, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--right, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--right, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--right, pivot);
+                    }
+                } else {
+                    for (size_t i = 0; i < right_split;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(*--right, pivot);
+                    }
+                }
+
+                size_t num = num_l < num_r ? num_l : num_r;
+                _swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                              num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+
+                if (num_l == 0) {
+                    start_l = 0;
+                    offsets_l_base = left;
+                }
+                if (num_r == 0) {
+                    start_r = 0;
+                    offsets_r_base = right;
+                }
+            }
+
+            // 处理某一侧缓冲区中剩余的元素
+            if (num_l) {
+                unsigned char *offsets = offsets_l + start_l;
+                while (num_l--) {
+                    MicroSTL::iter_swap(offsets_l_base + offsets[num_l], --right);
+                }
+                left = right;
+            }
+            if (num_r) {
+                unsigned char *offsets = offsets_r + start_r;
+                while (num_r--) {
+                    MicroSTL::iter_swap(offsets_r_base - offsets[num_r], left);
+                    ++left;
+                }
+                right = left;
+            }
+        }
+
+        RandomAccessIterator pivot_pos = left - 1;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    /**
+     * 以 *first 为 pivot 进行划分：[first, pivot] <= pivot < [pivot + 1, last)
+     * 用于 pivot 与左侧上一个 pivot 相等的情况，此时所有等于 pivot 的元素都被放到左边，无需再排序
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline RandomAccessIterator
+    _partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        T pivot = std::move(*first);
+        RandomAccessIterator left = first;
+        RandomAccessIterator right = last;
+
+        while (comp(pivot, *--right));
+
+        if (right + 1 == last) {
+            while (left < right && !comp(pivot, *++left));
+        } else {
+            while (!comp(pivot, *++left));
+        }
+
+        while (left < right) {
+            MicroSTL::iter_swap(left, right);
+            while (comp(pivot, *--right));
+            while (!comp(pivot, *++left));
+        }
+
+        RandomAccessIterator pivot_pos = right;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    // --------------------- sort --------------------------
+
+    /**
+     * 划分极度不平衡时，交换若干元素以打破输入中的模式
+     */
+    template<typename RandomAccessIterator, typename Distance>
+    inline void
+    _break_patterns(RandomAccessIterator first, RandomAccessIterator pivot_pos, RandomAccessIterator last,
+                    Distance l_size, Distance r_size) {
+        if (l_size >= SORT_INSERTION_THRESHOLD) {
+            MicroSTL::iter_swap(first, first + l_size / 4);
+            MicroSTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+            if (l_size > SORT_NINTHER_THRESHOLD) {
+                MicroSTL::iter_swap(first + 1, first + (l_size / 4 + 1));
+                MicroSTL::iter_swap(first + 2, first + (l_size / 4 + 2));
+                MicroSTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                MicroSTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+            }
+        }
+        if (r_size >= SORT_INSERTION_THRESHOLD) {
+            MicroSTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+            MicroSTL::iter_swap(last - 1, last - r_size / 4);
+            if (r_size > SORT_NINTHER_THRESHOLD) {
+                MicroSTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                MicroSTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                MicroSTL::iter_swap(last - 2, last - (1 + r_size / 4));
+                MicroSTL::iter_swap(last - 3, last - (2 + r_size / 4));
+            }
+        }
+    }
+
+    /**
+     * pdqsort 主循环
+     * - bad_allowed：还允许出现几次极度不平衡的划分
+     * - leftmost：区间是否位于最左侧，非最左侧的区间 first - 1 处的元素可以作为哨兵
+     */
+    template<typename RandomAccessIterator, typename Compare, typename Branchless>
+    void _pdqsort_loop(RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+                       int bad_allowed, bool leftmost, Branchless) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (;;) {
+            Distance size = last - first;
+
+            if (size < SORT_INSERTION_THRESHOLD) {
+                if (leftmost) {
+                    _insertion_sort(first, last, comp);
+                } else {
+                    _unguarded_insertion_sort(first, last, comp);
+                }
+                return;
+            }
+
+            _choose_pivot(first, last, comp);
+
+            // pivot 与左侧上一个 pivot 相等，说明存在大量重复元素
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = _partition_left(first, last, comp) + 1;
+                continue;
+            }
+
+            bool already_partitioned;
+            RandomAccessIterator pivot_pos = _partition_right(first, last, comp, already_partitioned, Branchless());
+
+            Distance l_size = pivot_pos - first;
+            Distance r_size = last - (pivot_pos + 1);
+            bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+            if (highly_unbalanced) {
+                if (--bad_allowed == 0) {
+                    _make_heap<2>(first, last, comp);
+                    _sort_heap<2>(first, last, comp);
+                    return;
+                }
+                _break_patterns(first, pivot_pos, last, l_size, r_size);
+            } else if (already_partitioned && _partial_insertion_sort(first, pivot_pos, comp)
+                       && _partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                return;
+            }
+
+            // 递归处理左侧，循环处理右侧
+            _pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost, Branchless());
+            first = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template<typename Size>
+    inline int _log2(Size n) {
+        int result = 0;
+        while (n >>= 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        using branchless = typename _branchless_partition<T, Compare>::type;
+        if (last - first < 2) {
+            return;
+        }
+        _pdqsort_loop(first, last, comp, _log2(last - first), true, branchless());
+    }
+
+    template<typename RandomAccessIterator>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        MicroSTL::sort(first, last, less<T>());
+    }
+
+    // --------------------- stable_sort --------------------------
+
+    /**
+     * 将 [first, middle) 移入缓冲区，再与 [middle, last) 归并回原区间
+     * 两侧相等时优先取左侧元素，保证稳定
+     */
+    template<typename RandomAccessIterator, typename T, typename Compare>
+    inline void
+    _merge_with_buffer(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+                       T *buffer, Compare comp) {
+        T *buffer_end = buffer;
+        for (RandomAccessIterator iter = first; iter != middle; ++iter, ++buffer_end) {
+            new(buffer_end) T(std::move(*iter));
+        }
+
+        T *left = buffer;
+        RandomAccessIterator right = middle;
+        RandomAccessIterator result = first;
+        while (left != buffer_end && right != last) {
+            if (comp(*right, *left)) {
+                *result = std::move(*right);
+                ++right;
+            } else {
+                *result = std::move(*left);
+                ++left;
+            }
+            ++result;
+        }
+        for (; left != buffer_end; ++left, ++result) {
+            *result = std::move(*left);
+        }
+
+        MicroSTL::destroy(buffer, buffer_end);
+    }
+
+    template<typename RandomAccessIterator, typename T, typename Compare>
+    void _merge_sort_with_buffer(RandomAccessIterator first, RandomAccessIterator last, T *buffer, Compare comp) {
+        if (last - first <= STABLE_SORT_CHUNK) {
+            _insertion_sort(first, last, comp);
+            return;
+        }
+        RandomAccessIterator middle = first + (last - first) / 2;
+        _merge_sort_with_buffer(first, middle, buffer, comp);
+        _merge_sort_with_buffer(middle, last, buffer, comp);
+        // 两段首尾已经有序，无需归并
+        if (!comp(*middle, *(middle - 1))) {
+            return;
+        }
+        _merge_with_buffer(first, middle, last, buffer, comp);
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (last - first <= STABLE_SORT_CHUNK) {
+            _insertion_sort(first, last, comp);
+            return;
+        }
+        // 左半部分最多 (n + 1) / 2 个元素
+        size_t buffer_size = (last - first + 1) / 2;
+        T *buffer = Alloc<T>::allocate(buffer_size);
+        try {
+            _merge_sort_with_buffer(first, last, buffer, comp);
+        } catch (...) {
+            Alloc<T>::deallocate(buffer, buffer_size);
+            throw;
+        }
+        Alloc<T>::deallocate(buffer, buffer_size);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        MicroSTL::stable_sort(first, last, less<T>());
+    }
+
+    // --------------------- partial_sort --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare comp) {
+        if (first == middle) {
+            return;
+        }
+        _heap_select_sort(first, middle, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void
+    partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        MicroSTL::partial_sort(first, middle, last, less<T>());
+    }
+
+    // --------------------- nth_element --------------------------
+
+    template<typename RandomAccessIterator, typename Compare, typename Branchless>
+    void _introselect(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last,
+                      Compare comp, int depth_limit, Branchless) {
+        const RandomAccessIterator begin = first;
+        while (last - first >= SORT_INSERTION_THRESHOLD) {
+            if (depth_limit-- == 0) {
+                _heap_select_sort(first, nth + 1, last, comp);
+                return;
+            }
+
+            _choose_pivot(first, last, comp);
+
+            if (first != begin && !comp(*(first - 1), *first)) {
+                // [first, pivot_pos] 全部等于 pivot
+                RandomAccessIterator pivot_pos = _partition_left(first, last, comp);
+                if (nth <= pivot_pos) {
+                    return;
+                }
+                first = pivot_pos + 1;
+                continue;
+            }
+
+            bool already_partitioned;
+            RandomAccessIterator pivot_pos = _partition_right(first, last, comp, already_partitioned, Branchless());
+            if (pivot_pos == nth) {
+                return;
+            }
+            if (nth < pivot_pos) {
+                last = pivot_pos;
+            } else {
+                first = pivot_pos + 1;
+            }
+        }
+        if (first == begin) {
+            _insertion_sort(first, last, comp);
+        } else {
+            _unguarded_insertion_sort(first, last, comp);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void
+    nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare comp) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        using branchless = typename _branchless_partition<T, Compare>::type;
+        if (nth == last || last - first < 2) {
+            return;
+        }
+        _introselect(first, nth, last, comp, 2 * _log2(last - first), branchless());
+    }
+
+    template<typename RandomAccessIterator>
+    inline void
+    nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        MicroSTL::nth_element(first, nth, last, less<T>());
+    }
+}
+
+#endif //MICROSTL_ALGO_H
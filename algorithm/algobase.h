@@ -1,9 +1,14 @@
 #ifndef MICROSTL_ALGOBASE_H
 #define MICROSTL_ALGOBASE_H
 
+#include <cstddef>
+#include <cstring>
+#include <utility>
 #include "../iterator/iterator.h"
 #include "../iterator/iterator_traits.h"
 #include "../iterator/type_traits.h"
+#include "../utility/pair.h"
+#include "simd.h"
 
 namespace MicroSTL {
     // --------------------- fill_n --------------------------
@@ -56,7 +61,10 @@ namespace MicroSTL {
     template<typename T>
     inline T *
     _copy_t(const T *first, const T *last, T *result, true_type) {
-        memmove(result, first, sizeof(T) * (last - first));
+        // 空容器的区间可能是 (nullptr, nullptr)，memmove 的参数不能为空指针，即使长度为 0
+        if (first != last) {
+            memmove(result, first, sizeof(T) * (last - first));
+        }
         return result + (last - first);
     }
 
@@ -98,7 +106,7 @@ namespace MicroSTL {
 
     template<typename T>
     struct copy_dispatch<const T *, T *> {
-        T *operator()(T *first, T *last, T *result) {
+        T *operator()(const T *first, const T *last, T *result) {
             using operator_type = typename type_traits<T>::has_trivial_assignment_operator;
             return _copy_t(first, last, result, operator_type());
         }
@@ -112,13 +120,17 @@ namespace MicroSTL {
 
     inline char *
     copy(char *first, char *last, char *result) {
-        memmove(result, first, last - first);
+        if (first != last) {
+            memmove(result, first, last - first);
+        }
         return result + (last - first);
     }
 
     inline wchar_t *
     copy(wchar_t *first, wchar_t *last, wchar_t *result) {
-        memmove(result, first, sizeof(wchar_t) * (last - first));
+        if (first != last) {
+            memmove(result, first, sizeof(wchar_t) * (last - first));
+        }
         return result + (last - first);
     }
 
@@ -132,8 +144,8 @@ namespace MicroSTL {
     inline BidirectionalIterator2
     _copy_backward_d(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result,
                      Distance *) {
-        for (Distance distance = last - first; distance > 0; --distance, --result, --last) {
-            *result = *last;
+        for (Distance distance = last - first; distance > 0; --distance) {
+            *--result = *--last;
         }
         return result;
     }
@@ -142,7 +154,9 @@ namespace MicroSTL {
     inline T *
     _copy_backward_t(const T *first, const T *last, T *result, true_type) {
         size_t len = sizeof(T) * (last - first);
-        memmove(result - (last - first), first, len);
+        if (first != last) {
+            memmove(result - (last - first), first, len);
+        }
         return result - (last - first);
     }
 
@@ -156,8 +170,8 @@ namespace MicroSTL {
     inline BidirectionalIterator2
     _copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result,
                    bidirectional_iterator_tag) {
-        for (; last != first; --last, --result) {
-            *result = *last;
+        while (last != first) {
+            *--result = *--last;
         }
         return result;
     }
@@ -187,7 +201,7 @@ namespace MicroSTL {
 
     template<typename T>
     struct copy_backward_dispatch<const T *, T *> {
-        T *operator()(T *first, T *last, T *result) {
+        T *operator()(const T *first, const T *last, T *result) {
             using operator_type = typename type_traits<T>::has_trivial_assignment_operator;
             return _copy_backward_t(first, last, result, operator_type());
         }
@@ -201,14 +215,18 @@ namespace MicroSTL {
 
     inline char *
     copy_backward(char *first, char *last, char *result) {
-        memmove(result - (last - first), first, (last - first));
+        if (first != last) {
+            memmove(result - (last - first), first, (last - first));
+        }
         return result - (last - first);
     }
 
     inline wchar_t *
     copy_backward(wchar_t *first, wchar_t *last, wchar_t *result) {
         size_t len = sizeof(wchar_t) * (last - first);
-        memmove(result - (last - first), first, len);
+        if (first != last) {
+            memmove(result - (last - first), first, len);
+        }
         return result - (last - first);
     }
 
@@ -216,21 +234,577 @@ namespace MicroSTL {
 
     template<typename T>
     inline void swap(T &a, T &b) {
-        T tmp = a;
-        a = b;
-        b = tmp;
+        // 使用移动语义，避免对持有资源的对象做三次深拷贝
+        T tmp = std::move(a);
+        a = std::move(b);
+        b = std::move(tmp);
     }
-}
 
-#endif //MICROSTL_ALGOBASE_H
+    // --------------------- iter_swap --------------------------
+
+    /**
+     * 经由 value_type 的临时对象交换，解引用得到代理对象（如 vector<bool> 的 _bit_reference）时同样适用
+     */
+    template<typename ForwardIterator1, typename ForwardIterator2>
+    inline void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+        typename iterator_traits<ForwardIterator1>::value_type tmp = std::move(*a);
+        *a = std::move(*b);
+        *b = std::move(tmp);
+    }
+
+    /**
+     * 查找/比较系列算法：
+     * - 如果迭代器是指向 1/2/4/8 字节整数的原生指针，按值比较等价于按字节比较，分发到 simd.h 中的向量化内核
+     *      - find：单字节使用 memchr，否则使用 SSE2/AVX2 比较 + movemask
+     *      - count：比较 + movemask + popcount
+     *      - equal：memcmp
+     *      - mismatch：逐字节向量比较，找到第一个不同的字节
+     *      - lexicographical_compare：unsigned char 使用 memcmp，其余整数先 mismatch 再比较该位置的元素
+     * - 否则，如果是 RandomAccessIterator，将循环展开 4 次，以 distance 控制循环次数
+     * - 再不行，使用 (;first != last; ++first) 的方式逐个比较
+     */
+
+    /**
+     * T 是否可以按字节比较
+     */
+    template<typename T>
+    struct _simd_comparable {
+        using type = typename arithmetic_traits<T>::is_integral;
+    };
+
+    template<>
+    struct _simd_comparable<bool> {
+        using type = false_type;
+    };
+
+    template<>
+    struct _simd_comparable<long double> {
+        using type = false_type;
+    };
+
+    /**
+     * 在 T 类型的数组中查找 U 类型的值，要求两者都可以按字节比较
+     */
+    template<typename T, typename U>
+    struct _simd_searchable {
+        using type = false_type;
+    };
+
+    template<typename T>
+    struct _simd_searchable<T, T> {
+        using type = typename _simd_comparable<T>::type;
+    };
+
+    template<>
+    struct _simd_searchable<char, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<signed char, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<unsigned char, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<short, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<unsigned short, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<long, int> {
+        using type = true_type;
+    };
+
+    template<>
+    struct _simd_searchable<long long, int> {
+        using type = true_type;
+    };
+
+    /**
+     * value 不能由 T 表示时，不会与任何元素相等
+     */
+    template<typename T, typename U>
+    inline bool _representable(const U &value) {
+        return static_cast<U>(static_cast<T>(value)) == value;
+    }
+
+    // --------------------- find --------------------------
+
+    template<typename InputIterator, typename T>
+    inline InputIterator
+    _find(InputIterator first, InputIterator last, const T &value, input_iterator_tag) {
+        while (first != last && !(*first == value)) {
+            ++first;
+        }
+        return first;
+    }
+
+    template<typename RandomAccessIterator, typename T>
+    inline RandomAccessIterator
+    _find(RandomAccessIterator first, RandomAccessIterator last, const T &value, random_access_iterator_tag) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance trip_count = (last - first) >> 2; trip_count > 0; --trip_count) {
+            if (*first == value) return first;
+            ++first;
+            if (*first == value) return first;
+            ++first;
+            if (*first == value) return first;
+            ++first;
+            if (*first == value) return first;
+            ++first;
+        }
+        switch (last - first) {
+            case 3:
+                if (*first == value) return first;
+                ++first;
+                [[fallthrough]];
+            case 2:
+                if (*first == value) return first;
+                ++first;
+                [[fallthrough]];
+            case 1:
+                if (*first == value) return first;
+                ++first;
+                [[fallthrough]];
+            default:
+                return last;
+        }
+    }
+
+    template<typename T, typename U>
+    inline T *_find_t(T *first, T *last, const U &value, true_type) {
+        using Element = typename iterator_traits<T *>::value_type;
+        if (!_representable<Element>(value)) {
+            return last;
+        }
+        return const_cast<T *>(simd_find<Element>(first, last, static_cast<Element>(value)));
+    }
+
+    template<typename T, typename U>
+    inline T *_find_t(T *first, T *last, const U &value, false_type) {
+        return _find(first, last, value, random_access_iterator_tag());
+    }
+
+    template<typename InputIterator, typename T>
+    struct find_dispatch {
+        InputIterator operator()(InputIterator first, InputIterator last, const T &value) {
+            return _find(first, last, value, iterator_category(first));
+        }
+    };
+
+    template<typename T, typename U>
+    struct find_dispatch<T *, U> {
+        T *operator()(T *first, T *last, const U &value) {
+            using searchable = typename _simd_searchable<T, U>::type;
+            return _find_t(first, last, value, searchable());
+        }
+    };
+
+    template<typename T, typename U>
+    struct find_dispatch<const T *, U> {
+        const T *operator()(const T *first, const T *last, const U &value) {
+            using searchable = typename _simd_searchable<T, U>::type;
+            return _find_t(first, last, value, searchable());
+        }
+    };
+
+    template<typename InputIterator, typename T>
+    inline InputIterator find(InputIterator first, InputIterator last, const T &value) {
+        return find_dispatch<InputIterator, T>()(first, last, value);
+    }
+
+    // --------------------- find_if --------------------------
+
+    template<typename InputIterator, typename Predicate>
+    inline InputIterator
+    _find_if(InputIterator first, InputIterator last, Predicate pred, input_iterator_tag) {
+        while (first != last && !pred(*first)) {
+            ++first;
+        }
+        return first;
+    }
+
+    template<typename RandomAccessIterator, typename Predicate>
+    inline RandomAccessIterator
+    _find_if(RandomAccessIterator first, RandomAccessIterator last, Predicate pred, random_access_iterator_tag) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance trip_count = (last - first) >> 2; trip_count > 0; --trip_count) {
+            if (pred(*first)) return first;
+            ++first;
+            if (pred(*first)) return first;
+            ++first;
+            if (pred(*first)) return first;
+            ++first;
+            if (pred(*first)) return first;
+            ++first;
+        }
+        switch (last - first) {
+            case 3:
+                if (pred(*first)) return first;
+                ++first;
+                [[fallthrough]];
+            case 2:
+                if (pred(*first)) return first;
+                ++first;
+                [[fallthrough]];
+            case 1:
+                if (pred(*first)) return first;
+                ++first;
+                [[fallthrough]];
+            default:
+                return last;
+        }
+    }
+
+    template<typename InputIterator, typename Predicate>
+    inline InputIterator find_if(InputIterator first, InputIterator last, Predicate pred) {
+        return _find_if(first, last, pred, iterator_category(first));
+    }
+
+    // --------------------- count --------------------------
+
+    template<typename InputIterator, typename T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    _count(InputIterator first, InputIterator last, const T &value) {
+        typename iterator_traits<InputIterator>::difference_type result = 0;
+        for (; first != last; ++first) {
+            if (*first == value) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    template<typename T, typename U>
+    inline ptrdiff_t _count_t(const T *first, const T *last, const U &value, true_type) {
+        if (!_representable<T>(value)) {
+            return 0;
+        }
+        return static_cast<ptrdiff_t>(simd_count<T>(first, last, static_cast<T>(value)));
+    }
+
+    template<typename T, typename U>
+    inline ptrdiff_t _count_t(const T *first, const T *last, const U &value, false_type) {
+        return _count(first, last, value);
+    }
+
+    template<typename InputIterator, typename T>
+    struct count_dispatch {
+        typename iterator_traits<InputIterator>::difference_type
+        operator()(InputIterator first, InputIterator last, const T &value) {
+            return _count(first, last, value);
+        }
+    };
+
+    template<typename T, typename U>
+    struct count_dispatch<T *, U> {
+        ptrdiff_t operator()(const T *first, const T *last, const U &value) {
+            using searchable = typename _simd_searchable<T, U>::type;
+            return _count_t(first, last, value, searchable());
+        }
+    };
+
+    template<typename T, typename U>
+    struct count_dispatch<const T *, U> {
+        ptrdiff_t operator()(const T *first, const T *last, const U &value) {
+            using searchable = typename _simd_searchable<T, U>::type;
+            return _count_t(first, last, value, searchable());
+        }
+    };
 
+    template<typename InputIterator, typename T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    count(InputIterator first, InputIterator last, const T &value) {
+        return count_dispatch<InputIterator, T>()(first, last, value);
+    }
+
+    // --------------------- count_if --------------------------
+
+    template<typename InputIterator, typename Predicate>
+    inline typename iterator_traits<InputIterator>::difference_type
+    count_if(InputIterator first, InputIterator last, Predicate pred) {
+        typename iterator_traits<InputIterator>::difference_type result = 0;
+        for (; first != last; ++first) {
+            if (pred(*first)) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // --------------------- mismatch --------------------------
+
+    template<typename InputIterator1, typename InputIterator2>
+    inline pair<InputIterator1, InputIterator2>
+    _mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        while (first1 != last1 && *first1 == *first2) {
+            ++first1;
+            ++first2;
+        }
+        return pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    template<typename T1, typename T2>
+    inline pair<T1 *, T2 *> _mismatch_t(T1 *first1, T1 *last1, T2 *first2, true_type) {
+        size_t index = simd_mismatch<typename iterator_traits<T1 *>::value_type>(first1, first2, last1 - first1);
+        return pair<T1 *, T2 *>(first1 + index, first2 + index);
+    }
+
+    template<typename T1, typename T2>
+    inline pair<T1 *, T2 *> _mismatch_t(T1 *first1, T1 *last1, T2 *first2, false_type) {
+        return _mismatch(first1, last1, first2);
+    }
+
+    template<typename InputIterator1, typename InputIterator2>
+    struct mismatch_dispatch {
+        pair<InputIterator1, InputIterator2>
+        operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+            return _mismatch(first1, last1, first2);
+        }
+    };
+
+    /**
+     * 两侧元素类型相同（忽略 const）时才能按字节比较
+     */
+    template<typename T>
+    struct mismatch_dispatch<T *, T *> {
+        pair<T *, T *> operator()(T *first1, T *last1, T *first2) {
+            return _mismatch_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename T>
+    struct mismatch_dispatch<const T *, T *> {
+        pair<const T *, T *> operator()(const T *first1, const T *last1, T *first2) {
+            return _mismatch_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
 
+    template<typename T>
+    struct mismatch_dispatch<T *, const T *> {
+        pair<T *, const T *> operator()(T *first1, T *last1, const T *first2) {
+            return _mismatch_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
 
+    template<typename T>
+    struct mismatch_dispatch<const T *, const T *> {
+        pair<const T *, const T *> operator()(const T *first1, const T *last1, const T *first2) {
+            return _mismatch_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
 
+    template<typename InputIterator1, typename InputIterator2>
+    inline pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        return mismatch_dispatch<InputIterator1, InputIterator2>()(first1, last1, first2);
+    }
 
+    template<typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
+    inline pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
+        while (first1 != last1 && pred(*first1, *first2)) {
+            ++first1;
+            ++first2;
+        }
+        return pair<InputIterator1, InputIterator2>(first1, first2);
+    }
 
+    // --------------------- equal --------------------------
 
+    template<typename InputIterator1, typename InputIterator2>
+    inline bool _equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        for (; first1 != last1; ++first1, ++first2) {
+            if (!(*first1 == *first2)) {
+                return false;
+            }
+        }
+        return true;
+    }
 
+    template<typename T>
+    inline bool _equal_t(const T *first1, const T *last1, const T *first2, true_type) {
+        return simd_equal(first1, first2, last1 - first1);
+    }
 
+    template<typename T>
+    inline bool _equal_t(const T *first1, const T *last1, const T *first2, false_type) {
+        return _equal(first1, last1, first2);
+    }
 
+    template<typename InputIterator1, typename InputIterator2>
+    struct equal_dispatch {
+        bool operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+            return _equal(first1, last1, first2);
+        }
+    };
 
+    template<typename T>
+    struct equal_dispatch<T *, T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2) {
+            return _equal_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename T>
+    struct equal_dispatch<const T *, T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2) {
+            return _equal_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename T>
+    struct equal_dispatch<T *, const T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2) {
+            return _equal_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename T>
+    struct equal_dispatch<const T *, const T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2) {
+            return _equal_t(first1, last1, first2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename InputIterator1, typename InputIterator2>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        return equal_dispatch<InputIterator1, InputIterator2>()(first1, last1, first2);
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
+        for (; first1 != last1; ++first1, ++first2) {
+            if (!pred(*first1, *first2)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // --------------------- lexicographical_compare --------------------------
+
+    template<typename InputIterator1, typename InputIterator2, typename Compare>
+    inline bool
+    lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                            InputIterator2 first2, InputIterator2 last2, Compare comp) {
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+            if (comp(*first1, *first2)) {
+                return true;
+            }
+            if (comp(*first2, *first1)) {
+                return false;
+            }
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+    template<typename InputIterator1, typename InputIterator2>
+    inline bool
+    _lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                             InputIterator2 first2, InputIterator2 last2) {
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+            if (*first1 < *first2) {
+                return true;
+            }
+            if (*first2 < *first1) {
+                return false;
+            }
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+    /**
+     * 先找到第一个不同的位置，再比较该位置的元素
+     */
+    template<typename T>
+    inline bool
+    _lexicographical_compare_t(const T *first1, const T *last1, const T *first2, const T *last2, true_type) {
+        const size_t len1 = last1 - first1;
+        const size_t len2 = last2 - first2;
+        const size_t len = len1 < len2 ? len1 : len2;
+        const size_t index = simd_mismatch(first1, first2, len);
+        if (index == len) {
+            return len1 < len2;
+        }
+        return first1[index] < first2[index];
+    }
+
+    template<typename T>
+    inline bool
+    _lexicographical_compare_t(const T *first1, const T *last1, const T *first2, const T *last2, false_type) {
+        return _lexicographical_compare(first1, last1, first2, last2);
+    }
+
+    template<typename InputIterator1, typename InputIterator2>
+    struct lexicographical_compare_dispatch {
+        bool operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2) {
+            return _lexicographical_compare(first1, last1, first2, last2);
+        }
+    };
+
+    template<typename T>
+    struct lexicographical_compare_dispatch<T *, T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2, const T *last2) {
+            return _lexicographical_compare_t(first1, last1, first2, last2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename T>
+    struct lexicographical_compare_dispatch<const T *, const T *> {
+        bool operator()(const T *first1, const T *last1, const T *first2, const T *last2) {
+            return _lexicographical_compare_t(first1, last1, first2, last2, typename _simd_comparable<T>::type());
+        }
+    };
+
+    template<typename InputIterator1, typename InputIterator2>
+    inline bool
+    lexicographical_compare(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2) {
+        return lexicographical_compare_dispatch<InputIterator1, InputIterator2>()(first1, last1, first2, last2);
+    }
+
+    /**
+     * 无符号字节按字典序比较与 memcmp 的语义一致
+     */
+    inline bool
+    lexicographical_compare(const unsigned char *first1, const unsigned char *last1,
+                            const unsigned char *first2, const unsigned char *last2) {
+        const size_t len1 = last1 - first1;
+        const size_t len2 = last2 - first2;
+        const size_t len = len1 < len2 ? len1 : len2;
+        const int result = len == 0 ? 0 : memcmp(first1, first2, len);
+        return result != 0 ? result < 0 : len1 < len2;
+    }
+
+    // --------------------- 无分支二分查找 --------------------------
+
+    /**
+     * 返回 [0, count) 中第一个 pred 为 false 的下标，要求 pred 先真后假。
+     * 每轮只根据比较结果条件赋值，编译为 cmov，没有分支预测失败；循环次数只与 count 有关
+     */
+    template<typename Predicate>
+    inline size_t _branchless_partition_point(size_t count, Predicate pred) {
+        if (count == 0) {
+            return 0;
+        }
+        size_t base = 0;
+        while (count > 1) {
+            size_t half = count / 2;
+            base = pred(base + half) ? base + half : base;
+            count -= half;
+        }
+        return base + pred(base);
+    }
+}
+
+#endif //MICROSTL_ALGOBASE_H
@@ -0,0 +1,225 @@
+#ifndef MICROSTL_HEAP_H
+#define MICROSTL_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../functor/functional.h"
+
+/**
+ * 堆算法，只接受 RandomAccessIterator，默认为大顶堆：
+ *
+ * - 内部实现带有编译期的分叉数 Arity，节点 i 的子节点为 [Arity * i + 1, Arity * i + Arity]，父节点为 (i - 1) / Arity
+ *      - 对外的 push_heap/pop_heap/make_heap/sort_heap 为二叉堆（Arity = 2），与 std 的布局一致
+ *      - 4 叉堆的高度只有二叉堆的一半，且同一个父节点的 4 个子节点通常位于同一条 cache line，
+ *        下沉时每层多做几次比较，但访存次数少得多，适合定时器、调度器这类 pop 频繁的队列
+ * - 下沉（adjust）时先把空洞一路移动到叶子，再把元素从叶子上浮到合适的位置，
+ *   被下沉的元素通常来自堆尾，最终位置也靠近叶子，这样可以省去每层与它比较的开销
+ */
+
+namespace MicroSTL {
+
+    // --------------------- 内部实现 --------------------------
+
+    /**
+     * 将 value 从 hole 处上浮，不超过 top
+     */
+    template<size_t Arity, typename RandomAccessIterator, typename Distance, typename T, typename Compare>
+    inline void
+    _push_heap(RandomAccessIterator first, Distance hole, Distance top, T value, Compare comp) {
+        Distance parent = (hole - 1) / static_cast<Distance>(Arity);
+        while (hole > top && comp(*(first + parent), value)) {
+            *(first + hole) = std::move(*(first + parent));
+            hole = parent;
+            parent = (hole - 1) / static_cast<Distance>(Arity);
+        }
+        *(first + hole) = std::move(value);
+    }
+
+    /**
+     * 将 hole 下沉到叶子，再把 value 放入
+     */
+    template<size_t Arity, typename RandomAccessIterator, typename Distance, typename T, typename Compare>
+    inline void
+    _adjust_heap(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp) {
+        const Distance arity = static_cast<Distance>(Arity);
+        const Distance top = hole;
+        Distance child = arity * hole + 1;
+
+        // 子节点齐全，选择最大子节点时用条件赋值代替分支，避免随机数据下的分支预测失败
+        while (child + (arity - 1) < len) {
+            Distance best = child;
+            for (Distance k = 1; k < arity; ++k) {
+                best = comp(*(first + best), *(first + (child + k))) ? child + k : best;
+            }
+            *(first + hole) = std::move(*(first + best));
+            hole = best;
+            child = arity * hole + 1;
+        }
+
+        // 最后一个不完整的分支
+        if (child < len) {
+            Distance best = child;
+            for (Distance k = child + 1; k < len; ++k) {
+                if (comp(*(first + best), *(first + k))) {
+                    best = k;
+                }
+            }
+            *(first + hole) = std::move(*(first + best));
+            hole = best;
+        }
+
+        _push_heap<Arity>(first, hole, top, std::move(value), comp);
+    }
+
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline void
+    _push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (last - first < 2) {
+            return;
+        }
+        T value = std::move(*(last - 1));
+        _push_heap<Arity>(first, Distance(last - first - 1), Distance(0), std::move(value), comp);
+    }
+
+    /**
+     * 将堆顶移动到 result，并把 result 处原先的元素放入堆中
+     */
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline void
+    _pop_heap(RandomAccessIterator first, RandomAccessIterator last, RandomAccessIterator result, Compare comp) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        T value = std::move(*result);
+        *result = std::move(*first);
+        _adjust_heap<Arity>(first, Distance(0), Distance(last - first), std::move(value), comp);
+    }
+
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline void
+    _pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        if (last - first < 2) {
+            return;
+        }
+        --last;
+        _pop_heap<Arity>(first, last, last, comp);
+    }
+
+    /**
+     * 自底向上建堆，O(n)
+     */
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline void
+    _make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        Distance len = last - first;
+        if (len < 2) {
+            return;
+        }
+        for (Distance parent = (len - 2) / static_cast<Distance>(Arity);; --parent) {
+            T value = std::move(*(first + parent));
+            _adjust_heap<Arity>(first, parent, len, std::move(value), comp);
+            if (parent == 0) {
+                return;
+            }
+        }
+    }
+
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline void
+    _sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        while (last - first > 1) {
+            _pop_heap<Arity>(first, last, comp);
+            --last;
+        }
+    }
+
+    template<size_t Arity, typename RandomAccessIterator, typename Compare>
+    inline bool
+    _is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        Distance len = last - first;
+        for (Distance child = 1; child < len; ++child) {
+            if (comp(*(first + (child - 1) / static_cast<Distance>(Arity)), *(first + child))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // --------------------- push_heap --------------------------
+
+    /**
+     * [first, last - 1) 是堆，将 *(last - 1) 加入堆中
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        _push_heap<2>(first, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        _push_heap<2>(first, last, less<T>());
+    }
+
+    // --------------------- pop_heap --------------------------
+
+    /**
+     * 将堆顶移动到 last - 1，[first, last - 1) 仍然是堆
+     */
+    template<typename RandomAccessIterator, typename Compare>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        _pop_heap<2>(first, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        _pop_heap<2>(first, last, less<T>());
+    }
+
+    // --------------------- make_heap --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        _make_heap<2>(first, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        _make_heap<2>(first, last, less<T>());
+    }
+
+    // --------------------- sort_heap --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        _sort_heap<2>(first, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        _sort_heap<2>(first, last, less<T>());
+    }
+
+    // --------------------- is_heap --------------------------
+
+    template<typename RandomAccessIterator, typename Compare>
+    inline bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        return _is_heap<2>(first, last, comp);
+    }
+
+    template<typename RandomAccessIterator>
+    inline bool is_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        return _is_heap<2>(first, last, less<T>());
+    }
+}
+
+#endif //MICROSTL_HEAP_H
@@ -0,0 +1,1067 @@
+#ifndef MICROSTL_NUMERIC_H
+#define MICROSTL_NUMERIC_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "../iterator/iterator_traits.h"
+#include "../iterator/type_traits.h"
+#include "../functor/functional.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "parallel.h"
+#include "simd.h"
+
+/**
+ * 数值算法：
+ *
+ * - accumulate / inner_product / partial_sum 严格按从左到右的顺序计算，与 std 的语义一致
+ *      - 连续内存上的整数使用默认运算时走向量化内核：补码加法、乘法满足结合律，结果与顺序计算完全相同
+ * - reduce / transform_reduce / inclusive_scan / exclusive_scan 允许以任意顺序结合，浮点数的结果可能有舍入误差
+ *      - RandomAccessIterator 使用 4 个累加器展开，打破归约运算的延迟依赖链
+ *      - 连续内存上的算术类型使用默认运算时，支持 AVX2 的 x86 上使用向量化内核：
+ *          - 求和、点积使用 4 个向量累加器
+ *          - 前缀和在寄存器内做对数步移位相加，块之间只传递一个广播的进位
+ * - parallel_reduce / parallel_inclusive_scan / parallel_exclusive_scan 按迭代器类型分发：
+ *      - RandomAccessIterator：区间切分给多个线程，扫描使用两趟算法
+ *          - 第一趟各线程归约自己的区段
+ *          - 顺序计算区段和的前缀，作为各区段的初值
+ *          - 第二趟各线程以该初值扫描自己的区段，每个区段内仍然可以使用向量化内核
+ *      - 其他迭代器：退化为顺序版本
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 并行算法中每个线程至少处理的元素个数
+     */
+    static const size_t NUMERIC_PARALLEL_GRAIN = 1 << 15;
+
+    // --------------------- 内核选择 --------------------------
+
+    /**
+     * 可以使用向量化内核的元素类型
+     */
+    template<typename T>
+    struct _numeric_vectorizable {
+        using type = typename arithmetic_traits<T>::is_arithmetic;
+    };
+
+    template<>
+    struct _numeric_vectorizable<bool> {
+        using type = false_type;
+    };
+
+    template<>
+    struct _numeric_vectorizable<long double> {
+        using type = false_type;
+    };
+
+    /**
+     * 重新结合后结果不变的元素类型
+     */
+    template<typename T>
+    struct _numeric_exact {
+        using type = typename arithmetic_traits<T>::is_integral;
+    };
+
+    template<>
+    struct _numeric_exact<bool> {
+        using type = false_type;
+    };
+
+    /**
+     * 将 const T * 统一为 T *，其他迭代器不变
+     */
+    template<typename Iterator>
+    struct _numeric_pointer {
+        using type = Iterator;
+    };
+
+    template<typename T>
+    struct _numeric_pointer<const T *> {
+        using type = T *;
+    };
+
+    /**
+     * 连续内存、元素类型与结果类型相同、使用加法时可以使用求和内核
+     */
+    template<typename Pointer, typename T, typename BinaryOperation, typename Exact>
+    struct _sum_kernel {
+        using type = false_type;
+    };
+
+    template<typename T>
+    struct _sum_kernel<T *, T, plus<T>, false_type> {
+        using type = typename _numeric_vectorizable<T>::type;
+    };
+
+    template<typename T>
+    struct _sum_kernel<T *, T, plus<T>, true_type> {
+        using type = typename _numeric_exact<T>::type;
+    };
+
+    /**
+     * 使用加法、乘法时可以使用点积内核
+     */
+    template<typename Pointer1, typename Pointer2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2, typename Exact>
+    struct _dot_kernel {
+        using type = false_type;
+    };
+
+    template<typename T>
+    struct _dot_kernel<T *, T *, T, plus<T>, multiplies<T>, false_type> {
+        using type = typename _numeric_vectorizable<T>::type;
+    };
+
+    template<typename T>
+    struct _dot_kernel<T *, T *, T, plus<T>, multiplies<T>, true_type> {
+        using type = typename _numeric_exact<T>::type;
+    };
+
+    // --------------------- 展开的标量内核 --------------------------
+
+    /**
+     * 使用 4 个累加器归约 load(0) ... load(size - 1)
+     */
+    template<typename T, typename BinaryOperation, typename Load>
+    inline T _unrolled_reduce(size_t size, T init, BinaryOperation op, Load load) {
+        if (size < 8) {
+            for (size_t i = 0; i < size; ++i) {
+                init = op(init, load(i));
+            }
+            return init;
+        }
+        T acc0 = load(0);
+        T acc1 = load(1);
+        T acc2 = load(2);
+        T acc3 = load(3);
+        size_t i = 4;
+        for (; i + 4 <= size; i += 4) {
+            acc0 = op(acc0, load(i));
+            acc1 = op(acc1, load(i + 1));
+            acc2 = op(acc2, load(i + 2));
+            acc3 = op(acc3, load(i + 3));
+        }
+        for (; i < size; ++i) {
+            acc0 = op(acc0, load(i));
+        }
+        return op(init, op(op(acc0, acc1), op(acc2, acc3)));
+    }
+
+    template<typename T>
+    inline T _unrolled_sum(const T *first, size_t size) {
+        return _unrolled_reduce(size, T(), plus<T>(), [first](size_t i) { return first[i]; });
+    }
+
+    template<typename T>
+    inline T _unrolled_dot(const T *a, const T *b, size_t size) {
+        return _unrolled_reduce(size, T(), plus<T>(), [a, b](size_t i) { return static_cast<T>(a[i] * b[i]); });
+    }
+
+    template<typename T>
+    inline T *_scalar_inclusive_scan(const T *first, size_t size, T *result, T value) {
+        for (size_t i = 0; i < size; ++i) {
+            value = static_cast<T>(value + first[i]);
+            result[i] = value;
+        }
+        return result + size;
+    }
+
+    template<typename T>
+    inline T *_scalar_exclusive_scan(const T *first, size_t size, T *result, T value) {
+        for (size_t i = 0; i < size; ++i) {
+            T x = first[i];
+            result[i] = value;
+            value = static_cast<T>(value + x);
+        }
+        return result + size;
+    }
+
+#ifdef MICROSTL_SIMD_X86
+
+    // --------------------- AVX2 内核 --------------------------
+
+    /**
+     * prefix：寄存器内的前缀和
+     * broadcast_last：将最后一个元素广播到所有位置，作为下一块的进位
+     * shift_in：整体后移一个元素，空出的第一个位置填入进位，用于 exclusive_scan
+     */
+    struct _avx2_ps_ops {
+        using vector = __m256;
+        using has_mul = true_type;
+        using has_scan = true_type;
+
+        __attribute__((target("avx2"))) static vector zero() {
+            return _mm256_setzero_ps();
+        }
+
+        __attribute__((target("avx2"))) static vector set1(const void *value) {
+            return _mm256_set1_ps(*static_cast<const float *>(value));
+        }
+
+        __attribute__((target("avx2"))) static vector load(const void *p) {
+            return _mm256_loadu_ps(static_cast<const float *>(p));
+        }
+
+        __attribute__((target("avx2"))) static void store(void *p, vector v) {
+            _mm256_storeu_ps(static_cast<float *>(p), v);
+        }
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_ps(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector mul(vector a, vector b) {
+            return _mm256_mul_ps(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector prefix(vector v) {
+            v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+            v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+            // 低 128 位的总和加到高 128 位
+            vector low = _mm256_permute2f128_ps(v, v, 0x08);
+            return _mm256_add_ps(v, _mm256_shuffle_ps(low, low, 0xFF));
+        }
+
+        __attribute__((target("avx2"))) static vector broadcast_last(vector v) {
+            vector high = _mm256_permute2f128_ps(v, v, 0x11);
+            return _mm256_shuffle_ps(high, high, 0xFF);
+        }
+
+        __attribute__((target("avx2"))) static vector shift_in(vector v, vector carry) {
+            vector rotated = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+            return _mm256_blend_ps(rotated, carry, 0x01);
+        }
+    };
+
+    struct _avx2_pd_ops {
+        using vector = __m256d;
+        using has_mul = true_type;
+        using has_scan = true_type;
+
+        __attribute__((target("avx2"))) static vector zero() {
+            return _mm256_setzero_pd();
+        }
+
+        __attribute__((target("avx2"))) static vector set1(const void *value) {
+            return _mm256_set1_pd(*static_cast<const double *>(value));
+        }
+
+        __attribute__((target("avx2"))) static vector load(const void *p) {
+            return _mm256_loadu_pd(static_cast<const double *>(p));
+        }
+
+        __attribute__((target("avx2"))) static void store(void *p, vector v) {
+            _mm256_storeu_pd(static_cast<double *>(p), v);
+        }
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_pd(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector mul(vector a, vector b) {
+            return _mm256_mul_pd(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector prefix(vector v) {
+            v = _mm256_add_pd(v, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(v), 8)));
+            vector low = _mm256_permute2f128_pd(v, v, 0x08);
+            return _mm256_add_pd(v, _mm256_permute_pd(low, 0xF));
+        }
+
+        __attribute__((target("avx2"))) static vector broadcast_last(vector v) {
+            return _mm256_permute4x64_pd(v, 0xFF);
+        }
+
+        __attribute__((target("avx2"))) static vector shift_in(vector v, vector carry) {
+            vector rotated = _mm256_permute4x64_pd(v, 0x93);
+            return _mm256_blend_pd(rotated, carry, 0x1);
+        }
+    };
+
+    /**
+     * 整数按宽度区分，有符号与无符号共用同一套指令
+     */
+    template<size_t Size>
+    struct _avx2_epi_ops {
+    };
+
+    struct _avx2_epi_base {
+        using vector = __m256i;
+
+        __attribute__((target("avx2"))) static vector zero() {
+            return _mm256_setzero_si256();
+        }
+
+        __attribute__((target("avx2"))) static vector load(const void *p) {
+            return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+        }
+
+        __attribute__((target("avx2"))) static void store(void *p, vector v) {
+            _mm256_storeu_si256(static_cast<__m256i *>(p), v);
+        }
+    };
+
+    template<>
+    struct _avx2_epi_ops<1> : public _avx2_epi_base {
+        using has_mul = false_type;
+        using has_scan = false_type;
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_epi8(a, b);
+        }
+    };
+
+    template<>
+    struct _avx2_epi_ops<2> : public _avx2_epi_base {
+        using has_mul = true_type;
+        using has_scan = false_type;
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_epi16(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector mul(vector a, vector b) {
+            return _mm256_mullo_epi16(a, b);
+        }
+    };
+
+    template<>
+    struct _avx2_epi_ops<4> : public _avx2_epi_base {
+        using has_mul = true_type;
+        using has_scan = true_type;
+
+        __attribute__((target("avx2"))) static vector set1(const void *value) {
+            int v;
+            memcpy(&v, value, 4);
+            return _mm256_set1_epi32(v);
+        }
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_epi32(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector mul(vector a, vector b) {
+            return _mm256_mullo_epi32(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector prefix(vector v) {
+            v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+            v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+            vector low = _mm256_permute2x128_si256(v, v, 0x08);
+            return _mm256_add_epi32(v, _mm256_shuffle_epi32(low, 0xFF));
+        }
+
+        __attribute__((target("avx2"))) static vector broadcast_last(vector v) {
+            return _mm256_permutevar8x32_epi32(v, _mm256_set1_epi32(7));
+        }
+
+        __attribute__((target("avx2"))) static vector shift_in(vector v, vector carry) {
+            vector rotated = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+            return _mm256_blend_epi32(rotated, carry, 0x01);
+        }
+    };
+
+    template<>
+    struct _avx2_epi_ops<8> : public _avx2_epi_base {
+        // AVX2 没有 64 位的乘法
+        using has_mul = false_type;
+        using has_scan = true_type;
+
+        __attribute__((target("avx2"))) static vector set1(const void *value) {
+            long long v;
+            memcpy(&v, value, 8);
+            return _mm256_set1_epi64x(v);
+        }
+
+        __attribute__((target("avx2"))) static vector add(vector a, vector b) {
+            return _mm256_add_epi64(a, b);
+        }
+
+        __attribute__((target("avx2"))) static vector prefix(vector v) {
+            v = _mm256_add_epi64(v, _mm256_slli_si256(v, 8));
+            vector low = _mm256_permute2x128_si256(v, v, 0x08);
+            return _mm256_add_epi64(v, _mm256_shuffle_epi32(low, 0xEE));
+        }
+
+        __attribute__((target("avx2"))) static vector broadcast_last(vector v) {
+            return _mm256_permute4x64_epi64(v, 0xFF);
+        }
+
+        __attribute__((target("avx2"))) static vector shift_in(vector v, vector carry) {
+            vector rotated = _mm256_permute4x64_epi64(v, 0x93);
+            return _mm256_blend_epi32(rotated, carry, 0x03);
+        }
+    };
+
+    template<typename T, typename Integral = typename arithmetic_traits<T>::is_integral>
+    struct _avx2_numeric {
+    };
+
+    template<typename T>
+    struct _avx2_numeric<T, true_type> {
+        using ops = _avx2_epi_ops<sizeof(T)>;
+    };
+
+    template<>
+    struct _avx2_numeric<float, false_type> {
+        using ops = _avx2_ps_ops;
+    };
+
+    template<>
+    struct _avx2_numeric<double, false_type> {
+        using ops = _avx2_pd_ops;
+    };
+
+    /**
+     * 将向量中的各个元素按顺序加到 value 上
+     */
+    template<typename Ops, typename T>
+    __attribute__((target("avx2"))) inline T _avx2_horizontal_sum(typename Ops::vector v, T value) {
+        T lanes[32 / sizeof(T)];
+        Ops::store(lanes, v);
+        for (size_t i = 0; i < 32 / sizeof(T); ++i) {
+            value = static_cast<T>(value + lanes[i]);
+        }
+        return value;
+    }
+
+    template<typename T>
+    __attribute__((target("avx2"))) inline T _avx2_sum(const T *first, size_t size) {
+        using ops = typename _avx2_numeric<T>::ops;
+        const size_t lanes = 32 / sizeof(T);
+        typename ops::vector acc0 = ops::zero();
+        typename ops::vector acc1 = ops::zero();
+        typename ops::vector acc2 = ops::zero();
+        typename ops::vector acc3 = ops::zero();
+        size_t i = 0;
+        for (; i + 4 * lanes <= size; i += 4 * lanes) {
+            acc0 = ops::add(acc0, ops::load(first + i));
+            acc1 = ops::add(acc1, ops::load(first + i + lanes));
+            acc2 = ops::add(acc2, ops::load(first + i + 2 * lanes));
+            acc3 = ops::add(acc3, ops::load(first + i + 3 * lanes));
+        }
+        for (; i + lanes <= size; i += lanes) {
+            acc0 = ops::add(acc0, ops::load(first + i));
+        }
+        acc0 = ops::add(ops::add(acc0, acc1), ops::add(acc2, acc3));
+        T result = _avx2_horizontal_sum<ops>(acc0, T());
+        for (; i < size; ++i) {
+            result = static_cast<T>(result + first[i]);
+        }
+        return result;
+    }
+
+    template<typename T>
+    __attribute__((target("avx2"))) inline T _avx2_dot(const T *a, const T *b, size_t size, true_type) {
+        using ops = typename _avx2_numeric<T>::ops;
+        const size_t lanes = 32 / sizeof(T);
+        typename ops::vector acc0 = ops::zero();
+        typename ops::vector acc1 = ops::zero();
+        typename ops::vector acc2 = ops::zero();
+        typename ops::vector acc3 = ops::zero();
+        size_t i = 0;
+        for (; i + 4 * lanes <= size; i += 4 * lanes) {
+            acc0 = ops::add(acc0, ops::mul(ops::load(a + i), ops::load(b + i)));
+            acc1 = ops::add(acc1, ops::mul(ops::load(a + i + lanes), ops::load(b + i + lanes)));
+            acc2 = ops::add(acc2, ops::mul(ops::load(a + i + 2 * lanes), ops::load(b + i + 2 * lanes)));
+            acc3 = ops::add(acc3, ops::mul(ops::load(a + i + 3 * lanes), ops::load(b + i + 3 * lanes)));
+        }
+        for (; i + lanes <= size; i += lanes) {
+            acc0 = ops::add(acc0, ops::mul(ops::load(a + i), ops::load(b + i)));
+        }
+        acc0 = ops::add(ops::add(acc0, acc1), ops::add(acc2, acc3));
+        T result = _avx2_horizontal_sum<ops>(acc0, T());
+        for (; i < size; ++i) {
+            result = static_cast<T>(result + a[i] * b[i]);
+        }
+        return result;
+    }
+
+    template<typename T>
+    inline T _avx2_dot(const T *a, const T *b, size_t size, false_type) {
+        return _unrolled_dot(a, b, size);
+    }
+
+    template<typename T>
+    __attribute__((target("avx2"))) inline T *
+    _avx2_inclusive_scan(const T *first, size_t size, T *result, T init, true_type) {
+        using ops = typename _avx2_numeric<T>::ops;
+        const size_t lanes = 32 / sizeof(T);
+        typename ops::vector carry = ops::set1(&init);
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes) {
+            typename ops::vector x = ops::add(ops::prefix(ops::load(first + i)), carry);
+            ops::store(result + i, x);
+            carry = ops::broadcast_last(x);
+        }
+        T lane[32 / sizeof(T)];
+        ops::store(lane, carry);
+        return _scalar_inclusive_scan(first + i, size - i, result + i, lane[0]);
+    }
+
+    template<typename T>
+    inline T *_avx2_inclusive_scan(const T *first, size_t size, T *result, T init, false_type) {
+        return _scalar_inclusive_scan(first, size, result, init);
+    }
+
+    /**
+     * 每一块先读后写，支持 first == result 的原地扫描
+     */
+    template<typename T>
+    __attribute__((target("avx2"))) inline T *
+    _avx2_exclusive_scan(const T *first, size_t size, T *result, T init, true_type) {
+        using ops = typename _avx2_numeric<T>::ops;
+        const size_t lanes = 32 / sizeof(T);
+        typename ops::vector carry = ops::set1(&init);
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes) {
+            typename ops::vector x = ops::add(ops::prefix(ops::load(first + i)), carry);
+            ops::store(result + i, ops::shift_in(x, carry));
+            carry = ops::broadcast_last(x);
+        }
+        T lane[32 / sizeof(T)];
+        ops::store(lane, carry);
+        return _scalar_exclusive_scan(first + i, size - i, result + i, lane[0]);
+    }
+
+    template<typename T>
+    inline T *_avx2_exclusive_scan(const T *first, size_t size, T *result, T init, false_type) {
+        return _scalar_exclusive_scan(first, size, result, init);
+    }
+
+#endif
+
+    // --------------------- 内核分发 --------------------------
+
+    template<typename T>
+    inline T _vector_sum(const T *first, size_t size) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_sum(first, size);
+        }
+#endif
+        return _unrolled_sum(first, size);
+    }
+
+    template<typename T>
+    inline T _vector_dot(const T *a, const T *b, size_t size) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_dot(a, b, size, typename _avx2_numeric<T>::ops::has_mul());
+        }
+#endif
+        return _unrolled_dot(a, b, size);
+    }
+
+    template<typename T>
+    inline T *_vector_inclusive_scan(const T *first, size_t size, T *result, T init) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_inclusive_scan(first, size, result, init, typename _avx2_numeric<T>::ops::has_scan());
+        }
+#endif
+        return _scalar_inclusive_scan(first, size, result, init);
+    }
+
+    template<typename T>
+    inline T *_vector_exclusive_scan(const T *first, size_t size, T *result, T init) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_exclusive_scan(first, size, result, init, typename _avx2_numeric<T>::ops::has_scan());
+        }
+#endif
+        return _scalar_exclusive_scan(first, size, result, init);
+    }
+
+    // --------------------- accumulate --------------------------
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op, false_type) {
+        for (; first != last; ++first) {
+            init = op(init, *first);
+        }
+        return init;
+    }
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _accumulate(InputIterator first, InputIterator last, T init, BinaryOperation, true_type) {
+        return static_cast<T>(init + _vector_sum(first, last - first));
+    }
+
+    /**
+     * 从左到右依次计算 init = op(init, *first)
+     */
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+        using kernel = typename _sum_kernel<typename _numeric_pointer<InputIterator>::type, T,
+                BinaryOperation, true_type>::type;
+        return _accumulate(first, last, init, op, kernel());
+    }
+
+    template<typename InputIterator, typename T>
+    inline T accumulate(InputIterator first, InputIterator last, T init) {
+        return MicroSTL::accumulate(first, last, init, plus<T>());
+    }
+
+    // --------------------- inner_product --------------------------
+
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                            BinaryOperation1 op1, BinaryOperation2 op2, false_type) {
+        for (; first1 != last1; ++first1, ++first2) {
+            init = op1(init, op2(*first1, *first2));
+        }
+        return init;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                            BinaryOperation1, BinaryOperation2, true_type) {
+        return static_cast<T>(init + _vector_dot<T>(first1, first2, last1 - first1));
+    }
+
+    /**
+     * 从左到右依次计算 init = op1(init, op2(*first1, *first2))
+     */
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                           BinaryOperation1 op1, BinaryOperation2 op2) {
+        using kernel = typename _dot_kernel<typename _numeric_pointer<InputIterator1>::type,
+                typename _numeric_pointer<InputIterator2>::type, T,
+                BinaryOperation1, BinaryOperation2, true_type>::type;
+        return _inner_product(first1, last1, first2, init, op1, op2, kernel());
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename T>
+    inline T inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init) {
+        return MicroSTL::inner_product(first1, last1, first2, init, plus<T>(), multiplies<T>());
+    }
+
+    // --------------------- reduce --------------------------
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _reduce(InputIterator first, InputIterator last, T init, BinaryOperation op, input_iterator_tag) {
+        return _accumulate(first, last, init, op, false_type());
+    }
+
+    template<typename RandomAccessIterator, typename T, typename BinaryOperation>
+    inline T _reduce(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                     random_access_iterator_tag) {
+        return _unrolled_reduce(size_t(last - first), init, op, [first](size_t i) { return first[i]; });
+    }
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _reduce(InputIterator first, InputIterator last, T init, BinaryOperation op, false_type) {
+        return _reduce(first, last, init, op, iterator_category(first));
+    }
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _reduce(InputIterator first, InputIterator last, T init, BinaryOperation, true_type) {
+        return static_cast<T>(init + _vector_sum(first, last - first));
+    }
+
+    /**
+     * op 需要满足结合律与交换律，元素可能以任意顺序参与运算
+     */
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+        using kernel = typename _sum_kernel<typename _numeric_pointer<InputIterator>::type, T,
+                BinaryOperation, false_type>::type;
+        return _reduce(first, last, init, op, kernel());
+    }
+
+    template<typename InputIterator, typename T>
+    inline T reduce(InputIterator first, InputIterator last, T init) {
+        return MicroSTL::reduce(first, last, init, plus<T>());
+    }
+
+    template<typename InputIterator>
+    inline typename iterator_traits<InputIterator>::value_type
+    reduce(InputIterator first, InputIterator last) {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        return MicroSTL::reduce(first, last, T(), plus<T>());
+    }
+
+    // --------------------- transform_reduce --------------------------
+
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                               BinaryOperation1 reduce_op, BinaryOperation2 transform_op, input_iterator_tag) {
+        return _inner_product(first1, last1, first2, init, reduce_op, transform_op, false_type());
+    }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _transform_reduce(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                               RandomAccessIterator2 first2, T init,
+                               BinaryOperation1 reduce_op, BinaryOperation2 transform_op,
+                               random_access_iterator_tag) {
+        return _unrolled_reduce(size_t(last1 - first1), init, reduce_op, [first1, first2, transform_op](size_t i) {
+            return transform_op(first1[i], first2[i]);
+        });
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                               BinaryOperation1 reduce_op, BinaryOperation2 transform_op, false_type) {
+        return _transform_reduce(first1, last1, first2, init, reduce_op, transform_op, iterator_category(first1));
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T _transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                               BinaryOperation1, BinaryOperation2, true_type) {
+        return static_cast<T>(init + _vector_dot<T>(first1, first2, last1 - first1));
+    }
+
+    /**
+     * 与 inner_product 相同，但允许重新结合，默认运算下即为点积
+     */
+    template<typename InputIterator1, typename InputIterator2, typename T,
+            typename BinaryOperation1, typename BinaryOperation2>
+    inline T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                              BinaryOperation1 reduce_op, BinaryOperation2 transform_op) {
+        using kernel = typename _dot_kernel<typename _numeric_pointer<InputIterator1>::type,
+                typename _numeric_pointer<InputIterator2>::type, T,
+                BinaryOperation1, BinaryOperation2, false_type>::type;
+        return _transform_reduce(first1, last1, first2, init, reduce_op, transform_op, kernel());
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename T>
+    inline T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init) {
+        return MicroSTL::transform_reduce(first1, last1, first2, init, plus<T>(), multiplies<T>());
+    }
+
+    template<typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+    inline T _transform_reduce(InputIterator first, InputIterator last, T init,
+                               BinaryOperation reduce_op, UnaryOperation transform_op, input_iterator_tag) {
+        for (; first != last; ++first) {
+            init = reduce_op(init, transform_op(*first));
+        }
+        return init;
+    }
+
+    template<typename RandomAccessIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+    inline T _transform_reduce(RandomAccessIterator first, RandomAccessIterator last, T init,
+                               BinaryOperation reduce_op, UnaryOperation transform_op, random_access_iterator_tag) {
+        return _unrolled_reduce(size_t(last - first), init, reduce_op, [first, transform_op](size_t i) {
+            return transform_op(first[i]);
+        });
+    }
+
+    template<typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+    inline T transform_reduce(InputIterator first, InputIterator last, T init,
+                              BinaryOperation reduce_op, UnaryOperation transform_op) {
+        return _transform_reduce(first, last, init, reduce_op, transform_op, iterator_category(first));
+    }
+
+    // --------------------- inclusive_scan --------------------------
+
+    /**
+     * 连续内存、输入输出类型相同、使用加法时可以使用前缀和内核
+     */
+    template<typename InputPointer, typename OutputIterator, typename T, typename BinaryOperation, typename Exact>
+    struct _scan_kernel {
+        using type = false_type;
+    };
+
+    template<typename T>
+    struct _scan_kernel<T *, T *, T, plus<T>, false_type> {
+        using type = typename _numeric_vectorizable<T>::type;
+    };
+
+    template<typename T>
+    struct _scan_kernel<T *, T *, T, plus<T>, true_type> {
+        using type = typename _numeric_exact<T>::type;
+    };
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator _inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                          BinaryOperation op, T init, false_type) {
+        for (; first != last; ++first, ++result) {
+            init = op(init, *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator _inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                          BinaryOperation, T init, true_type) {
+        return _vector_inclusive_scan<T>(first, last - first, result, init);
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename BinaryOperation, typename T>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                         BinaryOperation op, T init) {
+        using kernel = typename _scan_kernel<typename _numeric_pointer<InputIterator>::type, OutputIterator,
+                T, BinaryOperation, false_type>::type;
+        return _inclusive_scan(first, last, result, op, init, kernel());
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                         BinaryOperation op) {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        if (first == last) {
+            return result;
+        }
+        T init = *first;
+        *result = init;
+        return MicroSTL::inclusive_scan(++first, last, ++result, op, init);
+    }
+
+    template<typename InputIterator, typename OutputIterator>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result) {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        return MicroSTL::inclusive_scan(first, last, result, plus<T>());
+    }
+
+    // --------------------- partial_sum --------------------------
+
+    /**
+     * 从左到右计算前缀和，*result = *first，*(result + 1) = op(*first, *(first + 1))，以此类推
+     */
+    template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+    inline OutputIterator partial_sum(InputIterator first, InputIterator last, OutputIterator result,
+                                      BinaryOperation op) {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        using kernel = typename _scan_kernel<typename _numeric_pointer<InputIterator>::type, OutputIterator,
+                T, BinaryOperation, true_type>::type;
+        if (first == last) {
+            return result;
+        }
+        T init = *first;
+        *result = init;
+        return _inclusive_scan(++first, last, ++result, op, init, kernel());
+    }
+
+    template<typename InputIterator, typename OutputIterator>
+    inline OutputIterator partial_sum(InputIterator first, InputIterator last, OutputIterator result) {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        return MicroSTL::partial_sum(first, last, result, plus<T>());
+    }
+
+    // --------------------- exclusive_scan --------------------------
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator _exclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                          T init, BinaryOperation op, false_type) {
+        for (; first != last; ++first, ++result) {
+            // 先读再写，支持原地扫描
+            T value = *first;
+            *result = init;
+            init = op(init, value);
+        }
+        return result;
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator _exclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                          T init, BinaryOperation, true_type) {
+        return _vector_exclusive_scan<T>(first, last - first, result, init);
+    }
+
+    /**
+     * *result = init，*(result + 1) = op(init, *first)，以此类推，不包含当前元素
+     */
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                         T init, BinaryOperation op) {
+        using kernel = typename _scan_kernel<typename _numeric_pointer<InputIterator>::type, OutputIterator,
+                T, BinaryOperation, false_type>::type;
+        return _exclusive_scan(first, last, result, init, op, kernel());
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T>
+    inline OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init) {
+        return MicroSTL::exclusive_scan(first, last, result, init, plus<T>());
+    }
+
+    // --------------------- parallel_reduce --------------------------
+
+    template<typename InputIterator, typename T, typename BinaryOperation>
+    inline T _parallel_reduce(InputIterator first, InputIterator last, T init, BinaryOperation op,
+                              unsigned, input_iterator_tag) {
+        return MicroSTL::reduce(first, last, init, op);
+    }
+
+    /**
+     * 各线程的部分和存放在由 Alloc<T> 分配的数组中，只在当前线程中申请与释放
+     */
+    template<typename RandomAccessIterator, typename T, typename BinaryOperation>
+    T _parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                       unsigned thread_count, random_access_iterator_tag) {
+        const size_t size = last - first;
+        thread_count = _parallel_thread_count(thread_count, size, NUMERIC_PARALLEL_GRAIN);
+        if (thread_count <= 1) {
+            return MicroSTL::reduce(first, last, init, op);
+        }
+
+        const size_t chunk = (size + thread_count - 1) / thread_count;
+        T *partial = Alloc<T>::allocate(thread_count);
+        _parallel_for(thread_count, [&](unsigned index) {
+            size_t begin = index * chunk;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            new(partial + index) T(MicroSTL::reduce(first + (begin + 1), first + end, T(first[begin]), op));
+        });
+
+        for (unsigned index = 0; index < thread_count; ++index) {
+            init = op(init, partial[index]);
+        }
+        MicroSTL::destroy(partial, partial + thread_count);
+        Alloc<T>::deallocate(partial, thread_count);
+        return init;
+    }
+
+    /**
+     * thread_count 为 0 时使用 hardware_concurrency
+     */
+    template<typename InputIterator, typename T, typename BinaryOperation = plus<T>>
+    inline T parallel_reduce(InputIterator first, InputIterator last, T init,
+                             BinaryOperation op = BinaryOperation(), unsigned thread_count = 0) {
+        return _parallel_reduce(first, last, init, op, thread_count, iterator_category(first));
+    }
+
+    // --------------------- parallel_inclusive_scan / parallel_exclusive_scan --------------------------
+
+    /**
+     * 第一趟：除最后一个区段外，各线程归约自己的区段
+     */
+    template<typename RandomAccessIterator, typename T, typename BinaryOperation>
+    T *_parallel_scan_partials(RandomAccessIterator first, size_t size, size_t chunk, unsigned thread_count,
+                               BinaryOperation op) {
+        T *partial = Alloc<T>::allocate(thread_count);
+        _parallel_for(thread_count - 1, [&](unsigned index) {
+            size_t begin = index * chunk;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            new(partial + index) T(MicroSTL::reduce(first + (begin + 1), first + end, T(first[begin]), op));
+        });
+        return partial;
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+    inline OutputIterator
+    _parallel_inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op,
+                             unsigned, input_iterator_tag, output_iterator_tag) {
+        return MicroSTL::inclusive_scan(first, last, result, op);
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+    inline OutputIterator
+    _parallel_inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op,
+                             unsigned, input_iterator_tag, forward_iterator_tag) {
+        return MicroSTL::inclusive_scan(first, last, result, op);
+    }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename BinaryOperation>
+    RandomAccessIterator2
+    _parallel_inclusive_scan(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result,
+                             BinaryOperation op, unsigned thread_count,
+                             random_access_iterator_tag, random_access_iterator_tag) {
+        using T = typename iterator_traits<RandomAccessIterator1>::value_type;
+        const size_t size = last - first;
+        thread_count = _parallel_thread_count(thread_count, size, NUMERIC_PARALLEL_GRAIN);
+        if (thread_count <= 1) {
+            return MicroSTL::inclusive_scan(first, last, result, op);
+        }
+
+        const size_t chunk = (size + thread_count - 1) / thread_count;
+        T *partial = _parallel_scan_partials<RandomAccessIterator1, T>(first, size, chunk, thread_count, op);
+
+        // 区段 i 的初值为前 i 个区段的总和，就地存放在 partial[i - 1] 中
+        for (unsigned index = 1; index + 1 < thread_count; ++index) {
+            partial[index] = op(partial[index - 1], partial[index]);
+        }
+
+        // 第二趟：各线程以前缀为初值扫描自己的区段
+        _parallel_for(thread_count, [&](unsigned index) {
+            size_t begin = index * chunk;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            if (index == 0) {
+                MicroSTL::inclusive_scan(first, first + end, result, op);
+            } else {
+                MicroSTL::inclusive_scan(first + begin, first + end, result + begin, op, partial[index - 1]);
+            }
+        });
+
+        MicroSTL::destroy(partial, partial + (thread_count - 1));
+        Alloc<T>::deallocate(partial, thread_count);
+        return result + size;
+    }
+
+    /**
+     * 要求 first 与 result 都是 RandomAccessIterator 时才会并行，支持 first == result 的原地扫描
+     */
+    template<typename InputIterator, typename OutputIterator,
+            typename BinaryOperation = plus<typename iterator_traits<InputIterator>::value_type>>
+    inline OutputIterator parallel_inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                                  BinaryOperation op = BinaryOperation(),
+                                                  unsigned thread_count = 0) {
+        return _parallel_inclusive_scan(first, last, result, op, thread_count,
+                                        iterator_category(first), iterator_category(result));
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator
+    _parallel_exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init,
+                             BinaryOperation op, unsigned, input_iterator_tag, output_iterator_tag) {
+        return MicroSTL::exclusive_scan(first, last, result, init, op);
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+    inline OutputIterator
+    _parallel_exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init,
+                             BinaryOperation op, unsigned, input_iterator_tag, forward_iterator_tag) {
+        return MicroSTL::exclusive_scan(first, last, result, init, op);
+    }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename T, typename BinaryOperation>
+    RandomAccessIterator2
+    _parallel_exclusive_scan(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result,
+                             T init, BinaryOperation op, unsigned thread_count,
+                             random_access_iterator_tag, random_access_iterator_tag) {
+        const size_t size = last - first;
+        thread_count = _parallel_thread_count(thread_count, size, NUMERIC_PARALLEL_GRAIN);
+        if (thread_count <= 1) {
+            return MicroSTL::exclusive_scan(first, last, result, init, op);
+        }
+
+        const size_t chunk = (size + thread_count - 1) / thread_count;
+        T *partial = _parallel_scan_partials<RandomAccessIterator1, T>(first, size, chunk, thread_count, op);
+
+        partial[0] = op(init, partial[0]);
+        for (unsigned index = 1; index + 1 < thread_count; ++index) {
+            partial[index] = op(partial[index - 1], partial[index]);
+        }
+
+        _parallel_for(thread_count, [&](unsigned index) {
+            size_t begin = index * chunk;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            T offset = index == 0 ? init : partial[index - 1];
+            MicroSTL::exclusive_scan(first + begin, first + end, result + begin, offset, op);
+        });
+
+        MicroSTL::destroy(partial, partial + (thread_count - 1));
+        Alloc<T>::deallocate(partial, thread_count);
+        return result + size;
+    }
+
+    template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation = plus<T>>
+    inline OutputIterator parallel_exclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                                  T init, BinaryOperation op = BinaryOperation(),
+                                                  unsigned thread_count = 0) {
+        return _parallel_exclusive_scan(first, last, result, init, op, thread_count,
+                                        iterator_category(first), iterator_category(result));
+    }
+}
+
+#endif //MICROSTL_NUMERIC_H
@@ -0,0 +1,53 @@
+#ifndef MICROSTL_PARALLEL_H
+#define MICROSTL_PARALLEL_H
+
+#include <cstddef>
+#include <thread>
+
+/**
+ * 并行算法共用的线程工具：
+ *
+ * - 每次调用临时创建线程，不维护线程池，适合单次耗时在毫秒级以上的大区间
+ * - 当前线程负责第 0 个任务，只额外创建 thread_count - 1 个线程
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 单次调用最多使用的线程数
+     */
+    static const unsigned PARALLEL_MAX_THREADS = 64;
+
+    /**
+     * thread_count 为 0 时使用 hardware_concurrency，并且保证每个线程至少分到 grain 个元素
+     */
+    inline unsigned _parallel_thread_count(unsigned thread_count, size_t size, size_t grain) {
+        if (thread_count == 0) {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        if (thread_count > PARALLEL_MAX_THREADS) {
+            thread_count = PARALLEL_MAX_THREADS;
+        }
+        if (grain != 0 && size / grain < thread_count) {
+            thread_count = static_cast<unsigned>(size / grain);
+        }
+        return thread_count == 0 ? 1 : thread_count;
+    }
+
+    /**
+     * 在 thread_count 个线程上执行 fn(thread_index)，当前线程负责 0 号
+     */
+    template<typename Function>
+    inline void _parallel_for(unsigned thread_count, Function fn) {
+        std::thread workers[PARALLEL_MAX_THREADS];
+        for (unsigned i = 1; i < thread_count; ++i) {
+            workers[i] = std::thread(fn, i);
+        }
+        fn(0u);
+        for (unsigned i = 1; i < thread_count; ++i) {
+            workers[i].join();
+        }
+    }
+}
+
+#endif //MICROSTL_PARALLEL_H
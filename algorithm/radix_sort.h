@@ -0,0 +1,406 @@
+#ifndef MICROSTL_RADIX_SORT_H
+#define MICROSTL_RADIX_SORT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../iterator/type_traits.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "algo.h"
+#include "parallel.h"
+
+/**
+ * 基数排序，只接受 RandomAccessIterator，结果是稳定的：
+ *
+ * - key 必须是算术类型，编译期根据 arithmetic_traits 映射为同宽度的无符号整数，映射保持大小关系：
+ *      - 无符号整数：不变
+ *      - 有符号整数：翻转符号位
+ *      - IEEE 浮点数：负数翻转所有位，非负数翻转符号位（-0.0 排在 +0.0 之前，NaN 按位模式排在两端）
+ * - LSD：每次处理 8bit，一次扫描统计出所有位的直方图
+ *      - 如果某一位上所有元素都落在同一个桶中（比如时间戳的高位），则跳过这一趟
+ *      - 临时缓冲区由 Alloc<T> 分配，与原区间来回分发
+ * - 并行 MSD：多线程统计直方图，按最高的非平凡位并行分发到缓冲区，各桶再由线程各自进行 LSD
+ *      - 桶内排序使用原区间作为临时空间，线程中不会再向配置器申请内存
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 每一趟处理的 bit 数与桶数
+     */
+    static const size_t RADIX_BITS = 8;
+    static const size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+    /**
+     * 小于该长度的区间使用插入排序
+     */
+    static const size_t RADIX_SORT_THRESHOLD = 64;
+    /**
+     * 小于该长度时不启用并行
+     */
+    static const size_t RADIX_PARALLEL_THRESHOLD = 1 << 16;
+
+    // --------------------- key 映射 --------------------------
+
+    template<size_t Size>
+    struct _radix_unsigned {
+    };
+
+    template<>
+    struct _radix_unsigned<1> {
+        using type = unsigned char;
+    };
+
+    template<>
+    struct _radix_unsigned<2> {
+        using type = unsigned short;
+    };
+
+    template<>
+    struct _radix_unsigned<4> {
+        using type = unsigned int;
+    };
+
+    template<>
+    struct _radix_unsigned<8> {
+        using type = unsigned long long;
+    };
+
+    /**
+     * 无符号整数
+     */
+    template<typename Unsigned, typename Key>
+    inline Unsigned _radix_encode(Key key, true_type /* integral */, false_type /* signed */) {
+        return static_cast<Unsigned>(key);
+    }
+
+    /**
+     * 有符号整数
+     */
+    template<typename Unsigned, typename Key>
+    inline Unsigned _radix_encode(Key key, true_type /* integral */, true_type /* signed */) {
+        const Unsigned sign_bit = Unsigned(1) << (sizeof(Key) * 8 - 1);
+        return static_cast<Unsigned>(key) ^ sign_bit;
+    }
+
+    /**
+     * 浮点数
+     */
+    template<typename Unsigned, typename Key>
+    inline Unsigned _radix_encode(Key key, false_type /* integral */, true_type /* signed */) {
+        const Unsigned sign_bit = Unsigned(1) << (sizeof(Key) * 8 - 1);
+        Unsigned bits;
+        memcpy(&bits, &key, sizeof(Key));
+        // 负数翻转所有位，非负数只翻转符号位
+        return bits ^ (static_cast<Unsigned>(-static_cast<Unsigned>(bits >> (sizeof(Key) * 8 - 1))) | sign_bit);
+    }
+
+    /**
+     * 将元素映射为无符号的 key
+     */
+    template<typename KeyFn, typename Key>
+    struct _radix_encoder {
+        using key_type = Key;
+        using unsigned_type = typename _radix_unsigned<sizeof(Key)>::type;
+        using is_integral = typename arithmetic_traits<Key>::is_integral;
+        using is_signed = typename arithmetic_traits<Key>::is_signed;
+
+        KeyFn key_fn;
+
+        template<typename T>
+        unsigned_type operator()(const T &value) const {
+            return _radix_encode<unsigned_type>(static_cast<Key>(key_fn(value)), is_integral(), is_signed());
+        }
+    };
+
+    /**
+     * 默认的 key 为元素本身
+     */
+    struct _radix_identity {
+        template<typename T>
+        const T &operator()(const T &value) const {
+            return value;
+        }
+    };
+
+    /**
+     * 按映射后的 key 进行比较，用于短区间的插入排序
+     */
+    template<typename Encoder>
+    struct _radix_less {
+        Encoder encode;
+
+        template<typename T>
+        bool operator()(const T &a, const T &b) const {
+            return encode(a) < encode(b);
+        }
+    };
+
+    // --------------------- 分发 --------------------------
+
+    /**
+     * 目标位置尚未构造
+     */
+    template<typename T, typename U>
+    inline void _radix_put(T &dst, U &&src, true_type) {
+        new(&dst) T(std::move(src));
+    }
+
+    /**
+     * 目标位置已经构造
+     */
+    template<typename T, typename U>
+    inline void _radix_put(T &dst, U &&src, false_type) {
+        dst = std::move(src);
+    }
+
+    /**
+     * 按第 digit 位把 [src, src + size) 分发到 dst，offset 为各个桶当前的写入位置
+     */
+    template<typename SrcIterator, typename DstIterator, typename Encoder, typename Construct>
+    inline void _radix_scatter(SrcIterator src, DstIterator dst, size_t size, Encoder encode, size_t digit,
+                               size_t *offset, Construct) {
+        const size_t shift = digit * RADIX_BITS;
+        for (size_t i = 0; i < size; ++i) {
+            size_t bucket = static_cast<size_t>(encode(src[i]) >> shift) & (RADIX_BUCKETS - 1);
+            _radix_put(dst[offset[bucket]++], src[i], Construct());
+        }
+    }
+
+    /**
+     * 一次扫描统计 [0, digits) 位的直方图
+     */
+    template<typename RandomAccessIterator, typename Encoder>
+    inline void _radix_histogram(RandomAccessIterator first, size_t size, Encoder encode, size_t digits,
+                                 size_t (*count)[RADIX_BUCKETS]) {
+        for (size_t i = 0; i < size; ++i) {
+            typename Encoder::unsigned_type key = encode(first[i]);
+            for (size_t digit = 0; digit < digits; ++digit) {
+                ++count[digit][static_cast<size_t>(key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+            }
+        }
+    }
+
+    /**
+     * 对 [data, data + size) 的低 digits 位进行 LSD 排序，scratch 作为临时空间
+     * - scratch_constructed：scratch 中的对象是否已构造，第一次分发到 scratch 后会被置为 true
+     * - 返回 true 表示结果位于 scratch 中
+     */
+    template<typename DataIterator, typename ScratchIterator, typename Encoder>
+    bool _radix_lsd(DataIterator data, ScratchIterator scratch, size_t size, Encoder encode, size_t digits,
+                    bool &scratch_constructed) {
+        size_t count[sizeof(typename Encoder::unsigned_type)][RADIX_BUCKETS];
+        memset(count, 0, sizeof(count));
+        _radix_histogram(data, size, encode, digits, count);
+
+        const typename Encoder::unsigned_type first_key = encode(data[0]);
+        bool in_scratch = false;
+        size_t offset[RADIX_BUCKETS];
+
+        for (size_t digit = 0; digit < digits; ++digit) {
+            // 所有元素在这一位上都相同，跳过
+            size_t first_bucket = static_cast<size_t>(first_key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+            if (count[digit][first_bucket] == size) {
+                continue;
+            }
+
+            size_t sum = 0;
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+                offset[bucket] = sum;
+                sum += count[digit][bucket];
+            }
+
+            if (in_scratch) {
+                _radix_scatter(scratch, data, size, encode, digit, offset, false_type());
+            } else if (scratch_constructed) {
+                _radix_scatter(data, scratch, size, encode, digit, offset, false_type());
+            } else {
+                _radix_scatter(data, scratch, size, encode, digit, offset, true_type());
+                scratch_constructed = true;
+            }
+            in_scratch = !in_scratch;
+        }
+        return in_scratch;
+    }
+
+    template<typename SrcIterator, typename DstIterator>
+    inline void _radix_move(SrcIterator first, SrcIterator last, DstIterator result) {
+        for (; first != last; ++first, ++result) {
+            *result = std::move(*first);
+        }
+    }
+
+    /**
+     * key 的类型由 key_fn 的返回值决定；非算术类型的 key 找不到对应的 _radix_encode，无法通过编译
+     */
+    template<typename RandomAccessIterator, typename KeyFn>
+    inline _radix_encoder<KeyFn, typename std::decay<decltype(
+            std::declval<KeyFn &>()(*std::declval<RandomAccessIterator &>()))>::type>
+    _make_radix_encoder(RandomAccessIterator, KeyFn key_fn) {
+        return {key_fn};
+    }
+
+    // --------------------- radix_sort --------------------------
+
+    template<typename RandomAccessIterator, typename Encoder, typename T>
+    void _radix_sort(RandomAccessIterator first, RandomAccessIterator last, Encoder encode, T *) {
+        size_t size = last - first;
+        if (size < RADIX_SORT_THRESHOLD) {
+            _insertion_sort(first, last, _radix_less<Encoder>{encode});
+            return;
+        }
+
+        T *buffer = Alloc<T>::allocate(size);
+        bool constructed = false;
+        try {
+            if (_radix_lsd(first, buffer, size, encode, sizeof(typename Encoder::unsigned_type), constructed)) {
+                _radix_move(buffer, buffer + size, first);
+            }
+        } catch (...) {
+            if (constructed) {
+                MicroSTL::destroy(buffer, buffer + size);
+            }
+            Alloc<T>::deallocate(buffer, size);
+            throw;
+        }
+        if (constructed) {
+            MicroSTL::destroy(buffer, buffer + size);
+        }
+        Alloc<T>::deallocate(buffer, size);
+    }
+
+    /**
+     * 按 key_fn(element) 的返回值进行排序
+     */
+    template<typename RandomAccessIterator, typename KeyFn>
+    inline void radix_sort_by(RandomAccessIterator first, RandomAccessIterator last, KeyFn key_fn) {
+        _radix_sort(first, last, _make_radix_encoder(first, key_fn), value_type(first));
+    }
+
+    template<typename RandomAccessIterator>
+    inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+        MicroSTL::radix_sort_by(first, last, _radix_identity());
+    }
+
+    // --------------------- parallel_radix_sort --------------------------
+
+    /**
+     * 要求元素的移动构造与移动赋值不抛出异常
+     */
+    template<typename RandomAccessIterator, typename Encoder, typename T>
+    void _parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last, Encoder encode,
+                              unsigned thread_count, T *) {
+        using histogram = size_t[RADIX_BUCKETS];
+        const size_t digits = sizeof(typename Encoder::unsigned_type);
+        const size_t size = last - first;
+
+        thread_count = _parallel_thread_count(thread_count, size, 0);
+        if (thread_count <= 1 || size < RADIX_PARALLEL_THRESHOLD) {
+            _radix_sort(first, last, encode, static_cast<T *>(nullptr));
+            return;
+        }
+
+        const size_t chunk = (size + thread_count - 1) / thread_count;
+        const size_t count_size = thread_count * digits * RADIX_BUCKETS;
+        size_t *counts = Alloc<size_t>::allocate(count_size);
+        memset(counts, 0, sizeof(size_t) * count_size);
+
+        // 1. 各线程统计自己负责的区段的直方图
+        _parallel_for(thread_count, [&](unsigned index) {
+            size_t begin = index * chunk < size ? index * chunk : size;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            histogram *count = reinterpret_cast<histogram *>(counts + index * digits * RADIX_BUCKETS);
+            _radix_histogram(first + begin, end - begin, encode, digits, count);
+        });
+
+        // 2. 找到最高的非平凡位作为 MSD
+        size_t msd = digits;
+        for (size_t digit = digits; digit-- > 0 && msd == digits;) {
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+                size_t total = 0;
+                for (unsigned index = 0; index < thread_count; ++index) {
+                    total += counts[(index * digits + digit) * RADIX_BUCKETS + bucket];
+                }
+                if (total != 0) {
+                    if (total != size) {
+                        msd = digit;
+                    }
+                    break;
+                }
+            }
+        }
+        if (msd == digits) {
+            // 所有 key 都相同
+            Alloc<size_t>::deallocate(counts, count_size);
+            return;
+        }
+
+        // 3. 计算每个线程在每个桶中的写入位置，桶内按线程顺序排列，保证稳定
+        size_t bucket_begin[RADIX_BUCKETS + 1];
+        size_t *offsets = Alloc<size_t>::allocate(thread_count * RADIX_BUCKETS);
+        size_t sum = 0;
+        for (size_t bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+            bucket_begin[bucket] = sum;
+            for (unsigned index = 0; index < thread_count; ++index) {
+                offsets[index * RADIX_BUCKETS + bucket] = sum;
+                sum += counts[(index * digits + msd) * RADIX_BUCKETS + bucket];
+            }
+        }
+        bucket_begin[RADIX_BUCKETS] = sum;
+
+        T *buffer = Alloc<T>::allocate(size);
+
+        // 4. 并行分发到缓冲区
+        _parallel_for(thread_count, [&](unsigned index) {
+            size_t begin = index * chunk < size ? index * chunk : size;
+            size_t end = begin + chunk < size ? begin + chunk : size;
+            _radix_scatter(first + begin, buffer, end - begin, encode, msd, offsets + index * RADIX_BUCKETS,
+                           true_type());
+        });
+
+        // 5. 各线程领取桶，对低位进行 LSD，原区间作为临时空间
+        std::atomic<size_t> next_bucket(0);
+        _parallel_for(thread_count, [&](unsigned) {
+            for (size_t bucket = next_bucket++; bucket < RADIX_BUCKETS; bucket = next_bucket++) {
+                size_t begin = bucket_begin[bucket];
+                size_t end = bucket_begin[bucket + 1];
+                if (end - begin < RADIX_SORT_THRESHOLD) {
+                    _insertion_sort(buffer + begin, buffer + end, _radix_less<Encoder>{encode});
+                    _radix_move(buffer + begin, buffer + end, first + begin);
+                    continue;
+                }
+                bool constructed = true;
+                if (!_radix_lsd(buffer + begin, first + begin, end - begin, encode, msd, constructed)) {
+                    _radix_move(buffer + begin, buffer + end, first + begin);
+                }
+            }
+        });
+
+        MicroSTL::destroy(buffer, buffer + size);
+        Alloc<T>::deallocate(buffer, size);
+        Alloc<size_t>::deallocate(offsets, thread_count * RADIX_BUCKETS);
+        Alloc<size_t>::deallocate(counts, count_size);
+    }
+
+    /**
+     * thread_count 为 0 时使用 hardware_concurrency
+     */
+    template<typename RandomAccessIterator, typename KeyFn>
+    inline void
+    parallel_radix_sort_by(RandomAccessIterator first, RandomAccessIterator last, KeyFn key_fn,
+                           unsigned thread_count = 0) {
+        _parallel_radix_sort(first, last, _make_radix_encoder(first, key_fn), thread_count, value_type(first));
+    }
+
+    template<typename RandomAccessIterator>
+    inline void
+    parallel_radix_sort(RandomAccessIterator first, RandomAccessIterator last, unsigned thread_count = 0) {
+        MicroSTL::parallel_radix_sort_by(first, last, _radix_identity(), thread_count);
+    }
+}
+
+#endif //MICROSTL_RADIX_SORT_H
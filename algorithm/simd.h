@@ -0,0 +1,457 @@
+#ifndef MICROSTL_SIMD_H
+#define MICROSTL_SIMD_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * 连续内存上的向量化查找/比较内核，供 algobase.h 中的 find、count、mismatch 等算法分发使用：
+ *
+ * - 只处理"按字节比较等价于按值比较"的元素，即 1/2/4/8 字节的整数
+ * - x86 上运行时检测 CPU 特性：支持 AVX2 时每次处理 32 字节，否则使用 SSE2（x86-64 的基线）处理 16 字节
+ *      - 比较结果通过 movemask 压缩为位掩码，再用 ctz/popcount 得到位置与个数
+ *      - 8 字节元素在 SSE2 下没有 cmpeq_epi64，用两次 32 位比较的结果相与得到
+ * - 其他平台或定义了 MICROSTL_NO_SIMD 时退化为标量循环
+ * - 单字节查找、整段相等判断直接使用 memchr/memcmp，libc 中已有高度优化的实现
+ * - 子串查找（simd_search）同时比较候选位置的首尾字节，只有两者都命中时才逐段比较
+ */
+
+#if !defined(MICROSTL_NO_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#define MICROSTL_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace MicroSTL {
+
+    // --------------------- CPU 特性检测 --------------------------
+
+    struct cpu_features {
+        bool sse2;
+        bool sse42;
+        bool avx2;
+        bool popcnt;
+        bool bmi1;
+    };
+
+    /**
+     * 只在第一次调用时检测
+     */
+    inline const cpu_features &get_cpu_features() {
+        static const cpu_features features = []() {
+            cpu_features result = {false, false, false, false, false};
+#ifdef MICROSTL_SIMD_X86
+            __builtin_cpu_init();
+            result.sse2 = __builtin_cpu_supports("sse2");
+            result.sse42 = __builtin_cpu_supports("sse4.2");
+            result.avx2 = __builtin_cpu_supports("avx2");
+            result.popcnt = __builtin_cpu_supports("popcnt");
+            result.bmi1 = __builtin_cpu_supports("bmi");
+#endif
+            return result;
+        }();
+        return features;
+    }
+
+    // --------------------- 标量实现 --------------------------
+
+    template<typename T>
+    inline const T *_scalar_find(const T *first, const T *last, T value) {
+        for (; first != last; ++first) {
+            if (*first == value) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    template<typename T>
+    inline size_t _scalar_count(const T *first, const T *last, T value) {
+        size_t result = 0;
+        for (; first != last; ++first) {
+            result += *first == value;
+        }
+        return result;
+    }
+
+    /**
+     * 返回第一个不相等元素的下标，全部相等则返回 size
+     */
+    template<typename T>
+    inline size_t _scalar_mismatch(const T *a, const T *b, size_t size) {
+        size_t i = 0;
+        while (i < size && a[i] == b[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    /**
+     * 子串查找的标量收尾，返回 [i, size - needle_size] 中第一个匹配的位置，没有则返回 size
+     */
+    inline size_t _scalar_search_bytes(const unsigned char *s, size_t size, size_t i,
+                                       const unsigned char *needle, size_t needle_size) {
+        for (; i + needle_size <= size; ++i) {
+            if (s[i] == needle[0] && memcmp(s + i + 1, needle + 1, needle_size - 1) == 0) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+#ifdef MICROSTL_SIMD_X86
+
+    // --------------------- SSE2 --------------------------
+
+    template<size_t Size>
+    struct _sse2_ops {
+    };
+
+    template<>
+    struct _sse2_ops<1> {
+        static __m128i set1(const void *value) {
+            return _mm_set1_epi8(*static_cast<const char *>(value));
+        }
+
+        static __m128i cmpeq(__m128i a, __m128i b) {
+            return _mm_cmpeq_epi8(a, b);
+        }
+    };
+
+    template<>
+    struct _sse2_ops<2> {
+        static __m128i set1(const void *value) {
+            short v;
+            memcpy(&v, value, 2);
+            return _mm_set1_epi16(v);
+        }
+
+        static __m128i cmpeq(__m128i a, __m128i b) {
+            return _mm_cmpeq_epi16(a, b);
+        }
+    };
+
+    template<>
+    struct _sse2_ops<4> {
+        static __m128i set1(const void *value) {
+            int v;
+            memcpy(&v, value, 4);
+            return _mm_set1_epi32(v);
+        }
+
+        static __m128i cmpeq(__m128i a, __m128i b) {
+            return _mm_cmpeq_epi32(a, b);
+        }
+    };
+
+    template<>
+    struct _sse2_ops<8> {
+        static __m128i set1(const void *value) {
+            long long v;
+            memcpy(&v, value, 8);
+            return _mm_set1_epi64x(v);
+        }
+
+        static __m128i cmpeq(__m128i a, __m128i b) {
+            __m128i eq32 = _mm_cmpeq_epi32(a, b);
+            return _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    };
+
+    template<typename T>
+    inline const T *_sse2_find(const T *first, const T *last, T value) {
+        using ops = _sse2_ops<sizeof(T)>;
+        const size_t lanes = 16 / sizeof(T);
+        const __m128i needle = ops::set1(&value);
+        for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(ops::cmpeq(block, needle)));
+            if (mask) {
+                return first + __builtin_ctz(mask) / sizeof(T);
+            }
+        }
+        return _scalar_find(first, last, value);
+    }
+
+    template<typename T>
+    inline size_t _sse2_count(const T *first, const T *last, T value) {
+        using ops = _sse2_ops<sizeof(T)>;
+        const size_t lanes = 16 / sizeof(T);
+        const __m128i needle = ops::set1(&value);
+        size_t bits = 0;
+        for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            bits += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(ops::cmpeq(block, needle))));
+        }
+        // 每个匹配的元素在掩码中占 sizeof(T) 位
+        return bits / sizeof(T) + _scalar_count(first, last, value);
+    }
+
+    /**
+     * 按字节比较，返回第一个不相等字节的偏移
+     */
+    inline size_t _sse2_mismatch_bytes(const unsigned char *a, const unsigned char *b, size_t size) {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xffffu;
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + _scalar_mismatch(a + i, b + i, size - i);
+    }
+
+    /**
+     * 子串查找，needle_size >= 2：同时比较候选位置的首字节与尾字节，两者都相等的位置才用 memcmp 验证，
+     * 可以滤掉绝大多数只有首字节相同的候选
+     */
+    inline size_t _sse2_search_bytes(const unsigned char *s, size_t size, const unsigned char *needle,
+                                     size_t needle_size) {
+        const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+        const __m128i last = _mm_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+        size_t i = 0;
+        for (; i + needle_size - 1 + 16 <= size; i += 16) {
+            __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + needle_size - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+            for (; mask; mask &= mask - 1) {
+                size_t position = i + __builtin_ctz(mask);
+                if (memcmp(s + position + 1, needle + 1, needle_size - 2) == 0) {
+                    return position;
+                }
+            }
+        }
+        return _scalar_search_bytes(s, size, i, needle, needle_size);
+    }
+
+    // --------------------- AVX2 --------------------------
+
+    template<size_t Size>
+    struct _avx2_ops {
+    };
+
+    template<>
+    struct _avx2_ops<1> {
+        __attribute__((target("avx2"))) static __m256i set1(const void *value) {
+            return _mm256_set1_epi8(*static_cast<const char *>(value));
+        }
+
+        __attribute__((target("avx2"))) static __m256i cmpeq(__m256i a, __m256i b) {
+            return _mm256_cmpeq_epi8(a, b);
+        }
+    };
+
+    template<>
+    struct _avx2_ops<2> {
+        __attribute__((target("avx2"))) static __m256i set1(const void *value) {
+            short v;
+            memcpy(&v, value, 2);
+            return _mm256_set1_epi16(v);
+        }
+
+        __attribute__((target("avx2"))) static __m256i cmpeq(__m256i a, __m256i b) {
+            return _mm256_cmpeq_epi16(a, b);
+        }
+    };
+
+    template<>
+    struct _avx2_ops<4> {
+        __attribute__((target("avx2"))) static __m256i set1(const void *value) {
+            int v;
+            memcpy(&v, value, 4);
+            return _mm256_set1_epi32(v);
+        }
+
+        __attribute__((target("avx2"))) static __m256i cmpeq(__m256i a, __m256i b) {
+            return _mm256_cmpeq_epi32(a, b);
+        }
+    };
+
+    template<>
+    struct _avx2_ops<8> {
+        __attribute__((target("avx2"))) static __m256i set1(const void *value) {
+            long long v;
+            memcpy(&v, value, 8);
+            return _mm256_set1_epi64x(v);
+        }
+
+        __attribute__((target("avx2"))) static __m256i cmpeq(__m256i a, __m256i b) {
+            return _mm256_cmpeq_epi64(a, b);
+        }
+    };
+
+    template<typename T>
+    __attribute__((target("avx2"))) inline const T *_avx2_find(const T *first, const T *last, T value) {
+        using ops = _avx2_ops<sizeof(T)>;
+        const size_t lanes = 32 / sizeof(T);
+        const __m256i needle = ops::set1(&value);
+        // 每次处理两个向量，减少循环与分支的开销
+        for (; static_cast<size_t>(last - first) >= 2 * lanes; first += 2 * lanes) {
+            __m256i eq0 = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first)), needle);
+            __m256i eq1 = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + lanes)), needle);
+            if (!_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))) {
+                unsigned mask0 = static_cast<unsigned>(_mm256_movemask_epi8(eq0));
+                if (mask0) {
+                    return first + __builtin_ctz(mask0) / sizeof(T);
+                }
+                unsigned mask1 = static_cast<unsigned>(_mm256_movemask_epi8(eq1));
+                return first + lanes + __builtin_ctz(mask1) / sizeof(T);
+            }
+        }
+        for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(ops::cmpeq(block, needle)));
+            if (mask) {
+                return first + __builtin_ctz(mask) / sizeof(T);
+            }
+        }
+        return _scalar_find(first, last, value);
+    }
+
+    template<typename T>
+    __attribute__((target("avx2,popcnt"))) inline size_t _avx2_count(const T *first, const T *last, T value) {
+        using ops = _avx2_ops<sizeof(T)>;
+        const size_t lanes = 32 / sizeof(T);
+        const __m256i needle = ops::set1(&value);
+        size_t bits = 0;
+        for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            bits += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(ops::cmpeq(block, needle))));
+        }
+        return bits / sizeof(T) + _scalar_count(first, last, value);
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    _avx2_mismatch_bytes(const unsigned char *a, const unsigned char *b, size_t size) {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + _sse2_mismatch_bytes(a + i, b + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    _avx2_search_bytes(const unsigned char *s, size_t size, const unsigned char *needle, size_t needle_size) {
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+        const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+        size_t i = 0;
+        for (; i + needle_size - 1 + 32 <= size; i += 32) {
+            __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + needle_size - 1));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+            for (; mask; mask &= mask - 1) {
+                size_t position = i + __builtin_ctz(mask);
+                if (memcmp(s + position + 1, needle + 1, needle_size - 2) == 0) {
+                    return position;
+                }
+            }
+        }
+        return _scalar_search_bytes(s, size, i, needle, needle_size);
+    }
+
+#endif
+
+    // --------------------- 对外的内核入口 --------------------------
+
+    /**
+     * 在 [first, last) 中查找 value，T 为 1/2/4/8 字节整数
+     */
+    template<typename T>
+    inline const T *simd_find(const T *first, const T *last, T value) {
+        if (first == last) {
+            return last;
+        }
+        if (sizeof(T) == 1) {
+            const void *result = memchr(first, static_cast<unsigned char>(value), last - first);
+            return result ? static_cast<const T *>(result) : last;
+        }
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_find(first, last, value);
+        }
+        return _sse2_find(first, last, value);
+#else
+        return _scalar_find(first, last, value);
+#endif
+    }
+
+    template<typename T>
+    inline size_t simd_count(const T *first, const T *last, T value) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_count(first, last, value);
+        }
+        return _sse2_count(first, last, value);
+#else
+        return _scalar_count(first, last, value);
+#endif
+    }
+
+    /**
+     * 返回 a、b 中第一个不相等元素的下标，全部相等则返回 size
+     */
+    template<typename T>
+    inline size_t simd_mismatch(const T *a, const T *b, size_t size) {
+#ifdef MICROSTL_SIMD_X86
+        const unsigned char *ba = reinterpret_cast<const unsigned char *>(a);
+        const unsigned char *bb = reinterpret_cast<const unsigned char *>(b);
+        size_t bytes = get_cpu_features().avx2 ? _avx2_mismatch_bytes(ba, bb, size * sizeof(T))
+                                               : _sse2_mismatch_bytes(ba, bb, size * sizeof(T));
+        return bytes / sizeof(T);
+#else
+        return _scalar_mismatch(a, b, size);
+#endif
+    }
+
+    /**
+     * 在长度为 size 的 s 中查找长度为 needle_size 的子串，返回第一次出现的下标，没有则返回 size
+     *
+     * 单字节元素使用首尾字节过滤的向量化查找；其他元素用 simd_find 定位首元素后整段比较
+     */
+    template<typename T>
+    inline size_t simd_search(const T *s, size_t size, const T *needle, size_t needle_size) {
+        if (needle_size == 0) {
+            return 0;
+        }
+        if (needle_size > size) {
+            return size;
+        }
+        if (needle_size == 1) {
+            return simd_find(s, s + size, needle[0]) - s;
+        }
+        if (sizeof(T) == 1) {
+            const unsigned char *bs = reinterpret_cast<const unsigned char *>(s);
+            const unsigned char *bn = reinterpret_cast<const unsigned char *>(needle);
+#ifdef MICROSTL_SIMD_X86
+            if (get_cpu_features().avx2) {
+                return _avx2_search_bytes(bs, size, bn, needle_size);
+            }
+            return _sse2_search_bytes(bs, size, bn, needle_size);
+#else
+            return _scalar_search_bytes(bs, size, 0, bn, needle_size);
+#endif
+        }
+        const T *last = s + (size - needle_size + 1);
+        for (const T *p = s; (p = simd_find(p, last, needle[0])) != last; ++p) {
+            if (memcmp(p + 1, needle + 1, (needle_size - 1) * sizeof(T)) == 0) {
+                return p - s;
+            }
+        }
+        return size;
+    }
+
+    template<typename T>
+    inline bool simd_equal(const T *a, const T *b, size_t size) {
+        return size == 0 || memcmp(a, b, size * sizeof(T)) == 0;
+    }
+}
+
+#endif //MICROSTL_SIMD_H
@@ -0,0 +1,257 @@
+#ifndef MICROSTL_SIMD_BITS_H
+#define MICROSTL_SIMD_BITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "simd.h"
+
+/**
+ * 64 位字数组上的位运算内核，供 dynamic_bitset、vector<bool> 使用：
+ *
+ * - 按位与、或、异或、与非：AVX2 每次处理 4 个字（循环展开为 8 个），否则使用 SSE2 每次 2 个字
+ * - popcount：AVX2 下用 pshufb 查 4 位的计数表再用 sad 累加（Mula 算法），
+ *   没有 AVX2 但有 popcnt 指令时用 4 个累加器的 popcnt 循环，二者都没有时退化为编译器内建的软件实现
+ * - 查找第一个非零字：AVX2 一次检查 4 个字是否全为 0（vptest），稀疏位图中可以快速跳过空白区域
+ * - 与 simd.h 相同，运行时检测 CPU 特性，其他平台或定义了 MICROSTL_NO_SIMD 时使用标量循环
+ */
+
+namespace MicroSTL {
+
+    // --------------------- 位运算 --------------------------
+
+    struct _bits_and {
+        static uint64_t apply(uint64_t a, uint64_t b) {
+            return a & b;
+        }
+
+#ifdef MICROSTL_SIMD_X86
+
+        static __m128i apply(__m128i a, __m128i b) {
+            return _mm_and_si128(a, b);
+        }
+
+        __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+            return _mm256_and_si256(a, b);
+        }
+
+#endif
+    };
+
+    struct _bits_or {
+        static uint64_t apply(uint64_t a, uint64_t b) {
+            return a | b;
+        }
+
+#ifdef MICROSTL_SIMD_X86
+
+        static __m128i apply(__m128i a, __m128i b) {
+            return _mm_or_si128(a, b);
+        }
+
+        __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+            return _mm256_or_si256(a, b);
+        }
+
+#endif
+    };
+
+    struct _bits_xor {
+        static uint64_t apply(uint64_t a, uint64_t b) {
+            return a ^ b;
+        }
+
+#ifdef MICROSTL_SIMD_X86
+
+        static __m128i apply(__m128i a, __m128i b) {
+            return _mm_xor_si128(a, b);
+        }
+
+        __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+            return _mm256_xor_si256(a, b);
+        }
+
+#endif
+    };
+
+    /**
+     * a & ~b；andnot 指令对第一个操作数取反，因此交换参数
+     */
+    struct _bits_andnot {
+        static uint64_t apply(uint64_t a, uint64_t b) {
+            return a & ~b;
+        }
+
+#ifdef MICROSTL_SIMD_X86
+
+        static __m128i apply(__m128i a, __m128i b) {
+            return _mm_andnot_si128(b, a);
+        }
+
+        __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+            return _mm256_andnot_si256(b, a);
+        }
+
+#endif
+    };
+
+    // --------------------- 标量实现 --------------------------
+
+    template<typename Op>
+    inline void _scalar_bits_apply(uint64_t *dst, const uint64_t *src, size_t words) {
+        for (size_t i = 0; i < words; ++i) {
+            dst[i] = Op::apply(dst[i], src[i]);
+        }
+    }
+
+    inline size_t _scalar_popcount(const uint64_t *words, size_t size) {
+        size_t result = 0;
+        for (size_t i = 0; i < size; ++i) {
+            result += __builtin_popcountll(words[i]);
+        }
+        return result;
+    }
+
+    inline size_t _scalar_find_nonzero(const uint64_t *words, size_t size) {
+        size_t i = 0;
+        while (i < size && words[i] == 0) {
+            ++i;
+        }
+        return i;
+    }
+
+#ifdef MICROSTL_SIMD_X86
+
+    // --------------------- SSE2 --------------------------
+
+    template<typename Op>
+    inline void _sse2_bits_apply(uint64_t *dst, const uint64_t *src, size_t words) {
+        size_t i = 0;
+        for (; i + 2 <= words; i += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), Op::apply(a, b));
+        }
+        _scalar_bits_apply<Op>(dst + i, src + i, words - i);
+    }
+
+    /**
+     * 4 个独立的累加器，打断 popcnt 之间的依赖链
+     */
+    __attribute__((target("popcnt"))) inline size_t _popcnt_popcount(const uint64_t *words, size_t size) {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            c0 += __builtin_popcountll(words[i]);
+            c1 += __builtin_popcountll(words[i + 1]);
+            c2 += __builtin_popcountll(words[i + 2]);
+            c3 += __builtin_popcountll(words[i + 3]);
+        }
+        for (; i < size; ++i) {
+            c0 += __builtin_popcountll(words[i]);
+        }
+        return c0 + c1 + c2 + c3;
+    }
+
+    // --------------------- AVX2 --------------------------
+
+    template<typename Op>
+    __attribute__((target("avx2"))) inline void _avx2_bits_apply(uint64_t *dst, const uint64_t *src, size_t words) {
+        size_t i = 0;
+        for (; i + 8 <= words; i += 8) {
+            __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+            __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i + 4));
+            __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), Op::apply(a0, b0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 4), Op::apply(a1, b1));
+        }
+        _sse2_bits_apply<Op>(dst + i, src + i, words - i);
+    }
+
+    /**
+     * 每个字节拆成高低两个 4 位，查表得到各自的 1 的个数，sad 把每 8 个字节的计数横向加到一个 64 位整数上
+     */
+    __attribute__((target("avx2,popcnt"))) inline size_t _avx2_popcount(const uint64_t *words, size_t size) {
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+        __m256i total = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            __m256i low = _mm256_and_si256(v, low_mask);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, low), _mm256_shuffle_epi8(table, high));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+        }
+        size_t result = static_cast<size_t>(_mm256_extract_epi64(total, 0)) +
+                        static_cast<size_t>(_mm256_extract_epi64(total, 1)) +
+                        static_cast<size_t>(_mm256_extract_epi64(total, 2)) +
+                        static_cast<size_t>(_mm256_extract_epi64(total, 3));
+        for (; i < size; ++i) {
+            result += __builtin_popcountll(words[i]);
+        }
+        return result;
+    }
+
+    __attribute__((target("avx2"))) inline size_t _avx2_find_nonzero(const uint64_t *words, size_t size) {
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            if (!_mm256_testz_si256(v, v)) {
+                break;
+            }
+        }
+        return i + _scalar_find_nonzero(words + i, size - i);
+    }
+
+#endif
+
+    // --------------------- 对外的内核入口 --------------------------
+
+    /**
+     * dst[i] = Op(dst[i], src[i])，Op 为 _bits_and / _bits_or / _bits_xor / _bits_andnot
+     */
+    template<typename Op>
+    inline void simd_bits_apply(uint64_t *dst, const uint64_t *src, size_t words) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            _avx2_bits_apply<Op>(dst, src, words);
+            return;
+        }
+        _sse2_bits_apply<Op>(dst, src, words);
+#else
+        _scalar_bits_apply<Op>(dst, src, words);
+#endif
+    }
+
+    /**
+     * 数组中 1 的个数
+     */
+    inline size_t simd_popcount(const uint64_t *words, size_t size) {
+#ifdef MICROSTL_SIMD_X86
+        const cpu_features &features = get_cpu_features();
+        if (features.avx2 && features.popcnt) {
+            return _avx2_popcount(words, size);
+        }
+        if (features.popcnt) {
+            return _popcnt_popcount(words, size);
+        }
+#endif
+        return _scalar_popcount(words, size);
+    }
+
+    /**
+     * 第一个不为 0 的字的下标，全为 0 时返回 size
+     */
+    inline size_t simd_find_nonzero(const uint64_t *words, size_t size) {
+#ifdef MICROSTL_SIMD_X86
+        if (get_cpu_features().avx2) {
+            return _avx2_find_nonzero(words, size);
+        }
+#endif
+        return _scalar_find_nonzero(words, size);
+    }
+}
+
+#endif //MICROSTL_SIMD_BITS_H
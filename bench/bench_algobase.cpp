@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../algorithm/algobase.h"
+
+/**
+ * 可平凡复制的 24 字节结构体，MicroSTL 的 type_traits 默认把自定义类型视为非 POD，走逐个赋值的路径
+ */
+struct Point {
+    double x, y, z;
+};
+
+template<typename T>
+static std::vector<T> make_input(size_t size) {
+    std::vector<T> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = T(static_cast<char>('a' + i % 26));
+    }
+    return result;
+}
+
+template<>
+std::vector<Point> make_input<Point>(size_t size) {
+    std::vector<Point> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = Point{static_cast<double>(i), 0.0, 1.0};
+    }
+    return result;
+}
+
+template<>
+std::vector<std::string> make_input<std::string>(size_t size) {
+    std::vector<std::string> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = std::string(8, static_cast<char>('a' + i % 26));
+    }
+    return result;
+}
+
+template<typename T>
+static void BM_copy_micro(benchmark::State &state) {
+    std::vector<T> input = make_input<T>(state.range(0));
+    std::vector<T> output(input.size());
+    for (auto _: state) {
+        MicroSTL::copy(input.data(), input.data() + input.size(), output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_copy_std(benchmark::State &state) {
+    std::vector<T> input = make_input<T>(state.range(0));
+    std::vector<T> output(input.size());
+    for (auto _: state) {
+        std::copy(input.data(), input.data() + input.size(), output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+/**
+ * 区间重叠的向后复制（vector 中间插入时的移动方式）
+ */
+template<typename T>
+static void BM_copy_backward_micro(benchmark::State &state) {
+    std::vector<T> data = make_input<T>(state.range(0) + 1);
+    for (auto _: state) {
+        MicroSTL::copy_backward(data.data(), data.data() + data.size() - 1, data.data() + data.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_copy_backward_std(benchmark::State &state) {
+    std::vector<T> data = make_input<T>(state.range(0) + 1);
+    for (auto _: state) {
+        std::copy_backward(data.data(), data.data() + data.size() - 1, data.data() + data.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_fill_micro(benchmark::State &state) {
+    std::vector<T> data(state.range(0));
+    T value = make_input<T>(1)[0];
+    for (auto _: state) {
+        MicroSTL::fill(data.data(), data.data() + data.size(), value);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_fill_std(benchmark::State &state) {
+    std::vector<T> data(state.range(0));
+    T value = make_input<T>(1)[0];
+    for (auto _: state) {
+        std::fill(data.data(), data.data() + data.size(), value);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_fill_n_micro(benchmark::State &state) {
+    std::vector<T> data(state.range(0));
+    T value = make_input<T>(1)[0];
+    for (auto _: state) {
+        MicroSTL::fill_n(data.data(), data.size(), value);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_fill_n_std(benchmark::State &state) {
+    std::vector<T> data(state.range(0));
+    T value = make_input<T>(1)[0];
+    for (auto _: state) {
+        std::fill_n(data.data(), data.size(), value);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+#define ALGOBASE_BENCHMARKS(name, type, max)                                          \
+    BENCHMARK_TEMPLATE(name##_micro, type)->RangeMultiplier(8)->Range(8, max);     \
+    BENCHMARK_TEMPLATE(name##_std, type)->RangeMultiplier(8)->Range(8, max);
+
+ALGOBASE_BENCHMARKS(BM_copy, char, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_copy, int, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_copy, double, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_copy, Point, 1 << 18)
+ALGOBASE_BENCHMARKS(BM_copy, std::string, 1 << 15)
+ALGOBASE_BENCHMARKS(BM_copy_backward, char, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_copy_backward, int, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_copy_backward, Point, 1 << 18)
+ALGOBASE_BENCHMARKS(BM_fill, char, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_fill, int, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_fill, double, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_fill_n, char, 1 << 20)
+ALGOBASE_BENCHMARKS(BM_fill_n, int, 1 << 20)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <thread>
+#include "../memory/alloc.h"
+#include "../memory/numa_pool.h"
+#include "../container/spsc_queue.h"
+#include "../container/vector.h"
+#include "perf_counter.h"
+
+struct free_list_alloc {
+    static void *allocate(size_t size) {
+        return MicroSTL::AllocByFreeList::allocate(size);
+    }
+
+    static void deallocate(void *ptr, size_t size) {
+        MicroSTL::AllocByFreeList::deallocate(ptr, size);
+    }
+};
+
+struct numa_alloc {
+    static void *allocate(size_t size) {
+        return MicroSTL::AllocByNuma::allocate(size);
+    }
+
+    static void deallocate(void *ptr, size_t size) {
+        MicroSTL::AllocByNuma::deallocate(ptr, size);
+    }
+};
+
+struct malloc_alloc {
+    static void *allocate(size_t size) {
+        return MicroSTL::AllocByMalloc::allocate(size);
+    }
+
+    static void deallocate(void *ptr, size_t size) {
+        MicroSTL::AllocByMalloc::deallocate(ptr, size);
+    }
+};
+
+/**
+ * 对照组：std::allocator 最终调用的全局 operator new / delete
+ */
+struct std_alloc {
+    static void *allocate(size_t size) {
+        return ::operator new(size);
+    }
+
+    static void deallocate(void *ptr, size_t size) {
+        ::operator delete(ptr, size);
+    }
+};
+
+static const size_t CHURN_BLOCKS = 1024;
+
+/**
+ * 同一大小连续申请 CHURN_BLOCKS 块后按相反顺序释放，range(0) 为块大小
+ */
+template<typename Allocator>
+static void BM_churn_lifo(benchmark::State &state) {
+    size_t size = state.range(0);
+    void *blocks[CHURN_BLOCKS];
+    MicroSTL::perf_counter_group counters;
+    counters.start();
+    for (auto _: state) {
+        for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+            blocks[i] = Allocator::allocate(size);
+        }
+        benchmark::DoNotOptimize(blocks);
+        for (size_t i = CHURN_BLOCKS; i > 0; i--) {
+            Allocator::deallocate(blocks[i - 1], size);
+        }
+    }
+    counters.stop();
+    counters.report(state);
+    state.SetItemsProcessed(state.iterations() * CHURN_BLOCKS);
+}
+
+/**
+ * 维持 CHURN_BLOCKS 个存活块，每次随机释放一块再申请一块，模拟长期运行后的碎片化访问
+ */
+template<typename Allocator>
+static void BM_churn_random(benchmark::State &state) {
+    size_t size = state.range(0);
+    void *blocks[CHURN_BLOCKS];
+    for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+        blocks[i] = Allocator::allocate(size);
+    }
+    uint32_t victims[CHURN_BLOCKS];
+    std::mt19937 gen(size);
+    for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+        victims[i] = gen() % CHURN_BLOCKS;
+    }
+    for (auto _: state) {
+        for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+            uint32_t victim = victims[i];
+            Allocator::deallocate(blocks[victim], size);
+            blocks[victim] = Allocator::allocate(size);
+        }
+        benchmark::DoNotOptimize(blocks);
+    }
+    for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+        Allocator::deallocate(blocks[i], size);
+    }
+    state.SetItemsProcessed(state.iterations() * CHURN_BLOCKS);
+}
+
+/**
+ * 本线程申请、另一个线程释放，内存经 spsc_queue 传递；
+ * AllocByFreeList 没有加锁，不能跨线程释放，因此只比较 AllocByNuma、AllocByMalloc 与 operator new / delete
+ */
+template<typename Allocator>
+static void BM_cross_thread_free(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::spsc_queue<void *> queue(4096);
+    std::atomic<bool> done(false);
+    std::thread consumer([&]() {
+        void *ptr;
+        while (true) {
+            if (queue.try_pop(ptr)) {
+                Allocator::deallocate(ptr, size);
+            } else if (done.load(std::memory_order_acquire)) {
+                if (!queue.try_pop(ptr)) {
+                    break;
+                }
+                Allocator::deallocate(ptr, size);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (auto _: state) {
+        for (size_t i = 0; i < CHURN_BLOCKS; i++) {
+            void *ptr = Allocator::allocate(size);
+            while (!queue.try_push(ptr)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    state.SetItemsProcessed(state.iterations() * CHURN_BLOCKS);
+}
+
+BENCHMARK_TEMPLATE(BM_churn_lifo, free_list_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_lifo, numa_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_lifo, malloc_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_lifo, std_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_random, free_list_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_random, numa_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_random, malloc_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_churn_random, std_alloc)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_cross_thread_free, numa_alloc)->Arg(16)->Arg(128)->Arg(1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_cross_thread_free, malloc_alloc)->Arg(16)->Arg(128)->Arg(1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_cross_thread_free, std_alloc)->Arg(16)->Arg(128)->Arg(1024)->UseRealTime();
+
+BENCHMARK_MAIN();
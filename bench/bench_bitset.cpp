@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../container/dynamic_bitset.h"
+#include "../container/vector.h"
+
+/**
+ * 约 percent% 的位为 1
+ */
+static MicroSTL::dynamic_bitset make_bits(size_t size, int percent, unsigned seed) {
+    std::mt19937 gen(seed);
+    MicroSTL::dynamic_bitset result(size);
+    for (size_t i = 0; i < size; i++) {
+        if (static_cast<int>(gen() % 100) < percent) {
+            result.set(i);
+        }
+    }
+    return result;
+}
+
+static std::vector<bool> to_std(const MicroSTL::dynamic_bitset &bits) {
+    std::vector<bool> result(bits.size());
+    for (size_t i = 0; i < bits.size(); i++) {
+        result[i] = bits[i];
+    }
+    return result;
+}
+
+static void BM_count_bitset(benchmark::State &state) {
+    MicroSTL::dynamic_bitset bits = make_bits(state.range(0), 50, 1);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(bits.count());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+static void BM_count_std_vector_bool(benchmark::State &state) {
+    std::vector<bool> bits = to_std(make_bits(state.range(0), 50, 1));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::count(bits.begin(), bits.end(), true));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+/**
+ * 每个标志占 1 字节的基线，即特化之前 vector<bool> 的存储方式
+ */
+static void BM_count_byte_flags(benchmark::State &state) {
+    MicroSTL::dynamic_bitset bits = make_bits(state.range(0), 50, 1);
+    std::vector<uint8_t> flags(bits.size());
+    for (size_t i = 0; i < bits.size(); i++) {
+        flags[i] = bits[i];
+    }
+    for (auto _: state) {
+        size_t count = 0;
+        for (uint8_t flag: flags) {
+            count += flag;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+static void BM_and_bitset(benchmark::State &state) {
+    MicroSTL::dynamic_bitset a = make_bits(state.range(0), 50, 1);
+    MicroSTL::dynamic_bitset b = make_bits(state.range(0), 50, 2);
+    for (auto _: state) {
+        a &= b;
+        a |= b;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 4);
+}
+
+static void BM_and_std_vector_bool(benchmark::State &state) {
+    std::vector<bool> a = to_std(make_bits(state.range(0), 50, 1));
+    std::vector<bool> b = to_std(make_bits(state.range(0), 50, 2));
+    for (auto _: state) {
+        for (size_t i = 0; i < a.size(); i++) {
+            a[i] = a[i] && b[i];
+        }
+        for (size_t i = 0; i < a.size(); i++) {
+            a[i] = a[i] || b[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 4);
+}
+
+/**
+ * 遍历所有为 1 的位，range(1) 为 1 的比例（%）
+ */
+static void BM_iterate_set_bits_bitset(benchmark::State &state) {
+    MicroSTL::dynamic_bitset bits = make_bits(state.range(0), state.range(1), 3);
+    for (auto _: state) {
+        size_t sum = 0;
+        for (size_t i = bits.find_first(); i != MicroSTL::dynamic_bitset::npos; i = bits.find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_for_each_set_bitset(benchmark::State &state) {
+    MicroSTL::dynamic_bitset bits = make_bits(state.range(0), state.range(1), 3);
+    for (auto _: state) {
+        size_t sum = 0;
+        bits.for_each_set([&sum](size_t i) { sum += i; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_iterate_set_bits_std_vector_bool(benchmark::State &state) {
+    std::vector<bool> bits = to_std(make_bits(state.range(0), state.range(1), 3));
+    for (auto _: state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < bits.size(); i++) {
+            if (bits[i]) {
+                sum += i;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_push_back_vector_bool(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        MicroSTL::vector<bool> v;
+        for (size_t i = 0; i < size; i++) {
+            v.push_back(i & 1);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_push_back_std_vector_bool(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        std::vector<bool> v;
+        for (size_t i = 0; i < size; i++) {
+            v.push_back(i & 1);
+        }
+        benchmark::DoNotOptimize(v.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_count_bitset)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_count_std_vector_bool)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_count_byte_flags)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_and_bitset)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_and_std_vector_bool)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_iterate_set_bits_bitset)->Args({1 << 20, 1})->Args({1 << 20, 10})->Args({1 << 20, 50});
+BENCHMARK(BM_for_each_set_bitset)->Args({1 << 20, 1})->Args({1 << 20, 10})->Args({1 << 20, 50});
+BENCHMARK(BM_iterate_set_bits_std_vector_bool)->Args({1 << 20, 1})->Args({1 << 20, 10})->Args({1 << 20, 50});
+BENCHMARK(BM_push_back_vector_bool)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_push_back_std_vector_bool)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <malloc.h>
+#include <map>
+#include <random>
+#include "perf_counter.h"
+#include "../container/btree_map.h"
+#include "../container/map.h"
+#include "../container/vector.h"
+
+using btree_map = MicroSTL::btree_map<uint64_t, uint64_t>;
+using rb_map = MicroSTL::map<uint64_t, uint64_t>;
+using std_map = std::map<uint64_t, uint64_t>;
+
+// 随机插入构造，节点的填充率与生产环境中的索引接近
+template<typename Map>
+void fill_random(Map &map, size_t size) {
+    MicroSTL::vector<uint64_t> keys;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(i * 2);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(size));
+    for (size_t i = 0; i < size; i++) {
+        map.emplace(keys[i], i);
+    }
+}
+
+/**
+ * 随机查找，PMU 可用时额外报告每次查找的 cache 未命中次数
+ */
+template<typename Map>
+static void BM_lookup(benchmark::State &state) {
+    size_t size = state.range(0);
+    Map map;
+    fill_random(map, size);
+    MicroSTL::vector<uint64_t> keys;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(i * 2);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(size + 1));
+
+    MicroSTL::perf_counter misses = MicroSTL::perf_counter::cache_misses();
+    uint64_t total_misses = 0;
+    for (auto _: state) {
+        misses.start();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; i++) {
+            sum += map.find(keys[i])->second;
+        }
+        misses.stop();
+        total_misses += misses.read();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    if (misses.valid()) {
+        state.counters["cache_misses/lookup"] =
+                static_cast<double>(total_misses) / static_cast<double>(state.iterations() * size);
+    }
+}
+
+// 从中间开始的范围遍历
+template<typename Map>
+static void BM_scan(benchmark::State &state) {
+    size_t size = state.range(0);
+    Map map;
+    fill_random(map, size);
+    for (auto _: state) {
+        uint64_t sum = 0;
+        for (auto iter = map.lower_bound(size / 2); iter != map.end(); ++iter) {
+            sum += iter->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (size - size / 4));
+}
+
+/**
+ * 随机插入构造后堆上增加的字节数（包括分配器的额外开销），按元素平均
+ */
+template<typename Map>
+static void BM_memory(benchmark::State &state) {
+    size_t size = state.range(0);
+    double bytes = 0;
+    for (auto _: state) {
+        size_t before = mallinfo2().uordblks;
+        Map *map = new Map();
+        fill_random(*map, size);
+        bytes = static_cast<double>(mallinfo2().uordblks - before);
+        state.PauseTiming();
+        delete map;
+        state.ResumeTiming();
+    }
+    state.counters["bytes/element"] = bytes / static_cast<double>(size);
+}
+
+#define BTREE_BENCHMARK(fn, map, multiplier) \
+    BENCHMARK_TEMPLATE(fn, map)->RangeMultiplier(multiplier)->Range(1 << 10, 1 << 22)
+
+BTREE_BENCHMARK(BM_lookup, btree_map, 4);
+BTREE_BENCHMARK(BM_lookup, rb_map, 4);
+BTREE_BENCHMARK(BM_lookup, std_map, 4);
+BTREE_BENCHMARK(BM_scan, btree_map, 16);
+BTREE_BENCHMARK(BM_scan, rb_map, 16);
+BTREE_BENCHMARK(BM_scan, std_map, 16);
+BTREE_BENCHMARK(BM_memory, btree_map, 16)->Iterations(1);
+BTREE_BENCHMARK(BM_memory, rb_map, 16)->Iterations(1);
+BTREE_BENCHMARK(BM_memory, std_map, 16)->Iterations(1);
+
+BENCHMARK_MAIN();
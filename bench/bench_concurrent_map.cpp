@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+#include "../container/concurrent_unordered_map.h"
+
+/**
+ * 共享缓存的两种典型负载：读多写少（99% 查找）与读写各半，线程数 1 ~ 8
+ */
+
+static const uint64_t KEY_SPACE = 1 << 16;
+
+/**
+ * 作为对照：读写锁保护的 std::unordered_map
+ */
+class locked_map {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, uint64_t> map;
+
+public:
+    bool find(uint64_t key, uint64_t &out) const {
+        std::shared_lock<std::shared_mutex> guard(mutex);
+        auto it = map.find(key);
+        if (it == map.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    bool insert_or_assign(uint64_t key, uint64_t value) {
+        std::unique_lock<std::shared_mutex> guard(mutex);
+        return map.insert_or_assign(key, value).second;
+    }
+};
+
+using concurrent_map = MicroSTL::concurrent_unordered_map<uint64_t, uint64_t>;
+
+template<typename Map>
+Map &shared_map() {
+    static Map *map = [] {
+        Map *result = new Map();
+        for (uint64_t k = 0; k < KEY_SPACE; k += 2) {
+            result->insert_or_assign(k, k);
+        }
+        return result;
+    }();
+    return *map;
+}
+
+/**
+ * 每 range(0) 次操作中有一次写入
+ */
+template<typename Map>
+static void BM_workload(benchmark::State &state) {
+    Map &map = shared_map<Map>();
+    uint64_t write_every = static_cast<uint64_t>(state.range(0));
+    std::mt19937_64 rng(state.thread_index() + 1);
+    uint64_t found = 0;
+    uint64_t op = 0;
+    for (auto _: state) {
+        uint64_t key = rng() & (KEY_SPACE - 1);
+        if (++op % write_every == 0) {
+            map.insert_or_assign(key, op);
+        } else {
+            uint64_t value;
+            found += map.find(key, value);
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_workload, concurrent_map)->Arg(100)->Arg(2)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_workload, locked_map)->Arg(100)->Arg(2)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <deque>
+#include "../container/deque.h"
+#include "../container/vector.h"
+
+using micro_deque = MicroSTL::deque<uint64_t>;
+using std_deque = std::deque<uint64_t>;
+
+template<typename Deque>
+static void BM_push_back(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        Deque d;
+        for (size_t i = 0; i < size; i++) {
+            d.push_back(i);
+        }
+        benchmark::DoNotOptimize(d.back());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_push_back_vector(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        MicroSTL::vector<uint64_t> v;
+        for (size_t i = 0; i < size; i++) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.back());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Deque>
+static void BM_push_front(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        Deque d;
+        for (size_t i = 0; i < size; i++) {
+            d.push_front(i);
+        }
+        benchmark::DoNotOptimize(d.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 工作队列：队列长度稳定在 range(0)，尾进头出
+ */
+template<typename Deque>
+static void BM_work_queue(benchmark::State &state) {
+    size_t depth = state.range(0);
+    Deque d;
+    for (size_t i = 0; i < depth; i++) {
+        d.push_back(i);
+    }
+    uint64_t sum = 0;
+    for (auto _: state) {
+        for (size_t i = 0; i < 1024; i++) {
+            sum += d.front();
+            d.pop_front();
+            d.push_back(i);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+template<typename Deque>
+static void BM_random_access(benchmark::State &state) {
+    size_t size = state.range(0);
+    Deque d;
+    for (size_t i = 0; i < size; i++) {
+        d.push_back(i);
+    }
+    for (auto _: state) {
+        uint64_t sum = 0;
+        for (size_t i = 0, j = 0; i < size; i++, j = (j + 7919) % size) {
+            sum += d[j];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_push_back, micro_deque)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_back, std_deque)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_push_back_vector)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_front, micro_deque)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_front, std_deque)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_work_queue, micro_deque)->Range(64, 1 << 16);
+BENCHMARK_TEMPLATE(BM_work_queue, std_deque)->Range(64, 1 << 16);
+BENCHMARK_TEMPLATE(BM_random_access, micro_deque)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_random_access, std_deque)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
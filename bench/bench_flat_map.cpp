@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include "../adaptor/flat_map.h"
+#include "../container/btree_map.h"
+#include "../container/vector.h"
+
+using flat_map = MicroSTL::flat_map<uint64_t, uint64_t>;
+using btree_map = MicroSTL::btree_map<uint64_t, uint64_t>;
+using std_map = std::map<uint64_t, uint64_t>;
+
+MicroSTL::vector<MicroSTL::pair<uint64_t, uint64_t>> make_input(size_t size, uint64_t seed) {
+    MicroSTL::vector<uint64_t> keys;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(i * 2);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(seed));
+    MicroSTL::vector<MicroSTL::pair<uint64_t, uint64_t>> input;
+    input.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        input.push_back(MicroSTL::make_pair(keys[i], keys[i] / 2));
+    }
+    return input;
+}
+
+template<typename Map>
+void fill(Map &map, size_t size) {
+    auto input = make_input(size, size);
+    for (size_t i = 0; i < size; i++) {
+        map.emplace(input[i].first, input[i].second);
+    }
+}
+
+void fill(flat_map &map, size_t size) {
+    auto input = make_input(size, size);
+    map.insert(input.begin(), input.end());
+}
+
+template<typename Map>
+void run_lookup(benchmark::State &state, const Map &map, size_t size) {
+    MicroSTL::vector<uint64_t> keys;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(i * 2);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(size + 1));
+    for (auto _: state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; i++) {
+            sum += map.find(keys[i])->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Map>
+static void BM_lookup(benchmark::State &state) {
+    size_t size = state.range(0);
+    Map map;
+    fill(map, size);
+    run_lookup(state, map, size);
+}
+
+// 单点修改使 Eytzinger 索引失效，对比无分支二分查找
+static void BM_lookup_flat_binary(benchmark::State &state) {
+    size_t size = state.range(0);
+    flat_map map;
+    fill(map, size);
+    map.erase(map.end() - 1);
+    map[static_cast<uint64_t>(size - 1) * 2] = size - 1;
+    run_lookup(state, map, size);
+}
+
+template<typename Map>
+static void BM_build(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        Map map;
+        fill(map, size);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_lookup, flat_map)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_lookup_flat_binary)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_lookup, btree_map)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_lookup, std_map)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_build, flat_map)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_build, btree_map)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_build, std_map)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <list>
+#include <random>
+#include "../container/list.h"
+#include "perf_counter.h"
+
+using micro_list = MicroSTL::list<int>;
+using std_list = std::list<int>;
+
+template<typename List>
+static void fill_random(List &l, size_t size) {
+    std::mt19937 gen(static_cast<unsigned>(size));
+    for (size_t i = 0; i < size; i++) {
+        l.push_back(static_cast<int>(gen()));
+    }
+}
+
+template<typename List>
+static void BM_push_back(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        List l;
+        for (size_t i = 0; i < size; i++) {
+            l.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 交替在头部与一个固定的中间位置之前插入
+ */
+template<typename List>
+static void BM_insert(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        List l;
+        l.push_back(0);
+        auto middle = l.begin();
+        for (size_t i = 0; i < size; i++) {
+            if (i & 1) {
+                l.insert(middle, static_cast<int>(i));
+            } else {
+                l.push_front(static_cast<int>(i));
+            }
+        }
+        benchmark::DoNotOptimize(l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 在两个链表之间来回搬移单个节点，只修改指针
+ */
+template<typename List>
+static void BM_splice(benchmark::State &state) {
+    size_t size = state.range(0);
+    List a;
+    List b;
+    fill_random(a, size);
+    for (auto _: state) {
+        for (size_t i = 0; i < size; i++) {
+            b.splice(b.end(), a, a.begin());
+        }
+        for (size_t i = 0; i < size; i++) {
+            a.splice(a.end(), b, b.begin());
+        }
+        benchmark::DoNotOptimize(a.front());
+    }
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+template<typename List>
+static void BM_sort(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::perf_counter_group counters;
+    counters.start();
+    for (auto _: state) {
+        state.PauseTiming();
+        counters.stop();
+        List l;
+        fill_random(l, size);
+        counters.resume();
+        state.ResumeTiming();
+        l.sort();
+        benchmark::DoNotOptimize(l.front());
+    }
+    counters.stop();
+    counters.report(state);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename List>
+static void BM_traverse(benchmark::State &state) {
+    size_t size = state.range(0);
+    List l;
+    fill_random(l, size);
+    for (auto _: state) {
+        long long sum = 0;
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_push_back, micro_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_push_back, std_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_insert, micro_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_insert, std_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_splice, micro_list)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_splice, std_list)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_sort, micro_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_sort, std_list)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_traverse, micro_list)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_traverse, std_list)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_MAIN();
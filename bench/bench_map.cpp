@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include "perf_counter.h"
+#include "../container/map.h"
+#include "../container/vector.h"
+
+using micro_map = MicroSTL::map<uint64_t, uint64_t>;
+using std_map = std::map<uint64_t, uint64_t>;
+
+// 顺序查找时相邻的 key 在树中也相邻，路径上的节点大多还在 cache 中；随机查找则每一层都可能未命中
+struct sequential_order {
+};
+struct random_order {
+};
+
+// 间隔为 2 的已排序 key
+MicroSTL::vector<uint64_t> sorted_keys(size_t size) {
+    MicroSTL::vector<uint64_t> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(i * 2);
+    }
+    return result;
+}
+
+void lookup_order(MicroSTL::vector<uint64_t> &, sequential_order) {
+}
+
+void lookup_order(MicroSTL::vector<uint64_t> &keys, random_order) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(keys.size()));
+}
+
+/**
+ * 查找的工作集从 2^8 个节点（L1 内）增长到 2^22 个节点（远大于 LLC），
+ * PMU 可用时额外报告每次查找的 cache 未命中次数
+ */
+template<typename Map, typename Order>
+static void BM_lookup(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> keys = sorted_keys(size);
+    Map map;
+    for (size_t i = 0; i < size; i++) {
+        map.emplace_hint(map.end(), keys[i], i);
+    }
+    lookup_order(keys, Order());
+
+    MicroSTL::perf_counter misses = MicroSTL::perf_counter::cache_misses();
+    uint64_t total_misses = 0;
+    for (auto _: state) {
+        misses.start();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; i++) {
+            sum += map.find(keys[i])->second;
+        }
+        misses.stop();
+        total_misses += misses.read();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    if (misses.valid()) {
+        state.counters["cache_misses/lookup"] =
+                static_cast<double>(total_misses) / static_cast<double>(state.iterations() * size);
+    }
+}
+
+// 随机插入，节点在 pool 中的位置与在树中的位置无关
+template<typename Map>
+static void BM_insert_random(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> keys = sorted_keys(size);
+    lookup_order(keys, random_order());
+    for (auto _: state) {
+        Map map;
+        for (size_t i = 0; i < size; i++) {
+            map.emplace(keys[i], i);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// 有序输入，以 end() 为提示逐个插入
+template<typename Map>
+static void BM_insert_hint(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> keys = sorted_keys(size);
+    for (auto _: state) {
+        Map map;
+        for (size_t i = 0; i < size; i++) {
+            map.emplace_hint(map.end(), keys[i], i);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// value_type 的 key 为 const，不能放进 vector，用可赋值的 pair 准备输入
+template<typename Map>
+struct input_pair {
+    using type = MicroSTL::pair<uint64_t, uint64_t>;
+};
+
+template<>
+struct input_pair<std_map> {
+    using type = std::pair<uint64_t, uint64_t>;
+};
+
+// 从已排序的区间构造，MicroSTL::map 为 O(n) 直接建树
+template<typename Map>
+static void BM_build_sorted(benchmark::State &state) {
+    using Pair = typename input_pair<Map>::type;
+    size_t size = state.range(0);
+    MicroSTL::vector<Pair> values;
+    for (size_t i = 0; i < size; i++) {
+        values.push_back(Pair(i * 2, i));
+    }
+    for (auto _: state) {
+        Map map(values.begin(), values.end());
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_lookup, micro_map, sequential_order)->RangeMultiplier(4)->Range(1 << 8, 1 << 22);
+BENCHMARK_TEMPLATE(BM_lookup, std_map, sequential_order)->RangeMultiplier(4)->Range(1 << 8, 1 << 22);
+BENCHMARK_TEMPLATE(BM_lookup, micro_map, random_order)->RangeMultiplier(4)->Range(1 << 8, 1 << 22);
+BENCHMARK_TEMPLATE(BM_lookup, std_map, random_order)->RangeMultiplier(4)->Range(1 << 8, 1 << 22);
+
+BENCHMARK_TEMPLATE(BM_insert_random, micro_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_insert_random, std_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_insert_hint, micro_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_insert_hint, std_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_build_sorted, micro_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_build_sorted, std_map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include "../algorithm/numeric.h"
+#include "../container/vector.h"
+
+template<typename T>
+MicroSTL::vector<T> random_input(size_t size) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<T> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(static_cast<T>(rng() % 1000));
+    }
+    return result;
+}
+
+template<typename T>
+static void BM_micro_reduce(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::reduce(data.begin(), data.end(), T()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_std_accumulate(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::accumulate(data.begin(), data.end(), T()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_std_reduce(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::reduce(data.begin(), data.end(), T()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_micro_transform_reduce(benchmark::State &state) {
+    MicroSTL::vector<T> a = random_input<T>(state.range(0));
+    MicroSTL::vector<T> b = random_input<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::transform_reduce(a.begin(), a.end(), b.begin(), T()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_std_inner_product(benchmark::State &state) {
+    MicroSTL::vector<T> a = random_input<T>(state.range(0));
+    MicroSTL::vector<T> b = random_input<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::inner_product(a.begin(), a.end(), b.begin(), T()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_micro_inclusive_scan(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    MicroSTL::vector<T> result(state.range(0));
+    for (auto _: state) {
+        MicroSTL::inclusive_scan(data.begin(), data.end(), result.begin());
+        benchmark::DoNotOptimize(result.begin());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_std_inclusive_scan(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    MicroSTL::vector<T> result(state.range(0));
+    for (auto _: state) {
+        std::inclusive_scan(data.begin(), data.end(), result.begin());
+        benchmark::DoNotOptimize(result.begin());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_micro_parallel_inclusive_scan(benchmark::State &state) {
+    MicroSTL::vector<T> data = random_input<T>(state.range(0));
+    MicroSTL::vector<T> result(state.range(0));
+    for (auto _: state) {
+        MicroSTL::parallel_inclusive_scan(data.begin(), data.end(), result.begin());
+        benchmark::DoNotOptimize(result.begin());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+#define NUMERIC_BENCHMARK(fn, type) \
+    BENCHMARK_TEMPLATE(fn, type)->RangeMultiplier(32)->Range(1 << 10, 1 << 20)
+
+NUMERIC_BENCHMARK(BM_micro_reduce, float);
+NUMERIC_BENCHMARK(BM_std_accumulate, float);
+NUMERIC_BENCHMARK(BM_std_reduce, float);
+NUMERIC_BENCHMARK(BM_micro_reduce, double);
+NUMERIC_BENCHMARK(BM_std_accumulate, double);
+NUMERIC_BENCHMARK(BM_micro_reduce, int64_t);
+NUMERIC_BENCHMARK(BM_std_accumulate, int64_t);
+
+NUMERIC_BENCHMARK(BM_micro_transform_reduce, float);
+NUMERIC_BENCHMARK(BM_std_inner_product, float);
+NUMERIC_BENCHMARK(BM_micro_transform_reduce, double);
+NUMERIC_BENCHMARK(BM_std_inner_product, double);
+
+NUMERIC_BENCHMARK(BM_micro_inclusive_scan, float);
+NUMERIC_BENCHMARK(BM_std_inclusive_scan, float);
+NUMERIC_BENCHMARK(BM_micro_inclusive_scan, double);
+NUMERIC_BENCHMARK(BM_std_inclusive_scan, double);
+NUMERIC_BENCHMARK(BM_micro_inclusive_scan, int64_t);
+NUMERIC_BENCHMARK(BM_std_inclusive_scan, int64_t);
+NUMERIC_BENCHMARK(BM_micro_parallel_inclusive_scan, int64_t);
+
+BENCHMARK_MAIN();
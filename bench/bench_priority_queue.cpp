@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <vector>
+#include "../adaptor/priority_queue.h"
+
+using binary_queue = MicroSTL::priority_queue<uint64_t, MicroSTL::vector<uint64_t>, MicroSTL::greater<uint64_t>, 2>;
+using quaternary_queue = MicroSTL::priority_queue<uint64_t, MicroSTL::vector<uint64_t>, MicroSTL::greater<uint64_t>, 4>;
+using std_queue = std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>>;
+
+MicroSTL::vector<uint64_t> random_input(size_t size) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<uint64_t> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(rng());
+    }
+    return result;
+}
+
+// 全部 push 后全部 pop
+template<typename Queue>
+static void BM_push_pop(benchmark::State &state) {
+    MicroSTL::vector<uint64_t> input = random_input(state.range(0));
+    for (auto _: state) {
+        Queue queue;
+        for (uint64_t x: input) {
+            queue.push(x);
+        }
+        while (!queue.empty()) {
+            benchmark::DoNotOptimize(queue.top());
+            queue.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 定时器队列：队列大小保持不变，每次弹出最早的定时器并在其后重新插入一个
+template<typename Queue>
+static void BM_timer(benchmark::State &state) {
+    MicroSTL::vector<uint64_t> input = random_input(state.range(0));
+    Queue queue;
+    for (uint64_t x: input) {
+        queue.push(x);
+    }
+    std::mt19937_64 rng(42);
+    for (auto _: state) {
+        uint64_t now = queue.top();
+        queue.pop();
+        queue.push(now + (rng() >> 40));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 批量建堆
+static void BM_push_range_quaternary(benchmark::State &state) {
+    MicroSTL::vector<uint64_t> input = random_input(state.range(0));
+    for (auto _: state) {
+        quaternary_queue queue;
+        queue.push_range(input.begin(), input.end());
+        benchmark::DoNotOptimize(queue.top());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_push_range_std(benchmark::State &state) {
+    MicroSTL::vector<uint64_t> input = random_input(state.range(0));
+    for (auto _: state) {
+        std_queue queue(std::greater<uint64_t>(), std::vector<uint64_t>(input.begin(), input.end()));
+        benchmark::DoNotOptimize(queue.top());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define QUEUE_BENCHMARK(fn, queue) \
+    BENCHMARK_TEMPLATE(fn, queue)->RangeMultiplier(16)->Range(1 << 8, 1 << 20)
+
+QUEUE_BENCHMARK(BM_push_pop, binary_queue);
+QUEUE_BENCHMARK(BM_push_pop, quaternary_queue);
+QUEUE_BENCHMARK(BM_push_pop, std_queue);
+
+QUEUE_BENCHMARK(BM_timer, binary_queue);
+QUEUE_BENCHMARK(BM_timer, quaternary_queue);
+QUEUE_BENCHMARK(BM_timer, std_queue);
+
+BENCHMARK(BM_push_range_quaternary)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_push_range_std)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,243 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include "../container/mpmc_queue.h"
+#include "../container/spsc_queue.h"
+#include "../container/vector.h"
+
+/**
+ * 线程间传递数据的吞吐量与往返延迟，线程绑定到不同的 CPU（CPU 不足时轮流复用）
+ */
+
+static const size_t QUEUE_CAPACITY = 1024;
+static const size_t ITEMS = 1 << 20;
+static const size_t ROUND_TRIPS = 1 << 14;
+
+void pin_thread(unsigned index) {
+    unsigned cpus = std::thread::hardware_concurrency();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % (cpus == 0 ? 1 : cpus), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/**
+ * 只有一个 CPU 时忙等没有意义，让出时间片
+ */
+inline void spin_wait() {
+    static const bool single_cpu = std::thread::hardware_concurrency() <= 1;
+    if (single_cpu) {
+        std::this_thread::yield();
+    } else {
+        __builtin_ia32_pause();
+    }
+}
+
+/**
+ * 作为对照的加锁队列
+ */
+class locked_queue {
+    std::mutex mutex;
+    std::deque<uint64_t> items;
+    size_t limit;
+
+public:
+    explicit locked_queue(size_t capacity) : limit(capacity) {}
+
+    bool try_push(uint64_t value) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (items.size() == limit) {
+            return false;
+        }
+        items.push_back(value);
+        return true;
+    }
+
+    bool try_pop(uint64_t &out) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (items.empty()) {
+            return false;
+        }
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+};
+
+using spsc = MicroSTL::spsc_queue<uint64_t>;
+using mpmc = MicroSTL::mpmc_queue<uint64_t>;
+
+/**
+ * 一个生产者、一个消费者，每次迭代传递 ITEMS 个元素
+ */
+template<typename Queue>
+static void BM_throughput(benchmark::State &state) {
+    Queue queue(QUEUE_CAPACITY);
+    pin_thread(0);
+    for (auto _: state) {
+        std::thread producer([&] {
+            pin_thread(1);
+            for (uint64_t i = 0; i < ITEMS; i++) {
+                while (!queue.try_push(i)) {
+                    spin_wait();
+                }
+            }
+        });
+        uint64_t sum = 0;
+        uint64_t value;
+        for (size_t i = 0; i < ITEMS; i++) {
+            while (!queue.try_pop(value)) {
+                spin_wait();
+            }
+            sum += value;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ITEMS);
+}
+
+/**
+ * 批量接口，每批 range(0) 个元素
+ */
+template<typename Queue>
+static void BM_throughput_batch(benchmark::State &state) {
+    size_t batch = state.range(0);
+    Queue queue(QUEUE_CAPACITY);
+    pin_thread(0);
+    for (auto _: state) {
+        std::thread producer([&] {
+            pin_thread(1);
+            MicroSTL::vector<uint64_t> buffer(batch, 0);
+            for (uint64_t i = 0; i < ITEMS;) {
+                size_t n = std::min<size_t>(batch, ITEMS - i);
+                for (size_t j = 0; j < n; j++) {
+                    buffer[j] = i + j;
+                }
+                size_t pushed = queue.push_batch(buffer.begin(), n);
+                if (pushed == 0) {
+                    spin_wait();
+                }
+                i += pushed;
+            }
+        });
+        MicroSTL::vector<uint64_t> buffer(batch, 0);
+        uint64_t sum = 0;
+        for (size_t received = 0; received < ITEMS;) {
+            size_t n = queue.pop_batch(buffer.begin(), batch);
+            if (n == 0) {
+                spin_wait();
+            }
+            for (size_t j = 0; j < n; j++) {
+                sum += buffer[j];
+            }
+            received += n;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * ITEMS);
+}
+
+/**
+ * range(0) 个生产者与 range(0) 个消费者
+ */
+template<typename Queue>
+static void BM_throughput_mpmc(benchmark::State &state) {
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    Queue queue(QUEUE_CAPACITY);
+    size_t per_thread = ITEMS / threads;
+    for (auto _: state) {
+        std::atomic<uint64_t> sum(0);
+        std::thread workers[16];
+        for (unsigned t = 0; t < 2 * threads; t++) {
+            workers[t] = std::thread([&, t] {
+                pin_thread(t);
+                uint64_t local = 0;
+                uint64_t value;
+                for (size_t i = 0; i < per_thread; i++) {
+                    if (t < threads) {
+                        while (!queue.try_push(i)) {
+                            spin_wait();
+                        }
+                    } else {
+                        while (!queue.try_pop(value)) {
+                            spin_wait();
+                        }
+                        local += value;
+                    }
+                }
+                sum += local;
+            });
+        }
+        for (unsigned t = 0; t < 2 * threads; t++) {
+            workers[t].join();
+        }
+        benchmark::DoNotOptimize(sum.load());
+    }
+    state.SetItemsProcessed(state.iterations() * per_thread * threads);
+}
+
+/**
+ * 往返延迟：主线程发出时间戳，另一个线程原样送回，统计分位数
+ */
+template<typename Queue>
+static void BM_round_trip(benchmark::State &state) {
+    Queue request(QUEUE_CAPACITY);
+    Queue response(QUEUE_CAPACITY);
+    MicroSTL::vector<uint64_t> samples;
+    samples.reserve(ROUND_TRIPS);
+    pin_thread(0);
+    for (auto _: state) {
+        std::thread echo([&] {
+            pin_thread(1);
+            uint64_t value;
+            for (size_t i = 0; i < ROUND_TRIPS; i++) {
+                while (!request.try_pop(value)) {
+                    spin_wait();
+                }
+                while (!response.try_push(value)) {
+                    spin_wait();
+                }
+            }
+        });
+        samples.clear();
+        uint64_t value;
+        for (size_t i = 0; i < ROUND_TRIPS; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            while (!request.try_push(i)) {
+                spin_wait();
+            }
+            while (!response.try_pop(value)) {
+                spin_wait();
+            }
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+        echo.join();
+    }
+    std::sort(samples.begin(), samples.end());
+    state.counters["p50_ns"] = static_cast<double>(samples[samples.size() / 2]);
+    state.counters["p99_ns"] = static_cast<double>(samples[samples.size() * 99 / 100]);
+    state.counters["p999_ns"] = static_cast<double>(samples[samples.size() * 999 / 1000]);
+    state.SetItemsProcessed(state.iterations() * ROUND_TRIPS);
+}
+
+BENCHMARK_TEMPLATE(BM_throughput, spsc)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput, mpmc)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput, locked_queue)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput_batch, spsc)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput_batch, mpmc)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput_mpmc, mpmc)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput_mpmc, locked_queue)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, spsc)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, mpmc)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, locked_queue)->UseRealTime();
+
+BENCHMARK_MAIN();
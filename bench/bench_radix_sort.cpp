@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include "../algorithm/algo.h"
+#include "../algorithm/radix_sort.h"
+#include "../container/vector.h"
+
+template<typename T>
+MicroSTL::vector<T> random_input(size_t size) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<T> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(static_cast<T>(rng()));
+    }
+    return result;
+}
+
+// 时间戳：高位几乎不变
+MicroSTL::vector<uint64_t> timestamp_input(size_t size) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<uint64_t> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(1700000000000000000ull + rng() % (1ull << 32));
+    }
+    return result;
+}
+
+template<typename T, typename Sorter>
+void run_sort(benchmark::State &state, MicroSTL::vector<T> &input, Sorter sorter) {
+    size_t size = input.size();
+    MicroSTL::vector<T> data(size);
+    for (auto _: state) {
+        state.PauseTiming();
+        MicroSTL::copy(input.begin(), input.end(), data.begin());
+        state.ResumeTiming();
+        sorter(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+struct micro_radix_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { MicroSTL::radix_sort(first, last); }
+};
+
+struct micro_parallel_radix_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { MicroSTL::parallel_radix_sort(first, last); }
+};
+
+struct micro_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { MicroSTL::sort(first, last); }
+};
+
+struct std_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { std::sort(first, last); }
+};
+
+#define RADIX_BENCHMARK(sorter, type)                                     \
+    static void BM_##sorter##_##type(benchmark::State &state) {           \
+        MicroSTL::vector<type> input = random_input<type>(state.range(0)); \
+        run_sort<type>(state, input, sorter());                           \
+    }                                                                     \
+    BENCHMARK(BM_##sorter##_##type)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)
+
+RADIX_BENCHMARK(micro_radix_sort, uint32_t);
+RADIX_BENCHMARK(micro_sort, uint32_t);
+RADIX_BENCHMARK(std_sort, uint32_t);
+
+RADIX_BENCHMARK(micro_radix_sort, uint64_t);
+RADIX_BENCHMARK(micro_parallel_radix_sort, uint64_t);
+RADIX_BENCHMARK(std_sort, uint64_t);
+
+RADIX_BENCHMARK(micro_radix_sort, double);
+RADIX_BENCHMARK(std_sort, double);
+
+#define TIMESTAMP_BENCHMARK(sorter)                                       \
+    static void BM_##sorter##_timestamp(benchmark::State &state) {        \
+        MicroSTL::vector<uint64_t> input = timestamp_input(state.range(0)); \
+        run_sort<uint64_t>(state, input, sorter());                       \
+    }                                                                     \
+    BENCHMARK(BM_##sorter##_timestamp)->Arg(1 << 20)
+
+TIMESTAMP_BENCHMARK(micro_radix_sort);
+TIMESTAMP_BENCHMARK(std_sort);
+
+BENCHMARK_MAIN();
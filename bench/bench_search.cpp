@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include "../algorithm/algobase.h"
+#include "../container/vector.h"
+
+// 目标元素放在末尾，查找需要扫描整个区间
+template<typename T>
+MicroSTL::vector<T> make_haystack(size_t size) {
+    MicroSTL::vector<T> result;
+    for (size_t i = 0; i < size; i++) {
+        result.push_back(static_cast<T>(i % 100));
+    }
+    result.back() = static_cast<T>(127);
+    return result;
+}
+
+template<typename T>
+static void BM_micro_find(benchmark::State &state) {
+    MicroSTL::vector<T> data = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::find(data.begin(), data.end(), static_cast<T>(127)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_std_find(benchmark::State &state) {
+    MicroSTL::vector<T> data = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::find(data.begin(), data.end(), static_cast<T>(127)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_micro_count(benchmark::State &state) {
+    MicroSTL::vector<T> data = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::count(data.begin(), data.end(), static_cast<T>(42)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+template<typename T>
+static void BM_std_count(benchmark::State &state) {
+    MicroSTL::vector<T> data = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::count(data.begin(), data.end(), static_cast<T>(42)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+}
+
+// 两个区间只有最后一个元素不同
+template<typename T>
+static void BM_micro_mismatch(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    b.back() = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::mismatch(a.begin(), a.end(), b.begin()).first);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_std_mismatch(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    b.back() = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::mismatch(a.begin(), a.end(), b.begin()).first);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_micro_equal(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::equal(a.begin(), a.end(), b.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_std_equal(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::equal(a.begin(), a.end(), b.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_micro_lexicographical_compare(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    b.back() = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(MicroSTL::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+template<typename T>
+static void BM_std_lexicographical_compare(benchmark::State &state) {
+    MicroSTL::vector<T> a = make_haystack<T>(state.range(0));
+    MicroSTL::vector<T> b = make_haystack<T>(state.range(0));
+    b.back() = 0;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+#define SEARCH_BENCHMARK(fn, type) \
+    BENCHMARK_TEMPLATE(fn, type)->RangeMultiplier(32)->Range(1 << 5, 1 << 20)
+
+SEARCH_BENCHMARK(BM_micro_find, char);
+SEARCH_BENCHMARK(BM_std_find, char);
+SEARCH_BENCHMARK(BM_micro_find, int);
+SEARCH_BENCHMARK(BM_std_find, int);
+SEARCH_BENCHMARK(BM_micro_find, int64_t);
+SEARCH_BENCHMARK(BM_std_find, int64_t);
+
+SEARCH_BENCHMARK(BM_micro_count, char);
+SEARCH_BENCHMARK(BM_std_count, char);
+SEARCH_BENCHMARK(BM_micro_count, int);
+SEARCH_BENCHMARK(BM_std_count, int);
+
+SEARCH_BENCHMARK(BM_micro_mismatch, char);
+SEARCH_BENCHMARK(BM_std_mismatch, char);
+SEARCH_BENCHMARK(BM_micro_mismatch, int);
+SEARCH_BENCHMARK(BM_std_mismatch, int);
+
+SEARCH_BENCHMARK(BM_micro_equal, int);
+SEARCH_BENCHMARK(BM_std_equal, int);
+
+SEARCH_BENCHMARK(BM_micro_lexicographical_compare, int);
+SEARCH_BENCHMARK(BM_std_lexicographical_compare, int);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../utility/serialize.h"
+
+struct sample {
+    long id;
+    double values[3];
+};
+
+static MicroSTL::vector<sample> make_samples(size_t count) {
+    MicroSTL::vector<sample> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        result.push_back(sample{static_cast<long>(i), {i * 0.5, i * 0.25, 1.0}});
+    }
+    return result;
+}
+
+/**
+ * 写入内存文件，每轮从头覆盖；bytes_per_second 为负载的吞吐
+ */
+static void BM_write_vector(benchmark::State &state) {
+    MicroSTL::vector<sample> samples = make_samples(state.range(0));
+    int fd = memfd_create("bench_serialize", 0);
+    for (auto _: state) {
+        lseek(fd, 0, SEEK_SET);
+        MicroSTL::write_vector(fd, samples);
+    }
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * samples.size() * sizeof(sample));
+}
+
+/**
+ * 对照组：逐个元素 write，相当于逐个编码后再写出
+ */
+static void BM_write_elementwise(benchmark::State &state) {
+    MicroSTL::vector<sample> samples = make_samples(state.range(0));
+    int fd = memfd_create("bench_serialize", 0);
+    for (auto _: state) {
+        lseek(fd, 0, SEEK_SET);
+        for (auto &item: samples) {
+            benchmark::DoNotOptimize(write(fd, &item, sizeof(item)));
+        }
+    }
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * samples.size() * sizeof(sample));
+}
+
+static void BM_read_vector(benchmark::State &state) {
+    MicroSTL::vector<sample> samples = make_samples(state.range(0));
+    int fd = memfd_create("bench_serialize", 0);
+    MicroSTL::write_vector(fd, samples);
+    for (auto _: state) {
+        lseek(fd, 0, SEEK_SET);
+        MicroSTL::vector<sample> result = MicroSTL::read_vector<sample>(fd);
+        benchmark::DoNotOptimize(result.data());
+    }
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * samples.size() * sizeof(sample));
+}
+
+/**
+ * 对照组：逐个元素 read 后 push_back
+ */
+static void BM_read_elementwise(benchmark::State &state) {
+    MicroSTL::vector<sample> samples = make_samples(state.range(0));
+    int fd = memfd_create("bench_serialize", 0);
+    MicroSTL::write_vector(fd, samples);
+    for (auto _: state) {
+        lseek(fd, MicroSTL::SERIAL_HEADER_BYTES, SEEK_SET);
+        MicroSTL::vector<sample> result;
+        sample item;
+        for (size_t i = 0; i < samples.size(); i++) {
+            benchmark::DoNotOptimize(read(fd, &item, sizeof(item)));
+            result.push_back(item);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * samples.size() * sizeof(sample));
+}
+
+/**
+ * 在缓冲区上建立视图并扫描一遍，不复制
+ */
+static void BM_view_scan(benchmark::State &state) {
+    MicroSTL::vector<sample> samples = make_samples(state.range(0));
+    MicroSTL::vector<unsigned char> buffer;
+    buffer.resize_for_overwrite(MicroSTL::serialized_size(samples));
+    MicroSTL::serialize(samples, buffer.data());
+    for (auto _: state) {
+        MicroSTL::serial_view<sample> view(buffer.data(), buffer.size());
+        long sum = 0;
+        for (auto &item: view) {
+            sum += item.id;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * samples.size() * sizeof(sample));
+}
+
+static void BM_list_round_trip(benchmark::State &state) {
+    MicroSTL::list<sample> samples;
+    for (long i = 0; i < state.range(0); i++) {
+        samples.push_back(sample{i, {0, 0, 0}});
+    }
+    int fd = memfd_create("bench_serialize", 0);
+    for (auto _: state) {
+        lseek(fd, 0, SEEK_SET);
+        MicroSTL::write_list(fd, samples);
+        lseek(fd, 0, SEEK_SET);
+        MicroSTL::list<sample> result = MicroSTL::read_list<sample>(fd);
+        benchmark::DoNotOptimize(&result);
+    }
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(sample));
+}
+
+BENCHMARK(BM_write_vector)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_write_elementwise)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_read_vector)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_read_elementwise)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_view_scan)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_list_round_trip)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../container/soa_vector.h"
+#include "../container/vector.h"
+
+/**
+ * 8 个字段、64 字节的实体，更新循环只读写其中的 2 个
+ */
+struct Entity {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    uint32_t id;
+    char padding[32];
+};
+
+using entity_columns = MicroSTL::soa_vector<float, float, float, float, float, float, float, uint32_t>;
+
+static MicroSTL::vector<Entity> make_aos(size_t size) {
+    MicroSTL::vector<Entity> result;
+    for (size_t i = 0; i < size; i++) {
+        Entity e{};
+        e.x = static_cast<float>(i);
+        e.vx = 1.0f;
+        e.id = static_cast<uint32_t>(i);
+        result.push_back(e);
+    }
+    return result;
+}
+
+static entity_columns make_soa(size_t size) {
+    entity_columns result;
+    result.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        result.emplace_back(static_cast<float>(i), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, static_cast<uint32_t>(i));
+    }
+    return result;
+}
+
+static void BM_update_aos(benchmark::State &state) {
+    MicroSTL::vector<Entity> entities = make_aos(state.range(0));
+    for (auto _: state) {
+        for (Entity &e: entities) {
+            e.x += e.vx * 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * 按列处理：只有 x 与 vx 两列进入缓存，循环可以被向量化
+ */
+static void BM_update_soa_columns(benchmark::State &state) {
+    entity_columns entities = make_soa(state.range(0));
+    for (auto _: state) {
+        float *x = entities.data<0>();
+        const float *vx = entities.data<3>();
+        size_t size = entities.size();
+        for (size_t i = 0; i < size; i++) {
+            x[i] += vx[i] * 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * 按行访问，通过 tuple 引用取字段
+ */
+static void BM_update_soa_rows(benchmark::State &state) {
+    entity_columns entities = make_soa(state.range(0));
+    for (auto _: state) {
+        for (size_t i = 0; i < entities.size(); i++) {
+            auto row = entities[i];
+            std::get<0>(row) += std::get<3>(row) * 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_push_back_aos(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        MicroSTL::vector<Entity> entities;
+        for (size_t i = 0; i < size; i++) {
+            Entity e{};
+            e.x = static_cast<float>(i);
+            e.id = static_cast<uint32_t>(i);
+            entities.push_back(e);
+        }
+        benchmark::DoNotOptimize(entities.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_push_back_soa(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        entity_columns entities;
+        for (size_t i = 0; i < size; i++) {
+            entities.emplace_back(static_cast<float>(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, static_cast<uint32_t>(i));
+        }
+        benchmark::DoNotOptimize(entities.data<0>());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_update_aos)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_update_soa_columns)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_update_soa_rows)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_push_back_aos)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_push_back_soa)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "../algorithm/algo.h"
+#include "../container/vector.h"
+
+// 输入模式
+enum pattern {
+    RANDOM,
+    SORTED,
+    REVERSED,
+    FEW_UNIQUE
+};
+
+template<typename T>
+MicroSTL::vector<T> make_input(size_t size, pattern p) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<T> result;
+    for (size_t i = 0; i < size; i++) {
+        switch (p) {
+            case RANDOM:
+                result.push_back(static_cast<T>(rng()));
+                break;
+            case SORTED:
+                result.push_back(static_cast<T>(i));
+                break;
+            case REVERSED:
+                result.push_back(static_cast<T>(size - i));
+                break;
+            case FEW_UNIQUE:
+                result.push_back(static_cast<T>(rng() % 16));
+                break;
+        }
+    }
+    return result;
+}
+
+// 每轮都需要恢复输入，恢复的开销不计入结果
+template<typename T, typename Sorter>
+void run_sort(benchmark::State &state, pattern p, Sorter sorter) {
+    size_t size = state.range(0);
+    MicroSTL::vector<T> input = make_input<T>(size, p);
+    MicroSTL::vector<T> data(size);
+    for (auto _: state) {
+        state.PauseTiming();
+        MicroSTL::copy(input.begin(), input.end(), data.begin());
+        state.ResumeTiming();
+        sorter(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+struct micro_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { MicroSTL::sort(first, last); }
+};
+
+struct std_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { std::sort(first, last); }
+};
+
+struct micro_stable_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { MicroSTL::stable_sort(first, last); }
+};
+
+struct std_stable_sort {
+    template<typename T>
+    void operator()(T *first, T *last) const { std::stable_sort(first, last); }
+};
+
+#define SORT_BENCHMARK(sorter, type, p)                                   \
+    static void BM_##sorter##_##type##_##p(benchmark::State &state) {     \
+        run_sort<type>(state, p, sorter());                               \
+    }                                                                     \
+    BENCHMARK(BM_##sorter##_##type##_##p)->RangeMultiplier(16)->Range(1 << 10, 1 << 20)
+
+SORT_BENCHMARK(micro_sort, int, RANDOM);
+SORT_BENCHMARK(std_sort, int, RANDOM);
+SORT_BENCHMARK(micro_sort, int, SORTED);
+SORT_BENCHMARK(std_sort, int, SORTED);
+SORT_BENCHMARK(micro_sort, int, REVERSED);
+SORT_BENCHMARK(std_sort, int, REVERSED);
+SORT_BENCHMARK(micro_sort, int, FEW_UNIQUE);
+SORT_BENCHMARK(std_sort, int, FEW_UNIQUE);
+
+SORT_BENCHMARK(micro_sort, double, RANDOM);
+SORT_BENCHMARK(std_sort, double, RANDOM);
+
+SORT_BENCHMARK(micro_stable_sort, int, RANDOM);
+SORT_BENCHMARK(std_stable_sort, int, RANDOM);
+
+// 非算术类型，走普通划分
+static void BM_micro_sort_string(benchmark::State &state) {
+    std::mt19937 rng(1);
+    std::vector<std::string> input;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        input.push_back(std::to_string(rng()));
+    }
+    for (auto _: state) {
+        state.PauseTiming();
+        std::vector<std::string> data = input;
+        state.ResumeTiming();
+        MicroSTL::sort(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+}
+
+static void BM_std_sort_string(benchmark::State &state) {
+    std::mt19937 rng(1);
+    std::vector<std::string> input;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        input.push_back(std::to_string(rng()));
+    }
+    for (auto _: state) {
+        state.PauseTiming();
+        std::vector<std::string> data = input;
+        state.ResumeTiming();
+        std::sort(data.begin(), data.end());
+        benchmark::DoNotOptimize(data.data());
+    }
+}
+
+BENCHMARK(BM_micro_sort_string)->Arg(1 << 16);
+BENCHMARK(BM_std_sort_string)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
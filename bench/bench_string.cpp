@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+#include "../container/string.h"
+
+using micro_string = MicroSTL::string;
+
+static const char *const WORDS[] = {"id", "name", "user_id", "created_at", "timestamp_ms", "a_short_sso_string_____",
+                                    "a string that no longer fits inline"};
+
+/**
+ * 构造并销毁短字符串，range(0) 为 WORDS 的下标
+ */
+template<typename String>
+static void BM_construct(benchmark::State &state) {
+    const char *word = WORDS[state.range(0)];
+    for (auto _: state) {
+        String s(word);
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetLabel(std::to_string(strlen(word)) + " chars");
+}
+
+/**
+ * key + "=" + value + ";" 的拼接，结果长度在 SSO 边界附近
+ */
+template<typename String>
+static void BM_concat(benchmark::State &state) {
+    String key(WORDS[state.range(0)]);
+    String value("42");
+    for (auto _: state) {
+        String s = key + "=" + value + ";";
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+
+/**
+ * 逐个字符追加到 range(0) 长
+ */
+template<typename String>
+static void BM_push_back(benchmark::State &state) {
+    size_t size = state.range(0);
+    for (auto _: state) {
+        String s;
+        for (size_t i = 0; i < size; i++) {
+            s.push_back(static_cast<char>('a' + i % 26));
+        }
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 在 range(0) 字节的文本中查找只在末尾出现一次的子串
+ */
+template<typename String>
+static void BM_find(benchmark::State &state) {
+    size_t size = state.range(0);
+    String text;
+    for (size_t i = 0; i < size; i++) {
+        text.push_back(static_cast<char>('a' + (i * 7) % 19));
+    }
+    text += "needle";
+    for (auto _: state) {
+        benchmark::DoNotOptimize(text.find("needle"));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+template<typename String>
+static void BM_compare(benchmark::State &state) {
+    String a(WORDS[state.range(0)]);
+    String b(a);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(a == b);
+        benchmark::DoNotOptimize(a < b);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_construct, micro_string)->DenseRange(0, 6);
+BENCHMARK_TEMPLATE(BM_construct, std::string)->DenseRange(0, 6);
+BENCHMARK_TEMPLATE(BM_concat, micro_string)->DenseRange(0, 6);
+BENCHMARK_TEMPLATE(BM_concat, std::string)->DenseRange(0, 6);
+BENCHMARK_TEMPLATE(BM_push_back, micro_string)->Range(16, 1 << 14);
+BENCHMARK_TEMPLATE(BM_push_back, std::string)->Range(16, 1 << 14);
+BENCHMARK_TEMPLATE(BM_find, micro_string)->Range(64, 1 << 16);
+BENCHMARK_TEMPLATE(BM_find, std::string)->Range(64, 1 << 16);
+BENCHMARK_TEMPLATE(BM_compare, micro_string)->DenseRange(0, 6, 3);
+BENCHMARK_TEMPLATE(BM_compare, std::string)->DenseRange(0, 6, 3);
+
+BENCHMARK_MAIN();
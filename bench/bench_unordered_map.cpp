@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "../container/unordered_map.h"
+#include "../container/vector.h"
+
+using micro_map = MicroSTL::unordered_map<uint64_t, uint64_t>;
+using std_map = std::unordered_map<uint64_t, uint64_t>;
+using micro_string_map = MicroSTL::unordered_map<std::string, uint64_t>;
+using std_string_map = std::unordered_map<std::string, uint64_t>;
+
+// 打乱的 key，前一半用于插入，后一半保证查找不命中
+MicroSTL::vector<uint64_t> random_keys(size_t size) {
+    std::mt19937_64 rng(size);
+    MicroSTL::vector<uint64_t> result;
+    for (size_t i = 0; i < size * 2; i++) {
+        result.push_back(rng());
+    }
+    return result;
+}
+
+template<typename Key>
+Key make_key(uint64_t value);
+
+template<>
+uint64_t make_key<uint64_t>(uint64_t value) {
+    return value;
+}
+
+template<>
+std::string make_key<std::string>(uint64_t value) {
+    return "key-" + std::to_string(value);
+}
+
+template<typename Map>
+static void BM_insert(benchmark::State &state) {
+    using Key = typename Map::key_type;
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> raw = random_keys(size);
+    MicroSTL::vector<Key> keys;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(make_key<Key>(raw[i]));
+    }
+    for (auto _: state) {
+        Map map;
+        for (size_t i = 0; i < size; i++) {
+            map[keys[i]] = i;
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Map>
+static void BM_lookup_hit(benchmark::State &state) {
+    using Key = typename Map::key_type;
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> raw = random_keys(size);
+    MicroSTL::vector<Key> keys;
+    Map map;
+    for (size_t i = 0; i < size; i++) {
+        keys.push_back(make_key<Key>(raw[i]));
+        map[keys[i]] = i;
+    }
+    for (auto _: state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; i++) {
+            sum += map.find(keys[i])->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Map>
+static void BM_lookup_miss(benchmark::State &state) {
+    using Key = typename Map::key_type;
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> raw = random_keys(size);
+    MicroSTL::vector<Key> misses;
+    Map map;
+    for (size_t i = 0; i < size; i++) {
+        map[make_key<Key>(raw[i])] = i;
+        misses.push_back(make_key<Key>(raw[size + i]));
+    }
+    for (auto _: state) {
+        size_t found = 0;
+        for (size_t i = 0; i < size; i++) {
+            found += map.find(misses[i]) != map.end();
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// 删除全部元素后重新插入，计时只包含删除
+template<typename Map>
+static void BM_erase(benchmark::State &state) {
+    size_t size = state.range(0);
+    MicroSTL::vector<uint64_t> keys = random_keys(size);
+    Map map;
+    for (auto _: state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < size; i++) {
+            map[keys[i]] = i;
+        }
+        state.ResumeTiming();
+        for (size_t i = 0; i < size; i++) {
+            map.erase(keys[i]);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+#define MAP_BENCHMARK(fn, map) \
+    BENCHMARK_TEMPLATE(fn, map)->RangeMultiplier(16)->Range(1 << 8, 1 << 20)
+
+MAP_BENCHMARK(BM_insert, micro_map);
+MAP_BENCHMARK(BM_insert, std_map);
+MAP_BENCHMARK(BM_lookup_hit, micro_map);
+MAP_BENCHMARK(BM_lookup_hit, std_map);
+MAP_BENCHMARK(BM_lookup_miss, micro_map);
+MAP_BENCHMARK(BM_lookup_miss, std_map);
+MAP_BENCHMARK(BM_erase, micro_map);
+MAP_BENCHMARK(BM_erase, std_map);
+
+MAP_BENCHMARK(BM_insert, micro_string_map);
+MAP_BENCHMARK(BM_insert, std_string_map);
+MAP_BENCHMARK(BM_lookup_hit, micro_string_map);
+MAP_BENCHMARK(BM_lookup_hit, std_string_map);
+MAP_BENCHMARK(BM_lookup_miss, micro_string_map);
+MAP_BENCHMARK(BM_lookup_miss, std_string_map);
+
+BENCHMARK_MAIN();
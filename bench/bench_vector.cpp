@@ -0,0 +1,197 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "../container/vector.h"
+#include "../container/mapped_vector.h"
+#include "perf_counter.h"
+
+template<typename T>
+static T make_value(size_t i) {
+    return static_cast<T>(i);
+}
+
+template<>
+std::string make_value<std::string>(size_t i) {
+    // 超出 SSO 长度，每个元素都持有堆内存
+    return std::string(32, static_cast<char>('a' + i % 26));
+}
+
+template<typename Vector>
+static void BM_push_back(benchmark::State &state) {
+    using T = typename Vector::value_type;
+    size_t size = state.range(0);
+    MicroSTL::perf_counter_group counters;
+    counters.start();
+    for (auto _: state) {
+        Vector v;
+        for (size_t i = 0; i < size; i++) {
+            v.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(&*v.begin());
+    }
+    counters.stop();
+    counters.report(state);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 预先 reserve，与 BM_push_back 的差值即扩容（重新分配 + 搬移）的开销
+ */
+template<typename Vector>
+static void BM_push_back_reserved(benchmark::State &state) {
+    using T = typename Vector::value_type;
+    size_t size = state.range(0);
+    for (auto _: state) {
+        Vector v;
+        v.reserve(size);
+        for (size_t i = 0; i < size; i++) {
+            v.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(&*v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * 每次插入到正中间，需要移动后一半的元素
+ */
+template<typename Vector>
+static void BM_insert_middle(benchmark::State &state) {
+    using T = typename Vector::value_type;
+    size_t size = state.range(0);
+    for (auto _: state) {
+        Vector v;
+        for (size_t i = 0; i < size; i++) {
+            v.insert(v.begin() + v.size() / 2, make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(&*v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Vector>
+static void BM_erase_front(benchmark::State &state) {
+    using T = typename Vector::value_type;
+    size_t size = state.range(0);
+    Vector input;
+    for (size_t i = 0; i < size; i++) {
+        input.push_back(make_value<T>(i));
+    }
+    for (auto _: state) {
+        state.PauseTiming();
+        Vector v(input);
+        state.ResumeTiming();
+        while (!v.empty()) {
+            v.erase(v.begin());
+        }
+        benchmark::DoNotOptimize(v.size());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Vector>
+static void BM_traverse(benchmark::State &state) {
+    using T = typename Vector::value_type;
+    size_t size = state.range(0);
+    Vector v;
+    for (size_t i = 0; i < size; i++) {
+        v.push_back(make_value<T>(i));
+    }
+    for (auto _: state) {
+        T sum = T();
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+struct load_record {
+    long key;
+    double values[3];
+};
+
+/**
+ * 写好 range(0) 条记录的临时文件，用于比较启动时的加载方式
+ */
+static std::string write_records(size_t count) {
+    char name[] = "/tmp/microstl_bench_XXXXXX";
+    int fd = mkstemp(name);
+    close(fd);
+    MicroSTL::mapped_vector<load_record> file(name, MicroSTL::map_mode::truncate);
+    file.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        file[i].key = static_cast<long>(i);
+    }
+    return name;
+}
+
+/**
+ * 读取文件后逐条 push_back 进 vector，再扫描一遍
+ */
+static void BM_load_push_back(benchmark::State &state) {
+    size_t count = state.range(0);
+    std::string path = write_records(count);
+    for (auto _: state) {
+        FILE *file = fopen(path.c_str(), "rb");
+        MicroSTL::vector<load_record> records;
+        load_record record;
+        while (fread(&record, sizeof(record), 1, file) == 1) {
+            records.push_back(record);
+        }
+        fclose(file);
+        long sum = 0;
+        for (auto &item: records) {
+            sum += item.key;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    unlink(path.c_str());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+/**
+ * 只读映射同一个文件后扫描一遍，文件已在 page cache 中
+ */
+static void BM_load_mapped(benchmark::State &state) {
+    size_t count = state.range(0);
+    std::string path = write_records(count);
+    for (auto _: state) {
+        const MicroSTL::mapped_vector<load_record> records(path.c_str(), MicroSTL::map_mode::read_only);
+        long sum = 0;
+        for (auto &item: records) {
+            sum += item.key;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    unlink(path.c_str());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+using micro_int = MicroSTL::vector<int>;
+using std_int = std::vector<int>;
+using micro_string = MicroSTL::vector<std::string>;
+using std_string = std::vector<std::string>;
+
+BENCHMARK_TEMPLATE(BM_push_back, micro_int)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_back, std_int)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_back, micro_string)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_push_back, std_string)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_push_back_reserved, micro_int)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_push_back_reserved, std_int)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_insert_middle, micro_int)->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(BM_insert_middle, std_int)->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(BM_insert_middle, micro_string)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_insert_middle, std_string)->Range(1 << 6, 1 << 12);
+BENCHMARK_TEMPLATE(BM_erase_front, micro_int)->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(BM_erase_front, std_int)->Range(1 << 6, 1 << 14);
+BENCHMARK_TEMPLATE(BM_traverse, micro_int)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_traverse, std_int)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_load_push_back)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_load_mapped)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,186 @@
+#ifndef MICROSTL_BENCH_PERF_COUNTER_H
+#define MICROSTL_BENCH_PERF_COUNTER_H
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * 基准测试用的硬件计数器，基于 Linux 的 perf_event_open：
+ *
+ * - 只统计当前线程在用户态的事件
+ * - 不支持的平台、虚拟机里没有 PMU、或 perf_event_paranoid 不允许时 valid() 为 false，
+ *   此时 read() 始终返回 0，基准测试照常运行，只是不报告对应的计数
+ * - perf_counter_group 同时统计周期数、指令数与 cache 未命中，按每次迭代的平均值写入基准测试的 counters，
+ *   回归检查脚本（regression.py）会把它们与耗时一起输出
+ */
+
+namespace MicroSTL {
+
+    class perf_counter {
+    protected:
+        int fd;
+
+    public:
+        perf_counter(uint32_t type, uint64_t config) : fd(-1) {
+#if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+            (void) type;
+            (void) config;
+#endif
+        }
+
+        perf_counter(const perf_counter &) = delete;
+
+        perf_counter &operator=(const perf_counter &) = delete;
+
+        ~perf_counter() {
+#if defined(__linux__)
+            if (fd >= 0) {
+                close(fd);
+            }
+#endif
+        }
+
+        static perf_counter cycles() {
+#if defined(__linux__)
+            return perf_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+#else
+            return perf_counter(0, 0);
+#endif
+        }
+
+        static perf_counter instructions() {
+#if defined(__linux__)
+            return perf_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+#else
+            return perf_counter(0, 0);
+#endif
+        }
+
+        /**
+         * 最后一级 cache 的未命中次数
+         */
+        static perf_counter cache_misses() {
+#if defined(__linux__)
+            return perf_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#else
+            return perf_counter(0, 0);
+#endif
+        }
+
+        bool valid() const {
+            return fd >= 0;
+        }
+
+        void start() {
+#if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        /**
+         * 继续计数但不清零，与 stop() 配合跳过 PauseTiming 期间的准备工作
+         */
+        void resume() {
+#if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void stop() {
+#if defined(__linux__)
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+#endif
+        }
+
+        uint64_t read() const {
+            uint64_t value = 0;
+#if defined(__linux__)
+            if (fd >= 0 && ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+                value = 0;
+            }
+#endif
+            return value;
+        }
+    };
+
+    // --------------------- perf_counter_group --------------------------
+
+    /**
+     * 用法：循环前 start()，循环后 stop()，再 report(state)；循环内的 PauseTiming 区间用 stop()/resume() 包起来
+     */
+    class perf_counter_group {
+    protected:
+        perf_counter cycle_counter;
+        perf_counter instruction_counter;
+        perf_counter miss_counter;
+
+    public:
+        perf_counter_group() : cycle_counter(perf_counter::cycles()),
+                               instruction_counter(perf_counter::instructions()),
+                               miss_counter(perf_counter::cache_misses()) {}
+
+        void start() {
+            cycle_counter.start();
+            instruction_counter.start();
+            miss_counter.start();
+        }
+
+        void resume() {
+            cycle_counter.resume();
+            instruction_counter.resume();
+            miss_counter.resume();
+        }
+
+        void stop() {
+            cycle_counter.stop();
+            instruction_counter.stop();
+            miss_counter.stop();
+        }
+
+        /**
+         * 只写入可用的计数器，数值为每次迭代的平均值
+         */
+        template<typename State>
+        void report(State &state) const {
+            double iterations = static_cast<double>(state.iterations());
+            if (iterations == 0) {
+                return;
+            }
+            if (cycle_counter.valid()) {
+                state.counters["cycles"] = static_cast<double>(cycle_counter.read()) / iterations;
+            }
+            if (instruction_counter.valid()) {
+                state.counters["instructions"] = static_cast<double>(instruction_counter.read()) / iterations;
+            }
+            if (miss_counter.valid()) {
+                state.counters["cache_misses"] = static_cast<double>(miss_counter.read()) / iterations;
+            }
+        }
+    };
+}
+
+#endif //MICROSTL_BENCH_PERF_COUNTER_H
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+基准测试的性能回归检查，由 CTest 调用：
+
+- 基线保存在 bench/baseline/<bench>.json，只记录需要守护的热点基准（中位数与 MAD）
+- 运行时只执行基线中列出的基准，每个重复 --repetitions 次，用中位数代替平均值，用 MAD 估计噪声
+- 当前中位数同时超过「基线 * (1 + threshold)」与「基线 + noise * 噪声」时判定为回归，返回非 0
+- 基准报告了 cycles / instructions / cache_misses（见 perf_counter.h）时一并输出，便于判断回归的来源
+- --update 用本机的结果重写基线，换机器或有意改变性能特征后执行
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+# 正态分布下 MAD 与标准差的换算系数
+MAD_SCALE = 1.4826
+COUNTERS = ("cycles", "instructions", "cache_misses")
+
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    if n == 0:
+        return 0.0
+    if n % 2 == 1:
+        return values[n // 2]
+    return (values[n // 2 - 1] + values[n // 2]) / 2
+
+
+def mad(values):
+    center = median(values)
+    return median([abs(v - center) for v in values])
+
+
+def run_benchmarks(executable, names, repetitions, min_time):
+    pattern = "^(" + "|".join(re.escape(name) for name in names) + ")$"
+    command = [executable,
+               "--benchmark_filter=" + pattern,
+               "--benchmark_repetitions=%d" % repetitions,
+               "--benchmark_format=json"]
+    if min_time:
+        command.append("--benchmark_min_time=%s" % min_time)
+    output = subprocess.run(command, check=True, stdout=subprocess.PIPE).stdout
+    # 过滤条件没有匹配到任何基准时不会输出 JSON
+    if not output.strip():
+        return {}
+    report = json.loads(output)
+
+    # 只统计每次重复的原始结果，benchmark 自带的 mean / median / stddev 聚合行忽略
+    runs = {}
+    for entry in report["benchmarks"]:
+        if entry.get("run_type", "iteration") != "iteration":
+            continue
+        runs.setdefault(entry["run_name"], []).append(entry)
+
+    results = {}
+    for name, entries in runs.items():
+        # UseRealTime 的基准以墙上时间为准，其余使用 CPU 时间
+        key = "real_time" if name.endswith("/real_time") else "cpu_time"
+        times = [e[key] for e in entries]
+        result = {"median": round(median(times), 2), "mad": round(mad(times), 2), "time_unit": entries[0]["time_unit"]}
+        for counter in COUNTERS:
+            if counter in entries[0]:
+                result[counter] = round(median([e[counter] for e in entries]), 2)
+        results[name] = result
+    return results
+
+
+def format_counters(result):
+    parts = []
+    for counter in COUNTERS:
+        if counter in result:
+            parts.append("%s=%.1f" % (counter, result[counter]))
+    if "cycles" in result and "instructions" in result and result["cycles"] > 0:
+        parts.append("ipc=%.2f" % (result["instructions"] / result["cycles"]))
+    return " ".join(parts)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare benchmark results against a stored baseline")
+    parser.add_argument("--bench", required=True, help="benchmark executable")
+    parser.add_argument("--baseline", required=True, help="baseline json file")
+    parser.add_argument("--repetitions", type=int, default=9)
+    parser.add_argument("--min-time", default="", help="forwarded as --benchmark_min_time")
+    parser.add_argument("--threshold", type=float, default=None,
+                        help="allowed relative slowdown, overrides the value stored in the baseline")
+    parser.add_argument("--noise", type=float, default=3.0,
+                        help="a slowdown must also exceed this many scaled MADs")
+    parser.add_argument("--update", action="store_true", help="rewrite the baseline with the current results")
+    args = parser.parse_args()
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    threshold = args.threshold if args.threshold is not None else baseline.get("threshold", 0.10)
+    names = sorted(baseline["benchmarks"].keys())
+    current = run_benchmarks(args.bench, names, args.repetitions, args.min_time)
+
+    missing = [name for name in names if name not in current]
+    if missing:
+        for name in missing:
+            print("MISSING  %s" % name)
+        return 1
+
+    if args.update:
+        baseline["benchmarks"] = {name: current[name] for name in names}
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("updated %s" % os.path.relpath(args.baseline))
+        return 0
+
+    failed = 0
+    for name in names:
+        base = baseline["benchmarks"][name]
+        cur = current[name]
+        noise = args.noise * MAD_SCALE * max(base["mad"], cur["mad"])
+        delta = cur["median"] - base["median"]
+        regressed = delta > base["median"] * threshold and delta > noise
+        failed += regressed
+        print("%-8s %-48s %12.1f -> %12.1f %s (%+6.1f%%, noise %.1f) %s" % (
+            "REGRESS" if regressed else "ok", name, base["median"], cur["median"], cur["time_unit"],
+            100.0 * delta / base["median"], noise, format_counters(cur)))
+
+    if failed:
+        print("%d of %d benchmarks regressed by more than %.0f%%" % (failed, len(names), threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,1056 @@
+#ifndef MICROSTL_BTREE_H
+#define MICROSTL_BTREE_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../iterator/type_traits.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../algorithm/algobase.h"
+#include "../functor/functional.h"
+#include "../utility/pair.h"
+#include "vector.h"
+
+/**
+ * B+ 树，btree_map / btree_set 的底层实现，key 唯一：
+ *
+ * - 一个节点大约 NodeBytes 字节（默认 256，即 4 条 cache line），一次查找访问的节点数只有红黑树的 1/3 ~ 1/4，
+ *   每个元素也不再需要 3 个指针与颜色，内存占用接近元素本身的大小
+ * - 元素只存放在叶子中，叶子之间双向链接，范围遍历沿叶子顺序访问连续内存；
+ *   内部节点只存放分隔 key 与子节点指针，keys[i] 不大于 children[i + 1] 中的所有元素，且大于 children[i] 中的所有元素
+ * - 节点内查找：算术类型的 key 配合默认比较器时，直接统计小于 key 的元素个数，没有分支，编译器可以向量化；
+ *   其他类型使用无分支的二分查找
+ * - 在最右侧叶子的末尾追加时，分裂后旧节点保持全满，新节点只放新元素，顺序插入时节点的填充率接近 100%
+ * - 从已排序的区间构造时逐层直接建树，O(n)
+ * - 插入和删除会移动同一节点中的其他元素，之前的迭代器、指针、引用都可能失效
+ */
+
+namespace MicroSTL {
+
+    static const size_t BTREE_NODE_BYTES = 256;
+
+    // --------------------- 节点 --------------------------
+
+    struct _btree_node_base {
+        _btree_node_base *parent;
+        // 在父节点 children 中的下标
+        unsigned short position;
+        // 叶子为元素个数，内部节点为 key 的个数（子节点个数为 count + 1）
+        unsigned short count;
+        bool leaf;
+    };
+
+    template<typename Value, size_t Capacity>
+    struct _btree_leaf : public _btree_node_base {
+        _btree_leaf *prev;
+        _btree_leaf *next;
+        alignas(Value) unsigned char storage[sizeof(Value) * Capacity];
+
+        Value *values() {
+            return reinterpret_cast<Value *>(storage);
+        }
+    };
+
+    template<typename Key, size_t Capacity>
+    struct _btree_internal : public _btree_node_base {
+        _btree_node_base *children[Capacity + 1];
+        alignas(Key) unsigned char storage[sizeof(Key) * Capacity];
+
+        Key *keys() {
+            return reinterpret_cast<Key *>(storage);
+        }
+    };
+
+    /**
+     * 节点扣除头部后能容纳的元素个数，至少为 4，且不超过 count 能表示的范围
+     */
+    constexpr size_t _btree_capacity(size_t node_bytes, size_t header_bytes, size_t element_bytes) {
+        size_t capacity = node_bytes > header_bytes ? (node_bytes - header_bytes) / element_bytes : 0;
+        return capacity < 4 ? 4 : (capacity > 4096 ? 4096 : capacity);
+    }
+
+    // --------------------- 节点内查找 --------------------------
+
+    /**
+     * 只有算术类型配合默认比较器、且节点不太大时，才逐个比较并累加比较结果
+     */
+    template<typename Key, typename Compare, bool Small>
+    struct _btree_linear_search {
+        using type = false_type;
+    };
+
+    template<typename Key>
+    struct _btree_linear_search<Key, less<Key>, true> {
+        using type = typename arithmetic_traits<Key>::is_arithmetic;
+    };
+
+    template<typename Key>
+    struct _btree_linear_search<Key, greater<Key>, true> {
+        using type = typename arithmetic_traits<Key>::is_arithmetic;
+    };
+
+    /**
+     * 返回第一个 pred 为 false 的下标，要求 pred 在 [0, count) 上先真后假
+     */
+    template<typename Predicate>
+    inline size_t _btree_partition_point(size_t count, Predicate pred, true_type) {
+        size_t result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            result += pred(i);
+        }
+        return result;
+    }
+
+    template<typename Predicate>
+    inline size_t _btree_partition_point(size_t count, Predicate pred, false_type) {
+        return _branchless_partition_point(count, pred);
+    }
+
+    // --------------------- 迭代器 --------------------------
+
+    template<typename Value, typename Leaf, typename Reference, typename Pointer>
+    struct _btree_iterator {
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = Value;
+        using difference_type = ptrdiff_t;
+        using reference = Reference;
+        using pointer = Pointer;
+        using iterator = _btree_iterator<Value, Leaf, Value &, Value *>;
+
+        Leaf *leaf;
+        size_t position;
+
+        _btree_iterator() : leaf(nullptr), position(0) {}
+
+        _btree_iterator(Leaf *leaf, size_t position) : leaf(leaf), position(position) {}
+
+        _btree_iterator(const iterator &obj) : leaf(obj.leaf), position(obj.position) {}
+
+        reference operator*() const {
+            return leaf->values()[position];
+        }
+
+        pointer operator->() const {
+            return &(operator*());
+        }
+
+        /**
+         * end() 为最右侧叶子的 (leaf, count)
+         */
+        _btree_iterator &operator++() {
+            if (++position == leaf->count && leaf->next != nullptr) {
+                leaf = leaf->next;
+                position = 0;
+            }
+            return *this;
+        }
+
+        _btree_iterator operator++(int) {
+            _btree_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        _btree_iterator &operator--() {
+            if (position == 0) {
+                leaf = leaf->prev;
+                position = leaf->count;
+            }
+            --position;
+            return *this;
+        }
+
+        _btree_iterator operator--(int) {
+            _btree_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const _btree_iterator &obj) const {
+            return leaf == obj.leaf && position == obj.position;
+        }
+
+        bool operator!=(const _btree_iterator &obj) const {
+            return !(*this == obj);
+        }
+    };
+
+    // --------------------- btree --------------------------
+
+    template<typename Key, typename Value, typename KeyOfValue, typename Compare,
+            size_t NodeBytes = BTREE_NODE_BYTES>
+    class btree {
+    public:
+        static constexpr size_t LEAF_CAPACITY =
+                _btree_capacity(NodeBytes, sizeof(_btree_node_base) + 2 * sizeof(void *), sizeof(Value));
+        static constexpr size_t INTERNAL_CAPACITY =
+                _btree_capacity(NodeBytes, sizeof(_btree_node_base) + sizeof(void *), sizeof(Key) + sizeof(void *));
+        // 低于此数量时与兄弟节点合并或从兄弟节点借一个
+        static constexpr size_t LEAF_MIN = LEAF_CAPACITY / 2;
+        static constexpr size_t INTERNAL_MIN = INTERNAL_CAPACITY / 2;
+
+        using key_type = Key;
+        using value_type = Value;
+        using key_compare = Compare;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+    protected:
+        using base_ptr = _btree_node_base *;
+        using leaf_type = _btree_leaf<Value, LEAF_CAPACITY>;
+        using internal_type = _btree_internal<Key, INTERNAL_CAPACITY>;
+        using leaf_search = typename _btree_linear_search<Key, Compare, LEAF_CAPACITY <= 64>::type;
+        using internal_search = typename _btree_linear_search<Key, Compare, INTERNAL_CAPACITY <= 64>::type;
+
+    public:
+        using iterator = _btree_iterator<Value, leaf_type, Value &, Value *>;
+        using const_iterator = _btree_iterator<Value, leaf_type, const Value &, const Value *>;
+
+    protected:
+        base_ptr root;
+        leaf_type *leftmost;
+        leaf_type *rightmost;
+        size_type element_count;
+        size_type leaf_count;
+        size_type internal_count;
+        Compare comp;
+
+        static const Key &key(const Value &value) {
+            return KeyOfValue()(value);
+        }
+
+        static leaf_type *as_leaf(base_ptr node) {
+            return static_cast<leaf_type *>(node);
+        }
+
+        static internal_type *as_internal(base_ptr node) {
+            return static_cast<internal_type *>(node);
+        }
+
+        // --------------------- 节点的分配与释放 --------------------------
+
+        leaf_type *create_leaf() {
+            leaf_type *node = Alloc<leaf_type>::allocate();
+            node->parent = nullptr;
+            node->position = 0;
+            node->count = 0;
+            node->leaf = true;
+            node->prev = nullptr;
+            node->next = nullptr;
+            ++leaf_count;
+            return node;
+        }
+
+        internal_type *create_internal() {
+            internal_type *node = Alloc<internal_type>::allocate();
+            node->parent = nullptr;
+            node->position = 0;
+            node->count = 0;
+            node->leaf = false;
+            ++internal_count;
+            return node;
+        }
+
+        void free_node(base_ptr node) {
+            if (node->leaf) {
+                Alloc<leaf_type>::deallocate(as_leaf(node));
+                --leaf_count;
+            } else {
+                Alloc<internal_type>::deallocate(as_internal(node));
+                --internal_count;
+            }
+        }
+
+        /**
+         * 析构子树中的所有元素与 key，并释放节点
+         */
+        void destroy_subtree(base_ptr node) {
+            if (node->leaf) {
+                MicroSTL::destroy(as_leaf(node)->values(), as_leaf(node)->values() + node->count);
+            } else {
+                internal_type *internal = as_internal(node);
+                for (size_t i = 0; i <= internal->count; ++i) {
+                    destroy_subtree(internal->children[i]);
+                }
+                MicroSTL::destroy(internal->keys(), internal->keys() + internal->count);
+            }
+            free_node(node);
+        }
+
+        static void set_child(internal_type *node, size_t i, base_ptr child) {
+            node->children[i] = child;
+            child->parent = node;
+            child->position = static_cast<unsigned short>(i);
+        }
+
+        /**
+         * 把 src 处的对象移动到未初始化的 dst，并析构 src
+         */
+        template<typename T>
+        static void relocate(T *dst, T *src) {
+            new(dst) T(std::move(*src));
+            MicroSTL::destroy(src);
+        }
+
+        /**
+         * 把 [first, first + n) 整体后移 shift 个位置，目标区域的尾部必须未初始化
+         */
+        template<typename T>
+        static void shift_right(T *first, size_t n, size_t shift) {
+            for (size_t i = n; i > 0; --i) {
+                relocate(first + i - 1 + shift, first + i - 1);
+            }
+        }
+
+        template<typename T>
+        static void shift_left(T *first, size_t n, size_t shift) {
+            for (size_t i = 0; i < n; ++i) {
+                relocate(first + i - shift, first + i);
+            }
+        }
+
+        static void shift_children_right(internal_type *node, size_t from, size_t to_end) {
+            for (size_t i = to_end; i > from; --i) {
+                set_child(node, i, node->children[i - 1]);
+            }
+        }
+
+        static void shift_children_left(internal_type *node, size_t from, size_t end) {
+            for (size_t i = from; i < end; ++i) {
+                set_child(node, i - 1, node->children[i]);
+            }
+        }
+
+        // --------------------- 查找 --------------------------
+
+        /**
+         * 叶子中第一个不小于 k 的位置
+         */
+        size_t leaf_lower_bound(leaf_type *node, const Key &k) const {
+            const Value *values = node->values();
+            return _btree_partition_point(node->count, [&](size_t i) {
+                return comp(key(values[i]), k);
+            }, leaf_search());
+        }
+
+        size_t leaf_upper_bound(leaf_type *node, const Key &k) const {
+            const Value *values = node->values();
+            return _btree_partition_point(node->count, [&](size_t i) {
+                return !comp(k, key(values[i]));
+            }, leaf_search());
+        }
+
+        /**
+         * 从根下降到可能包含 k 的叶子，每层选择第一个大于 k 的分隔 key 左侧的子节点
+         */
+        leaf_type *find_leaf(const Key &k) const {
+            base_ptr node = root;
+            while (!node->leaf) {
+                internal_type *internal = as_internal(node);
+                const Key *keys = internal->keys();
+                size_t i = _btree_partition_point(internal->count, [&](size_t j) {
+                    return !comp(k, keys[j]);
+                }, internal_search());
+                node = internal->children[i];
+            }
+            return as_leaf(node);
+        }
+
+        /**
+         * 位于叶子末尾的位置规范化为下一个叶子的开头，最右侧叶子的末尾即 end()
+         */
+        iterator normalize(leaf_type *node, size_t position) const {
+            if (position == node->count && node->next != nullptr) {
+                return iterator(node->next, 0);
+            }
+            return iterator(node, position);
+        }
+
+        // --------------------- 插入 --------------------------
+
+        /**
+         * 分裂已满的内部节点 node，把 separator 与 right 放在原先第 i 个子节点之后，返回需要上移的 key
+         */
+        Key split_internal(internal_type *node, internal_type *sibling, size_t i, Key &separator, base_ptr right,
+                           bool append) {
+            if (append && i == node->count) {
+                // 左节点保留 count - 1 个 key，最后一个 key 上移，右节点只有新的分隔 key
+                size_t last = node->count - 1;
+                Key middle(std::move(node->keys()[last]));
+                MicroSTL::destroy(node->keys() + last);
+                new(sibling->keys()) Key(std::move(separator));
+                sibling->count = 1;
+                set_child(sibling, 0, node->children[node->count]);
+                set_child(sibling, 1, right);
+                node->count = static_cast<unsigned short>(last);
+                return middle;
+            }
+
+            // 先对半分裂，keys[mid] 上移，再把新的 key 放入对应的一半
+            size_t mid = node->count / 2;
+            size_t moved = node->count - mid - 1;
+            for (size_t j = 0; j < moved; ++j) {
+                relocate(sibling->keys() + j, node->keys() + mid + 1 + j);
+            }
+            for (size_t j = 0; j <= moved; ++j) {
+                set_child(sibling, j, node->children[mid + 1 + j]);
+            }
+            Key middle(std::move(node->keys()[mid]));
+            MicroSTL::destroy(node->keys() + mid);
+            node->count = static_cast<unsigned short>(mid);
+            sibling->count = static_cast<unsigned short>(moved);
+
+            internal_type *target = i <= mid ? node : sibling;
+            size_t index = i <= mid ? i : i - mid - 1;
+            shift_right(target->keys() + index, target->count - index, 1);
+            new(target->keys() + index) Key(std::move(separator));
+            shift_children_right(target, index + 1, target->count + 1);
+            set_child(target, index + 1, right);
+            ++target->count;
+            return middle;
+        }
+
+        /**
+         * 在 left 与 right 之间加入分隔 key，left 原本已经在树中，right 是由 left 分裂出的右半部分。
+         * append 表示是在整棵树的最右侧追加，此时分裂后的左节点保持全满
+         */
+        void insert_into_parent(base_ptr left, Key separator, base_ptr right, bool append) {
+            if (left == root) {
+                internal_type *node = create_internal();
+                new(node->keys()) Key(std::move(separator));
+                node->count = 1;
+                set_child(node, 0, left);
+                set_child(node, 1, right);
+                root = node;
+                return;
+            }
+
+            internal_type *node = as_internal(left->parent);
+            size_t i = left->position;
+            if (node->count < INTERNAL_CAPACITY) {
+                shift_right(node->keys() + i, node->count - i, 1);
+                new(node->keys() + i) Key(std::move(separator));
+                shift_children_right(node, i + 1, node->count + 1);
+                set_child(node, i + 1, right);
+                ++node->count;
+                return;
+            }
+
+            internal_type *sibling = create_internal();
+            Key middle = split_internal(node, sibling, i, separator, right, append);
+            insert_into_parent(node, std::move(middle), sibling, append);
+        }
+
+        /**
+         * 在叶子的 position 处放入 value，叶子已满时先分裂
+         */
+        template<typename V>
+        iterator insert_at(leaf_type *node, size_t position, V &&value) {
+            if (node->count < LEAF_CAPACITY) {
+                shift_right(node->values() + position, node->count - position, 1);
+                new(node->values() + position) Value(std::forward<V>(value));
+                ++node->count;
+                ++element_count;
+                return iterator(node, position);
+            }
+
+            bool append = position == node->count && node->next == nullptr;
+            size_t keep = append ? node->count : node->count / 2;
+            leaf_type *sibling = create_leaf();
+            for (size_t j = keep; j < node->count; ++j) {
+                relocate(sibling->values() + (j - keep), node->values() + j);
+            }
+            sibling->count = static_cast<unsigned short>(node->count - keep);
+            node->count = static_cast<unsigned short>(keep);
+
+            sibling->prev = node;
+            sibling->next = node->next;
+            if (node->next != nullptr) {
+                node->next->prev = sibling;
+            } else {
+                rightmost = sibling;
+            }
+            node->next = sibling;
+
+            leaf_type *target = position <= keep && !append ? node : sibling;
+            size_t index = target == node ? position : position - keep;
+            shift_right(target->values() + index, target->count - index, 1);
+            new(target->values() + index) Value(std::forward<V>(value));
+            ++target->count;
+            ++element_count;
+
+            insert_into_parent(node, key(sibling->values()[0]), sibling, append);
+            return iterator(target, index);
+        }
+
+        template<typename V>
+        pair<iterator, bool> insert_value(V &&value) {
+            const Key &k = key(value);
+            if (root == nullptr) {
+                leftmost = rightmost = create_leaf();
+                root = leftmost;
+            }
+            leaf_type *node = find_leaf(k);
+            size_t position = leaf_lower_bound(node, k);
+            if (position < node->count && !comp(k, key(node->values()[position]))) {
+                return pair<iterator, bool>(iterator(node, position), false);
+            }
+            return pair<iterator, bool>(insert_at(node, position, std::forward<V>(value)), true);
+        }
+
+        /**
+         * 提示为 end() 且新元素大于所有元素时直接追加到最右侧叶子，不需要从根下降
+         */
+        template<typename V>
+        iterator insert_value(const_iterator hint, V &&value) {
+            if (hint == end() && element_count > 0 &&
+                comp(key(rightmost->values()[rightmost->count - 1]), key(value))) {
+                return insert_at(rightmost, rightmost->count, std::forward<V>(value));
+            }
+            return insert_value(std::forward<V>(value)).first;
+        }
+
+        // --------------------- 删除 --------------------------
+
+        void remove_from_parent(internal_type *parent, size_t key_index) {
+            MicroSTL::destroy(parent->keys() + key_index);
+            shift_left(parent->keys() + key_index + 1, parent->count - key_index - 1, 1);
+            shift_children_left(parent, key_index + 2, parent->count + 1);
+            --parent->count;
+        }
+
+        /**
+         * 元素数低于下限的叶子：能与兄弟合并就合并，否则从兄弟借一个元素
+         */
+        void rebalance_leaf(leaf_type *node) {
+            internal_type *parent = as_internal(node->parent);
+            size_t i = node->position;
+            if (i > 0) {
+                leaf_type *left = as_leaf(parent->children[i - 1]);
+                if (left->count + node->count <= LEAF_CAPACITY) {
+                    merge_leaf(left, node, i - 1);
+                } else {
+                    shift_right(node->values(), node->count, 1);
+                    relocate(node->values(), left->values() + left->count - 1);
+                    --left->count;
+                    ++node->count;
+                    parent->keys()[i - 1] = key(node->values()[0]);
+                }
+            } else {
+                leaf_type *right = as_leaf(parent->children[1]);
+                if (node->count + right->count <= LEAF_CAPACITY) {
+                    merge_leaf(node, right, 0);
+                } else {
+                    relocate(node->values() + node->count, right->values());
+                    shift_left(right->values() + 1, right->count - 1, 1);
+                    ++node->count;
+                    --right->count;
+                    parent->keys()[0] = key(right->values()[0]);
+                }
+            }
+        }
+
+        /**
+         * 把 right 合并到 left，key_index 为两者之间的分隔 key
+         */
+        void merge_leaf(leaf_type *left, leaf_type *right, size_t key_index) {
+            for (size_t j = 0; j < right->count; ++j) {
+                relocate(left->values() + left->count + j, right->values() + j);
+            }
+            left->count = static_cast<unsigned short>(left->count + right->count);
+            left->next = right->next;
+            if (right->next != nullptr) {
+                right->next->prev = left;
+            } else {
+                rightmost = left;
+            }
+            internal_type *parent = as_internal(left->parent);
+            free_node(right);
+            remove_from_parent(parent, key_index);
+            rebalance_internal(parent);
+        }
+
+        void rebalance_internal(internal_type *node) {
+            if (node == root) {
+                if (node->count == 0) {
+                    root = node->children[0];
+                    root->parent = nullptr;
+                    root->position = 0;
+                    free_node(node);
+                }
+                return;
+            }
+            if (node->count >= INTERNAL_MIN) {
+                return;
+            }
+
+            internal_type *parent = as_internal(node->parent);
+            size_t i = node->position;
+            if (i > 0) {
+                internal_type *left = as_internal(parent->children[i - 1]);
+                // count 是 unsigned short，相加会提升为 int，先转换为 size_t 再与容量比较
+                size_t merged = static_cast<size_t>(left->count) + node->count + 1;
+                if (merged <= INTERNAL_CAPACITY) {
+                    merge_internal(left, node, i - 1);
+                } else {
+                    // 父节点的分隔 key 下移到 node 开头，left 的最后一个 key 上移
+                    shift_right(node->keys(), node->count, 1);
+                    relocate(node->keys(), parent->keys() + i - 1);
+                    shift_children_right(node, 0, node->count + 1);
+                    set_child(node, 0, left->children[left->count]);
+                    relocate(parent->keys() + i - 1, left->keys() + left->count - 1);
+                    --left->count;
+                    ++node->count;
+                }
+            } else {
+                internal_type *right = as_internal(parent->children[1]);
+                size_t merged = static_cast<size_t>(node->count) + right->count + 1;
+                if (merged <= INTERNAL_CAPACITY) {
+                    merge_internal(node, right, 0);
+                } else {
+                    relocate(node->keys() + node->count, parent->keys());
+                    set_child(node, node->count + 1, right->children[0]);
+                    relocate(parent->keys(), right->keys());
+                    shift_left(right->keys() + 1, right->count - 1, 1);
+                    shift_children_left(right, 1, right->count + 1);
+                    ++node->count;
+                    --right->count;
+                }
+            }
+        }
+
+        void merge_internal(internal_type *left, internal_type *right, size_t key_index) {
+            internal_type *parent = as_internal(left->parent);
+            size_t base = left->count;
+            new(left->keys() + base) Key(std::move(parent->keys()[key_index]));
+            for (size_t j = 0; j < right->count; ++j) {
+                relocate(left->keys() + base + 1 + j, right->keys() + j);
+            }
+            for (size_t j = 0; j <= right->count; ++j) {
+                set_child(left, base + 1 + j, right->children[j]);
+            }
+            left->count = static_cast<unsigned short>(base + 1 + right->count);
+            free_node(right);
+            remove_from_parent(parent, key_index);
+            rebalance_internal(parent);
+        }
+
+        // --------------------- 批量建树 --------------------------
+
+        /**
+         * 要求当前为空树且 [first, last) 严格递增：叶子依次填满，再逐层向上建立内部节点
+         */
+        template<typename ForwardIterator>
+        void build_from_sorted(ForwardIterator first, ForwardIterator last) {
+            if (first == last) {
+                return;
+            }
+            vector<base_ptr> level;
+            // 每个节点子树中最小的 key，即上一层的分隔 key
+            vector<const Key *> lows;
+            leaf_type *previous = nullptr;
+            try {
+                while (first != last) {
+                    leaf_type *node = create_leaf();
+                    node->prev = previous;
+                    if (previous != nullptr) {
+                        previous->next = node;
+                    } else {
+                        leftmost = node;
+                    }
+                    previous = node;
+                    level.push_back(node);
+                    for (; first != last && node->count < LEAF_CAPACITY; ++first) {
+                        new(node->values() + node->count) Value(*first);
+                        ++node->count;
+                    }
+                    lows.push_back(&key(node->values()[0]));
+                    element_count += node->count;
+                }
+            } catch (...) {
+                for (size_t i = 0; i < level.size(); ++i) {
+                    destroy_subtree(level[i]);
+                }
+                leftmost = nullptr;
+                element_count = 0;
+                throw;
+            }
+            rightmost = previous;
+
+            while (level.size() > 1) {
+                vector<base_ptr> upper;
+                vector<const Key *> upper_lows;
+                size_t fanout = INTERNAL_CAPACITY + 1;
+                size_t consumed = 0;
+                try {
+                    while (consumed < level.size()) {
+                        size_t group = level.size() - consumed;
+                        if (group > fanout) {
+                            // 最后一组至少保留两个子节点
+                            group = group - fanout < 2 ? group - 2 : fanout;
+                        }
+                        internal_type *node = create_internal();
+                        upper.push_back(node);
+                        upper_lows.push_back(lows[consumed]);
+                        set_child(node, 0, level[consumed++]);
+                        for (size_t j = 1; j < group; ++j) {
+                            new(node->keys() + node->count) Key(*lows[consumed]);
+                            ++node->count;
+                            set_child(node, node->count, level[consumed++]);
+                        }
+                    }
+                } catch (...) {
+                    for (size_t i = 0; i < upper.size(); ++i) {
+                        destroy_subtree(upper[i]);
+                    }
+                    for (size_t i = consumed; i < level.size(); ++i) {
+                        destroy_subtree(level[i]);
+                    }
+                    leftmost = rightmost = nullptr;
+                    element_count = 0;
+                    throw;
+                }
+                level.swap(upper);
+                lows.swap(upper_lows);
+            }
+            root = level[0];
+        }
+
+        template<typename ForwardIterator>
+        bool strictly_sorted(ForwardIterator first, ForwardIterator last) const {
+            if (first == last) {
+                return true;
+            }
+            ForwardIterator next = first;
+            for (++next; next != last; ++first, ++next) {
+                // 区间元素类型与 value_type 不同时绑定到转换后的临时对象上
+                const value_type &a = *first;
+                const value_type &b = *next;
+                if (!comp(key(a), key(b))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename InputIterator>
+        void insert_range(InputIterator first, InputIterator last, input_iterator_tag) {
+            for (; first != last; ++first) {
+                insert_value(end(), *first);
+            }
+        }
+
+        template<typename ForwardIterator>
+        void insert_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            if (empty() && strictly_sorted(first, last)) {
+                build_from_sorted(first, last);
+            } else {
+                insert_range(first, last, input_iterator_tag());
+            }
+        }
+
+    public:
+        btree() : root(nullptr), leftmost(nullptr), rightmost(nullptr), element_count(0), leaf_count(0),
+                  internal_count(0), comp() {}
+
+        explicit btree(const Compare &comp) : root(nullptr), leftmost(nullptr), rightmost(nullptr),
+                                              element_count(0), leaf_count(0), internal_count(0), comp(comp) {}
+
+        /**
+         * 源树已经有序，直接按批量建树的方式复制，O(n)
+         */
+        btree(const btree &obj) : btree(obj.comp) {
+            build_from_sorted(obj.begin(), obj.end());
+        }
+
+        btree(btree &&obj) noexcept: btree(obj.comp) {
+            swap(obj);
+        }
+
+        ~btree() {
+            clear();
+        }
+
+        btree &operator=(const btree &obj) {
+            if (this != &obj) {
+                btree temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        btree &operator=(btree &&obj) noexcept {
+            if (this != &obj) {
+                btree temp(std::move(obj));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        void swap(btree &obj) {
+            MicroSTL::swap(root, obj.root);
+            MicroSTL::swap(leftmost, obj.leftmost);
+            MicroSTL::swap(rightmost, obj.rightmost);
+            MicroSTL::swap(element_count, obj.element_count);
+            MicroSTL::swap(leaf_count, obj.leaf_count);
+            MicroSTL::swap(internal_count, obj.internal_count);
+            MicroSTL::swap(comp, obj.comp);
+        }
+
+        key_compare key_comp() const {
+            return comp;
+        }
+
+        iterator begin() {
+            return iterator(leftmost, 0);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(leftmost, 0);
+        }
+
+        iterator end() {
+            return iterator(rightmost, rightmost == nullptr ? 0 : rightmost->count);
+        }
+
+        const_iterator end() const {
+            return const_iterator(rightmost, rightmost == nullptr ? 0 : rightmost->count);
+        }
+
+        bool empty() const {
+            return element_count == 0;
+        }
+
+        size_type size() const {
+            return element_count;
+        }
+
+        /**
+         * 所有节点占用的字节数，不包括 btree 对象本身
+         */
+        size_type memory_usage() const {
+            return leaf_count * sizeof(leaf_type) + internal_count * sizeof(internal_type);
+        }
+
+        size_type height() const {
+            size_type result = 0;
+            for (base_ptr node = root; node != nullptr; ++result) {
+                node = node->leaf ? nullptr : as_internal(node)->children[0];
+            }
+            return result;
+        }
+
+        // --------------------- 插入 --------------------------
+
+        pair<iterator, bool> insert_unique(const value_type &value) {
+            return insert_value(value);
+        }
+
+        pair<iterator, bool> insert_unique(value_type &&value) {
+            return insert_value(std::move(value));
+        }
+
+        iterator insert_unique(const_iterator hint, const value_type &value) {
+            return insert_value(hint, value);
+        }
+
+        /**
+         * 元素在节点之间移动时需要移动构造，这里先构造出完整的元素再放入树中
+         */
+        template<typename... Args>
+        pair<iterator, bool> emplace_unique(Args &&... args) {
+            value_type value(std::forward<Args>(args)...);
+            return insert_value(std::move(value));
+        }
+
+        template<typename... Args>
+        iterator emplace_hint_unique(const_iterator hint, Args &&... args) {
+            value_type value(std::forward<Args>(args)...);
+            return insert_value(hint, std::move(value));
+        }
+
+        /**
+         * 空树且区间严格递增时 O(n) 建树，否则逐个以 end() 为提示插入
+         */
+        template<typename InputIterator>
+        void insert_unique(InputIterator first, InputIterator last) {
+            insert_range(first, last, iterator_category(first));
+        }
+
+        // --------------------- 删除 --------------------------
+
+        void erase(const_iterator position) {
+            leaf_type *node = position.leaf;
+            MicroSTL::destroy(node->values() + position.position);
+            shift_left(node->values() + position.position + 1, node->count - position.position - 1, 1);
+            --node->count;
+            --element_count;
+            if (node == root) {
+                if (node->count == 0) {
+                    free_node(node);
+                    root = leftmost = rightmost = nullptr;
+                }
+                return;
+            }
+            if (node->count < LEAF_MIN) {
+                rebalance_leaf(node);
+            }
+        }
+
+        size_type erase(const key_type &k) {
+            iterator iter = find(k);
+            if (iter == end()) {
+                return 0;
+            }
+            erase(iter);
+            return 1;
+        }
+
+        void clear() {
+            if (root != nullptr) {
+                destroy_subtree(root);
+            }
+            root = leftmost = rightmost = nullptr;
+            element_count = 0;
+        }
+
+        // --------------------- 查找 --------------------------
+
+        iterator lower_bound(const key_type &k) {
+            if (root == nullptr) {
+                return end();
+            }
+            leaf_type *node = find_leaf(k);
+            return normalize(node, leaf_lower_bound(node, k));
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return const_cast<btree *>(this)->lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type &k) {
+            if (root == nullptr) {
+                return end();
+            }
+            leaf_type *node = find_leaf(k);
+            return normalize(node, leaf_upper_bound(node, k));
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return const_cast<btree *>(this)->upper_bound(k);
+        }
+
+        iterator find(const key_type &k) {
+            if (root == nullptr) {
+                return end();
+            }
+            leaf_type *node = find_leaf(k);
+            size_t position = leaf_lower_bound(node, k);
+            if (position == node->count || comp(k, key(node->values()[position]))) {
+                return end();
+            }
+            return iterator(node, position);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return const_cast<btree *>(this)->find(k);
+        }
+
+        pair<iterator, iterator> equal_range(const key_type &k) {
+            return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        size_type count(const key_type &k) const {
+            return find(k) == end() ? 0 : 1;
+        }
+
+        /**
+         * 检查 B+ 树的结构：叶子深度相同，父子链接正确，非根节点不为空，
+         * 分隔 key 正确划分子树，叶子链表完整有序，计数正确
+         */
+        bool verify() const {
+            if (root == nullptr) {
+                return element_count == 0 && leftmost == nullptr && rightmost == nullptr;
+            }
+            if (root->parent != nullptr) {
+                return false;
+            }
+            size_t leaf_depth = 0;
+            size_t leaves = 0;
+            size_t internals = 0;
+            if (!verify_subtree(root, 0, leaf_depth, leaves, internals, nullptr, nullptr)) {
+                return false;
+            }
+            if (leaves != leaf_count || internals != internal_count) {
+                return false;
+            }
+            size_t counted = 0;
+            leaf_type *previous = nullptr;
+            for (leaf_type *node = leftmost; node != nullptr; node = node->next) {
+                if (node->prev != previous) {
+                    return false;
+                }
+                if (previous != nullptr && !comp(key(previous->values()[previous->count - 1]), key(node->values()[0]))) {
+                    return false;
+                }
+                counted += node->count;
+                previous = node;
+            }
+            return previous == rightmost && counted == element_count;
+        }
+
+    private:
+        /**
+         * low / high 为子树的下界（包含）与上界（不包含），nullptr 表示无界
+         */
+        bool verify_subtree(base_ptr node, size_t depth, size_t &leaf_depth, size_t &leaves, size_t &internals,
+                            const Key *low, const Key *high) const {
+            if (node != root && node->count == 0) {
+                return false;
+            }
+            if (node->leaf) {
+                ++leaves;
+                if (leaf_depth == 0) {
+                    leaf_depth = depth + 1;
+                } else if (leaf_depth != depth + 1) {
+                    return false;
+                }
+                leaf_type *leaf = as_leaf(node);
+                for (size_t i = 0; i < leaf->count; ++i) {
+                    const Key &k = key(leaf->values()[i]);
+                    if ((i > 0 && !comp(key(leaf->values()[i - 1]), k)) ||
+                        (low != nullptr && comp(k, *low)) || (high != nullptr && !comp(k, *high))) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            ++internals;
+            internal_type *internal = as_internal(node);
+            for (size_t i = 0; i <= internal->count; ++i) {
+                base_ptr child = internal->children[i];
+                if (child->parent != node || child->position != i) {
+                    return false;
+                }
+                const Key *child_low = i == 0 ? low : internal->keys() + i - 1;
+                const Key *child_high = i == internal->count ? high : internal->keys() + i;
+                if (!verify_subtree(child, depth + 1, leaf_depth, leaves, internals, child_low, child_high)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
+
+#endif //MICROSTL_BTREE_H
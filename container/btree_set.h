@@ -0,0 +1,147 @@
+#ifndef MICROSTL_BTREE_SET_H
+#define MICROSTL_BTREE_SET_H
+
+#include <utility>
+#include "btree.h"
+
+/**
+ * 基于 B+ 树的有序集合，元素唯一且只读：
+ *
+ * - 接口与 set 一致，适合元素数量很大、查找与范围遍历为主的索引
+ * - 插入、删除会使所有迭代器、指针、引用失效
+ * - NodeBytes 为节点的目标大小，key 较大时可以调大以保持足够的分叉数
+ */
+
+namespace MicroSTL {
+
+    // --------------------- btree_set --------------------------
+
+    template<typename Key, typename Compare = less<Key>, size_t NodeBytes = BTREE_NODE_BYTES>
+    class btree_set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using tree_type = btree<Key, value_type, identity<value_type>, Compare, NodeBytes>;
+        tree_type tree;
+
+    public:
+        // 元素即 key，不允许通过迭代器修改
+        using iterator = typename tree_type::const_iterator;
+        using const_iterator = typename tree_type::const_iterator;
+
+        btree_set() : tree() {}
+
+        explicit btree_set(const Compare &comp) : tree(comp) {}
+
+        /**
+         * 区间按 key 严格递增时 O(n) 建树
+         */
+        template<typename InputIterator>
+        btree_set(InputIterator first, InputIterator last) : tree() {
+            tree.insert_unique(first, last);
+        }
+
+        const_iterator begin() const {
+            return tree.begin();
+        }
+
+        const_iterator end() const {
+            return tree.end();
+        }
+
+        bool empty() const {
+            return tree.empty();
+        }
+
+        size_type size() const {
+            return tree.size();
+        }
+
+        key_compare key_comp() const {
+            return tree.key_comp();
+        }
+
+        /**
+         * 所有节点占用的字节数
+         */
+        size_type memory_usage() const {
+            return tree.memory_usage();
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            return tree.insert_unique(value);
+        }
+
+        /**
+         * 提示为 end() 且新元素大于所有元素时直接追加，不需要从根下降
+         */
+        iterator insert(const_iterator hint, const value_type &value) {
+            return tree.insert_unique(hint, value);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            tree.insert_unique(first, last);
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            return tree.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const_iterator hint, Args &&... args) {
+            return tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
+        }
+
+        void erase(const_iterator position) {
+            tree.erase(position);
+        }
+
+        size_type erase(const key_type &k) {
+            return tree.erase(k);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        void swap(btree_set &obj) {
+            tree.swap(obj.tree);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return tree.find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return tree.find(k) == end() ? 0 : 1;
+        }
+
+        bool contains(const key_type &k) const {
+            return tree.find(k) != end();
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return tree.lower_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return tree.upper_bound(k);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return tree.equal_range(k);
+        }
+    };
+
+}
+
+#endif //MICROSTL_BTREE_SET_H
@@ -0,0 +1,554 @@
+#ifndef MICROSTL_CONCURRENT_UNORDERED_MAP_H
+#define MICROSTL_CONCURRENT_UNORDERED_MAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <utility>
+#include "../memory/alloc.h"
+#include "../memory/epoch.h"
+#include "../functor/functional.h"
+#include "../functor/hash.h"
+#include "../utility/pair.h"
+
+/**
+ * 支持多线程同时读写的哈希表，适合共享缓存：
+ *
+ * - 拉链法，桶数组中每个桶是一条单链表；写操作按哈希值的低位对 CONCURRENT_MAP_STRIPES 把锁之一加锁（锁分段），
+ *   读操作不加锁，只在 epoch_guard 内沿链表查找
+ * - 节点一旦发布就不再修改：赋值与 update 先复制出新节点再替换，删除只摘下节点；
+ *   被替换或摘下的节点交给 epoch_retire，等所有可能读到它的线程离开后才释放
+ * - find 不返回引用，而是在 epoch_guard 内对找到的值调用 visitor，离开后不会留下悬空的引用
+ * - 扩容是渐进的，不会暂停所有线程：
+ *      - 负载因子超过 1 时新建两倍大小的桶数组，旧数组挂在新数组的 prev 上
+ *      - 之后每个写操作先搬迁自己所在的旧桶，再顺带搬迁 CONCURRENT_MAP_MIGRATE_STEP 个旧桶；
+ *        搬迁把节点复制到新数组后，把旧桶置为 moved 标记
+ *      - 读者在旧桶中读到 moved 标记时转到新数组中查找
+ *      - 桶数不小于锁的个数且都是 2 的幂，同一个 key 在新旧数组中的桶由同一把锁保护
+ * - 元素个数按锁分段统计，插入不会争抢同一个计数器
+ * - 节点与桶数组由 AllocByMalloc 分配：AllocByFreeList 没有加锁，不能在多个线程中同时使用
+ * - 析构时不能有其他线程在访问
+ */
+
+namespace MicroSTL {
+
+    static const size_t CONCURRENT_MAP_STRIPES = 64;
+    static const size_t CONCURRENT_MAP_MIGRATE_STEP = 16;
+
+    /**
+     * 与元素个数统计放在同一条 cache line 上的自旋锁
+     */
+    struct alignas(CACHE_LINE_SIZE) _concurrent_stripe {
+        std::atomic<bool> locked;
+        // 只在持有锁时修改，size() 不加锁读取
+        std::atomic<size_t> count;
+
+        _concurrent_stripe() : locked(false), count(0) {}
+
+        void lock() {
+            unsigned spins = 0;
+            while (locked.exchange(true, std::memory_order_acquire)) {
+                while (locked.load(std::memory_order_relaxed)) {
+                    if (++spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+                        __builtin_ia32_pause();
+#endif
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+        void unlock() {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    template<typename Value>
+    struct _concurrent_node {
+        std::atomic<_concurrent_node *> next;
+        size_t hash;
+        Value value;
+
+        template<typename... Args>
+        _concurrent_node(size_t hash, Args &&... args) : next(nullptr), hash(hash), value(std::forward<Args>(args)...) {}
+    };
+
+    template<typename Value>
+    struct _concurrent_table {
+        using node = _concurrent_node<Value>;
+
+        std::atomic<node *> *buckets;
+        size_t mask;
+        // 正在搬迁到本数组的旧数组
+        std::atomic<_concurrent_table *> prev;
+        // 本数组正在搬迁到的新数组，读者在桶中读到 moved 标记时沿它查找
+        std::atomic<_concurrent_table *> next;
+        // 旧数组中下一个待搬迁的桶
+        std::atomic<size_t> migrate_cursor;
+        // 旧数组中已经搬迁完的桶数
+        std::atomic<size_t> migrated;
+
+        static node *moved() {
+            return reinterpret_cast<node *>(static_cast<uintptr_t>(1));
+        }
+
+        static _concurrent_table *create(size_t bucket_count, _concurrent_table *prev) {
+            _concurrent_table *table = static_cast<_concurrent_table *>(
+                    AllocByMalloc::allocate(sizeof(_concurrent_table)));
+            table->buckets = static_cast<std::atomic<node *> *>(
+                    AllocByMalloc::allocate(bucket_count * sizeof(std::atomic<node *>)));
+            for (size_t i = 0; i < bucket_count; ++i) {
+                new(table->buckets + i) std::atomic<node *>(nullptr);
+            }
+            table->mask = bucket_count - 1;
+            new(&table->prev) std::atomic<_concurrent_table *>(prev);
+            new(&table->next) std::atomic<_concurrent_table *>(nullptr);
+            new(&table->migrate_cursor) std::atomic<size_t>(0);
+            new(&table->migrated) std::atomic<size_t>(0);
+            return table;
+        }
+
+        /**
+         * 只释放桶数组本身，节点由调用者处理
+         */
+        static void destroy(void *ptr) {
+            _concurrent_table *table = static_cast<_concurrent_table *>(ptr);
+            AllocByMalloc::deallocate(table->buckets, (table->mask + 1) * sizeof(std::atomic<node *>));
+            AllocByMalloc::deallocate(table, sizeof(_concurrent_table));
+        }
+
+        size_t bucket_count() const {
+            return mask + 1;
+        }
+    };
+
+    // --------------------- concurrent_unordered_map --------------------------
+
+    template<typename Key, typename T, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+    class concurrent_unordered_map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = pair<const Key, T>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using size_type = size_t;
+
+    protected:
+        using node = _concurrent_node<value_type>;
+        using table = _concurrent_table<value_type>;
+
+        std::atomic<table *> current;
+        // 同一时刻只允许一次扩容
+        std::atomic<bool> resizing;
+        _concurrent_stripe stripes[CONCURRENT_MAP_STRIPES];
+        Hash hash_fn;
+        KeyEqual equal_fn;
+
+        size_t hash_of(const key_type &k) const {
+            return _hash_mix(hash_fn(k));
+        }
+
+        _concurrent_stripe &stripe_of(size_t hash) {
+            return stripes[hash & (CONCURRENT_MAP_STRIPES - 1)];
+        }
+
+        template<typename... Args>
+        static node *create_node(size_t hash, Args &&... args) {
+            node *result = static_cast<node *>(AllocByMalloc::allocate(sizeof(node)));
+            try {
+                new(result) node(hash, std::forward<Args>(args)...);
+            } catch (...) {
+                AllocByMalloc::deallocate(result, sizeof(node));
+                throw;
+            }
+            return result;
+        }
+
+        static void destroy_node(void *ptr) {
+            node *target = static_cast<node *>(ptr);
+            target->~node();
+            AllocByMalloc::deallocate(target, sizeof(node));
+        }
+
+        static void retire_node(node *target) {
+            epoch_retire(target, &destroy_node);
+        }
+
+        /**
+         * 在持有锁的桶中查找，返回指向该节点的链接；找不到时返回链表末尾的空链接
+         */
+        std::atomic<node *> *find_link(std::atomic<node *> *link, size_t hash, const key_type &k) const {
+            for (node *current_node = link->load(std::memory_order_acquire); current_node;
+                 current_node = link->load(std::memory_order_acquire)) {
+                if (current_node->hash == hash && equal_fn(current_node->value.first, k)) {
+                    return link;
+                }
+                link = &current_node->next;
+            }
+            return link;
+        }
+
+        /**
+         * 读者使用，需要在 epoch_guard 内：从还没有搬迁完的最旧的数组开始，桶已经搬迁时沿 next 转到新数组，
+         * 即使读取期间开始了新的扩容也能找到 key 所在的链表
+         */
+        static table *oldest_table(table *newest) {
+            table *old = newest->prev.load(std::memory_order_acquire);
+            return old ? old : newest;
+        }
+
+        node *read_head(size_t hash) const {
+            table *target = oldest_table(current.load(std::memory_order_acquire));
+            node *head = target->buckets[hash & target->mask].load(std::memory_order_acquire);
+            while (head == table::moved()) {
+                target = target->next.load(std::memory_order_acquire);
+                head = target->buckets[hash & target->mask].load(std::memory_order_acquire);
+            }
+            return head;
+        }
+
+        node *read_find(size_t hash, const key_type &k) const {
+            node *current_node = read_head(hash);
+            for (; current_node; current_node = current_node->next.load(std::memory_order_acquire)) {
+                if (current_node->hash == hash && equal_fn(current_node->value.first, k)) {
+                    return current_node;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * 把旧数组的第 index 个桶复制到新数组，调用者持有该桶对应的锁
+         */
+        void migrate_bucket(table *old, table *newest, size_t index) {
+            std::atomic<node *> &bucket = old->buckets[index];
+            node *head = bucket.load(std::memory_order_acquire);
+            if (head == table::moved()) {
+                return;
+            }
+            for (node *current_node = head; current_node; current_node = current_node->next.load(std::memory_order_relaxed)) {
+                node *copy = create_node(current_node->hash, current_node->value);
+                std::atomic<node *> &target = newest->buckets[current_node->hash & newest->mask];
+                copy->next.store(target.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                target.store(copy, std::memory_order_release);
+            }
+            bucket.store(table::moved(), std::memory_order_release);
+            for (node *current_node = head; current_node;) {
+                node *next = current_node->next.load(std::memory_order_relaxed);
+                retire_node(current_node);
+                current_node = next;
+            }
+            if (old->migrated.fetch_add(1, std::memory_order_acq_rel) + 1 == old->bucket_count()) {
+                // 最后一个桶搬迁完成，旧数组交给 epoch 回收
+                newest->prev.store(nullptr, std::memory_order_release);
+                epoch_retire(old, &table::destroy);
+                resizing.store(false, std::memory_order_release);
+            }
+        }
+
+        /**
+         * 写操作开始前（不持有锁时）顺带搬迁一段旧桶
+         */
+        void help_migrate() {
+            table *newest = current.load(std::memory_order_acquire);
+            table *old = newest->prev.load(std::memory_order_acquire);
+            if (!old) {
+                return;
+            }
+            size_t begin = old->migrate_cursor.fetch_add(CONCURRENT_MAP_MIGRATE_STEP, std::memory_order_relaxed);
+            size_t end = begin + CONCURRENT_MAP_MIGRATE_STEP;
+            if (end > old->bucket_count()) {
+                end = old->bucket_count();
+            }
+            for (size_t index = begin; index < end; ++index) {
+                _concurrent_stripe &stripe = stripes[index & (CONCURRENT_MAP_STRIPES - 1)];
+                stripe.lock();
+                migrate_bucket(old, newest, index);
+                stripe.unlock();
+            }
+        }
+
+        /**
+         * 持有 stripe 锁时调用：保证 key 所在的旧桶已经搬迁，返回新数组中的桶
+         */
+        std::atomic<node *> *write_bucket(size_t hash) {
+            table *newest = current.load(std::memory_order_acquire);
+            table *old = newest->prev.load(std::memory_order_acquire);
+            if (old) {
+                migrate_bucket(old, newest, hash & old->mask);
+            }
+            return newest->buckets + (hash & newest->mask);
+        }
+
+        /**
+         * 某个分段的元素个数超过平均每段的桶数时开始扩容
+         */
+        void maybe_grow(size_t stripe_count) {
+            table *newest = current.load(std::memory_order_acquire);
+            if (stripe_count <= newest->bucket_count() / CONCURRENT_MAP_STRIPES) {
+                return;
+            }
+            bool expected = false;
+            if (!resizing.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return;
+            }
+            newest = current.load(std::memory_order_acquire);
+            if (size() <= newest->bucket_count()) {
+                resizing.store(false, std::memory_order_release);
+                return;
+            }
+            table *grown = table::create(newest->bucket_count() * 2, newest);
+            newest->next.store(grown, std::memory_order_release);
+            current.store(grown, std::memory_order_release);
+        }
+
+        /**
+         * 在持有锁的桶中插入或替换，assign 为 false 时不替换已有元素；返回是否插入了新元素
+         */
+        template<typename Value>
+        bool insert_aux(const key_type &k, Value &&value, bool assign) {
+            size_t hash = hash_of(k);
+            epoch_guard guard;
+            help_migrate();
+            _concurrent_stripe &stripe = stripe_of(hash);
+            stripe.lock();
+            std::atomic<node *> *bucket;
+            std::atomic<node *> *link;
+            try {
+                bucket = write_bucket(hash);
+                link = find_link(bucket, hash, k);
+                node *found = link->load(std::memory_order_relaxed);
+                if (found) {
+                    if (assign) {
+                        node *replacement = create_node(hash, k, std::forward<Value>(value));
+                        replacement->next.store(found->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                        link->store(replacement, std::memory_order_release);
+                        retire_node(found);
+                    }
+                    stripe.unlock();
+                    return false;
+                }
+                node *created = create_node(hash, k, std::forward<Value>(value));
+                created->next.store(bucket->load(std::memory_order_relaxed), std::memory_order_relaxed);
+                bucket->store(created, std::memory_order_release);
+            } catch (...) {
+                stripe.unlock();
+                throw;
+            }
+            size_t stripe_count = stripe.count.load(std::memory_order_relaxed) + 1;
+            stripe.count.store(stripe_count, std::memory_order_relaxed);
+            stripe.unlock();
+            maybe_grow(stripe_count);
+            return true;
+        }
+
+    public:
+        explicit concurrent_unordered_map(size_type bucket_count = CONCURRENT_MAP_STRIPES,
+                                          const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+                : current(nullptr), resizing(false), stripes(), hash_fn(hash), equal_fn(equal) {
+            size_type count = CONCURRENT_MAP_STRIPES;
+            while (count < bucket_count) {
+                count <<= 1;
+            }
+            current.store(table::create(count, nullptr), std::memory_order_relaxed);
+        }
+
+        concurrent_unordered_map(const concurrent_unordered_map &) = delete;
+
+        concurrent_unordered_map &operator=(const concurrent_unordered_map &) = delete;
+
+        ~concurrent_unordered_map() {
+            table *newest = current.load(std::memory_order_relaxed);
+            table *old = newest->prev.load(std::memory_order_relaxed);
+            if (old) {
+                release_table(old);
+            }
+            release_table(newest);
+        }
+
+        size_type size() const {
+            size_type result = 0;
+            for (size_t i = 0; i < CONCURRENT_MAP_STRIPES; ++i) {
+                result += stripes[i].count.load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_type bucket_count() const {
+            return current.load(std::memory_order_acquire)->bucket_count();
+        }
+
+        // --------------------- 读取 --------------------------
+
+        /**
+         * 找到时在 epoch_guard 内调用 visitor(const T &) 并返回 true
+         */
+        template<typename Visitor>
+        bool find(const key_type &k, Visitor visitor) const {
+            size_t hash = hash_of(k);
+            epoch_guard guard;
+            node *found = read_find(hash, k);
+            if (!found) {
+                return false;
+            }
+            visitor(static_cast<const T &>(found->value.second));
+            return true;
+        }
+
+        /**
+         * 找到时把值复制到 out
+         */
+        bool find(const key_type &k, T &out) const {
+            return find(k, [&out](const T &value) {
+                out = value;
+            });
+        }
+
+        bool contains(const key_type &k) const {
+            size_t hash = hash_of(k);
+            epoch_guard guard;
+            return read_find(hash, k) != nullptr;
+        }
+
+        /**
+         * 对每个元素调用 visitor(const value_type &)；与写操作并发时只保证每个 key 最多访问一次
+         */
+        template<typename Visitor>
+        void for_each(Visitor visitor) const {
+            epoch_guard guard;
+            table *target = oldest_table(current.load(std::memory_order_acquire));
+            for (size_t i = 0; i < target->bucket_count(); ++i) {
+                visit_bucket(target, i, visitor);
+            }
+        }
+
+        // --------------------- 写入 --------------------------
+
+        /**
+         * key 不存在时插入，返回是否插入
+         */
+        bool insert(const key_type &k, const T &value) {
+            return insert_aux(k, value, false);
+        }
+
+        /**
+         * key 不存在时插入，存在时替换为 value；返回是否插入了新元素
+         */
+        bool insert_or_assign(const key_type &k, const T &value) {
+            return insert_aux(k, value, true);
+        }
+
+        bool insert_or_assign(const key_type &k, T &&value) {
+            return insert_aux(k, std::move(value), true);
+        }
+
+        /**
+         * key 存在时以 fn(T &) 修改值的副本并替换原节点，返回 key 是否存在
+         */
+        template<typename Function>
+        bool update(const key_type &k, Function fn) {
+            size_t hash = hash_of(k);
+            epoch_guard guard;
+            help_migrate();
+            _concurrent_stripe &stripe = stripe_of(hash);
+            stripe.lock();
+            try {
+                std::atomic<node *> *link = find_link(write_bucket(hash), hash, k);
+                node *found = link->load(std::memory_order_relaxed);
+                if (!found) {
+                    stripe.unlock();
+                    return false;
+                }
+                node *replacement = create_node(hash, found->value);
+                try {
+                    fn(replacement->value.second);
+                } catch (...) {
+                    destroy_node(replacement);
+                    throw;
+                }
+                replacement->next.store(found->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                link->store(replacement, std::memory_order_release);
+                retire_node(found);
+            } catch (...) {
+                stripe.unlock();
+                throw;
+            }
+            stripe.unlock();
+            return true;
+        }
+
+        /**
+         * 返回删除的元素个数
+         */
+        size_type erase(const key_type &k) {
+            size_t hash = hash_of(k);
+            epoch_guard guard;
+            help_migrate();
+            _concurrent_stripe &stripe = stripe_of(hash);
+            stripe.lock();
+            size_type erased = 0;
+            try {
+                std::atomic<node *> *link = find_link(write_bucket(hash), hash, k);
+                node *found = link->load(std::memory_order_relaxed);
+                if (found) {
+                    link->store(found->next.load(std::memory_order_relaxed), std::memory_order_release);
+                    retire_node(found);
+                    stripe.count.store(stripe.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+                    erased = 1;
+                }
+            } catch (...) {
+                stripe.unlock();
+                throw;
+            }
+            stripe.unlock();
+            return erased;
+        }
+
+    protected:
+        /**
+         * 新数组是旧数组的两倍，已搬迁的旧桶 i 中的元素只会在新桶 i 与 i + 旧桶数中
+         */
+        template<typename Visitor>
+        static void visit_bucket(table *target, size_t index, Visitor &visitor) {
+            node *current_node = target->buckets[index].load(std::memory_order_acquire);
+            if (current_node == table::moved()) {
+                table *grown = target->next.load(std::memory_order_acquire);
+                visit_bucket(grown, index, visitor);
+                visit_bucket(grown, index + target->bucket_count(), visitor);
+                return;
+            }
+            for (; current_node; current_node = current_node->next.load(std::memory_order_acquire)) {
+                visitor(static_cast<const value_type &>(current_node->value));
+            }
+        }
+
+        /**
+         * 析构时使用，直接释放桶数组中的所有节点
+         */
+        static void release_table(table *target) {
+            for (size_t i = 0; i < target->bucket_count(); ++i) {
+                node *current_node = target->buckets[i].load(std::memory_order_relaxed);
+                if (current_node == table::moved()) {
+                    continue;
+                }
+                while (current_node) {
+                    node *next = current_node->next.load(std::memory_order_relaxed);
+                    destroy_node(current_node);
+                    current_node = next;
+                }
+            }
+            table::destroy(target);
+        }
+    };
+}
+
+#endif //MICROSTL_CONCURRENT_UNORDERED_MAP_H
@@ -0,0 +1,701 @@
+#ifndef MICROSTL_DEQUE_H
+#define MICROSTL_DEQUE_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator.h"
+#include "../iterator/type_traits.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../memory/uninitialized.h"
+#include "../algorithm/algobase.h"
+
+/**
+ * 分段连续的双端队列：
+ *
+ * - 元素存放在固定大小的块中，块由 Alloc<T>（AllocByFreeList）分配，每块的元素个数由 sizeof(T) 在编译期决定
+ * - 中控器 map 是一个块指针数组，已使用的部分位于 map 中间：
+ *      - 头尾任意一端用完时，如果 map 剩余空间足够，只把块指针重新移到中间，否则扩大 map
+ *      - 扩容只复制块指针，已有元素不会移动，push_front / push_back 均为 O(1)
+ * - 迭代器为随机访问迭代器，可以直接用于 algorithm 中的算法
+ * - 两端插入与删除只会使迭代器失效，不会使元素的引用失效；中间插入与删除移动较少的一侧
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 每个块的目标字节数
+     */
+    static const size_t DEQUE_BLOCK_BYTES = 512;
+
+    /**
+     * 每个块至少容纳的元素个数，避免大对象退化为每个元素一次分配
+     */
+    static const size_t DEQUE_MIN_BLOCK_ELEMENTS = 4;
+
+    /**
+     * 中控器的最小长度
+     */
+    static const size_t DEQUE_INITIAL_MAP_SIZE = 8;
+
+    constexpr size_t _deque_buffer_size(size_t size) {
+        return size * DEQUE_MIN_BLOCK_ELEMENTS < DEQUE_BLOCK_BYTES ? DEQUE_BLOCK_BYTES / size : DEQUE_MIN_BLOCK_ELEMENTS;
+    }
+
+    // --------------------- 迭代器 --------------------------
+
+    template<typename T, typename Ref, typename Ptr>
+    struct _deque_iterator {
+        using iterator = _deque_iterator<T, T &, T *>;
+        using const_iterator = _deque_iterator<T, const T &, const T *>;
+        using self = _deque_iterator<T, Ref, Ptr>;
+        using iterator_category = random_access_iterator_tag;
+        using value_type = T;
+        using pointer = Ptr;
+        using reference = Ref;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using map_pointer = T **;
+
+        static constexpr difference_type buffer_size = _deque_buffer_size(sizeof(T));
+
+        // 当前元素
+        T *cur;
+        // 当前块的起点
+        T *first;
+        // 当前块的终点（不含）
+        T *last;
+        // 当前块在 map 中的位置
+        map_pointer node;
+
+        _deque_iterator() : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+
+        _deque_iterator(T *cur, map_pointer node) : cur(cur), first(*node), last(*node + buffer_size), node(node) {}
+
+        _deque_iterator(const _deque_iterator &) = default;
+
+        _deque_iterator &operator=(const _deque_iterator &) = default;
+
+        /**
+         * iterator 可以隐式转换为 const_iterator
+         */
+        template<typename OtherRef, typename OtherPtr,
+                typename = typename std::enable_if<
+                        std::is_same<_deque_iterator<T, OtherRef, OtherPtr>, iterator>::value &&
+                        !std::is_same<Ref, T &>::value>::type>
+        _deque_iterator(const _deque_iterator<T, OtherRef, OtherPtr> &obj)
+                : cur(obj.cur), first(obj.first), last(obj.last), node(obj.node) {}
+
+        /**
+         * 切换到另一个块，cur 由调用者设置
+         */
+        void set_node(map_pointer new_node) {
+            node = new_node;
+            first = *new_node;
+            last = first + buffer_size;
+        }
+
+        reference operator*() const {
+            return *cur;
+        }
+
+        pointer operator->() const {
+            return cur;
+        }
+
+        difference_type operator-(const self &obj) const {
+            if (node == obj.node) {
+                return cur - obj.cur;
+            }
+            return buffer_size * (node - obj.node - 1) + (cur - first) + (obj.last - obj.cur);
+        }
+
+        self &operator++() {
+            ++cur;
+            if (cur == last) {
+                set_node(node + 1);
+                cur = first;
+            }
+            return *this;
+        }
+
+        self operator++(int) {
+            self temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        self &operator--() {
+            if (cur == first) {
+                set_node(node - 1);
+                cur = last;
+            }
+            --cur;
+            return *this;
+        }
+
+        self operator--(int) {
+            self temp = *this;
+            --*this;
+            return temp;
+        }
+
+        self &operator+=(difference_type n) {
+            difference_type offset = n + (cur - first);
+            if (offset >= 0 && offset < buffer_size) {
+                cur += n;
+            } else {
+                difference_type node_offset = offset > 0 ? offset / buffer_size
+                                                         : -((-offset - 1) / buffer_size) - 1;
+                set_node(node + node_offset);
+                cur = first + (offset - node_offset * buffer_size);
+            }
+            return *this;
+        }
+
+        self operator+(difference_type n) const {
+            self temp = *this;
+            return temp += n;
+        }
+
+        self &operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        self operator-(difference_type n) const {
+            self temp = *this;
+            return temp -= n;
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        bool operator==(const self &obj) const {
+            return cur == obj.cur;
+        }
+
+        bool operator!=(const self &obj) const {
+            return cur != obj.cur;
+        }
+
+        bool operator<(const self &obj) const {
+            return node == obj.node ? cur < obj.cur : node < obj.node;
+        }
+
+        bool operator>(const self &obj) const {
+            return obj < *this;
+        }
+
+        bool operator<=(const self &obj) const {
+            return !(obj < *this);
+        }
+
+        bool operator>=(const self &obj) const {
+            return !(*this < obj);
+        }
+    };
+
+    template<typename T, typename Ref, typename Ptr>
+    inline _deque_iterator<T, Ref, Ptr>
+    operator+(ptrdiff_t n, const _deque_iterator<T, Ref, Ptr> &iter) {
+        return iter + n;
+    }
+
+    // --------------------- deque --------------------------
+
+    template<typename T>
+    class deque {
+    public:
+        using value_type = T;
+        using pointer = value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using iterator = _deque_iterator<T, T &, T *>;
+        using const_iterator = _deque_iterator<T, const T &, const T *>;
+
+        static constexpr size_type buffer_size = _deque_buffer_size(sizeof(T));
+
+    protected:
+        using map_pointer = T **;
+        using data_allocator = Alloc<T>;
+        using map_allocator = Alloc<T *>;
+
+        iterator start;
+        iterator finish;
+        map_pointer map;
+        size_type map_size;
+
+        static T *allocate_node() {
+            return data_allocator::allocate(buffer_size);
+        }
+
+        static void deallocate_node(T *buffer) {
+            data_allocator::deallocate(buffer, buffer_size);
+        }
+
+        void create_nodes(map_pointer first, map_pointer last) {
+            map_pointer current = first;
+            try {
+                for (; current <= last; ++current) {
+                    *current = allocate_node();
+                }
+            } catch (...) {
+                destroy_nodes(first, current - 1);
+                throw;
+            }
+        }
+
+        void destroy_nodes(map_pointer first, map_pointer last) {
+            for (; first <= last; ++first) {
+                deallocate_node(*first);
+            }
+        }
+
+        /**
+         * 分配 map 与容纳 count 个元素所需的块，已使用的块位于 map 中间
+         */
+        void create_map_and_nodes(size_type count) {
+            size_type num_nodes = count / buffer_size + 1;
+            map_size = num_nodes + 2 > DEQUE_INITIAL_MAP_SIZE ? num_nodes + 2 : DEQUE_INITIAL_MAP_SIZE;
+            map = map_allocator::allocate(map_size);
+
+            map_pointer node_start = map + (map_size - num_nodes) / 2;
+            map_pointer node_finish = node_start + num_nodes - 1;
+            try {
+                create_nodes(node_start, node_finish);
+            } catch (...) {
+                map_allocator::deallocate(map, map_size);
+                map = nullptr;
+                map_size = 0;
+                throw;
+            }
+            start.set_node(node_start);
+            finish.set_node(node_finish);
+            start.cur = start.first;
+            finish.cur = finish.first + count % buffer_size;
+        }
+
+        /**
+         * 元素构造失败时释放已分配的块与 map
+         */
+        void release_storage() {
+            destroy_nodes(start.node, finish.node);
+            map_allocator::deallocate(map, map_size);
+            map = nullptr;
+            map_size = 0;
+        }
+
+        void fill_initialize(size_type count, const T &value) {
+            create_map_and_nodes(count);
+            try {
+                MicroSTL::uninitialized_fill_n(start, count, value);
+            } catch (...) {
+                release_storage();
+                throw;
+            }
+        }
+
+        template<typename Integer>
+        void range_initialize(Integer count, Integer value, true_type) {
+            fill_initialize(static_cast<size_type>(count), static_cast<T>(value));
+        }
+
+        template<typename InputIterator>
+        void range_initialize(InputIterator first, InputIterator last, false_type) {
+            create_map_and_nodes(0);
+            try {
+                for (; first != last; ++first) {
+                    push_back(*first);
+                }
+            } catch (...) {
+                clear();
+                release_storage();
+                throw;
+            }
+        }
+
+        /**
+         * 头部或尾部需要 nodes_to_add 个新块而 map 空间不足：
+         * map 的长度超过所需块数的两倍时把已使用的部分移到中间，否则扩大 map
+         */
+        void reallocate_map(size_type nodes_to_add, bool add_at_front) {
+            size_type old_num_nodes = finish.node - start.node + 1;
+            size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+            map_pointer new_start;
+            if (map_size > 2 * new_num_nodes) {
+                new_start = map + (map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+                std::memmove(new_start, start.node, old_num_nodes * sizeof(T *));
+            } else {
+                size_type new_map_size = map_size + (map_size > nodes_to_add ? map_size : nodes_to_add) + 2;
+                map_pointer new_map = map_allocator::allocate(new_map_size);
+                new_start = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+                std::memcpy(new_start, start.node, old_num_nodes * sizeof(T *));
+                map_allocator::deallocate(map, map_size);
+                map = new_map;
+                map_size = new_map_size;
+            }
+            start.set_node(new_start);
+            finish.set_node(new_start + old_num_nodes - 1);
+        }
+
+        void reserve_map_at_back(size_type nodes_to_add = 1) {
+            if (nodes_to_add + 1 > map_size - (finish.node - map)) {
+                reallocate_map(nodes_to_add, false);
+            }
+        }
+
+        void reserve_map_at_front(size_type nodes_to_add = 1) {
+            if (nodes_to_add > static_cast<size_type>(start.node - map)) {
+                reallocate_map(nodes_to_add, true);
+            }
+        }
+
+        /**
+         * 尾部的块已满，先分配下一个块再构造
+         */
+        template<typename... Args>
+        void emplace_back_aux(Args &&... args) {
+            reserve_map_at_back();
+            *(finish.node + 1) = allocate_node();
+            try {
+                new(finish.cur) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_node(*(finish.node + 1));
+                throw;
+            }
+            finish.set_node(finish.node + 1);
+            finish.cur = finish.first;
+        }
+
+        /**
+         * 头部的块已满，先分配上一个块再构造
+         */
+        template<typename... Args>
+        void emplace_front_aux(Args &&... args) {
+            reserve_map_at_front();
+            *(start.node - 1) = allocate_node();
+            try {
+                new(*(start.node - 1) + buffer_size - 1) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_node(*(start.node - 1));
+                throw;
+            }
+            start.set_node(start.node - 1);
+            start.cur = start.last - 1;
+        }
+
+        iterator insert_aux(iterator position, const T &obj) {
+            difference_type index = position - start;
+            T obj_copy = obj;
+            if (static_cast<size_type>(index) < size() / 2) {
+                // 前半部分整体前移一位
+                push_front(front());
+                iterator front1 = start + 1;
+                position = start + index;
+                MicroSTL::copy(front1 + 1, position + 1, front1);
+            } else {
+                // 后半部分整体后移一位
+                push_back(back());
+                iterator back1 = finish - 1;
+                position = start + index;
+                MicroSTL::copy_backward(position, back1 - 1, back1);
+            }
+            *position = obj_copy;
+            return position;
+        }
+
+    public:
+        deque() : start(), finish(), map(nullptr), map_size(0) {
+            create_map_and_nodes(0);
+        }
+
+        explicit deque(size_type count) : start(), finish(), map(nullptr), map_size(0) {
+            fill_initialize(count, T());
+        }
+
+        deque(size_type count, const T &value) : start(), finish(), map(nullptr), map_size(0) {
+            fill_initialize(count, value);
+        }
+
+        template<typename InputIterator>
+        deque(InputIterator first, InputIterator last) : start(), finish(), map(nullptr), map_size(0) {
+            range_initialize(first, last, typename arithmetic_traits<InputIterator>::is_integral());
+        }
+
+        deque(const deque &obj) : start(), finish(), map(nullptr), map_size(0) {
+            create_map_and_nodes(obj.size());
+            try {
+                MicroSTL::uninitialized_copy(obj.begin(), obj.end(), start);
+            } catch (...) {
+                release_storage();
+                throw;
+            }
+        }
+
+        /**
+         * 被移动的 deque 保留一个空块，仍然可以继续使用
+         */
+        deque(deque &&obj) : deque() {
+            swap(obj);
+        }
+
+        ~deque() {
+            if (map) {
+                MicroSTL::destroy(start, finish);
+                release_storage();
+            }
+        }
+
+        deque &operator=(const deque &obj) {
+            if (this != &obj) {
+                deque temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        deque &operator=(deque &&obj) noexcept {
+            swap(obj);
+            return *this;
+        }
+
+        void swap(deque &obj) noexcept {
+            MicroSTL::swap(start, obj.start);
+            MicroSTL::swap(finish, obj.finish);
+            MicroSTL::swap(map, obj.map);
+            MicroSTL::swap(map_size, obj.map_size);
+        }
+
+        iterator begin() {
+            return start;
+        }
+
+        const_iterator begin() const {
+            return start;
+        }
+
+        iterator end() {
+            return finish;
+        }
+
+        const_iterator end() const {
+            return finish;
+        }
+
+        size_type size() const {
+            return finish - start;
+        }
+
+        bool empty() const {
+            return start == finish;
+        }
+
+        reference operator[](size_type n) {
+            return start[static_cast<difference_type>(n)];
+        }
+
+        const_reference operator[](size_type n) const {
+            return start[static_cast<difference_type>(n)];
+        }
+
+        reference at(size_type n) {
+            if (n >= size()) {
+                throw std::out_of_range("deque::at");
+            }
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= size()) {
+                throw std::out_of_range("deque::at");
+            }
+            return (*this)[n];
+        }
+
+        reference front() {
+            return *start;
+        }
+
+        const_reference front() const {
+            return *start;
+        }
+
+        reference back() {
+            return *(finish - 1);
+        }
+
+        const_reference back() const {
+            return *(finish - 1);
+        }
+
+        // --------------------- 两端插入与删除 --------------------------
+
+        template<typename... Args>
+        reference emplace_back(Args &&... args) {
+            if (finish.cur != finish.last - 1) {
+                T *position = finish.cur;
+                new(position) T(std::forward<Args>(args)...);
+                ++finish.cur;
+                return *position;
+            }
+            emplace_back_aux(std::forward<Args>(args)...);
+            return back();
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args &&... args) {
+            if (start.cur != start.first) {
+                new(start.cur - 1) T(std::forward<Args>(args)...);
+                --start.cur;
+            } else {
+                emplace_front_aux(std::forward<Args>(args)...);
+            }
+            return front();
+        }
+
+        void push_back(const T &obj) {
+            emplace_back(obj);
+        }
+
+        void push_back(T &&obj) {
+            emplace_back(std::move(obj));
+        }
+
+        void push_front(const T &obj) {
+            emplace_front(obj);
+        }
+
+        void push_front(T &&obj) {
+            emplace_front(std::move(obj));
+        }
+
+        void pop_back() {
+            if (finish.cur == finish.first) {
+                // 尾部的块已空，归还后退回上一个块
+                deallocate_node(finish.first);
+                finish.set_node(finish.node - 1);
+                finish.cur = finish.last;
+            }
+            --finish.cur;
+            MicroSTL::destroy(finish.cur);
+        }
+
+        void pop_front() {
+            MicroSTL::destroy(start.cur);
+            if (start.cur != start.last - 1) {
+                ++start.cur;
+            } else {
+                deallocate_node(start.first);
+                start.set_node(start.node + 1);
+                start.cur = start.first;
+            }
+        }
+
+        // --------------------- 中间插入与删除 --------------------------
+
+        iterator insert(iterator position, const T &obj) {
+            if (position.cur == start.cur) {
+                push_front(obj);
+                return start;
+            }
+            if (position.cur == finish.cur) {
+                push_back(obj);
+                return finish - 1;
+            }
+            return insert_aux(position, obj);
+        }
+
+        iterator erase(iterator position) {
+            iterator next = position + 1;
+            difference_type index = position - start;
+            if (static_cast<size_type>(index) < size() / 2) {
+                MicroSTL::copy_backward(start, position, next);
+                pop_front();
+            } else {
+                MicroSTL::copy(next, finish, position);
+                pop_back();
+            }
+            return start + index;
+        }
+
+        iterator erase(iterator first, iterator last) {
+            if (first == start && last == finish) {
+                clear();
+                return finish;
+            }
+            difference_type count = last - first;
+            difference_type elements_before = first - start;
+            if (static_cast<size_type>(elements_before) < (size() - count) / 2) {
+                MicroSTL::copy_backward(start, first, last);
+                iterator new_start = start + count;
+                MicroSTL::destroy(start, new_start);
+                for (map_pointer node = start.node; node < new_start.node; ++node) {
+                    deallocate_node(*node);
+                }
+                start = new_start;
+            } else {
+                MicroSTL::copy(last, finish, first);
+                iterator new_finish = finish - count;
+                MicroSTL::destroy(new_finish, finish);
+                for (map_pointer node = new_finish.node + 1; node <= finish.node; ++node) {
+                    deallocate_node(*node);
+                }
+                finish = new_finish;
+            }
+            return start + elements_before;
+        }
+
+        /**
+         * 只保留一个块
+         */
+        void clear() {
+            for (map_pointer node = start.node + 1; node < finish.node; ++node) {
+                MicroSTL::destroy(*node, *node + buffer_size);
+                deallocate_node(*node);
+            }
+            if (start.node != finish.node) {
+                MicroSTL::destroy(start.cur, start.last);
+                MicroSTL::destroy(finish.first, finish.cur);
+                deallocate_node(finish.first);
+            } else {
+                MicroSTL::destroy(start.cur, finish.cur);
+            }
+            finish = start;
+        }
+
+        void resize(size_type new_size, const T &obj) {
+            size_type old_size = size();
+            if (new_size < old_size) {
+                erase(start + new_size, finish);
+            } else {
+                for (; old_size < new_size; ++old_size) {
+                    push_back(obj);
+                }
+            }
+        }
+
+        void resize(size_type new_size) {
+            resize(new_size, T());
+        }
+    };
+
+    template<typename T>
+    inline bool operator==(const deque<T> &lhs, const deque<T> &rhs) {
+        return lhs.size() == rhs.size() && MicroSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template<typename T>
+    inline bool operator!=(const deque<T> &lhs, const deque<T> &rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif //MICROSTL_DEQUE_H
@@ -0,0 +1,711 @@
+#ifndef MICROSTL_DYNAMIC_BITSET_H
+#define MICROSTL_DYNAMIC_BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "../memory/alloc.h"
+#include "../iterator/iterator.h"
+#include "../algorithm/algobase.h"
+#include "../algorithm/simd_bits.h"
+
+/**
+ * 长度可变的紧凑位图，每个元素只占 1 位：
+ *
+ * - 以 64 位字为单位存放，第 i 位位于第 i / 64 个字的第 i % 64 位；最后一个字中超出长度的位始终为 0，
+ *   count、any、比较等操作因此可以直接按整字处理
+ * - 单个位通过代理对象 _bit_reference 读写；迭代器为随机访问迭代器，解引用得到代理对象，
+ *   可以直接用于 algorithm 中的 find、count、fill、copy 等算法
+ * - 区间的 set / reset / flip 首尾按掩码处理，中间的整字直接赋值
+ * - count 使用 popcount，find_first / find_next 先跳过全 0 的字，再用 ctz（tzcnt）定位字内的位置；
+ *   遍历所有为 1 的位时 for_each_set 逐字处理，更快
+ * - 两个位图之间的 &=、|=、^=、-=（与非）使用 simd_bits.h 中的向量化内核，两者长度必须相同
+ * - 空间来自 Alloc<uint64_t>，push_back 容量不足时扩大为原来的 2 倍
+ */
+
+namespace MicroSTL {
+
+    static const size_t BITS_PER_WORD = 64;
+
+    /**
+     * 单个位的代理
+     */
+    class _bit_reference {
+    protected:
+        uint64_t *word;
+        uint64_t mask;
+
+    public:
+        _bit_reference(uint64_t *word, uint64_t mask) : word(word), mask(mask) {}
+
+        operator bool() const {
+            return (*word & mask) != 0;
+        }
+
+        _bit_reference &operator=(bool value) {
+            if (value) {
+                *word |= mask;
+            } else {
+                *word &= ~mask;
+            }
+            return *this;
+        }
+
+        _bit_reference &operator=(const _bit_reference &obj) {
+            return *this = static_cast<bool>(obj);
+        }
+
+        bool operator~() const {
+            return (*word & mask) == 0;
+        }
+
+        void flip() {
+            *word ^= mask;
+        }
+    };
+
+    /**
+     * 代理对象是右值，交换的是两者指向的位
+     */
+    inline void swap(_bit_reference a, _bit_reference b) {
+        bool tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    inline void swap(_bit_reference a, bool &b) {
+        bool tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    inline void swap(bool &a, _bit_reference b) {
+        bool tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // --------------------- 迭代器 --------------------------
+
+    /**
+     * 字指针 + 字内偏移，offset 始终在 [0, 64) 内
+     */
+    struct _bit_iterator_base {
+        uint64_t *word;
+        unsigned offset;
+
+        _bit_iterator_base(uint64_t *word, unsigned offset) : word(word), offset(offset) {}
+
+        void bump_up() {
+            if (offset++ == BITS_PER_WORD - 1) {
+                offset = 0;
+                ++word;
+            }
+        }
+
+        void bump_down() {
+            if (offset-- == 0) {
+                offset = BITS_PER_WORD - 1;
+                --word;
+            }
+        }
+
+        void advance(ptrdiff_t n) {
+            ptrdiff_t position = n + static_cast<ptrdiff_t>(offset);
+            // 负数按向下取整的方式拆分
+            ptrdiff_t words = position >= 0 ? position / static_cast<ptrdiff_t>(BITS_PER_WORD)
+                                            : -((-position + static_cast<ptrdiff_t>(BITS_PER_WORD) - 1) /
+                                                static_cast<ptrdiff_t>(BITS_PER_WORD));
+            word += words;
+            offset = static_cast<unsigned>(position - words * static_cast<ptrdiff_t>(BITS_PER_WORD));
+        }
+
+        ptrdiff_t operator-(const _bit_iterator_base &obj) const {
+            return (word - obj.word) * static_cast<ptrdiff_t>(BITS_PER_WORD) + offset - obj.offset;
+        }
+
+        bool operator==(const _bit_iterator_base &obj) const {
+            return word == obj.word && offset == obj.offset;
+        }
+
+        bool operator!=(const _bit_iterator_base &obj) const {
+            return !(*this == obj);
+        }
+
+        bool operator<(const _bit_iterator_base &obj) const {
+            return word < obj.word || (word == obj.word && offset < obj.offset);
+        }
+
+        bool operator>(const _bit_iterator_base &obj) const {
+            return obj < *this;
+        }
+
+        bool operator<=(const _bit_iterator_base &obj) const {
+            return !(obj < *this);
+        }
+
+        bool operator>=(const _bit_iterator_base &obj) const {
+            return !(*this < obj);
+        }
+    };
+
+    template<typename Reference, typename Self>
+    struct _bit_iterator_ops : public _bit_iterator_base {
+        using iterator_category = random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+        _bit_iterator_ops(uint64_t *word, unsigned offset) : _bit_iterator_base(word, offset) {}
+
+        Self &self() {
+            return static_cast<Self &>(*this);
+        }
+
+        const Self &self() const {
+            return static_cast<const Self &>(*this);
+        }
+
+        Self &operator++() {
+            bump_up();
+            return self();
+        }
+
+        Self operator++(int) {
+            Self tmp = self();
+            bump_up();
+            return tmp;
+        }
+
+        Self &operator--() {
+            bump_down();
+            return self();
+        }
+
+        Self operator--(int) {
+            Self tmp = self();
+            bump_down();
+            return tmp;
+        }
+
+        Self &operator+=(difference_type n) {
+            advance(n);
+            return self();
+        }
+
+        Self &operator-=(difference_type n) {
+            advance(-n);
+            return self();
+        }
+
+        Self operator+(difference_type n) const {
+            Self tmp = self();
+            return tmp += n;
+        }
+
+        Self operator-(difference_type n) const {
+            Self tmp = self();
+            return tmp -= n;
+        }
+
+        using _bit_iterator_base::operator-;
+
+        reference operator[](difference_type n) const {
+            return *(self() + n);
+        }
+    };
+
+    class _bit_iterator : public _bit_iterator_ops<_bit_reference, _bit_iterator> {
+    public:
+        _bit_iterator() : _bit_iterator_ops(nullptr, 0) {}
+
+        _bit_iterator(uint64_t *word, unsigned offset) : _bit_iterator_ops(word, offset) {}
+
+        reference operator*() const {
+            return _bit_reference(word, static_cast<uint64_t>(1) << offset);
+        }
+    };
+
+    class _bit_const_iterator : public _bit_iterator_ops<bool, _bit_const_iterator> {
+    public:
+        _bit_const_iterator() : _bit_iterator_ops(nullptr, 0) {}
+
+        _bit_const_iterator(const uint64_t *word, unsigned offset)
+                : _bit_iterator_ops(const_cast<uint64_t *>(word), offset) {}
+
+        _bit_const_iterator(const _bit_iterator &obj) : _bit_iterator_ops(obj.word, obj.offset) {}
+
+        reference operator*() const {
+            return (*word >> offset) & 1;
+        }
+    };
+
+    // --------------------- dynamic_bitset --------------------------
+
+    class dynamic_bitset {
+    public:
+        using value_type = bool;
+        using word_type = uint64_t;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = _bit_reference;
+        using const_reference = bool;
+        using iterator = _bit_iterator;
+        using const_iterator = _bit_const_iterator;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    protected:
+        using allocator = Alloc<word_type>;
+
+        word_type *words;
+        size_type bit_count;
+        // 以字为单位
+        size_type word_capacity;
+
+        static size_type words_for(size_type bits) {
+            return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        }
+
+        static word_type fill_word(bool value) {
+            return value ? ~static_cast<word_type>(0) : 0;
+        }
+
+        /**
+         * [low, high) 位为 1 的掩码，0 <= low < high <= 64
+         */
+        static word_type range_mask(size_type low, size_type high) {
+            word_type upper = high == BITS_PER_WORD ? ~static_cast<word_type>(0)
+                                                    : (static_cast<word_type>(1) << high) - 1;
+            return upper & ~((static_cast<word_type>(1) << low) - 1);
+        }
+
+        /**
+         * 清零最后一个字中超出长度的位
+         */
+        void clear_unused_bits() {
+            size_type rest = bit_count % BITS_PER_WORD;
+            if (rest != 0) {
+                words[bit_count / BITS_PER_WORD] &= (static_cast<word_type>(1) << rest) - 1;
+            }
+        }
+
+        void reallocate(size_type new_word_capacity) {
+            word_type *new_words = allocator::allocate(new_word_capacity);
+            size_type used = num_words();
+            if (used != 0) {
+                memcpy(new_words, words, used * sizeof(word_type));
+            }
+            deallocate();
+            words = new_words;
+            word_capacity = new_word_capacity;
+        }
+
+        void deallocate() {
+            if (words) {
+                allocator::deallocate(words, word_capacity);
+            }
+        }
+
+        /**
+         * 对 [pos, pos + n) 中的每个字应用 op(word, mask)，mask 为该字中落在区间内的位
+         */
+        template<typename WordOp>
+        void apply_range(size_type pos, size_type n, WordOp op) {
+            if (pos > bit_count || n > bit_count - pos) {
+                throw std::out_of_range("dynamic_bitset: range out of bounds");
+            }
+            size_type last = pos + n;
+            while (pos < last) {
+                size_type index = pos / BITS_PER_WORD;
+                size_type low = pos % BITS_PER_WORD;
+                size_type high = last - index * BITS_PER_WORD < BITS_PER_WORD ? last - index * BITS_PER_WORD
+                                                                              : BITS_PER_WORD;
+                op(words[index], range_mask(low, high));
+                pos = index * BITS_PER_WORD + high;
+            }
+        }
+
+        /**
+         * 从第 index 个字开始的第一个为 1 的位；单独成函数，使 find_next 在当前字内命中的路径足够短，可以内联
+         */
+        size_type find_from_word(size_type index) const {
+            size_type used = num_words();
+            if (index >= used) {
+                return npos;
+            }
+            size_type next = index + simd_find_nonzero(words + index, used - index);
+            if (next == used) {
+                return npos;
+            }
+            return next * BITS_PER_WORD + __builtin_ctzll(words[next]);
+        }
+
+    public:
+        dynamic_bitset() : words(nullptr), bit_count(0), word_capacity(0) {}
+
+        explicit dynamic_bitset(size_type size, bool value = false)
+                : words(nullptr), bit_count(size), word_capacity(words_for(size)) {
+            words = allocator::allocate(word_capacity);
+            for (size_type i = 0; i < word_capacity; ++i) {
+                words[i] = fill_word(value);
+            }
+            clear_unused_bits();
+        }
+
+        dynamic_bitset(const dynamic_bitset &obj)
+                : words(nullptr), bit_count(obj.bit_count), word_capacity(obj.num_words()) {
+            words = allocator::allocate(word_capacity);
+            if (word_capacity != 0) {
+                memcpy(words, obj.words, word_capacity * sizeof(word_type));
+            }
+        }
+
+        dynamic_bitset(dynamic_bitset &&obj) noexcept
+                : words(obj.words), bit_count(obj.bit_count), word_capacity(obj.word_capacity) {
+            obj.words = nullptr;
+            obj.bit_count = 0;
+            obj.word_capacity = 0;
+        }
+
+        ~dynamic_bitset() {
+            deallocate();
+        }
+
+        dynamic_bitset &operator=(const dynamic_bitset &obj) {
+            if (this != &obj) {
+                dynamic_bitset tmp(obj);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        dynamic_bitset &operator=(dynamic_bitset &&obj) noexcept {
+            if (this != &obj) {
+                deallocate();
+                words = obj.words;
+                bit_count = obj.bit_count;
+                word_capacity = obj.word_capacity;
+                obj.words = nullptr;
+                obj.bit_count = 0;
+                obj.word_capacity = 0;
+            }
+            return *this;
+        }
+
+        void swap(dynamic_bitset &obj) noexcept {
+            MicroSTL::swap(words, obj.words);
+            MicroSTL::swap(bit_count, obj.bit_count);
+            MicroSTL::swap(word_capacity, obj.word_capacity);
+        }
+
+        // --------------------- 容量 --------------------------
+
+        size_type size() const {
+            return bit_count;
+        }
+
+        bool empty() const {
+            return bit_count == 0;
+        }
+
+        size_type capacity() const {
+            return word_capacity * BITS_PER_WORD;
+        }
+
+        size_type num_words() const {
+            return words_for(bit_count);
+        }
+
+        /**
+         * 底层的字数组，共 num_words() 个
+         */
+        word_type *data() {
+            return words;
+        }
+
+        const word_type *data() const {
+            return words;
+        }
+
+        void reserve(size_type bits) {
+            if (words_for(bits) > word_capacity) {
+                reallocate(words_for(bits));
+            }
+        }
+
+        void resize(size_type size, bool value = false) {
+            size_type old_size = bit_count;
+            size_type old_words = num_words();
+            if (words_for(size) > word_capacity) {
+                reallocate(words_for(size));
+            }
+            if (size > old_size) {
+                // 最后一个字中原本超出长度的位为 0，只需要在填 1 时补上
+                if (value && old_size % BITS_PER_WORD != 0) {
+                    words[old_size / BITS_PER_WORD] |= ~((static_cast<word_type>(1) << (old_size % BITS_PER_WORD)) - 1);
+                }
+                for (size_type i = old_words; i < words_for(size); ++i) {
+                    words[i] = fill_word(value);
+                }
+            }
+            bit_count = size;
+            clear_unused_bits();
+        }
+
+        void clear() {
+            bit_count = 0;
+        }
+
+        void push_back(bool value) {
+            if (bit_count == word_capacity * BITS_PER_WORD) {
+                reallocate(word_capacity == 0 ? 1 : word_capacity * 2);
+            }
+            size_type index = bit_count / BITS_PER_WORD;
+            word_type mask = static_cast<word_type>(1) << (bit_count % BITS_PER_WORD);
+            if (mask == 1) {
+                words[index] = 0;
+            }
+            if (value) {
+                words[index] |= mask;
+            }
+            ++bit_count;
+        }
+
+        void pop_back() {
+            --bit_count;
+            clear_unused_bits();
+        }
+
+        // --------------------- 访问 --------------------------
+
+        iterator begin() {
+            return iterator(words, 0);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(words, 0);
+        }
+
+        iterator end() {
+            return begin() + static_cast<difference_type>(bit_count);
+        }
+
+        const_iterator end() const {
+            return begin() + static_cast<difference_type>(bit_count);
+        }
+
+        reference operator[](size_type pos) {
+            return reference(words + pos / BITS_PER_WORD, static_cast<word_type>(1) << (pos % BITS_PER_WORD));
+        }
+
+        const_reference operator[](size_type pos) const {
+            return (words[pos / BITS_PER_WORD] >> (pos % BITS_PER_WORD)) & 1;
+        }
+
+        bool test(size_type pos) const {
+            if (pos >= bit_count) {
+                throw std::out_of_range("dynamic_bitset::test");
+            }
+            return (*this)[pos];
+        }
+
+        // --------------------- 修改 --------------------------
+
+        dynamic_bitset &set() {
+            size_type used = num_words();
+            for (size_type i = 0; i < used; ++i) {
+                words[i] = ~static_cast<word_type>(0);
+            }
+            clear_unused_bits();
+            return *this;
+        }
+
+        dynamic_bitset &set(size_type pos, bool value = true) {
+            (*this)[pos] = value;
+            return *this;
+        }
+
+        /**
+         * 把 [pos, pos + n) 置为 value
+         */
+        dynamic_bitset &set(size_type pos, size_type n, bool value) {
+            if (value) {
+                apply_range(pos, n, [](word_type &word, word_type mask) { word |= mask; });
+            } else {
+                apply_range(pos, n, [](word_type &word, word_type mask) { word &= ~mask; });
+            }
+            return *this;
+        }
+
+        dynamic_bitset &reset() {
+            size_type used = num_words();
+            if (used != 0) {
+                memset(words, 0, used * sizeof(word_type));
+            }
+            return *this;
+        }
+
+        dynamic_bitset &reset(size_type pos) {
+            (*this)[pos] = false;
+            return *this;
+        }
+
+        dynamic_bitset &reset(size_type pos, size_type n) {
+            return set(pos, n, false);
+        }
+
+        dynamic_bitset &flip() {
+            size_type used = num_words();
+            for (size_type i = 0; i < used; ++i) {
+                words[i] = ~words[i];
+            }
+            clear_unused_bits();
+            return *this;
+        }
+
+        dynamic_bitset &flip(size_type pos) {
+            words[pos / BITS_PER_WORD] ^= static_cast<word_type>(1) << (pos % BITS_PER_WORD);
+            return *this;
+        }
+
+        dynamic_bitset &flip(size_type pos, size_type n) {
+            apply_range(pos, n, [](word_type &word, word_type mask) { word ^= mask; });
+            return *this;
+        }
+
+        // --------------------- 统计与查找 --------------------------
+
+        size_type count() const {
+            return simd_popcount(words, num_words());
+        }
+
+        bool any() const {
+            return simd_find_nonzero(words, num_words()) != num_words();
+        }
+
+        bool none() const {
+            return !any();
+        }
+
+        bool all() const {
+            return count() == bit_count;
+        }
+
+        /**
+         * 第一个为 1 的位，没有则返回 npos
+         */
+        size_type find_first() const {
+            return find_from_word(0);
+        }
+
+        /**
+         * pos 之后第一个为 1 的位，没有则返回 npos
+         */
+        size_type find_next(size_type pos) const {
+            ++pos;
+            if (pos >= bit_count) {
+                return npos;
+            }
+            size_type index = pos / BITS_PER_WORD;
+            word_type rest = words[index] & ~((static_cast<word_type>(1) << (pos % BITS_PER_WORD)) - 1);
+            if (rest != 0) {
+                return index * BITS_PER_WORD + __builtin_ctzll(rest);
+            }
+            return find_from_word(index + 1);
+        }
+
+        /**
+         * 按升序对每个为 1 的位调用 f(pos)；逐字取出最低位的 1 再清除（blsr），
+         * 比反复调用 find_next 少了每次重新定位字与掩码的开销
+         */
+        template<typename Function>
+        void for_each_set(Function f) const {
+            size_type used = num_words();
+            for (size_type index = 0; index < used; ++index) {
+                for (word_type word = words[index]; word != 0; word &= word - 1) {
+                    f(index * BITS_PER_WORD + __builtin_ctzll(word));
+                }
+            }
+        }
+
+        // --------------------- 位图之间的运算 --------------------------
+
+    protected:
+        /**
+         * 逐字运算要求两个位图的长度相同，否则会读到 obj 的存储之外
+         */
+        void check_same_size(const dynamic_bitset &obj) const {
+            if (bit_count != obj.bit_count) {
+                throw std::invalid_argument("dynamic_bitset: operands have different sizes");
+            }
+        }
+
+    public:
+        dynamic_bitset &operator&=(const dynamic_bitset &obj) {
+            check_same_size(obj);
+            simd_bits_apply<_bits_and>(words, obj.words, num_words());
+            return *this;
+        }
+
+        dynamic_bitset &operator|=(const dynamic_bitset &obj) {
+            check_same_size(obj);
+            simd_bits_apply<_bits_or>(words, obj.words, num_words());
+            return *this;
+        }
+
+        dynamic_bitset &operator^=(const dynamic_bitset &obj) {
+            check_same_size(obj);
+            simd_bits_apply<_bits_xor>(words, obj.words, num_words());
+            return *this;
+        }
+
+        /**
+         * 差集：清除 obj 中为 1 的位
+         */
+        dynamic_bitset &operator-=(const dynamic_bitset &obj) {
+            check_same_size(obj);
+            simd_bits_apply<_bits_andnot>(words, obj.words, num_words());
+            return *this;
+        }
+
+        dynamic_bitset operator~() const {
+            dynamic_bitset result(*this);
+            result.flip();
+            return result;
+        }
+
+        bool operator==(const dynamic_bitset &obj) const {
+            return bit_count == obj.bit_count &&
+                   (bit_count == 0 || memcmp(words, obj.words, num_words() * sizeof(word_type)) == 0);
+        }
+
+        bool operator!=(const dynamic_bitset &obj) const {
+            return !(*this == obj);
+        }
+    };
+
+    inline dynamic_bitset operator&(const dynamic_bitset &a, const dynamic_bitset &b) {
+        dynamic_bitset result(a);
+        return result &= b;
+    }
+
+    inline dynamic_bitset operator|(const dynamic_bitset &a, const dynamic_bitset &b) {
+        dynamic_bitset result(a);
+        return result |= b;
+    }
+
+    inline dynamic_bitset operator^(const dynamic_bitset &a, const dynamic_bitset &b) {
+        dynamic_bitset result(a);
+        return result ^= b;
+    }
+
+    inline dynamic_bitset operator-(const dynamic_bitset &a, const dynamic_bitset &b) {
+        dynamic_bitset result(a);
+        return result -= b;
+    }
+}
+
+#endif //MICROSTL_DYNAMIC_BITSET_H
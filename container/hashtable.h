@@ -0,0 +1,618 @@
+#ifndef MICROSTL_HASHTABLE_H
+#define MICROSTL_HASHTABLE_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../algorithm/algobase.h"
+#include "../algorithm/simd.h"
+#include "../functor/functional.h"
+#include "../functor/hash.h"
+#include "../utility/pair.h"
+
+/**
+ * 开放寻址哈希表，unordered_map / unordered_set 的底层实现（SwissTable 布局）：
+ *
+ * - 元素直接存放在由 Alloc<Value> 分配的连续槽位中，另有一个与槽位一一对应的控制字节数组
+ *      - 控制字节为 0x80 表示空槽，否则为哈希值的低 7 位（H2）
+ *      - 槽位按 16 个一组，组内的 16 个控制字节用一次 SSE2 比较得到匹配的位掩码，
+ *        绝大多数查找只需要访问一组控制字节和一个槽位
+ * - 哈希值的其余位（H1）决定起始组，冲突时按三角数序列（+1、+2、+3……）依次探测下一组，
+ *   组数是 2 的幂，可以保证遍历所有组
+ * - 删除不使用墓碑：每组记录有多少个元素在插入时因为本组已满而越过本组（溢出计数）
+ *      - 查找在溢出计数为 0 的组停止
+ *      - 删除时把槽位直接置空，并将探测路径上各组的溢出计数减一，因此删除再多也不会拖慢查找
+ *      - 计数达到 255 后不再变化，只会让查找多探测几组，不影响正确性
+ * - 负载因子上限为 7/8，容量为不小于 16 的 2 的幂
+ * - 用户的哈希值先经过 _hash_mix 混合，整数的恒等哈希也能得到均匀的 H1、H2
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 每组的槽位数，等于一个 SSE2 寄存器的字节数
+     */
+    static const size_t HASHTABLE_GROUP_WIDTH = 16;
+    static const size_t HASHTABLE_MIN_CAPACITY = 16;
+
+    using _ctrl_t = signed char;
+    static const _ctrl_t HASHTABLE_CTRL_EMPTY = -128;
+
+    // --------------------- 控制字节组 --------------------------
+
+    /**
+     * 返回的位掩码中第 i 位对应组内第 i 个槽位
+     */
+    struct _hashtable_group {
+#if defined(MICROSTL_SIMD_X86) && defined(__SSE2__)
+        __m128i ctrl;
+
+        explicit _hashtable_group(const _ctrl_t *p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+        unsigned match(_ctrl_t h2) const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+        }
+
+        /**
+         * 只有空槽的最高位为 1
+         */
+        unsigned match_empty() const {
+            return static_cast<unsigned>(_mm_movemask_epi8(ctrl));
+        }
+#else
+        const _ctrl_t *ctrl;
+
+        explicit _hashtable_group(const _ctrl_t *p) : ctrl(p) {}
+
+        unsigned match(_ctrl_t h2) const {
+            unsigned result = 0;
+            for (size_t i = 0; i < HASHTABLE_GROUP_WIDTH; ++i) {
+                result |= static_cast<unsigned>(ctrl[i] == h2) << i;
+            }
+            return result;
+        }
+
+        unsigned match_empty() const {
+            return match(HASHTABLE_CTRL_EMPTY);
+        }
+#endif
+
+        unsigned match_full() const {
+            return ~match_empty() & 0xFFFFu;
+        }
+    };
+
+    // --------------------- 迭代器 --------------------------
+
+    /**
+     * 迭代器只依赖控制字节与槽位，不需要指向哈希表本身
+     */
+    template<typename Value, typename Reference, typename Pointer>
+    struct _hashtable_iterator {
+        using iterator_category = forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = ptrdiff_t;
+        using pointer = Pointer;
+        using reference = Reference;
+        using iterator = _hashtable_iterator<Value, Value &, Value *>;
+
+        const _ctrl_t *ctrl;
+        const _ctrl_t *ctrl_end;
+        Value *slot;
+
+        _hashtable_iterator() : ctrl(nullptr), ctrl_end(nullptr), slot(nullptr) {}
+
+        _hashtable_iterator(const _ctrl_t *ctrl, const _ctrl_t *ctrl_end, Value *slot)
+                : ctrl(ctrl), ctrl_end(ctrl_end), slot(slot) {}
+
+        _hashtable_iterator(const _hashtable_iterator &) = default;
+
+        _hashtable_iterator &operator=(const _hashtable_iterator &) = default;
+
+        /**
+         * iterator 可以隐式转换为 const_iterator
+         */
+        template<typename OtherReference, typename OtherPointer,
+                typename = typename std::enable_if<
+                        std::is_same<_hashtable_iterator<Value, OtherReference, OtherPointer>, iterator>::value &&
+                        !std::is_same<Reference, Value &>::value>::type>
+        _hashtable_iterator(const _hashtable_iterator<Value, OtherReference, OtherPointer> &obj)
+                : ctrl(obj.ctrl), ctrl_end(obj.ctrl_end), slot(obj.slot) {}
+
+        reference operator*() const {
+            return *slot;
+        }
+
+        pointer operator->() const {
+            return slot;
+        }
+
+        _hashtable_iterator &operator++() {
+            ++ctrl;
+            ++slot;
+            skip_empty();
+            return *this;
+        }
+
+        _hashtable_iterator operator++(int) {
+            _hashtable_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const _hashtable_iterator &obj) const {
+            return ctrl == obj.ctrl;
+        }
+
+        bool operator!=(const _hashtable_iterator &obj) const {
+            return ctrl != obj.ctrl;
+        }
+
+        /**
+         * 前进到下一个非空槽位，能读取一整组时每次跳过 16 个
+         */
+        void skip_empty() {
+            while (ctrl != ctrl_end) {
+                if (ctrl_end - ctrl >= static_cast<ptrdiff_t>(HASHTABLE_GROUP_WIDTH)) {
+                    unsigned full = _hashtable_group(ctrl).match_full();
+                    if (full != 0) {
+                        unsigned offset = __builtin_ctz(full);
+                        ctrl += offset;
+                        slot += offset;
+                        return;
+                    }
+                    ctrl += HASHTABLE_GROUP_WIDTH;
+                    slot += HASHTABLE_GROUP_WIDTH;
+                } else {
+                    if (*ctrl != HASHTABLE_CTRL_EMPTY) {
+                        return;
+                    }
+                    ++ctrl;
+                    ++slot;
+                }
+            }
+        }
+    };
+
+    // --------------------- hashtable --------------------------
+
+    /**
+     * key 唯一的哈希表，ExtractKey 从元素中取出 key
+     */
+    template<typename Value, typename Key, typename ExtractKey, typename Hash, typename KeyEqual>
+    class hashtable {
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using iterator = _hashtable_iterator<Value, Value &, Value *>;
+        using const_iterator = _hashtable_iterator<Value, const Value &, const Value *>;
+
+    protected:
+        using slot_allocator = Alloc<value_type>;
+        // 控制字节与溢出计数在同一块内存中
+        using ctrl_allocator = Alloc<unsigned char>;
+
+        _ctrl_t *ctrl;
+        // 每组一个溢出计数
+        unsigned char *overflow;
+        value_type *slots;
+        size_type slot_count;
+        size_type element_count;
+        Hash hash_fn;
+        KeyEqual equal_fn;
+        ExtractKey get_key;
+
+        size_type group_count() const {
+            return slot_count / HASHTABLE_GROUP_WIDTH;
+        }
+
+        static size_type max_load(size_type slots) {
+            return slots - slots / 8;
+        }
+
+        /**
+         * 能容纳 size 个元素的最小容量
+         */
+        static size_type capacity_for(size_type size) {
+            size_type result = HASHTABLE_MIN_CAPACITY;
+            while (max_load(result) < size) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        template<typename K>
+        size_t hash_of(const K &key) const {
+            return _hash_mix(hash_fn(key));
+        }
+
+        static _ctrl_t h2(size_t hash) {
+            return static_cast<_ctrl_t>(hash & 0x7F);
+        }
+
+        size_type home_group(size_t hash) const {
+            return (hash >> 7) & (group_count() - 1);
+        }
+
+        iterator make_iterator(size_type index) {
+            return iterator(ctrl + index, ctrl + slot_count, slots + index);
+        }
+
+        const_iterator make_iterator(size_type index) const {
+            return const_iterator(ctrl + index, ctrl + slot_count, slots + index);
+        }
+
+        /**
+         * 返回槽位下标，不存在时返回 slot_count
+         */
+        template<typename K>
+        size_type find_index(const K &key, size_t hash) const {
+            if (slot_count == 0) {
+                return 0;
+            }
+            const size_type mask = group_count() - 1;
+            size_type group = home_group(hash);
+            for (size_type step = 1;; ++step) {
+                _hashtable_group g(ctrl + group * HASHTABLE_GROUP_WIDTH);
+                for (unsigned bits = g.match(h2(hash)); bits != 0; bits &= bits - 1) {
+                    size_type index = group * HASHTABLE_GROUP_WIDTH + __builtin_ctz(bits);
+                    if (equal_fn(get_key(slots[index]), key)) {
+                        return index;
+                    }
+                }
+                if (overflow[group] == 0) {
+                    return slot_count;
+                }
+                group = (group + step) & mask;
+            }
+        }
+
+        /**
+         * 找到 hash 的探测路径上第一个空槽，并为越过的组增加溢出计数，调用前需保证有空间
+         */
+        size_type prepare_insert(size_t hash) {
+            const size_type mask = group_count() - 1;
+            size_type group = home_group(hash);
+            for (size_type step = 1;; ++step) {
+                unsigned empty = _hashtable_group(ctrl + group * HASHTABLE_GROUP_WIDTH).match_empty();
+                if (empty != 0) {
+                    return group * HASHTABLE_GROUP_WIDTH + __builtin_ctz(empty);
+                }
+                if (overflow[group] != 255) {
+                    ++overflow[group];
+                }
+                group = (group + step) & mask;
+            }
+        }
+
+        void allocate_table(size_type count) {
+            slot_count = count;
+            if (count == 0) {
+                ctrl = nullptr;
+                overflow = nullptr;
+                slots = nullptr;
+                return;
+            }
+            unsigned char *block = ctrl_allocator::allocate(count + count / HASHTABLE_GROUP_WIDTH);
+            ctrl = reinterpret_cast<_ctrl_t *>(block);
+            overflow = block + count;
+            memset(ctrl, HASHTABLE_CTRL_EMPTY, count);
+            memset(overflow, 0, count / HASHTABLE_GROUP_WIDTH);
+            slots = slot_allocator::allocate(count);
+        }
+
+        static void deallocate_table(_ctrl_t *ctrl, value_type *slots, size_type count) {
+            if (count != 0) {
+                ctrl_allocator::deallocate(reinterpret_cast<unsigned char *>(ctrl),
+                                           count + count / HASHTABLE_GROUP_WIDTH);
+                slot_allocator::deallocate(slots, count);
+            }
+        }
+
+        /**
+         * 重新分配 count 个槽位，并把元素移动过去
+         */
+        void resize(size_type count) {
+            _ctrl_t *old_ctrl = ctrl;
+            value_type *old_slots = slots;
+            size_type old_count = slot_count;
+            allocate_table(count);
+            for (size_type i = 0; i < old_count; ++i) {
+                if (old_ctrl[i] != HASHTABLE_CTRL_EMPTY) {
+                    size_t hash = hash_of(get_key(old_slots[i]));
+                    size_type index = prepare_insert(hash);
+                    new(slots + index) value_type(std::move(old_slots[i]));
+                    ctrl[index] = h2(hash);
+                    MicroSTL::destroy(old_slots + i);
+                }
+            }
+            deallocate_table(old_ctrl, old_slots, old_count);
+        }
+
+        void destroy_elements() {
+            for (size_type i = 0; i < slot_count; ++i) {
+                if (ctrl[i] != HASHTABLE_CTRL_EMPTY) {
+                    MicroSTL::destroy(slots + i);
+                }
+            }
+        }
+
+        void erase_index(size_type index) {
+            size_t hash = hash_of(get_key(slots[index]));
+            MicroSTL::destroy(slots + index);
+            ctrl[index] = HASHTABLE_CTRL_EMPTY;
+            --element_count;
+
+            // 撤销插入时在探测路径上增加的溢出计数
+            const size_type mask = group_count() - 1;
+            const size_type target = index / HASHTABLE_GROUP_WIDTH;
+            size_type group = home_group(hash);
+            for (size_type step = 1; group != target; ++step) {
+                if (overflow[group] != 255) {
+                    --overflow[group];
+                }
+                group = (group + step) & mask;
+            }
+        }
+
+    public:
+        hashtable() : ctrl(nullptr), overflow(nullptr), slots(nullptr), slot_count(0), element_count(0),
+                      hash_fn(), equal_fn(), get_key() {}
+
+        explicit hashtable(size_type count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+                : element_count(0), hash_fn(hash), equal_fn(equal), get_key() {
+            allocate_table(count == 0 ? 0 : capacity_for(count));
+        }
+
+        /**
+         * 直接复制控制字节与溢出计数，元素放在相同的槽位上，不需要重新哈希
+         */
+        hashtable(const hashtable &obj)
+                : element_count(0), hash_fn(obj.hash_fn), equal_fn(obj.equal_fn), get_key(obj.get_key) {
+            allocate_table(obj.slot_count);
+            if (slot_count == 0) {
+                return;
+            }
+            memcpy(overflow, obj.overflow, slot_count / HASHTABLE_GROUP_WIDTH);
+            try {
+                for (size_type i = 0; i < slot_count; ++i) {
+                    if (obj.ctrl[i] != HASHTABLE_CTRL_EMPTY) {
+                        new(slots + i) value_type(obj.slots[i]);
+                        ctrl[i] = obj.ctrl[i];
+                        ++element_count;
+                    }
+                }
+            } catch (...) {
+                destroy_elements();
+                deallocate_table(ctrl, slots, slot_count);
+                throw;
+            }
+        }
+
+        hashtable(hashtable &&obj) noexcept
+                : ctrl(obj.ctrl), overflow(obj.overflow), slots(obj.slots), slot_count(obj.slot_count),
+                  element_count(obj.element_count), hash_fn(obj.hash_fn), equal_fn(obj.equal_fn),
+                  get_key(obj.get_key) {
+            obj.ctrl = nullptr;
+            obj.overflow = nullptr;
+            obj.slots = nullptr;
+            obj.slot_count = 0;
+            obj.element_count = 0;
+        }
+
+        ~hashtable() {
+            destroy_elements();
+            deallocate_table(ctrl, slots, slot_count);
+        }
+
+        hashtable &operator=(const hashtable &obj) {
+            if (this != &obj) {
+                hashtable temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        hashtable &operator=(hashtable &&obj) noexcept {
+            if (this != &obj) {
+                hashtable temp(std::move(obj));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        void swap(hashtable &obj) {
+            MicroSTL::swap(ctrl, obj.ctrl);
+            MicroSTL::swap(overflow, obj.overflow);
+            MicroSTL::swap(slots, obj.slots);
+            MicroSTL::swap(slot_count, obj.slot_count);
+            MicroSTL::swap(element_count, obj.element_count);
+            MicroSTL::swap(hash_fn, obj.hash_fn);
+            MicroSTL::swap(equal_fn, obj.equal_fn);
+        }
+
+        iterator begin() {
+            iterator result(ctrl, ctrl + slot_count, slots);
+            result.skip_empty();
+            return result;
+        }
+
+        const_iterator begin() const {
+            const_iterator result(ctrl, ctrl + slot_count, slots);
+            result.skip_empty();
+            return result;
+        }
+
+        iterator end() {
+            return make_iterator(slot_count);
+        }
+
+        const_iterator end() const {
+            return make_iterator(slot_count);
+        }
+
+        bool empty() const {
+            return element_count == 0;
+        }
+
+        size_type size() const {
+            return element_count;
+        }
+
+        size_type bucket_count() const {
+            return slot_count;
+        }
+
+        float load_factor() const {
+            return slot_count == 0 ? 0.0f : static_cast<float>(element_count) / slot_count;
+        }
+
+        float max_load_factor() const {
+            return 0.875f;
+        }
+
+        hasher hash_function() const {
+            return hash_fn;
+        }
+
+        key_equal key_eq() const {
+            return equal_fn;
+        }
+
+        /**
+         * 保证插入 count 个元素之前不会再扩容
+         */
+        void reserve(size_type count) {
+            size_type capacity = capacity_for(count);
+            if (capacity > slot_count) {
+                resize(capacity);
+            }
+        }
+
+        /**
+         * 槽位数调整为不小于 count、且能容纳现有元素的 2 的幂，可以用来收缩
+         */
+        void rehash(size_type count) {
+            size_type capacity = capacity_for(element_count);
+            while (capacity < count) {
+                capacity <<= 1;
+            }
+            if (element_count == 0 && count == 0) {
+                capacity = 0;
+            }
+            if (capacity != slot_count) {
+                resize(capacity);
+            }
+        }
+
+        /**
+         * key 不存在时在空槽上调用 construct(slot) 构造元素，构造成功后才标记为已占用
+         */
+        template<typename K, typename Construct>
+        pair<iterator, bool> insert_with(const K &key, Construct construct) {
+            size_t hash = hash_of(key);
+            size_type index = find_index(key, hash);
+            if (index != slot_count) {
+                return pair<iterator, bool>(make_iterator(index), false);
+            }
+            if (element_count + 1 > max_load(slot_count)) {
+                resize(slot_count == 0 ? HASHTABLE_MIN_CAPACITY : slot_count * 2);
+            }
+            index = prepare_insert(hash);
+            construct(slots + index);
+            ctrl[index] = h2(hash);
+            ++element_count;
+            return pair<iterator, bool>(make_iterator(index), true);
+        }
+
+        pair<iterator, bool> insert_unique(const value_type &value) {
+            return insert_with(get_key(value), [&value](value_type *slot) {
+                new(slot) value_type(value);
+            });
+        }
+
+        pair<iterator, bool> insert_unique(value_type &&value) {
+            return insert_with(get_key(value), [&value](value_type *slot) {
+                new(slot) value_type(std::move(value));
+            });
+        }
+
+        /**
+         * 需要先构造出元素才能得到 key
+         */
+        template<typename... Args>
+        pair<iterator, bool> emplace_unique(Args &&... args) {
+            value_type value(std::forward<Args>(args)...);
+            return insert_unique(std::move(value));
+        }
+
+        template<typename K>
+        iterator find(const K &key) {
+            if (slot_count == 0) {
+                return end();
+            }
+            return make_iterator(find_index(key, hash_of(key)));
+        }
+
+        template<typename K>
+        const_iterator find(const K &key) const {
+            if (slot_count == 0) {
+                return end();
+            }
+            return make_iterator(find_index(key, hash_of(key)));
+        }
+
+        template<typename K>
+        size_type count(const K &key) const {
+            return find(key) == end() ? 0 : 1;
+        }
+
+        iterator erase(const_iterator position) {
+            size_type index = position.ctrl - ctrl;
+            erase_index(index);
+            iterator result = make_iterator(index);
+            result.skip_empty();
+            return result;
+        }
+
+        template<typename K>
+        size_type erase_key(const K &key) {
+            if (slot_count == 0) {
+                return 0;
+            }
+            size_type index = find_index(key, hash_of(key));
+            if (index == slot_count) {
+                return 0;
+            }
+            erase_index(index);
+            return 1;
+        }
+
+        /**
+         * 保留槽位
+         */
+        void clear() {
+            destroy_elements();
+            if (slot_count != 0) {
+                memset(ctrl, HASHTABLE_CTRL_EMPTY, slot_count);
+                memset(overflow, 0, slot_count / HASHTABLE_GROUP_WIDTH);
+            }
+            element_count = 0;
+        }
+    };
+}
+
+#endif //MICROSTL_HASHTABLE_H
@@ -5,6 +5,9 @@
 #include "../memory/alloc.h"
 #include "../memory/construct.h"
 #include "../algorithm/algobase.h"
+#include "../utility/hardening.h"
+#include "../utility/trace.h"
+#include <type_traits>
 
 namespace MicroSTL {
     // --------------------- 双向链表结构 --------------------------
@@ -13,6 +16,10 @@ namespace MicroSTL {
         using void_pointer = _list_node<T> *;
         void_pointer prev;
         void_pointer next;
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+        // 所属链表的头节点，头节点指向自己
+        void_pointer owner;
+#endif
         T data;
     };
 
@@ -32,12 +39,43 @@ namespace MicroSTL {
         using difference_type = ptrdiff_t;
 
         link_type node;
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+        // 创建时节点在登记表中的编号，节点被删除或内存被复用后不再相等
+        size_t serial = 0;
+#endif
 
         list_iterator() = default;
 
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+        list_iterator(link_type iter) : node(iter), serial(_debug_node_registry::instance().serial(iter)) {}
+#else
         list_iterator(link_type iter) : node(iter) {}
+#endif
 
-        list_iterator(const iterator &iter) : node(iter.node) {}
+        list_iterator(const list_iterator &) = default;
+
+        list_iterator &operator=(const list_iterator &) = default;
+
+        // iterator 可以转换为 const_iterator
+        template<typename R, typename P,
+                typename = typename std::enable_if<
+                        std::is_same<list_iterator<T, R, P>, iterator>::value && !std::is_same<Ref, T &>::value>::type>
+        list_iterator(const list_iterator<T, R, P> &iter) : node(iter.node) {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            serial = iter.serial;
+#endif
+        }
+
+        /**
+         * 完全加固时检查迭代器指向的节点仍然存活，之后才可以读取节点；其他级别为空
+         */
+        void verify() const {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            MICROSTL_CHECK(node != nullptr, "using a singular list iterator");
+            MICROSTL_CHECK(serial != 0 && _debug_node_registry::instance().serial(node) == serial,
+                           "list iterator points to an erased node");
+#endif
+        }
 
         bool operator==(const self &iter) const {
             return node == iter.node;
@@ -48,6 +86,11 @@ namespace MicroSTL {
         }
 
         reference operator*() const {
+            MICROSTL_CHECK(node != nullptr, "dereferencing a singular list iterator");
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            verify();
+            MICROSTL_CHECK(node->owner != node, "dereferencing list::end()");
+#endif
             return (*node).data;
         }
 
@@ -56,7 +99,12 @@ namespace MicroSTL {
         }
 
         self &operator++() {
+            verify();
             node = link_type((*node).next);
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            serial = _debug_node_registry::instance().serial(node);
+#endif
+            return *this;
         }
 
         self operator++(int) {
@@ -66,7 +114,12 @@ namespace MicroSTL {
         }
 
         self &operator--() {
+            verify();
             node = link_type((*node).prev);
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            serial = _debug_node_registry::instance().serial(node);
+#endif
+            return *this;
         }
 
         self operator--(int) {
@@ -84,59 +137,97 @@ namespace MicroSTL {
         using list_node = _list_node<T>;
         list_node *node;
         using list_node_allocator = Alloc<list_node>;
+        // 定义 MICROSTL_TRACE 时记录 size() 等 O(n) 操作，否则为空
+        [[no_unique_address]] _trace_handle trace;
     public:
         using link_type = _list_node<T> *;
         using value_type = T;
         using size_type = size_t;
         using pointer = T *;
         using reference = T &;
+        using const_reference = const T &;
         using iterator = list_iterator<T, T &, T *>;
+        using const_iterator = list_iterator<T, const T &, const T *>;
 
         iterator begin() {
             return link_type((*node).next);
         }
 
+        const_iterator begin() const {
+            return link_type((*node).next);
+        }
+
         iterator end() {
             return node;
         }
 
+        const_iterator end() const {
+            return node;
+        }
+
         bool empty() const {
             return node->next == node;
         }
 
+        // 不单独记录长度，需要遍历整个链表
         size_type size() const {
+            trace.linear();
             size_type result = 0;
-            for (auto first = begin(); first != end(); ++first) {
+            for (const_iterator first = begin(); first != end(); ++first) {
                 ++result;
             }
             return result;
         }
 
         reference front() {
+            MICROSTL_CHECK(!empty(), "list::front on empty list");
+            return *begin();
+        }
+
+        const_reference front() const {
+            MICROSTL_CHECK(!empty(), "list::front on empty list");
             return *begin();
         }
 
         reference back() {
+            MICROSTL_CHECK(!empty(), "list::back on empty list");
+            return *(--end());
+        }
+
+        const_reference back() const {
+            MICROSTL_CHECK(!empty(), "list::back on empty list");
             return *(--end());
         }
 
     protected:
         link_type get_node() {
-            return list_node_allocator::allocate();
+            link_type ptr = list_node_allocator::allocate();
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            _debug_node_registry::instance().add(ptr);
+#endif
+            return ptr;
         }
 
         void put_node(link_type ptr) {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            _debug_node_registry::instance().remove(ptr);
+#endif
             list_node_allocator::deallocate(ptr);
         }
 
         link_type create_node(const T &obj) {
             link_type ptr = get_node();
-            construct(&ptr->data, obj);
+            try {
+                MicroSTL::construct(&ptr->data, obj);
+            } catch (...) {
+                put_node(ptr);
+                throw;
+            }
             return ptr;
         }
 
         void destroy_node(link_type ptr) {
-            destroy(&ptr->data);
+            MicroSTL::destroy(&ptr->data);
             put_node(ptr);
         }
 
@@ -145,11 +236,59 @@ namespace MicroSTL {
             node = get_node();
             node->next = node;
             node->prev = node;
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            node->owner = node;
+#endif
+        }
+
+        /**
+         * 完全加固时检查迭代器属于 obj；其他级别为空
+         */
+        void check_owner(iterator iter, const list &obj) const {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            iter.verify();
+            MICROSTL_CHECK(iter.node->owner == obj.node, "iterator does not belong to this list");
+#else
+            (void) iter;
+            (void) obj;
+#endif
+        }
+
+        // 将[first, last)内的元素移动到position之前
+        void transfer(iterator position, iterator first, iterator last);
+
+    public:
+        list(_trace_location location = _trace_location::current()) : trace("list", location) {
+            empty_initialize();
+        }
+
+        list(const list &obj, _trace_location location = _trace_location::current()) : trace("list", location) {
+            empty_initialize();
+            for (const_iterator first = obj.begin(); first != obj.end(); ++first) {
+                push_back(*first);
+            }
+        }
+
+        list &operator=(const list &obj) {
+            if (this != &obj) {
+                list tmp(obj);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        ~list() {
+            clear();
+            put_node(node);
         }
 
         // 在position处插入一个node
         iterator insert(iterator position, const T &obj) {
+            check_owner(position, *this);
             link_type temp = create_node(obj);
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            temp->owner = node;
+#endif
             temp->next = position.node;
             temp->prev = position.node->prev;
             (link_type(position.node->prev))->next = temp;
@@ -166,6 +305,8 @@ namespace MicroSTL {
         }
 
         iterator erase(iterator position) {
+            MICROSTL_CHECK(position.node != node, "list::erase(end())");
+            check_owner(position, *this);
             link_type next_node = link_type(position.node->next);
             link_type prev_node = link_type(position.node->prev);
             prev_node->next = next_node;
@@ -175,37 +316,41 @@ namespace MicroSTL {
         }
 
         void pop_front() {
+            MICROSTL_CHECK(!empty(), "list::pop_front on empty list");
             erase(begin());
         }
 
         void pop_back() {
+            MICROSTL_CHECK(!empty(), "list::pop_back on empty list");
             iterator temp = end();
             erase(--temp);
         }
 
+        // 删除所有节点，保留头节点
+        void clear();
+
         // 移除目标值
         void remove(const T &obj);
 
         // 移除连续而相同的元素
         void unique();
 
-        // 将[first, last)内的元素移动到position之前
-        void transfer(iterator position, iterator first, iterator last);
-
-        void list_swap(list &obj);
-
-    public:
-        list() {
-            empty_initialize();
+        // 只需要交换头节点
+        void swap(list &obj) {
+            MicroSTL::swap(node, obj.node);
         }
 
         void splice(iterator position, list &obj) {
+            check_owner(position, *this);
             if (!obj.empty()) {
                 transfer(position, obj.begin(), obj.end());
             }
         }
 
-        void splice(iterator position, list &, iterator iter_i) {
+        void splice(iterator position, list &obj, iterator iter_i) {
+            check_owner(position, *this);
+            check_owner(iter_i, obj);
+            MICROSTL_CHECK(iter_i != obj.end(), "list::splice of end()");
             iterator iter_j = iter_i;
             ++iter_j;
             if (position == iter_i || position == iter_j) {
@@ -214,7 +359,10 @@ namespace MicroSTL {
             transfer(position, iter_i, iter_j);
         }
 
-        void splice(iterator position, list &, iterator first, iterator last) {
+        void splice(iterator position, list &obj, iterator first, iterator last) {
+            check_owner(position, *this);
+            check_owner(first, obj);
+            check_owner(last, obj);
             if (first != last) {
                 transfer(position, first, last);
             }
@@ -226,10 +374,22 @@ namespace MicroSTL {
         // 反转
         void reverse();
 
-        // 快排方案
+        // 非递归的归并排序，只调整指针，不复制元素
         void sort();
     };
 
+    template<typename T>
+    void list<T>::clear() {
+        link_type current = link_type(node->next);
+        while (current != node) {
+            link_type temp = current;
+            current = link_type(current->next);
+            destroy_node(temp);
+        }
+        node->next = node;
+        node->prev = node;
+    }
+
     template<typename T>
     void list<T>::remove(const T &value) {
         iterator first = begin();
@@ -265,6 +425,12 @@ namespace MicroSTL {
     template<typename T>
     void list<T>::transfer(list::iterator position, list::iterator first, list::iterator last) {
         if (position != last) {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            // 节点换了所属链表，需要逐个更新，完全加固时 splice 变为 O(n)
+            for (link_type current = first.node; current != last.node; current = link_type(current->next)) {
+                current->owner = node;
+            }
+#endif
             (*(link_type((*last.node).prev))).next = position.node;
             (*(link_type((*first.node).prev))).next = last.node;
             (*(link_type((*position.node).prev))).next = first.node;
@@ -291,9 +457,9 @@ namespace MicroSTL {
             } else {
                 ++first1;
             }
-            if (first2 != last2) {
-                transfer(last1, first2, last2);
-            }
+        }
+        if (first2 != last2) {
+            transfer(last1, first2, last2);
         }
     }
 
@@ -329,33 +495,23 @@ namespace MicroSTL {
             carry.splice(carry.begin(), *this, begin());
             int i = 0;
 
+            // counter[i] 存放 2^i 个有序元素，carry 逐级向上合并
             while (i < fill && !counter[i].empty()) {
                 counter[i].merge(carry);
-                carry.list_swap(counter[i++]);
+                carry.swap(counter[i++]);
             }
 
-            carry.list_swap(counter[i]);
+            carry.swap(counter[i]);
             if (i == fill) {
                 ++fill;
             }
-
-            for (int i = 1; i < fill; ++i) {
-                counter[i].merge(counter[i - 1]);
-            }
-
-            swap(counter[fill - 1]);
         }
-    }
 
-    template<class T>
-    void list<T>::list_swap(list &obj) {
-        iterator head1 = begin();
-        iterator tail1 = end();
-        iterator head2 = obj.begin();
-        iterator tail2 = obj.end();
+        for (int i = 1; i < fill; ++i) {
+            counter[i].merge(counter[i - 1]);
+        }
 
-        swap(head1.node, head2.node);
-        swap(tail1.node, tail2.node);
+        swap(counter[fill - 1]);
     }
 }
 
@@ -0,0 +1,346 @@
+#ifndef MICROSTL_MAP_H
+#define MICROSTL_MAP_H
+
+#include <stdexcept>
+#include <utility>
+#include "rb_tree.h"
+
+/**
+ * 基于红黑树的有序关联容器，元素为 pair<const Key, T>：
+ *
+ * - map 的 key 唯一，multimap 允许重复的 key，相等的元素按插入顺序排列
+ * - 插入、删除不会使其他元素的迭代器失效
+ * - 以 end() 为提示按顺序插入、或者从已排序的区间构造时，不需要从根开始查找
+ */
+
+namespace MicroSTL {
+
+    // --------------------- map --------------------------
+
+    template<typename Key, typename T, typename Compare = less<Key>>
+    class map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = pair<const Key, T>;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using tree_type = rb_tree<Key, value_type, select1st<value_type>, Compare>;
+        tree_type tree;
+
+    public:
+        using iterator = typename tree_type::iterator;
+        using const_iterator = typename tree_type::const_iterator;
+
+        map() : tree() {}
+
+        explicit map(const Compare &comp) : tree(comp) {}
+
+        /**
+         * 区间按 key 严格递增时 O(n) 建树
+         */
+        template<typename InputIterator>
+        map(InputIterator first, InputIterator last) : tree() {
+            tree.insert_unique(first, last);
+        }
+
+        iterator begin() {
+            return tree.begin();
+        }
+
+        const_iterator begin() const {
+            return tree.begin();
+        }
+
+        iterator end() {
+            return tree.end();
+        }
+
+        const_iterator end() const {
+            return tree.end();
+        }
+
+        bool empty() const {
+            return tree.empty();
+        }
+
+        size_type size() const {
+            return tree.size();
+        }
+
+        key_compare key_comp() const {
+            return tree.key_comp();
+        }
+
+        T &operator[](const key_type &k) {
+            iterator iter = tree.lower_bound(k);
+            if (iter == end() || key_comp()(k, iter->first)) {
+                iter = tree.emplace_hint_unique(iter, k, T());
+            }
+            return iter->second;
+        }
+
+        T &at(const key_type &k) {
+            iterator iter = tree.find(k);
+            if (iter == end()) {
+                throw std::out_of_range("map::at");
+            }
+            return iter->second;
+        }
+
+        const T &at(const key_type &k) const {
+            const_iterator iter = tree.find(k);
+            if (iter == end()) {
+                throw std::out_of_range("map::at");
+            }
+            return iter->second;
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            return tree.insert_unique(value);
+        }
+
+        /**
+         * 新元素恰好位于 hint 之前时 O(1) 找到插入位置
+         */
+        iterator insert(const_iterator hint, const value_type &value) {
+            return tree.insert_unique(hint, value);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            tree.insert_unique(first, last);
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            return tree.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const_iterator hint, Args &&... args) {
+            return tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
+        }
+
+        void erase(const_iterator position) {
+            tree.erase(position);
+        }
+
+        void erase(iterator position) {
+            tree.erase(position);
+        }
+
+        size_type erase(const key_type &k) {
+            return tree.erase(k);
+        }
+
+        void erase(const_iterator first, const_iterator last) {
+            tree.erase(first, last);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        void swap(map &obj) {
+            tree.swap(obj.tree);
+        }
+
+        iterator find(const key_type &k) {
+            return tree.find(k);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return tree.find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return tree.find(k) == end() ? 0 : 1;
+        }
+
+        bool contains(const key_type &k) const {
+            return tree.find(k) != end();
+        }
+
+        iterator lower_bound(const key_type &k) {
+            return tree.lower_bound(k);
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return tree.lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type &k) {
+            return tree.upper_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return tree.upper_bound(k);
+        }
+
+        pair<iterator, iterator> equal_range(const key_type &k) {
+            return tree.equal_range(k);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return tree.equal_range(k);
+        }
+    };
+
+    // --------------------- multimap --------------------------
+
+    template<typename Key, typename T, typename Compare = less<Key>>
+    class multimap {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = pair<const Key, T>;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using tree_type = rb_tree<Key, value_type, select1st<value_type>, Compare>;
+        tree_type tree;
+
+    public:
+        using iterator = typename tree_type::iterator;
+        using const_iterator = typename tree_type::const_iterator;
+
+        multimap() : tree() {}
+
+        explicit multimap(const Compare &comp) : tree(comp) {}
+
+        /**
+         * 区间按 key 非递减时 O(n) 建树
+         */
+        template<typename InputIterator>
+        multimap(InputIterator first, InputIterator last) : tree() {
+            tree.insert_equal(first, last);
+        }
+
+        iterator begin() {
+            return tree.begin();
+        }
+
+        const_iterator begin() const {
+            return tree.begin();
+        }
+
+        iterator end() {
+            return tree.end();
+        }
+
+        const_iterator end() const {
+            return tree.end();
+        }
+
+        bool empty() const {
+            return tree.empty();
+        }
+
+        size_type size() const {
+            return tree.size();
+        }
+
+        key_compare key_comp() const {
+            return tree.key_comp();
+        }
+
+        iterator insert(const value_type &value) {
+            return tree.insert_equal(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type &value) {
+            return tree.insert_equal(hint, value);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            tree.insert_equal(first, last);
+        }
+
+        template<typename... Args>
+        iterator emplace(Args &&... args) {
+            return tree.emplace_equal(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const_iterator hint, Args &&... args) {
+            return tree.emplace_hint_equal(hint, std::forward<Args>(args)...);
+        }
+
+        void erase(const_iterator position) {
+            tree.erase(position);
+        }
+
+        void erase(iterator position) {
+            tree.erase(position);
+        }
+
+        size_type erase(const key_type &k) {
+            return tree.erase(k);
+        }
+
+        void erase(const_iterator first, const_iterator last) {
+            tree.erase(first, last);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        void swap(multimap &obj) {
+            tree.swap(obj.tree);
+        }
+
+        iterator find(const key_type &k) {
+            return tree.find(k);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return tree.find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return tree.count(k);
+        }
+
+        bool contains(const key_type &k) const {
+            return tree.find(k) != end();
+        }
+
+        iterator lower_bound(const key_type &k) {
+            return tree.lower_bound(k);
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return tree.lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type &k) {
+            return tree.upper_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return tree.upper_bound(k);
+        }
+
+        pair<iterator, iterator> equal_range(const key_type &k) {
+            return tree.equal_range(k);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return tree.equal_range(k);
+        }
+    };
+}
+
+#endif //MICROSTL_MAP_H
@@ -0,0 +1,457 @@
+#ifndef MICROSTL_MAPPED_VECTOR_H
+#define MICROSTL_MAPPED_VECTOR_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include "../utility/hardening.h"
+
+/**
+ * 以文件为存储的 vector，元素必须可平凡复制：
+ *
+ * - 文件内容就是元素数组本身，没有头部，size() == 文件大小 / sizeof(T)，已有的 POD 记录文件可以直接打开
+ * - 存储是文件的 MAP_SHARED 映射：打开不需要读取与解析，只读打开几乎是瞬间完成的，
+ *   多个进程映射同一个文件时共享同一份 page cache
+ * - 迭代器为原生指针，可以直接交给 MicroSTL 与标准库的算法
+ * - 扩容时先用 ftruncate 扩大文件，再用 mremap 扩大映射（必要时由内核移动映射地址），容量翻倍；
+ *   打开期间文件可能比元素多出未使用的容量，close() 与析构时把文件截断为 size() 个元素
+ * - flush() 调用 msync 把修改写回文件；不调用时由内核在之后写回，进程崩溃不会丢失已写入映射的数据
+ * - 系统调用失败时抛出 std::system_error；只读打开的 mapped_vector 上调用修改长度的操作抛出 std::logic_error，
+ *   通过 operator[] 等写入只读映射会触发 SIGSEGV，只读打开时应只通过 const 引用访问
+ */
+
+namespace MicroSTL {
+
+    enum class map_mode {
+        // 只读打开已有的文件
+        read_only,
+        // 读写打开，文件不存在时创建
+        read_write,
+        // 读写打开并清空原有内容
+        truncate
+    };
+
+    template<typename T>
+    class mapped_vector {
+        static_assert(std::is_trivially_copyable<T>::value, "mapped_vector 的元素必须可平凡复制");
+
+    public:
+        using value_type = T;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using iterator = value_type *;
+        using const_iterator = const value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+    protected:
+        int fd;
+        bool writable;
+        pointer start;
+        size_type count;
+        // 映射的元素个数，也是打开期间文件的长度
+        size_type cap;
+
+        [[noreturn]] static void fail(const char *what) {
+            throw std::system_error(errno, std::generic_category(), std::string("mapped_vector: ") + what);
+        }
+
+        void check_writable() const {
+            if (!writable) {
+                throw std::logic_error("mapped_vector: modifying a read-only mapping");
+            }
+        }
+
+        /**
+         * 把文件与映射扩大到 new_capacity 个元素
+         */
+        void remap(size_type new_capacity) {
+            check_writable();
+            size_t new_bytes = new_capacity * sizeof(T);
+            if (ftruncate(fd, static_cast<off_t>(new_bytes)) != 0) {
+                fail("ftruncate");
+            }
+            void *result;
+            if (start == nullptr) {
+                result = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            } else {
+                result = mremap(start, cap * sizeof(T), new_bytes, MREMAP_MAYMOVE);
+            }
+            if (result == MAP_FAILED) {
+                fail(start == nullptr ? "mmap" : "mremap");
+            }
+            start = static_cast<pointer>(result);
+            cap = new_capacity;
+        }
+
+        void grow(size_type required) {
+            size_type doubled = cap * 2;
+            // 第一次扩容至少占满一个页
+            size_type minimum = sysconf(_SC_PAGESIZE) / sizeof(T);
+            size_type new_capacity = required > doubled ? required : doubled;
+            remap(new_capacity > minimum ? new_capacity : minimum);
+        }
+
+    public:
+        mapped_vector() : fd(-1), writable(false), start(nullptr), count(0), cap(0) {}
+
+        explicit mapped_vector(const char *path, map_mode mode = map_mode::read_write) : mapped_vector() {
+            open(path, mode);
+        }
+
+        mapped_vector(const mapped_vector &) = delete;
+
+        mapped_vector &operator=(const mapped_vector &) = delete;
+
+        mapped_vector(mapped_vector &&obj) noexcept
+                : fd(obj.fd), writable(obj.writable), start(obj.start), count(obj.count), cap(obj.cap) {
+            obj.fd = -1;
+            obj.start = nullptr;
+            obj.count = obj.cap = 0;
+        }
+
+        mapped_vector &operator=(mapped_vector &&obj) noexcept {
+            if (this != &obj) {
+                mapped_vector temp(static_cast<mapped_vector &&>(obj));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        ~mapped_vector() {
+            try {
+                close();
+            } catch (...) {
+                // 析构中无法报告错误，已写入映射的数据仍由内核写回
+            }
+        }
+
+        void swap(mapped_vector &obj) noexcept {
+            std::swap(fd, obj.fd);
+            std::swap(writable, obj.writable);
+            std::swap(start, obj.start);
+            std::swap(count, obj.count);
+            std::swap(cap, obj.cap);
+        }
+
+        // --------------------- 打开与关闭 --------------------------
+
+        /**
+         * 映射 path，之前打开的文件先关闭；文件大小不是 sizeof(T) 的整数倍时抛出 std::runtime_error
+         */
+        void open(const char *path, map_mode mode = map_mode::read_write) {
+            close();
+            int flags = mode == map_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+            if (mode == map_mode::truncate) {
+                flags |= O_TRUNC;
+            }
+            int file = ::open(path, flags | O_CLOEXEC, 0644);
+            if (file < 0) {
+                fail("open");
+            }
+            struct stat info;
+            if (fstat(file, &info) != 0) {
+                int error = errno;
+                ::close(file);
+                errno = error;
+                fail("fstat");
+            }
+            size_t bytes = static_cast<size_t>(info.st_size);
+            if (bytes % sizeof(T) != 0) {
+                ::close(file);
+                throw std::runtime_error("mapped_vector: file size is not a multiple of the element size");
+            }
+            void *result = nullptr;
+            if (bytes != 0) {
+                int protection = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+                result = mmap(nullptr, bytes, protection, MAP_SHARED, file, 0);
+                if (result == MAP_FAILED) {
+                    int error = errno;
+                    ::close(file);
+                    errno = error;
+                    fail("mmap");
+                }
+            }
+            fd = file;
+            writable = mode != map_mode::read_only;
+            start = static_cast<pointer>(result);
+            count = cap = bytes / sizeof(T);
+        }
+
+        /**
+         * 解除映射，把文件截断为 size() 个元素后关闭；没有打开时什么也不做
+         */
+        void close() {
+            if (fd < 0) {
+                return;
+            }
+            if (start != nullptr) {
+                munmap(start, cap * sizeof(T));
+            }
+            int result = 0;
+            if (writable && count != cap) {
+                result = ftruncate(fd, static_cast<off_t>(count * sizeof(T)));
+            }
+            int error = errno;
+            ::close(fd);
+            fd = -1;
+            start = nullptr;
+            count = cap = 0;
+            if (result != 0) {
+                errno = error;
+                fail("ftruncate");
+            }
+        }
+
+        bool is_open() const {
+            return fd >= 0;
+        }
+
+        bool read_only() const {
+            return !writable;
+        }
+
+        /**
+         * 把修改写回文件，async 为 true 时只安排写回、不等待完成
+         */
+        void flush(bool async = false) {
+            if (start != nullptr && writable && msync(start, cap * sizeof(T), async ? MS_ASYNC : MS_SYNC) != 0) {
+                fail("msync");
+            }
+        }
+
+        /**
+         * 转发给 madvise，如顺序扫描前传入 MADV_SEQUENTIAL、即将访问全部数据时传入 MADV_WILLNEED
+         */
+        void advise(int advice) const {
+            if (start != nullptr && madvise(start, cap * sizeof(T), advice) != 0) {
+                fail("madvise");
+            }
+        }
+
+        // --------------------- 元素访问 --------------------------
+
+        iterator begin() {
+            return start;
+        }
+
+        const_iterator begin() const {
+            return start;
+        }
+
+        iterator end() {
+            return start + count;
+        }
+
+        const_iterator end() const {
+            return start + count;
+        }
+
+        pointer data() {
+            return start;
+        }
+
+        const_pointer data() const {
+            return start;
+        }
+
+        size_type size() const {
+            return count;
+        }
+
+        size_type capacity() const {
+            return cap;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        reference operator[](size_type n) {
+            MICROSTL_CHECK(n < count, "mapped_vector index out of range");
+            return start[n];
+        }
+
+        const_reference operator[](size_type n) const {
+            MICROSTL_CHECK(n < count, "mapped_vector index out of range");
+            return start[n];
+        }
+
+        reference at(size_type n) {
+            if (n >= count) {
+                throw std::out_of_range("mapped_vector::at");
+            }
+            return start[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= count) {
+                throw std::out_of_range("mapped_vector::at");
+            }
+            return start[n];
+        }
+
+        reference front() {
+            MICROSTL_CHECK(count != 0, "front on empty mapped_vector");
+            return start[0];
+        }
+
+        const_reference front() const {
+            MICROSTL_CHECK(count != 0, "front on empty mapped_vector");
+            return start[0];
+        }
+
+        reference back() {
+            MICROSTL_CHECK(count != 0, "back on empty mapped_vector");
+            return start[count - 1];
+        }
+
+        const_reference back() const {
+            MICROSTL_CHECK(count != 0, "back on empty mapped_vector");
+            return start[count - 1];
+        }
+
+        // --------------------- 修改 --------------------------
+
+        void reserve(size_type new_capacity) {
+            if (new_capacity > cap) {
+                remap(new_capacity);
+            }
+        }
+
+        void push_back(const T &value) {
+            if (count == cap) {
+                // value 可能指向映射内部，扩容前先复制出来
+                T copy = value;
+                grow(count + 1);
+                start[count++] = copy;
+                return;
+            }
+            start[count++] = value;
+        }
+
+        /**
+         * 追加 [first, last) 中的元素，只扩容一次
+         */
+        void append(const T *first, const T *last) {
+            size_type n = last - first;
+            if (n == 0) {
+                return;
+            }
+            check_writable();
+            if (count + n > cap) {
+                // 区间可能位于映射内部，先记下偏移
+                bool inside = first >= start && first < start + count;
+                size_type offset = first - start;
+                grow(count + n);
+                if (inside) {
+                    first = start + offset;
+                }
+            }
+            memmove(start + count, first, n * sizeof(T));
+            count += n;
+        }
+
+        void pop_back() {
+            MICROSTL_CHECK(count != 0, "pop_back on empty mapped_vector");
+            check_writable();
+            --count;
+        }
+
+        iterator insert(const_iterator position, const T &value) {
+            size_type offset = position - start;
+            MICROSTL_CHECK(offset <= count, "iterator does not belong to this mapped_vector");
+            T copy = value;
+            if (count == cap) {
+                grow(count + 1);
+            }
+            check_writable();
+            memmove(start + offset + 1, start + offset, (count - offset) * sizeof(T));
+            start[offset] = copy;
+            ++count;
+            return start + offset;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            size_type offset = first - start;
+            size_type n = last - first;
+            MICROSTL_CHECK(offset <= count && n <= count - offset, "invalid range");
+            check_writable();
+            memmove(start + offset, start + offset + n, (count - offset - n) * sizeof(T));
+            count -= n;
+            return start + offset;
+        }
+
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+
+        /**
+         * 新增的元素为 value；缩短时不缩小文件，直到 shrink_to_fit 或 close
+         */
+        void resize(size_type new_size, const T &value) {
+            check_writable();
+            if (new_size > cap) {
+                T copy = value;
+                grow(new_size);
+                std::fill(start + count, start + new_size, copy);
+            } else if (new_size > count) {
+                std::fill(start + count, start + new_size, value);
+            }
+            count = new_size;
+        }
+
+        /**
+         * 新增的元素值初始化
+         */
+        void resize(size_type new_size) {
+            resize(new_size, T());
+        }
+
+        void clear() {
+            check_writable();
+            count = 0;
+        }
+
+        /**
+         * 把文件与映射缩小到 size() 个元素
+         */
+        void shrink_to_fit() {
+            if (count == cap) {
+                return;
+            }
+            check_writable();
+            if (count == 0) {
+                munmap(start, cap * sizeof(T));
+                start = nullptr;
+                cap = 0;
+                if (ftruncate(fd, 0) != 0) {
+                    fail("ftruncate");
+                }
+                return;
+            }
+            void *result = mremap(start, cap * sizeof(T), count * sizeof(T), 0);
+            if (result == MAP_FAILED) {
+                fail("mremap");
+            }
+            cap = count;
+            if (ftruncate(fd, static_cast<off_t>(count * sizeof(T))) != 0) {
+                fail("ftruncate");
+            }
+        }
+    };
+}
+
+#endif //MICROSTL_MAPPED_VECTOR_H
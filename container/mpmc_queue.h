@@ -0,0 +1,198 @@
+#ifndef MICROSTL_MPMC_QUEUE_H
+#define MICROSTL_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "ring_buffer.h"
+
+/**
+ * 多生产者多消费者的有界无锁队列（Dmitry Vyukov 的算法）：
+ *
+ * - 每个槽位带一个序号：
+ *      - 序号等于 pos 时槽位空闲，可以写入第 pos 个元素，写入后序号置为 pos + 1
+ *      - 序号等于 pos + 1 时第 pos 个元素可读，取出后序号置为 pos + capacity，留给下一圈的写入
+ * - 生产者与消费者各自只用一次 CAS 争抢 enqueue_pos / dequeue_pos，两个计数各占一条 cache line
+ * - push_batch / pop_batch 先检查连续的若干个槽位是否就绪，再用一次 CAS 占下整段，减少争抢
+ * - 存储在构造时分配，之后不再分配内存；满或空时立即返回，不会阻塞
+ */
+
+namespace MicroSTL {
+
+    template<typename T>
+    struct _mpmc_cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() {
+            return reinterpret_cast<T *>(storage);
+        }
+    };
+
+    template<typename T>
+    class mpmc_queue {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+
+    protected:
+        using cell = _mpmc_cell<T>;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> enqueue_pos;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> dequeue_pos;
+        alignas(CACHE_LINE_SIZE) _ring_storage<cell> cells;
+
+        static intptr_t distance(size_type sequence, size_type position) {
+            return static_cast<intptr_t>(sequence - position);
+        }
+
+        /**
+         * 从 pos 开始连续 count 个槽位中，序号等于 pos + i + offset 的前缀长度
+         */
+        size_type ready_prefix(size_type position, size_type count, size_type offset) const {
+            size_type ready = 0;
+            while (ready < count &&
+                   cells.slot(position + ready)->sequence.load(std::memory_order_acquire) == position + ready + offset) {
+                ++ready;
+            }
+            return ready;
+        }
+
+        /**
+         * 占下 counter 上从当前位置开始最多 count 个就绪的槽位，返回起始位置，个数写入 count
+         */
+        size_type claim(std::atomic<size_type> &counter, size_type &count, size_type offset) {
+            size_type position = counter.load(std::memory_order_relaxed);
+            for (;;) {
+                size_type ready = ready_prefix(position, count, offset);
+                if (ready == 0) {
+                    intptr_t diff = distance(cells.slot(position)->sequence.load(std::memory_order_acquire),
+                                             position + offset);
+                    if (diff < 0) {
+                        // 写入时为满，读取时为空
+                        count = 0;
+                        return position;
+                    }
+                    // 其他线程已经越过这个位置
+                    position = counter.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (counter.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+                    count = ready;
+                    return position;
+                }
+            }
+        }
+
+    public:
+        explicit mpmc_queue(size_type capacity) : enqueue_pos(0), dequeue_pos(0), cells(capacity) {
+            for (size_type i = 0; i < cells.capacity(); ++i) {
+                cells.slot(i)->sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpmc_queue(const mpmc_queue &) = delete;
+
+        mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+        /**
+         * 析构时不能有其他线程在访问队列
+         */
+        ~mpmc_queue() {
+            size_type last = enqueue_pos.load(std::memory_order_relaxed);
+            for (size_type i = dequeue_pos.load(std::memory_order_relaxed); i != last; ++i) {
+                MicroSTL::destroy(cells.slot(i)->value());
+            }
+        }
+
+        size_type capacity() const {
+            return cells.capacity();
+        }
+
+        /**
+         * 其他线程同时读写时只是一个近似值
+         */
+        size_type size() const {
+            size_type tail = enqueue_pos.load(std::memory_order_acquire);
+            size_type head = dequeue_pos.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        template<typename... Args>
+        bool try_emplace(Args &&... args) {
+            size_type count = 1;
+            size_type position = claim(enqueue_pos, count, 0);
+            if (count == 0) {
+                return false;
+            }
+            cell *target = cells.slot(position);
+            new(target->value()) T(std::forward<Args>(args)...);
+            target->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T &obj) {
+            return try_emplace(obj);
+        }
+
+        bool try_push(T &&obj) {
+            return try_emplace(std::move(obj));
+        }
+
+        bool try_pop(T &out) {
+            size_type count = 1;
+            size_type position = claim(dequeue_pos, count, 1);
+            if (count == 0) {
+                return false;
+            }
+            cell *target = cells.slot(position);
+            out = std::move(*target->value());
+            MicroSTL::destroy(target->value());
+            target->sequence.store(position + capacity(), std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * 从 first 开始最多写入 count 个元素，返回实际写入的个数
+         */
+        template<typename InputIterator>
+        size_type push_batch(InputIterator first, size_type count) {
+            if (count == 0) {
+                return 0;
+            }
+            size_type position = claim(enqueue_pos, count, 0);
+            for (size_type i = 0; i < count; ++i, ++first) {
+                cell *target = cells.slot(position + i);
+                new(target->value()) T(*first);
+                target->sequence.store(position + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+
+        /**
+         * 最多取出 count 个元素写入 result，返回实际取出的个数
+         */
+        template<typename OutputIterator>
+        size_type pop_batch(OutputIterator result, size_type count) {
+            if (count == 0) {
+                return 0;
+            }
+            size_type position = claim(dequeue_pos, count, 1);
+            for (size_type i = 0; i < count; ++i, ++result) {
+                cell *target = cells.slot(position + i);
+                *result = std::move(*target->value());
+                MicroSTL::destroy(target->value());
+                target->sequence.store(position + i + capacity(), std::memory_order_release);
+            }
+            return count;
+        }
+    };
+}
+
+#endif //MICROSTL_MPMC_QUEUE_H
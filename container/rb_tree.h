@@ -0,0 +1,1058 @@
+#ifndef MICROSTL_RB_TREE_H
+#define MICROSTL_RB_TREE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../iterator/iterator_traits.h"
+#include "../memory/construct.h"
+#include "../memory/node_pool.h"
+#include "../algorithm/algobase.h"
+#include "../functor/functional.h"
+#include "../utility/pair.h"
+
+/**
+ * 红黑树，map / set / multimap / multiset 的底层实现：
+ *
+ * - 使用 header 哨兵节点：header.parent 为根，header.left 为最小节点，header.right 为最大节点，
+ *   begin() / end() 都是 O(1)；根节点的 parent 指向 header
+ * - 节点从每棵树私有的 node_pool 中分配，同一棵树的节点集中在少数几块 slab 中
+ * - 带提示的插入：新元素恰好应该放在 hint 之前时不需要从根开始查找，
+ *   按顺序插入时（hint 为 end()）每次都是 O(1) 找到位置，再加上均摊 O(1) 的旋转
+ * - 从已排序的区间建树是 O(n) 的：按中序依次取元素，递归地以中间元素为根，
+ *   得到尽可能平衡的树，只有最底下不满的一层染成红色
+ */
+
+namespace MicroSTL {
+
+    using _rb_tree_color_type = bool;
+    static const _rb_tree_color_type RB_TREE_RED = false;
+    static const _rb_tree_color_type RB_TREE_BLACK = true;
+
+    // --------------------- 节点 --------------------------
+
+    struct _rb_tree_node_base {
+        using base_ptr = _rb_tree_node_base *;
+
+        _rb_tree_color_type color;
+        base_ptr parent;
+        base_ptr left;
+        base_ptr right;
+
+        static base_ptr minimum(base_ptr x) {
+            while (x->left != nullptr) {
+                x = x->left;
+            }
+            return x;
+        }
+
+        static base_ptr maximum(base_ptr x) {
+            while (x->right != nullptr) {
+                x = x->right;
+            }
+            return x;
+        }
+    };
+
+    template<typename Value>
+    struct _rb_tree_node : public _rb_tree_node_base {
+        Value value_field;
+    };
+
+    // --------------------- 迭代器 --------------------------
+
+    struct _rb_tree_base_iterator {
+        using base_ptr = _rb_tree_node_base::base_ptr;
+        using iterator_category = bidirectional_iterator_tag;
+        using difference_type = ptrdiff_t;
+
+        base_ptr node;
+
+        /**
+         * 中序遍历的后继
+         */
+        void increment() {
+            if (node->right != nullptr) {
+                node = node->right;
+                while (node->left != nullptr) {
+                    node = node->left;
+                }
+            } else {
+                base_ptr parent = node->parent;
+                while (node == parent->right) {
+                    node = parent;
+                    parent = parent->parent;
+                }
+                // 根节点没有右子树时，node 会停在 header，此时 node->right == parent
+                if (node->right != parent) {
+                    node = parent;
+                }
+            }
+        }
+
+        /**
+         * 中序遍历的前驱，header（end()）的前驱为最大节点
+         */
+        void decrement() {
+            if (node->color == RB_TREE_RED && node->parent->parent == node) {
+                node = node->right;
+            } else if (node->left != nullptr) {
+                base_ptr x = node->left;
+                while (x->right != nullptr) {
+                    x = x->right;
+                }
+                node = x;
+            } else {
+                base_ptr parent = node->parent;
+                while (node == parent->left) {
+                    node = parent;
+                    parent = parent->parent;
+                }
+                node = parent;
+            }
+        }
+    };
+
+    template<typename Value, typename Reference, typename Pointer>
+    struct _rb_tree_iterator : public _rb_tree_base_iterator {
+        using value_type = Value;
+        using reference = Reference;
+        using pointer = Pointer;
+        using iterator = _rb_tree_iterator<Value, Value &, Value *>;
+        using link_type = _rb_tree_node<Value> *;
+
+        _rb_tree_iterator() {
+            node = nullptr;
+        }
+
+        explicit _rb_tree_iterator(base_ptr x) {
+            node = x;
+        }
+
+        _rb_tree_iterator(const _rb_tree_iterator &) = default;
+
+        _rb_tree_iterator &operator=(const _rb_tree_iterator &) = default;
+
+        /**
+         * iterator 可以隐式转换为 const_iterator
+         */
+        template<typename OtherReference, typename OtherPointer,
+                typename = typename std::enable_if<
+                        std::is_same<_rb_tree_iterator<Value, OtherReference, OtherPointer>, iterator>::value &&
+                        !std::is_same<Reference, Value &>::value>::type>
+        _rb_tree_iterator(const _rb_tree_iterator<Value, OtherReference, OtherPointer> &obj) {
+            node = obj.node;
+        }
+
+        reference operator*() const {
+            return static_cast<link_type>(node)->value_field;
+        }
+
+        pointer operator->() const {
+            return &(operator*());
+        }
+
+        _rb_tree_iterator &operator++() {
+            increment();
+            return *this;
+        }
+
+        _rb_tree_iterator operator++(int) {
+            _rb_tree_iterator temp = *this;
+            increment();
+            return temp;
+        }
+
+        _rb_tree_iterator &operator--() {
+            decrement();
+            return *this;
+        }
+
+        _rb_tree_iterator operator--(int) {
+            _rb_tree_iterator temp = *this;
+            decrement();
+            return temp;
+        }
+
+        bool operator==(const _rb_tree_iterator &obj) const {
+            return node == obj.node;
+        }
+
+        bool operator!=(const _rb_tree_iterator &obj) const {
+            return node != obj.node;
+        }
+    };
+
+    // --------------------- 旋转与再平衡 --------------------------
+
+    inline void _rb_tree_rotate_left(_rb_tree_node_base *x, _rb_tree_node_base *&root) {
+        _rb_tree_node_base *y = x->right;
+        x->right = y->left;
+        if (y->left != nullptr) {
+            y->left->parent = x;
+        }
+        y->parent = x->parent;
+        if (x == root) {
+            root = y;
+        } else if (x == x->parent->left) {
+            x->parent->left = y;
+        } else {
+            x->parent->right = y;
+        }
+        y->left = x;
+        x->parent = y;
+    }
+
+    inline void _rb_tree_rotate_right(_rb_tree_node_base *x, _rb_tree_node_base *&root) {
+        _rb_tree_node_base *y = x->left;
+        x->left = y->right;
+        if (y->right != nullptr) {
+            y->right->parent = x;
+        }
+        y->parent = x->parent;
+        if (x == root) {
+            root = y;
+        } else if (x == x->parent->right) {
+            x->parent->right = y;
+        } else {
+            x->parent->left = y;
+        }
+        y->right = x;
+        x->parent = y;
+    }
+
+    /**
+     * 新插入的红色节点 x 可能与父节点同为红色，向上调整
+     */
+    inline void _rb_tree_rebalance(_rb_tree_node_base *x, _rb_tree_node_base *&root) {
+        x->color = RB_TREE_RED;
+        while (x != root && x->parent->color == RB_TREE_RED) {
+            _rb_tree_node_base *grand = x->parent->parent;
+            if (x->parent == grand->left) {
+                _rb_tree_node_base *uncle = grand->right;
+                if (uncle != nullptr && uncle->color == RB_TREE_RED) {
+                    x->parent->color = RB_TREE_BLACK;
+                    uncle->color = RB_TREE_BLACK;
+                    grand->color = RB_TREE_RED;
+                    x = grand;
+                } else {
+                    if (x == x->parent->right) {
+                        x = x->parent;
+                        _rb_tree_rotate_left(x, root);
+                    }
+                    x->parent->color = RB_TREE_BLACK;
+                    x->parent->parent->color = RB_TREE_RED;
+                    _rb_tree_rotate_right(x->parent->parent, root);
+                }
+            } else {
+                _rb_tree_node_base *uncle = grand->left;
+                if (uncle != nullptr && uncle->color == RB_TREE_RED) {
+                    x->parent->color = RB_TREE_BLACK;
+                    uncle->color = RB_TREE_BLACK;
+                    grand->color = RB_TREE_RED;
+                    x = grand;
+                } else {
+                    if (x == x->parent->left) {
+                        x = x->parent;
+                        _rb_tree_rotate_right(x, root);
+                    }
+                    x->parent->color = RB_TREE_BLACK;
+                    x->parent->parent->color = RB_TREE_RED;
+                    _rb_tree_rotate_left(x->parent->parent, root);
+                }
+            }
+        }
+        root->color = RB_TREE_BLACK;
+    }
+
+    /**
+     * 从树中摘除 z 并恢复红黑性质，返回实际被摘除的节点（即 z）
+     */
+    inline _rb_tree_node_base *
+    _rb_tree_rebalance_for_erase(_rb_tree_node_base *z, _rb_tree_node_base *&root,
+                                 _rb_tree_node_base *&leftmost, _rb_tree_node_base *&rightmost) {
+        _rb_tree_node_base *y = z;
+        _rb_tree_node_base *x = nullptr;
+        _rb_tree_node_base *x_parent = nullptr;
+
+        if (y->left == nullptr) {
+            x = y->right;
+        } else if (y->right == nullptr) {
+            x = y->left;
+        } else {
+            // z 有两个子节点，用后继 y 替换 z
+            y = y->right;
+            while (y->left != nullptr) {
+                y = y->left;
+            }
+            x = y->right;
+        }
+
+        if (y != z) {
+            z->left->parent = y;
+            y->left = z->left;
+            if (y != z->right) {
+                x_parent = y->parent;
+                if (x != nullptr) {
+                    x->parent = y->parent;
+                }
+                y->parent->left = x;
+                y->right = z->right;
+                z->right->parent = y;
+            } else {
+                x_parent = y;
+            }
+            if (root == z) {
+                root = y;
+            } else if (z->parent->left == z) {
+                z->parent->left = y;
+            } else {
+                z->parent->right = y;
+            }
+            y->parent = z->parent;
+            _rb_tree_color_type color = y->color;
+            y->color = z->color;
+            z->color = color;
+            y = z;
+        } else {
+            x_parent = y->parent;
+            if (x != nullptr) {
+                x->parent = y->parent;
+            }
+            if (root == z) {
+                root = x;
+            } else if (z->parent->left == z) {
+                z->parent->left = x;
+            } else {
+                z->parent->right = x;
+            }
+            if (leftmost == z) {
+                leftmost = z->right == nullptr ? z->parent : _rb_tree_node_base::minimum(x);
+            }
+            if (rightmost == z) {
+                rightmost = z->left == nullptr ? z->parent : _rb_tree_node_base::maximum(x);
+            }
+        }
+
+        if (y->color != RB_TREE_RED) {
+            while (x != root && (x == nullptr || x->color == RB_TREE_BLACK)) {
+                if (x == x_parent->left) {
+                    _rb_tree_node_base *w = x_parent->right;
+                    if (w->color == RB_TREE_RED) {
+                        w->color = RB_TREE_BLACK;
+                        x_parent->color = RB_TREE_RED;
+                        _rb_tree_rotate_left(x_parent, root);
+                        w = x_parent->right;
+                    }
+                    if ((w->left == nullptr || w->left->color == RB_TREE_BLACK) &&
+                        (w->right == nullptr || w->right->color == RB_TREE_BLACK)) {
+                        w->color = RB_TREE_RED;
+                        x = x_parent;
+                        x_parent = x_parent->parent;
+                    } else {
+                        if (w->right == nullptr || w->right->color == RB_TREE_BLACK) {
+                            w->left->color = RB_TREE_BLACK;
+                            w->color = RB_TREE_RED;
+                            _rb_tree_rotate_right(w, root);
+                            w = x_parent->right;
+                        }
+                        w->color = x_parent->color;
+                        x_parent->color = RB_TREE_BLACK;
+                        if (w->right != nullptr) {
+                            w->right->color = RB_TREE_BLACK;
+                        }
+                        _rb_tree_rotate_left(x_parent, root);
+                        break;
+                    }
+                } else {
+                    _rb_tree_node_base *w = x_parent->left;
+                    if (w->color == RB_TREE_RED) {
+                        w->color = RB_TREE_BLACK;
+                        x_parent->color = RB_TREE_RED;
+                        _rb_tree_rotate_right(x_parent, root);
+                        w = x_parent->left;
+                    }
+                    if ((w->right == nullptr || w->right->color == RB_TREE_BLACK) &&
+                        (w->left == nullptr || w->left->color == RB_TREE_BLACK)) {
+                        w->color = RB_TREE_RED;
+                        x = x_parent;
+                        x_parent = x_parent->parent;
+                    } else {
+                        if (w->left == nullptr || w->left->color == RB_TREE_BLACK) {
+                            w->right->color = RB_TREE_BLACK;
+                            w->color = RB_TREE_RED;
+                            _rb_tree_rotate_left(w, root);
+                            w = x_parent->left;
+                        }
+                        w->color = x_parent->color;
+                        x_parent->color = RB_TREE_BLACK;
+                        if (w->left != nullptr) {
+                            w->left->color = RB_TREE_BLACK;
+                        }
+                        _rb_tree_rotate_right(x_parent, root);
+                        break;
+                    }
+                }
+            }
+            if (x != nullptr) {
+                x->color = RB_TREE_BLACK;
+            }
+        }
+        return y;
+    }
+
+    // --------------------- rb_tree --------------------------
+
+    template<typename Key, typename Value, typename KeyOfValue, typename Compare>
+    class rb_tree {
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using key_compare = Compare;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using iterator = _rb_tree_iterator<Value, Value &, Value *>;
+        using const_iterator = _rb_tree_iterator<Value, const Value &, const Value *>;
+
+    protected:
+        using base_ptr = _rb_tree_node_base *;
+        using link_type = _rb_tree_node<Value> *;
+
+        node_pool<_rb_tree_node<Value>> pool;
+        // 只使用 color、parent、left、right
+        _rb_tree_node_base header;
+        size_type node_count;
+        Compare comp;
+        KeyOfValue get_key;
+
+        base_ptr &root() const {
+            return const_cast<base_ptr &>(header.parent);
+        }
+
+        base_ptr &leftmost() const {
+            return const_cast<base_ptr &>(header.left);
+        }
+
+        base_ptr &rightmost() const {
+            return const_cast<base_ptr &>(header.right);
+        }
+
+        base_ptr header_ptr() const {
+            return const_cast<base_ptr>(&header);
+        }
+
+        static const Key &key(base_ptr x) {
+            return KeyOfValue()(static_cast<link_type>(x)->value_field);
+        }
+
+        template<typename... Args>
+        link_type create_node(Args &&... args) {
+            link_type node = pool.allocate();
+            try {
+                new(&node->value_field) Value(std::forward<Args>(args)...);
+            } catch (...) {
+                pool.deallocate(node);
+                throw;
+            }
+            node->left = nullptr;
+            node->right = nullptr;
+            return node;
+        }
+
+        void destroy_node(link_type node) {
+            MicroSTL::destroy(&node->value_field);
+            pool.deallocate(node);
+        }
+
+        void empty_initialize() {
+            header.color = RB_TREE_RED;
+            header.parent = nullptr;
+            header.left = &header;
+            header.right = &header;
+            node_count = 0;
+        }
+
+        /**
+         * 在 parent 下挂上新节点 node，insert_left 决定挂在左侧还是右侧
+         */
+        iterator link_node(base_ptr parent, link_type node, bool insert_left) {
+            node->parent = parent;
+            if (parent == header_ptr()) {
+                header.parent = node;
+                header.left = node;
+                header.right = node;
+            } else if (insert_left) {
+                parent->left = node;
+                if (parent == leftmost()) {
+                    leftmost() = node;
+                }
+            } else {
+                parent->right = node;
+                if (parent == rightmost()) {
+                    rightmost() = node;
+                }
+            }
+            _rb_tree_rebalance(node, root());
+            ++node_count;
+            return iterator(node);
+        }
+
+        /**
+         * 从根开始查找允许重复 key 的插入位置
+         */
+        iterator insert_equal_node(link_type node) {
+            base_ptr y = header_ptr();
+            base_ptr x = root();
+            const Key &k = key(node);
+            while (x != nullptr) {
+                y = x;
+                x = comp(k, key(x)) ? x->left : x->right;
+            }
+            return link_node(y, node, y == header_ptr() || comp(k, key(y)));
+        }
+
+        /**
+         * key 唯一时的插入位置，first 为父节点，second 为 false 时说明 key 已存在，first 为已存在的节点
+         */
+        pair<base_ptr, bool> unique_position(const Key &k) const {
+            base_ptr y = header_ptr();
+            base_ptr x = root();
+            bool less = true;
+            while (x != nullptr) {
+                y = x;
+                less = comp(k, key(x));
+                x = less ? x->left : x->right;
+            }
+            iterator j(y);
+            if (less) {
+                if (j == iterator(leftmost())) {
+                    return pair<base_ptr, bool>(y, true);
+                }
+                --j;
+            }
+            if (comp(key(j.node), k)) {
+                return pair<base_ptr, bool>(y, true);
+            }
+            return pair<base_ptr, bool>(j.node, false);
+        }
+
+        pair<iterator, bool> insert_unique_node(link_type node) {
+            pair<base_ptr, bool> position = unique_position(key(node));
+            if (!position.second) {
+                destroy_node(node);
+                return pair<iterator, bool>(iterator(position.first), false);
+            }
+            base_ptr y = position.first;
+            return pair<iterator, bool>(link_node(y, node, y == header_ptr() || comp(key(node), key(y))), true);
+        }
+
+        /**
+         * hint 之前是新元素的位置时 O(1) 插入，否则退化为普通插入
+         */
+        iterator insert_unique_node(const_iterator hint, link_type node) {
+            base_ptr position = hint.node;
+            const Key &k = key(node);
+            if (position == header_ptr()) {
+                // 追加到末尾，顺序插入时总是走这条路径
+                if (node_count > 0 && comp(key(rightmost()), k)) {
+                    return link_node(rightmost(), node, false);
+                }
+                return insert_unique_node(node).first;
+            }
+            if (position == leftmost()) {
+                if (comp(k, key(position))) {
+                    return link_node(position, node, true);
+                }
+                return insert_unique_node(node).first;
+            }
+            iterator before(position);
+            --before;
+            if (comp(key(before.node), k) && comp(k, key(position))) {
+                if (before.node->right == nullptr) {
+                    return link_node(before.node, node, false);
+                }
+                return link_node(position, node, true);
+            }
+            return insert_unique_node(node).first;
+        }
+
+        iterator insert_equal_node(const_iterator hint, link_type node) {
+            base_ptr position = hint.node;
+            const Key &k = key(node);
+            if (position == header_ptr()) {
+                if (node_count > 0 && !comp(k, key(rightmost()))) {
+                    return link_node(rightmost(), node, false);
+                }
+                return insert_equal_node(node);
+            }
+            if (position == leftmost()) {
+                if (!comp(key(position), k)) {
+                    return link_node(position, node, true);
+                }
+                return insert_equal_node(node);
+            }
+            iterator before(position);
+            --before;
+            if (!comp(k, key(before.node)) && !comp(key(position), k)) {
+                if (before.node->right == nullptr) {
+                    return link_node(before.node, node, false);
+                }
+                return link_node(position, node, true);
+            }
+            return insert_equal_node(node);
+        }
+
+        /**
+         * 复制以 x 为根的子树，挂在 parent 下
+         */
+        link_type copy_subtree(base_ptr x, base_ptr parent) {
+            link_type top = create_node(static_cast<link_type>(x)->value_field);
+            top->color = x->color;
+            top->parent = parent;
+            try {
+                if (x->right != nullptr) {
+                    top->right = copy_subtree(x->right, top);
+                }
+                parent = top;
+                x = x->left;
+                // 左链迭代，右子树递归
+                while (x != nullptr) {
+                    link_type y = create_node(static_cast<link_type>(x)->value_field);
+                    y->color = x->color;
+                    parent->left = y;
+                    y->parent = parent;
+                    if (x->right != nullptr) {
+                        y->right = copy_subtree(x->right, y);
+                    }
+                    parent = y;
+                    x = x->left;
+                }
+            } catch (...) {
+                erase_subtree(top);
+                throw;
+            }
+            return top;
+        }
+
+        void erase_subtree(base_ptr x) {
+            while (x != nullptr) {
+                erase_subtree(x->right);
+                base_ptr left = x->left;
+                destroy_node(static_cast<link_type>(x));
+                x = left;
+            }
+        }
+
+        /**
+         * 中序消费 [first, first + size) 建出平衡的子树，depth 为当前深度，
+         * 深度为 red_depth 的节点（最底下不满的一层）染成红色
+         */
+        template<typename InputIterator>
+        base_ptr build_subtree(InputIterator &first, size_type size, size_type depth, size_type red_depth,
+                               base_ptr parent) {
+            if (size == 0) {
+                return nullptr;
+            }
+            size_type left_size = size / 2;
+            base_ptr left = build_subtree(first, left_size, depth + 1, red_depth, nullptr);
+            link_type node;
+            try {
+                node = create_node(*first);
+            } catch (...) {
+                erase_subtree(left);
+                throw;
+            }
+            ++first;
+            node->color = depth == red_depth ? RB_TREE_RED : RB_TREE_BLACK;
+            node->parent = parent;
+            node->left = left;
+            if (left != nullptr) {
+                left->parent = node;
+            }
+            try {
+                node->right = build_subtree(first, size - left_size - 1, depth + 1, red_depth, node);
+            } catch (...) {
+                erase_subtree(node);
+                throw;
+            }
+            return node;
+        }
+
+        /**
+         * 要求当前为空树且 [first, first + size) 已按 comp 排序
+         */
+        template<typename InputIterator>
+        void build_from_sorted(InputIterator first, size_type size) {
+            if (size == 0) {
+                return;
+            }
+            // 满的层数为 floor(log2(size + 1))，之下的一层为红色
+            size_type full_levels = 0;
+            while ((size_type(2) << full_levels) - 1 <= size) {
+                ++full_levels;
+            }
+            // 构造失败时 build_subtree 会释放已经建好的部分，树保持为空
+            root() = build_subtree(first, size, 0, full_levels, header_ptr());
+            leftmost() = _rb_tree_node_base::minimum(root());
+            rightmost() = _rb_tree_node_base::maximum(root());
+            node_count = size;
+        }
+
+        template<typename ForwardIterator>
+        bool sorted_range(ForwardIterator first, ForwardIterator last, bool strict, size_type &size) const {
+            size = 0;
+            if (first == last) {
+                return true;
+            }
+            ForwardIterator next = first;
+            for (++next, size = 1; next != last; ++first, ++next, ++size) {
+                // 区间元素类型与 value_type 不同时（如 pair<K, T> 与 pair<const K, T>）绑定到转换后的临时对象上
+                const value_type &a = *first;
+                const value_type &b = *next;
+                if (strict ? !comp(KeyOfValue()(a), KeyOfValue()(b)) : comp(KeyOfValue()(b), KeyOfValue()(a))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename InputIterator>
+        void assign_range(InputIterator first, InputIterator last, bool unique, input_iterator_tag) {
+            for (; first != last; ++first) {
+                if (unique) {
+                    insert_unique(end(), *first);
+                } else {
+                    insert_equal(end(), *first);
+                }
+            }
+        }
+
+        template<typename ForwardIterator>
+        void assign_range(ForwardIterator first, ForwardIterator last, bool unique, forward_iterator_tag) {
+            size_type size;
+            if (sorted_range(first, last, unique, size)) {
+                build_from_sorted(first, size);
+            } else {
+                assign_range(first, last, unique, input_iterator_tag());
+            }
+        }
+
+    public:
+        rb_tree() : node_count(0), comp(), get_key() {
+            empty_initialize();
+        }
+
+        explicit rb_tree(const Compare &comp) : node_count(0), comp(comp), get_key() {
+            empty_initialize();
+        }
+
+        rb_tree(const rb_tree &obj) : node_count(0), comp(obj.comp), get_key() {
+            empty_initialize();
+            if (obj.root() != nullptr) {
+                header.color = RB_TREE_RED;
+                root() = copy_subtree(obj.root(), header_ptr());
+                leftmost() = _rb_tree_node_base::minimum(root());
+                rightmost() = _rb_tree_node_base::maximum(root());
+                node_count = obj.node_count;
+            }
+        }
+
+        rb_tree(rb_tree &&obj) noexcept: node_count(0), comp(obj.comp), get_key() {
+            empty_initialize();
+            swap(obj);
+        }
+
+        ~rb_tree() {
+            clear();
+        }
+
+        rb_tree &operator=(const rb_tree &obj) {
+            if (this != &obj) {
+                rb_tree temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        rb_tree &operator=(rb_tree &&obj) noexcept {
+            if (this != &obj) {
+                rb_tree temp(std::move(obj));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        /**
+         * 根节点的 parent 指向 header，交换 header 后需要修正
+         */
+        void swap(rb_tree &obj) {
+            pool.swap(obj.pool);
+            MicroSTL::swap(header.parent, obj.header.parent);
+            MicroSTL::swap(header.left, obj.header.left);
+            MicroSTL::swap(header.right, obj.header.right);
+            MicroSTL::swap(node_count, obj.node_count);
+            MicroSTL::swap(comp, obj.comp);
+            if (root() == nullptr) {
+                header.left = &header;
+                header.right = &header;
+            } else {
+                root()->parent = &header;
+            }
+            if (obj.root() == nullptr) {
+                obj.header.left = &obj.header;
+                obj.header.right = &obj.header;
+            } else {
+                obj.root()->parent = &obj.header;
+            }
+        }
+
+        key_compare key_comp() const {
+            return comp;
+        }
+
+        iterator begin() {
+            return iterator(leftmost());
+        }
+
+        const_iterator begin() const {
+            return const_iterator(leftmost());
+        }
+
+        iterator end() {
+            return iterator(header_ptr());
+        }
+
+        const_iterator end() const {
+            return const_iterator(header_ptr());
+        }
+
+        bool empty() const {
+            return node_count == 0;
+        }
+
+        size_type size() const {
+            return node_count;
+        }
+
+        // --------------------- 插入 --------------------------
+
+        pair<iterator, bool> insert_unique(const value_type &value) {
+            pair<base_ptr, bool> position = unique_position(get_key(value));
+            if (!position.second) {
+                return pair<iterator, bool>(iterator(position.first), false);
+            }
+            base_ptr y = position.first;
+            bool insert_left = y == header_ptr() || comp(get_key(value), key(y));
+            return pair<iterator, bool>(link_node(y, create_node(value), insert_left), true);
+        }
+
+        iterator insert_equal(const value_type &value) {
+            return insert_equal_node(create_node(value));
+        }
+
+        iterator insert_unique(const_iterator hint, const value_type &value) {
+            return insert_unique_node(hint, create_node(value));
+        }
+
+        iterator insert_equal(const_iterator hint, const value_type &value) {
+            return insert_equal_node(hint, create_node(value));
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace_unique(Args &&... args) {
+            return insert_unique_node(create_node(std::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        iterator emplace_equal(Args &&... args) {
+            return insert_equal_node(create_node(std::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        iterator emplace_hint_unique(const_iterator hint, Args &&... args) {
+            return insert_unique_node(hint, create_node(std::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        iterator emplace_hint_equal(const_iterator hint, Args &&... args) {
+            return insert_equal_node(hint, create_node(std::forward<Args>(args)...));
+        }
+
+        /**
+         * 空树且区间已排序时 O(n) 建树，否则逐个以 end() 为提示插入
+         */
+        template<typename InputIterator>
+        void insert_unique(InputIterator first, InputIterator last) {
+            if (empty()) {
+                assign_range(first, last, true, iterator_category(first));
+            } else {
+                assign_range(first, last, true, input_iterator_tag());
+            }
+        }
+
+        template<typename InputIterator>
+        void insert_equal(InputIterator first, InputIterator last) {
+            if (empty()) {
+                assign_range(first, last, false, iterator_category(first));
+            } else {
+                assign_range(first, last, false, input_iterator_tag());
+            }
+        }
+
+        // --------------------- 删除 --------------------------
+
+        void erase(const_iterator position) {
+            base_ptr y = _rb_tree_rebalance_for_erase(position.node, header.parent, header.left, header.right);
+            destroy_node(static_cast<link_type>(y));
+            --node_count;
+        }
+
+        size_type erase(const key_type &k) {
+            pair<iterator, iterator> range = equal_range(k);
+            size_type count = 0;
+            while (range.first != range.second) {
+                erase(range.first++);
+                ++count;
+            }
+            return count;
+        }
+
+        void erase(const_iterator first, const_iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return;
+            }
+            while (first != last) {
+                erase(first++);
+            }
+        }
+
+        /**
+         * 所有节点都在 pool 中，析构元素后直接归还整个 pool
+         */
+        void clear() {
+            if (node_count != 0) {
+                erase_subtree(root());
+            }
+            pool.release();
+            empty_initialize();
+        }
+
+        // --------------------- 查找 --------------------------
+
+        iterator lower_bound(const key_type &k) {
+            base_ptr y = header_ptr();
+            base_ptr x = root();
+            while (x != nullptr) {
+                if (!comp(key(x), k)) {
+                    y = x;
+                    x = x->left;
+                } else {
+                    x = x->right;
+                }
+            }
+            return iterator(y);
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return const_cast<rb_tree *>(this)->lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type &k) {
+            base_ptr y = header_ptr();
+            base_ptr x = root();
+            while (x != nullptr) {
+                if (comp(k, key(x))) {
+                    y = x;
+                    x = x->left;
+                } else {
+                    x = x->right;
+                }
+            }
+            return iterator(y);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return const_cast<rb_tree *>(this)->upper_bound(k);
+        }
+
+        iterator find(const key_type &k) {
+            iterator j = lower_bound(k);
+            return j == end() || comp(k, key(j.node)) ? end() : j;
+        }
+
+        const_iterator find(const key_type &k) const {
+            return const_cast<rb_tree *>(this)->find(k);
+        }
+
+        pair<iterator, iterator> equal_range(const key_type &k) {
+            return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+
+        size_type count(const key_type &k) const {
+            pair<const_iterator, const_iterator> range = equal_range(k);
+            size_type result = 0;
+            for (const_iterator iter = range.first; iter != range.second; ++iter) {
+                ++result;
+            }
+            return result;
+        }
+
+        /**
+         * 检查红黑树的性质：根为黑色，红色节点没有红色子节点，所有路径上黑色节点数相同，
+         * 中序有序，并且 leftmost / rightmost / node_count 正确
+         */
+        bool verify() const {
+            if (node_count == 0) {
+                return begin() == end() && root() == nullptr;
+            }
+            if (root()->color != RB_TREE_BLACK || root()->parent != header_ptr()) {
+                return false;
+            }
+            size_type count = 0;
+            if (verify_subtree(root(), count) < 0 || count != node_count) {
+                return false;
+            }
+            return leftmost() == _rb_tree_node_base::minimum(root()) &&
+                   rightmost() == _rb_tree_node_base::maximum(root());
+        }
+
+    private:
+        /**
+         * 返回子树的黑高，不满足性质时返回 -1
+         */
+        int verify_subtree(base_ptr x, size_type &count) const {
+            if (x == nullptr) {
+                return 0;
+            }
+            ++count;
+            base_ptr l = x->left;
+            base_ptr r = x->right;
+            if (x->color == RB_TREE_RED &&
+                ((l != nullptr && l->color == RB_TREE_RED) || (r != nullptr && r->color == RB_TREE_RED))) {
+                return -1;
+            }
+            if ((l != nullptr && (l->parent != x || comp(key(x), key(l)))) ||
+                (r != nullptr && (r->parent != x || comp(key(r), key(x))))) {
+                return -1;
+            }
+            int left_height = verify_subtree(l, count);
+            int right_height = verify_subtree(r, count);
+            if (left_height < 0 || right_height < 0 || left_height != right_height) {
+                return -1;
+            }
+            return left_height + (x->color == RB_TREE_BLACK ? 1 : 0);
+        }
+    };
+}
+
+#endif //MICROSTL_RB_TREE_H
@@ -0,0 +1,218 @@
+#ifndef MICROSTL_RING_BUFFER_H
+#define MICROSTL_RING_BUFFER_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../algorithm/algobase.h"
+
+/**
+ * 固定容量的环形缓冲区：
+ *
+ * - 容量向上取整为 2 的幂，下标对容量取模只需要一次按位与
+ * - 存储在构造时一次性分配，之后的 push / pop 不再分配内存；满了以后 push 返回 false
+ * - head 与 tail 为单调递增的计数，元素个数为 tail - head，不需要额外区分空与满
+ * - 单线程使用；跨线程传递数据使用基于同一存储的 spsc_queue
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 向上取整为 2 的幂，至少为 2
+     */
+    inline size_t _ring_capacity(size_t capacity) {
+        size_t result = 2;
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    /**
+     * 环形缓冲区的原始存储，只负责分配与按序号定位槽位，元素的构造与析构由使用者负责
+     */
+    template<typename T>
+    class _ring_storage {
+    protected:
+        T *data;
+        size_t mask;
+
+    public:
+        explicit _ring_storage(size_t capacity) : data(nullptr), mask(_ring_capacity(capacity) - 1) {
+            data = Alloc<T>::allocate(mask + 1);
+        }
+
+        _ring_storage(const _ring_storage &) = delete;
+
+        _ring_storage &operator=(const _ring_storage &) = delete;
+
+        ~_ring_storage() {
+            Alloc<T>::deallocate(data, mask + 1);
+        }
+
+        size_t capacity() const {
+            return mask + 1;
+        }
+
+        T *slot(size_t index) const {
+            return data + (index & mask);
+        }
+
+        void swap(_ring_storage &obj) {
+            MicroSTL::swap(data, obj.data);
+            MicroSTL::swap(mask, obj.mask);
+        }
+    };
+
+    // --------------------- ring_buffer --------------------------
+
+    template<typename T>
+    class ring_buffer {
+    public:
+        using value_type = T;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = size_t;
+
+    protected:
+        _ring_storage<T> storage;
+        size_type head;
+        size_type tail;
+
+    public:
+        explicit ring_buffer(size_type capacity) : storage(capacity), head(0), tail(0) {}
+
+        ring_buffer(const ring_buffer &obj) : storage(obj.capacity()), head(0), tail(0) {
+            try {
+                for (size_type i = 0; i < obj.size(); ++i) {
+                    push_back(obj[i]);
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        ring_buffer &operator=(const ring_buffer &obj) {
+            if (this != &obj) {
+                ring_buffer temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        ~ring_buffer() {
+            clear();
+        }
+
+        size_type size() const {
+            return tail - head;
+        }
+
+        size_type capacity() const {
+            return storage.capacity();
+        }
+
+        bool empty() const {
+            return head == tail;
+        }
+
+        bool full() const {
+            return size() == capacity();
+        }
+
+        /**
+         * 下标从最早写入的元素开始
+         */
+        reference operator[](size_type n) {
+            return *storage.slot(head + n);
+        }
+
+        const_reference operator[](size_type n) const {
+            return *storage.slot(head + n);
+        }
+
+        reference front() {
+            return *storage.slot(head);
+        }
+
+        const_reference front() const {
+            return *storage.slot(head);
+        }
+
+        reference back() {
+            return *storage.slot(tail - 1);
+        }
+
+        const_reference back() const {
+            return *storage.slot(tail - 1);
+        }
+
+        /**
+         * 已满时返回 false，不修改缓冲区
+         */
+        template<typename... Args>
+        bool emplace_back(Args &&... args) {
+            if (full()) {
+                return false;
+            }
+            new(storage.slot(tail)) T(std::forward<Args>(args)...);
+            ++tail;
+            return true;
+        }
+
+        bool push_back(const T &obj) {
+            return emplace_back(obj);
+        }
+
+        bool push_back(T &&obj) {
+            return emplace_back(std::move(obj));
+        }
+
+        /**
+         * 已满时覆盖最早的元素
+         */
+        void push_overwrite(const T &obj) {
+            if (full()) {
+                pop_front();
+            }
+            emplace_back(obj);
+        }
+
+        void pop_front() {
+            MicroSTL::destroy(storage.slot(head));
+            ++head;
+        }
+
+        /**
+         * 取出最早的元素，为空时返回 false
+         */
+        bool pop_front(T &out) {
+            if (empty()) {
+                return false;
+            }
+            T *position = storage.slot(head);
+            out = std::move(*position);
+            MicroSTL::destroy(position);
+            ++head;
+            return true;
+        }
+
+        void clear() {
+            while (!empty()) {
+                pop_front();
+            }
+            head = tail = 0;
+        }
+
+        void swap(ring_buffer &obj) {
+            storage.swap(obj.storage);
+            MicroSTL::swap(head, obj.head);
+            MicroSTL::swap(tail, obj.tail);
+        }
+    };
+}
+
+#endif //MICROSTL_RING_BUFFER_H
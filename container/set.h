@@ -0,0 +1,265 @@
+#ifndef MICROSTL_SET_H
+#define MICROSTL_SET_H
+
+#include <utility>
+#include "rb_tree.h"
+
+/**
+ * 基于红黑树的有序集合：
+ *
+ * - set 的元素唯一，multiset 允许重复元素，相等的元素按插入顺序排列
+ * - 元素本身就是 key，迭代器都是只读的
+ * - 以 end() 为提示按顺序插入、或者从已排序的区间构造时，不需要从根开始查找
+ */
+
+namespace MicroSTL {
+
+    // --------------------- set --------------------------
+
+    template<typename Key, typename Compare = less<Key>>
+    class set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using tree_type = rb_tree<Key, value_type, identity<value_type>, Compare>;
+        tree_type tree;
+
+    public:
+        // 元素即 key，不允许通过迭代器修改
+        using iterator = typename tree_type::const_iterator;
+        using const_iterator = typename tree_type::const_iterator;
+
+        set() : tree() {}
+
+        explicit set(const Compare &comp) : tree(comp) {}
+
+        /**
+         * 区间按 key 严格递增时 O(n) 建树
+         */
+        template<typename InputIterator>
+        set(InputIterator first, InputIterator last) : tree() {
+            tree.insert_unique(first, last);
+        }
+
+        const_iterator begin() const {
+            return tree.begin();
+        }
+
+        const_iterator end() const {
+            return tree.end();
+        }
+
+        bool empty() const {
+            return tree.empty();
+        }
+
+        size_type size() const {
+            return tree.size();
+        }
+
+        key_compare key_comp() const {
+            return tree.key_comp();
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            return tree.insert_unique(value);
+        }
+
+        /**
+         * 新元素恰好位于 hint 之前时 O(1) 找到插入位置
+         */
+        iterator insert(const_iterator hint, const value_type &value) {
+            return tree.insert_unique(hint, value);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            tree.insert_unique(first, last);
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            return tree.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const_iterator hint, Args &&... args) {
+            return tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
+        }
+
+        void erase(const_iterator position) {
+            tree.erase(position);
+        }
+
+        size_type erase(const key_type &k) {
+            return tree.erase(k);
+        }
+
+        void erase(const_iterator first, const_iterator last) {
+            tree.erase(first, last);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        void swap(set &obj) {
+            tree.swap(obj.tree);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return tree.find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return tree.find(k) == end() ? 0 : 1;
+        }
+
+        bool contains(const key_type &k) const {
+            return tree.find(k) != end();
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return tree.lower_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return tree.upper_bound(k);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return tree.equal_range(k);
+        }
+    };
+
+    // --------------------- multiset --------------------------
+
+    template<typename Key, typename Compare = less<Key>>
+    class multiset {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using tree_type = rb_tree<Key, value_type, identity<value_type>, Compare>;
+        tree_type tree;
+
+    public:
+        // 元素即 key，不允许通过迭代器修改
+        using iterator = typename tree_type::const_iterator;
+        using const_iterator = typename tree_type::const_iterator;
+
+        multiset() : tree() {}
+
+        explicit multiset(const Compare &comp) : tree(comp) {}
+
+        /**
+         * 区间按 key 非递减时 O(n) 建树
+         */
+        template<typename InputIterator>
+        multiset(InputIterator first, InputIterator last) : tree() {
+            tree.insert_equal(first, last);
+        }
+
+        const_iterator begin() const {
+            return tree.begin();
+        }
+
+        const_iterator end() const {
+            return tree.end();
+        }
+
+        bool empty() const {
+            return tree.empty();
+        }
+
+        size_type size() const {
+            return tree.size();
+        }
+
+        key_compare key_comp() const {
+            return tree.key_comp();
+        }
+
+        iterator insert(const value_type &value) {
+            return tree.insert_equal(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type &value) {
+            return tree.insert_equal(hint, value);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            tree.insert_equal(first, last);
+        }
+
+        template<typename... Args>
+        iterator emplace(Args &&... args) {
+            return tree.emplace_equal(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const_iterator hint, Args &&... args) {
+            return tree.emplace_hint_equal(hint, std::forward<Args>(args)...);
+        }
+
+        void erase(const_iterator position) {
+            tree.erase(position);
+        }
+
+        size_type erase(const key_type &k) {
+            return tree.erase(k);
+        }
+
+        void erase(const_iterator first, const_iterator last) {
+            tree.erase(first, last);
+        }
+
+        void clear() {
+            tree.clear();
+        }
+
+        void swap(multiset &obj) {
+            tree.swap(obj.tree);
+        }
+
+        const_iterator find(const key_type &k) const {
+            return tree.find(k);
+        }
+
+        size_type count(const key_type &k) const {
+            return tree.count(k);
+        }
+
+        bool contains(const key_type &k) const {
+            return tree.find(k) != end();
+        }
+
+        const_iterator lower_bound(const key_type &k) const {
+            return tree.lower_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type &k) const {
+            return tree.upper_bound(k);
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type &k) const {
+            return tree.equal_range(k);
+        }
+    };
+}
+
+#endif //MICROSTL_SET_H
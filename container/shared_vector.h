@@ -0,0 +1,330 @@
+#ifndef MICROSTL_SHARED_VECTOR_H
+#define MICROSTL_SHARED_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../memory/epoch.h"
+#include "../utility/hardening.h"
+#include "vector.h"
+
+/**
+ * 不可变的共享快照 shared_vector<T> 与原子发布点 atomic_shared_vector<T>，用于读多写少的配置表、路由表：
+ *
+ * - shared_vector 指向一块带引用计数的只读存储，复制只增加引用计数，O(1)；最后一个引用消失时析构元素并释放存储
+ * - 元素与引用计数在同一次分配中，存储来自 AllocByMalloc（AllocByFreeList 不能在多个线程中同时使用）
+ * - 写者从快照得到私有的 vector（to_vector），修改完后构造新的 shared_vector，再 store 或 compare_exchange 发布；
+ *   update(edit) 封装了「复制、修改、比较交换」的重试循环
+ * - atomic_shared_vector 持有当前版本的一个引用。读者 load 时在 epoch_guard 内读取指针并增加引用计数，全程不加锁；
+ *   被替换的旧版本不会立即减少发布点持有的引用，而是交给 epoch_retire，等所有可能读到旧指针的线程离开后才减少，
+ *   因此读者增加引用计数时存储一定还没有被释放
+ * - 旧版本在最后一个读者释放快照、且 epoch 回收之后才会析构；epoch_reclaim() 可以立即尝试回收本线程交出的旧版本
+ */
+
+namespace MicroSTL {
+
+    template<typename T>
+    struct _shared_block {
+        std::atomic<size_t> refs;
+        size_t count;
+
+        static const size_t ALIGNMENT = alignof(T) > alignof(std::atomic<size_t>) ? alignof(T)
+                                                                                   : alignof(std::atomic<size_t>);
+        // 元素紧跟在头部之后
+        static const size_t HEADER_BYTES = (sizeof(std::atomic<size_t>) + sizeof(size_t) + ALIGNMENT - 1) /
+                                           ALIGNMENT * ALIGNMENT;
+
+        T *elements() {
+            return reinterpret_cast<T *>(reinterpret_cast<char *>(this) + HEADER_BYTES);
+        }
+
+        static size_t bytes(size_t count) {
+            return HEADER_BYTES + count * sizeof(T);
+        }
+
+        /**
+         * 复制 [first, last) 构造新的存储，引用计数为 1
+         */
+        template<typename InputIterator>
+        static _shared_block *create(InputIterator first, InputIterator last, size_t count) {
+            void *memory = AllocByMalloc::aligned_allocate(bytes(count), ALIGNMENT);
+            _shared_block *block = static_cast<_shared_block *>(memory);
+            block->refs.store(1, std::memory_order_relaxed);
+            block->count = count;
+            T *out = block->elements();
+            T *current = out;
+            try {
+                for (; first != last; ++first, ++current) {
+                    MicroSTL::construct(current, *first);
+                }
+            } catch (...) {
+                MicroSTL::destroy(out, current);
+                AllocByMalloc::aligned_deallocate(memory, bytes(count), ALIGNMENT);
+                throw;
+            }
+            return block;
+        }
+
+        void retain() {
+            refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * 减少一个引用，归零时析构元素并释放存储
+         */
+        void release() {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                MicroSTL::destroy(elements(), elements() + count);
+                AllocByMalloc::aligned_deallocate(this, bytes(count), ALIGNMENT);
+            }
+        }
+
+        /**
+         * 交给 epoch_retire 的删除函数
+         */
+        static void release_retired(void *ptr) {
+            static_cast<_shared_block *>(ptr)->release();
+        }
+    };
+
+    // --------------------- 快照 --------------------------
+
+    template<typename T>
+    class atomic_shared_vector;
+
+    template<typename T>
+    class shared_vector {
+        friend class atomic_shared_vector<T>;
+
+    public:
+        using value_type = T;
+        using const_pointer = const T *;
+        using const_iterator = const T *;
+        using iterator = const_iterator;
+        using const_reference = const T &;
+        using reference = const_reference;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+    protected:
+        using block = _shared_block<T>;
+
+        block *storage;
+
+        /**
+         * 接管 target 的一个引用
+         */
+        explicit shared_vector(block *target) : storage(target) {}
+
+    public:
+        shared_vector() : storage(nullptr) {}
+
+        explicit shared_vector(const vector<T> &vec)
+                : storage(vec.empty() ? nullptr : block::create(vec.data(), vec.data() + vec.size(), vec.size())) {}
+
+        template<typename InputIterator>
+        shared_vector(InputIterator first, InputIterator last, size_type count)
+                : storage(count == 0 ? nullptr : block::create(first, last, count)) {}
+
+        shared_vector(const shared_vector &obj) : storage(obj.storage) {
+            if (storage != nullptr) {
+                storage->retain();
+            }
+        }
+
+        shared_vector(shared_vector &&obj) noexcept: storage(obj.storage) {
+            obj.storage = nullptr;
+        }
+
+        shared_vector &operator=(const shared_vector &obj) {
+            shared_vector temp(obj);
+            swap(temp);
+            return *this;
+        }
+
+        shared_vector &operator=(shared_vector &&obj) noexcept {
+            shared_vector temp(std::move(obj));
+            swap(temp);
+            return *this;
+        }
+
+        ~shared_vector() {
+            if (storage != nullptr) {
+                storage->release();
+            }
+        }
+
+        void swap(shared_vector &obj) noexcept {
+            block *temp = storage;
+            storage = obj.storage;
+            obj.storage = temp;
+        }
+
+        const_iterator begin() const {
+            return storage == nullptr ? nullptr : storage->elements();
+        }
+
+        const_iterator end() const {
+            return storage == nullptr ? nullptr : storage->elements() + storage->count;
+        }
+
+        const_pointer data() const {
+            return begin();
+        }
+
+        size_type size() const {
+            return storage == nullptr ? 0 : storage->count;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        const_reference operator[](size_type n) const {
+            MICROSTL_CHECK(n < size(), "shared_vector index out of range");
+            return storage->elements()[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= size()) {
+                throw std::out_of_range("shared_vector::at");
+            }
+            return storage->elements()[n];
+        }
+
+        const_reference front() const {
+            MICROSTL_CHECK(!empty(), "front on empty shared_vector");
+            return storage->elements()[0];
+        }
+
+        const_reference back() const {
+            MICROSTL_CHECK(!empty(), "back on empty shared_vector");
+            return storage->elements()[storage->count - 1];
+        }
+
+        /**
+         * 共享同一份存储的快照个数（包括发布点持有的引用），只用于调试与测试
+         */
+        size_type use_count() const {
+            return storage == nullptr ? 0 : storage->refs.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * 是否与 obj 共享同一份存储
+         */
+        bool same_storage(const shared_vector &obj) const {
+            return storage == obj.storage;
+        }
+
+        /**
+         * 复制出可以修改的私有 vector
+         */
+        vector<T> to_vector() const {
+            vector<T> result;
+            result.reserve(size());
+            for (const T &item: *this) {
+                result.push_back(item);
+            }
+            return result;
+        }
+    };
+
+    // --------------------- 原子发布点 --------------------------
+
+    template<typename T>
+    class atomic_shared_vector {
+    protected:
+        using block = _shared_block<T>;
+
+        std::atomic<block *> current;
+
+        /**
+         * 被替换下来的版本持有的引用交给 epoch 回收
+         */
+        static void retire(block *old) {
+            if (old != nullptr) {
+                epoch_retire(old, &block::release_retired);
+            }
+        }
+
+    public:
+        atomic_shared_vector() : current(nullptr) {}
+
+        explicit atomic_shared_vector(shared_vector<T> initial) : current(initial.storage) {
+            initial.storage = nullptr;
+        }
+
+        atomic_shared_vector(const atomic_shared_vector &) = delete;
+
+        atomic_shared_vector &operator=(const atomic_shared_vector &) = delete;
+
+        /**
+         * 析构时不能再有其他线程访问
+         */
+        ~atomic_shared_vector() {
+            block *last = current.load(std::memory_order_relaxed);
+            if (last != nullptr) {
+                last->release();
+            }
+        }
+
+        /**
+         * 取得当前版本的快照，不加锁
+         */
+        shared_vector<T> load() const {
+            epoch_guard guard;
+            block *target = current.load(std::memory_order_acquire);
+            if (target != nullptr) {
+                target->retain();
+            }
+            return shared_vector<T>(target);
+        }
+
+        /**
+         * 发布新版本
+         */
+        void store(shared_vector<T> desired) {
+            block *old = current.exchange(desired.storage, std::memory_order_acq_rel);
+            desired.storage = nullptr;
+            retire(old);
+        }
+
+        /**
+         * 当前版本仍是 expected 时发布 desired 并返回 true，否则返回 false
+         */
+        bool compare_exchange(const shared_vector<T> &expected, shared_vector<T> desired) {
+            block *old = expected.storage;
+            if (!current.compare_exchange_strong(old, desired.storage, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                return false;
+            }
+            desired.storage = nullptr;
+            retire(old);
+            return true;
+        }
+
+        /**
+         * 在当前版本的私有副本上调用 edit(vector<T> &) 后发布，期间被其他写者抢先时基于新版本重试；
+         * 返回发布的版本
+         */
+        template<typename Edit>
+        shared_vector<T> update(Edit edit) {
+            while (true) {
+                shared_vector<T> snapshot = load();
+                vector<T> draft = snapshot.to_vector();
+                edit(draft);
+                shared_vector<T> next(draft);
+                shared_vector<T> result = next;
+                if (compare_exchange(snapshot, std::move(next))) {
+                    return result;
+                }
+            }
+        }
+    };
+}
+
+#endif //MICROSTL_SHARED_VECTOR_H
@@ -0,0 +1,479 @@
+#ifndef MICROSTL_SOA_VECTOR_H
+#define MICROSTL_SOA_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "../memory/alloc.h"
+#include "../memory/construct.h"
+#include "../iterator/iterator.h"
+
+/**
+ * 按列存放的 vector（structure of arrays）：
+ *
+ * - soa_vector<Ts...> 的每个字段各占一个连续数组，由 Alloc<T> 分配；所有列共用同一个 size 与 capacity
+ * - 只访问少数字段的循环只会把这几列读入缓存，不会像 vector<struct> 那样把整行都带进来
+ * - column<I>() 返回第 I 列的 std::span，可以直接交给向量化的内核按列处理
+ * - 按行访问时 operator[] 与迭代器返回各列元素引用组成的 std::tuple<Ts &...>，可以用结构化绑定拆开
+ * - 扩容时容量翻倍，可平凡复制的列直接 memcpy，其余逐个移动构造
+ * - erase 保持顺序，需要移动其后所有行；erase_unordered 用最后一行填补空位，O(1)
+ */
+
+namespace MicroSTL {
+
+    template<typename Owner, typename Reference>
+    class _soa_iterator {
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type = typename Owner::value_type;
+        using difference_type = ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+    protected:
+        Owner *owner;
+        size_t index;
+
+    public:
+        _soa_iterator() : owner(nullptr), index(0) {}
+
+        _soa_iterator(Owner *owner, size_t index) : owner(owner), index(index) {}
+
+        /**
+         * iterator 可以隐式转换为 const_iterator
+         */
+        template<typename OtherOwner, typename OtherReference,
+                typename = typename std::enable_if<std::is_convertible<OtherOwner *, Owner *>::value>::type>
+        _soa_iterator(const _soa_iterator<OtherOwner, OtherReference> &obj)
+                : owner(obj.container()), index(obj.position()) {}
+
+        Owner *container() const {
+            return owner;
+        }
+
+        size_t position() const {
+            return index;
+        }
+
+        reference operator*() const {
+            return (*owner)[index];
+        }
+
+        reference operator[](difference_type n) const {
+            return (*owner)[index + n];
+        }
+
+        _soa_iterator &operator++() {
+            ++index;
+            return *this;
+        }
+
+        _soa_iterator operator++(int) {
+            _soa_iterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        _soa_iterator &operator--() {
+            --index;
+            return *this;
+        }
+
+        _soa_iterator operator--(int) {
+            _soa_iterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        _soa_iterator &operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        _soa_iterator &operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        _soa_iterator operator+(difference_type n) const {
+            return _soa_iterator(owner, index + n);
+        }
+
+        _soa_iterator operator-(difference_type n) const {
+            return _soa_iterator(owner, index - n);
+        }
+
+        difference_type operator-(const _soa_iterator &obj) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(obj.index);
+        }
+
+        bool operator==(const _soa_iterator &obj) const {
+            return index == obj.index;
+        }
+
+        bool operator!=(const _soa_iterator &obj) const {
+            return index != obj.index;
+        }
+
+        bool operator<(const _soa_iterator &obj) const {
+            return index < obj.index;
+        }
+
+        bool operator>(const _soa_iterator &obj) const {
+            return index > obj.index;
+        }
+
+        bool operator<=(const _soa_iterator &obj) const {
+            return index <= obj.index;
+        }
+
+        bool operator>=(const _soa_iterator &obj) const {
+            return index >= obj.index;
+        }
+    };
+
+    template<typename... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) > 0, "soa_vector 至少需要一列");
+
+    public:
+        using value_type = std::tuple<Ts...>;
+        using reference = std::tuple<Ts &...>;
+        using const_reference = std::tuple<const Ts &...>;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using iterator = _soa_iterator<soa_vector, reference>;
+        using const_iterator = _soa_iterator<const soa_vector, const_reference>;
+
+        template<size_t I>
+        using column_type = typename std::tuple_element<I, value_type>::type;
+
+        static constexpr size_t COLUMNS = sizeof...(Ts);
+
+    protected:
+        using index_sequence = std::index_sequence_for<Ts...>;
+
+        // 各列的起始地址
+        std::tuple<Ts *...> columns;
+        size_type count;
+        size_type cap;
+
+        /**
+         * 对每一列调用 f(integral_constant<size_t, I>)
+         */
+        template<typename Function, size_t... I>
+        static void each_column(Function &&f, std::index_sequence<I...>) {
+            (f(std::integral_constant<size_t, I>()), ...);
+        }
+
+        template<typename Function>
+        static void each_column(Function &&f) {
+            each_column(f, index_sequence());
+        }
+
+        template<size_t... I>
+        reference row(size_type n, std::index_sequence<I...>) {
+            return reference(std::get<I>(columns)[n]...);
+        }
+
+        template<size_t... I>
+        const_reference row(size_type n, std::index_sequence<I...>) const {
+            return const_reference(std::get<I>(columns)[n]...);
+        }
+
+        /**
+         * 把 [0, count) 移动到容量为 new_capacity 的新数组中，释放旧数组
+         */
+        void reallocate(size_type new_capacity) {
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using T = column_type<I>;
+                T *old_data = std::get<I>(columns);
+                T *new_data = Alloc<T>::allocate(new_capacity);
+                if (std::is_trivially_copyable<T>::value) {
+                    if (count != 0) {
+                        memcpy(static_cast<void *>(new_data), old_data, count * sizeof(T));
+                    }
+                } else {
+                    for (size_type i = 0; i < count; ++i) {
+                        new(new_data + i) T(std::move(old_data[i]));
+                    }
+                    MicroSTL::destroy(old_data, old_data + count);
+                }
+                Alloc<T>::deallocate(old_data, cap);
+                std::get<I>(columns) = new_data;
+            });
+            cap = new_capacity;
+        }
+
+        void grow_for_one() {
+            if (count == cap) {
+                reallocate(cap == 0 ? 8 : cap * 2);
+            }
+        }
+
+        void release() {
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using T = column_type<I>;
+                T *data = std::get<I>(columns);
+                MicroSTL::destroy(data, data + count);
+                Alloc<T>::deallocate(data, cap);
+                std::get<I>(columns) = nullptr;
+            });
+            count = 0;
+            cap = 0;
+        }
+
+        template<typename Tuple, size_t... I>
+        void push_tuple(Tuple &&values, std::index_sequence<I...>) {
+            emplace_back(std::get<I>(std::forward<Tuple>(values))...);
+        }
+
+    public:
+        soa_vector() : columns(), count(0), cap(0) {}
+
+        explicit soa_vector(size_type size) : columns(), count(0), cap(0) {
+            resize(size);
+        }
+
+        soa_vector(const soa_vector &obj) : columns(), count(0), cap(0) {
+            reserve(obj.count);
+            for (size_type i = 0; i < obj.count; ++i) {
+                push_back(value_type(obj[i]));
+            }
+        }
+
+        soa_vector(soa_vector &&obj) noexcept: columns(obj.columns), count(obj.count), cap(obj.cap) {
+            obj.columns = std::tuple<Ts *...>();
+            obj.count = 0;
+            obj.cap = 0;
+        }
+
+        ~soa_vector() {
+            release();
+        }
+
+        soa_vector &operator=(const soa_vector &obj) {
+            if (this != &obj) {
+                soa_vector tmp(obj);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        soa_vector &operator=(soa_vector &&obj) noexcept {
+            if (this != &obj) {
+                release();
+                swap(obj);
+            }
+            return *this;
+        }
+
+        void swap(soa_vector &obj) noexcept {
+            std::swap(columns, obj.columns);
+            std::swap(count, obj.count);
+            std::swap(cap, obj.cap);
+        }
+
+        // --------------------- 容量 --------------------------
+
+        size_type size() const {
+            return count;
+        }
+
+        size_type capacity() const {
+            return cap;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        void reserve(size_type new_capacity) {
+            if (new_capacity > cap) {
+                reallocate(new_capacity);
+            }
+        }
+
+        /**
+         * 变长时新增的行值初始化
+         */
+        void resize(size_type new_size) {
+            if (new_size > cap) {
+                reallocate(new_size > cap * 2 ? new_size : cap * 2);
+            }
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                using T = column_type<I>;
+                T *data = std::get<I>(columns);
+                if (new_size < count) {
+                    MicroSTL::destroy(data + new_size, data + count);
+                }
+                for (size_type i = count; i < new_size; ++i) {
+                    new(data + i) T();
+                }
+            });
+            count = new_size;
+        }
+
+        void clear() {
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                column_type<I> *data = std::get<I>(columns);
+                MicroSTL::destroy(data, data + count);
+            });
+            count = 0;
+        }
+
+        // --------------------- 按列访问 --------------------------
+
+        template<size_t I>
+        column_type<I> *data() {
+            return std::get<I>(columns);
+        }
+
+        template<size_t I>
+        const column_type<I> *data() const {
+            return std::get<I>(columns);
+        }
+
+        template<size_t I>
+        std::span<column_type<I>> column() {
+            return std::span<column_type<I>>(std::get<I>(columns), count);
+        }
+
+        template<size_t I>
+        std::span<const column_type<I>> column() const {
+            return std::span<const column_type<I>>(std::get<I>(columns), count);
+        }
+
+        // --------------------- 按行访问 --------------------------
+
+        reference operator[](size_type n) {
+            return row(n, index_sequence());
+        }
+
+        const_reference operator[](size_type n) const {
+            return row(n, index_sequence());
+        }
+
+        reference at(size_type n) {
+            if (n >= count) {
+                throw std::out_of_range("soa_vector::at");
+            }
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= count) {
+                throw std::out_of_range("soa_vector::at");
+            }
+            return (*this)[n];
+        }
+
+        reference front() {
+            return (*this)[0];
+        }
+
+        reference back() {
+            return (*this)[count - 1];
+        }
+
+        iterator begin() {
+            return iterator(this, 0);
+        }
+
+        iterator end() {
+            return iterator(this, count);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, count);
+        }
+
+        // --------------------- 修改 --------------------------
+
+        /**
+         * 每列一个参数，依次构造该行的各个字段
+         */
+        template<typename... Args>
+        reference emplace_back(Args &&... args) {
+            static_assert(sizeof...(Args) == COLUMNS, "soa_vector::emplace_back 需要为每一列提供一个参数");
+            grow_for_one();
+            std::tuple<Args &&...> values(std::forward<Args>(args)...);
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                new(std::get<I>(columns) + count) column_type<I>(std::get<I>(std::move(values)));
+            });
+            ++count;
+            return back();
+        }
+
+        void push_back(const value_type &value) {
+            push_tuple(value, index_sequence());
+        }
+
+        void push_back(value_type &&value) {
+            push_tuple(std::move(value), index_sequence());
+        }
+
+        void pop_back() {
+            --count;
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                MicroSTL::destroy(std::get<I>(columns) + count);
+            });
+        }
+
+        /**
+         * 删除 [first, last) 行，其后的行依次前移
+         */
+        iterator erase(const_iterator first, const_iterator last) {
+            size_type from = first.position();
+            size_type to = last.position();
+            if (from == to) {
+                return begin() + from;
+            }
+            each_column([&](auto column) {
+                constexpr size_t I = decltype(column)::value;
+                column_type<I> *data = std::get<I>(columns);
+                for (size_type i = to; i < count; ++i) {
+                    data[from + i - to] = std::move(data[i]);
+                }
+                MicroSTL::destroy(data + count - (to - from), data + count);
+            });
+            count -= to - from;
+            return begin() + from;
+        }
+
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+
+        /**
+         * 用最后一行覆盖第 n 行，不保持顺序
+         */
+        void erase_unordered(size_type n) {
+            if (n != count - 1) {
+                each_column([&](auto column) {
+                    constexpr size_t I = decltype(column)::value;
+                    column_type<I> *data = std::get<I>(columns);
+                    data[n] = std::move(data[count - 1]);
+                });
+            }
+            pop_back();
+        }
+    };
+}
+
+#endif //MICROSTL_SOA_VECTOR_H
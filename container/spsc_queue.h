@@ -0,0 +1,188 @@
+#ifndef MICROSTL_SPSC_QUEUE_H
+#define MICROSTL_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "ring_buffer.h"
+
+/**
+ * 单生产者单消费者的有界无锁队列，基于 ring_buffer 的存储：
+ *
+ * - 每个操作的步数有上限，不会自旋等待（wait-free）；满或空时立即返回 false
+ * - head 只由消费者写，tail 只由生产者写，两者各占一条 cache line，避免伪共享
+ * - 生产者缓存最近一次读到的 head，消费者缓存最近一次读到的 tail：
+ *      只有缓存值显示队列已满或已空时才读取对方的原子变量，大部分操作不会访问对方的 cache line
+ * - 存储在构造时分配，之后不再分配内存
+ * - 同一时刻只能有一个线程调用 push 系列函数，一个线程调用 pop 系列函数
+ */
+
+namespace MicroSTL {
+
+    template<typename T>
+    class spsc_queue {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+
+    protected:
+        // 消费者独占的 cache line
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> head;
+        size_type cached_tail;
+
+        // 生产者独占的 cache line
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> tail;
+        size_type cached_head;
+
+        // 只读的部分单独放在一条 cache line 上
+        alignas(CACHE_LINE_SIZE) _ring_storage<T> storage;
+
+        /**
+         * 生产者可写入的槽位数，缓存的 head 不足以满足 wanted 时才重新读取
+         */
+        size_type writable(size_type t, size_type wanted) {
+            size_type available = storage.capacity() - (t - cached_head);
+            if (available < wanted) {
+                cached_head = head.load(std::memory_order_acquire);
+                available = storage.capacity() - (t - cached_head);
+            }
+            return available;
+        }
+
+        /**
+         * 消费者可读取的元素个数，缓存的 tail 不足以满足 wanted 时才重新读取
+         */
+        size_type readable(size_type h, size_type wanted) {
+            size_type available = cached_tail - h;
+            if (available < wanted) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                available = cached_tail - h;
+            }
+            return available;
+        }
+
+    public:
+        explicit spsc_queue(size_type capacity) : head(0), cached_tail(0), tail(0), cached_head(0), storage(capacity) {}
+
+        spsc_queue(const spsc_queue &) = delete;
+
+        spsc_queue &operator=(const spsc_queue &) = delete;
+
+        ~spsc_queue() {
+            size_type t = tail.load(std::memory_order_relaxed);
+            for (size_type h = head.load(std::memory_order_relaxed); h != t; ++h) {
+                MicroSTL::destroy(storage.slot(h));
+            }
+        }
+
+        size_type capacity() const {
+            return storage.capacity();
+        }
+
+        /**
+         * 其他线程同时读写时只是一个近似值
+         */
+        size_type size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // --------------------- 生产者 --------------------------
+
+        template<typename... Args>
+        bool try_emplace(Args &&... args) {
+            size_type t = tail.load(std::memory_order_relaxed);
+            if (writable(t, 1) == 0) {
+                return false;
+            }
+            new(storage.slot(t)) T(std::forward<Args>(args)...);
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T &obj) {
+            return try_emplace(obj);
+        }
+
+        bool try_push(T &&obj) {
+            return try_emplace(std::move(obj));
+        }
+
+        /**
+         * 从 first 开始最多写入 count 个元素，只发布一次 tail，返回实际写入的个数
+         */
+        template<typename InputIterator>
+        size_type push_batch(InputIterator first, size_type count) {
+            size_type t = tail.load(std::memory_order_relaxed);
+            size_type available = writable(t, count);
+            if (count > available) {
+                count = available;
+            }
+            for (size_type i = 0; i < count; ++i, ++first) {
+                new(storage.slot(t + i)) T(*first);
+            }
+            if (count != 0) {
+                tail.store(t + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        // --------------------- 消费者 --------------------------
+
+        bool try_pop(T &out) {
+            size_type h = head.load(std::memory_order_relaxed);
+            if (readable(h, 1) == 0) {
+                return false;
+            }
+            T *position = storage.slot(h);
+            out = std::move(*position);
+            MicroSTL::destroy(position);
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * 队首元素的指针，为空时返回 nullptr；之后需要调用 pop 移除
+         */
+        T *front() {
+            size_type h = head.load(std::memory_order_relaxed);
+            return readable(h, 1) == 0 ? nullptr : storage.slot(h);
+        }
+
+        /**
+         * 移除队首元素，调用前 front() 必须不为空
+         */
+        void pop() {
+            size_type h = head.load(std::memory_order_relaxed);
+            MicroSTL::destroy(storage.slot(h));
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        /**
+         * 最多取出 count 个元素写入 result，只发布一次 head，返回实际取出的个数
+         */
+        template<typename OutputIterator>
+        size_type pop_batch(OutputIterator result, size_type count) {
+            size_type h = head.load(std::memory_order_relaxed);
+            size_type available = readable(h, count);
+            if (count > available) {
+                count = available;
+            }
+            for (size_type i = 0; i < count; ++i, ++result) {
+                T *position = storage.slot(h + i);
+                *result = std::move(*position);
+                MicroSTL::destroy(position);
+            }
+            if (count != 0) {
+                head.store(h + count, std::memory_order_release);
+            }
+            return count;
+        }
+    };
+}
+
+#endif //MICROSTL_SPSC_QUEUE_H
@@ -0,0 +1,690 @@
+#ifndef MICROSTL_STRING_H
+#define MICROSTL_STRING_H
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "string_view.h"
+#include "../memory/alloc.h"
+#include "../memory/uninitialized.h"
+#include "../algorithm/algobase.h"
+
+/**
+ * 带短字符串优化（SSO）的字符串：
+ *
+ * - 对象大小为 3 个指针（64 位下 24 字节），长字符串时依次存放 数据指针、长度、容量
+ * - 短字符串直接存放在对象内部，char 最多 23 个字符，wchar_t / char32_t 最多 5 个，char16_t 最多 11 个
+ *      - 最后一个字符的位置存放 剩余容量 = 短容量 - 长度，恰好填满时剩余容量为 0，同时充当结尾的 '\0'
+ *      - 长字符串的容量字段最高位置 1；小端序下它落在对象的最后一个字节，与短字符串的剩余容量互不冲突，
+ *        读取最后一个字节的最高位即可区分两种状态
+ * - 长字符串的空间来自 Alloc<CharT>，多分配一个字符存放 '\0'，容量不足时至少扩大为原来的 2 倍
+ * - 字符的复制使用 uninitialized_copy / copy / copy_backward，char、wchar_t 会走 memmove 的重载
+ * - find / compare 等只读操作转换为 basic_string_view 后执行，共用其中基于 SIMD 内核的实现
+ */
+
+namespace MicroSTL {
+
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "basic_string 的短字符串布局要求小端序");
+
+    template<typename CharT>
+    class basic_string {
+    public:
+        using value_type = CharT;
+        using pointer = CharT *;
+        using const_pointer = const CharT *;
+        using reference = CharT &;
+        using const_reference = const CharT &;
+        // 迭代器为原生指针
+        using iterator = CharT *;
+        using const_iterator = const CharT *;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using view_type = basic_string_view<CharT>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    protected:
+        using allocator = Alloc<CharT>;
+
+        struct _long_rep {
+            CharT *data;
+            size_type size;
+            // 最高位为长字符串标记，容量不包含结尾的 '\0'
+            size_type capacity;
+        };
+
+        static constexpr size_type SHORT_SLOTS = sizeof(_long_rep) / sizeof(CharT);
+        static constexpr size_type SHORT_CAPACITY = SHORT_SLOTS - 1;
+        static constexpr size_type LONG_FLAG = static_cast<size_type>(1) << (sizeof(size_type) * 8 - 1);
+
+        union {
+            _long_rep l;
+            CharT s[SHORT_SLOTS];
+        } rep;
+
+        bool is_long() const {
+            return (reinterpret_cast<const unsigned char *>(&rep)[sizeof(rep) - 1] & 0x80) != 0;
+        }
+
+        void set_short_size(size_type size) {
+            rep.s[SHORT_CAPACITY] = static_cast<CharT>(SHORT_CAPACITY - size);
+            rep.s[size] = CharT();
+        }
+
+        void set_size(size_type size) {
+            if (is_long()) {
+                rep.l.size = size;
+                rep.l.data[size] = CharT();
+            } else {
+                set_short_size(size);
+            }
+        }
+
+        /**
+         * 分配能容纳 capacity 个字符的长字符串空间，原有内容由调用者处理
+         */
+        void set_long(CharT *data, size_type size, size_type capacity) {
+            rep.l.data = data;
+            rep.l.size = size;
+            rep.l.capacity = capacity | LONG_FLAG;
+            data[size] = CharT();
+        }
+
+        void deallocate() {
+            if (is_long()) {
+                allocator::deallocate(rep.l.data, capacity() + 1);
+            }
+        }
+
+        void initialize(const CharT *s, size_type size) {
+            if (size <= SHORT_CAPACITY) {
+                MicroSTL::uninitialized_copy(s, s + size, rep.s);
+                set_short_size(size);
+            } else {
+                CharT *data = allocator::allocate(size + 1);
+                MicroSTL::uninitialized_copy(s, s + size, data);
+                set_long(data, size, size);
+            }
+        }
+
+        void initialize_fill(size_type size, CharT c) {
+            CharT *data = rep.s;
+            if (size > SHORT_CAPACITY) {
+                data = allocator::allocate(size + 1);
+            }
+            for (size_type i = 0; i < size; ++i) {
+                data[i] = c;
+            }
+            if (size > SHORT_CAPACITY) {
+                set_long(data, size, size);
+            } else {
+                set_short_size(size);
+            }
+        }
+
+        /**
+         * 容量扩大到至少 required，保留原有内容
+         */
+        void grow(size_type required) {
+            size_type old_capacity = capacity();
+            size_type new_capacity = old_capacity * 2 > required ? old_capacity * 2 : required;
+            size_type size = this->size();
+            CharT *data = allocator::allocate(new_capacity + 1);
+            MicroSTL::uninitialized_copy(static_cast<const CharT *>(this->data()),
+                                         static_cast<const CharT *>(this->data()) + size, data);
+            deallocate();
+            set_long(data, size, new_capacity);
+        }
+
+    public:
+        basic_string() noexcept {
+            set_short_size(0);
+        }
+
+        basic_string(const CharT *s) {
+            initialize(s, _string_length(s));
+        }
+
+        basic_string(const CharT *s, size_type size) {
+            initialize(s, size);
+        }
+
+        basic_string(size_type size, CharT c) {
+            initialize_fill(size, c);
+        }
+
+        explicit basic_string(view_type view) {
+            initialize(view.data(), view.size());
+        }
+
+        basic_string(const basic_string &obj) {
+            initialize(obj.data(), obj.size());
+        }
+
+        /**
+         * 直接接管对方的表示，对方变为空的短字符串
+         */
+        basic_string(basic_string &&obj) noexcept: rep(obj.rep) {
+            obj.set_short_size(0);
+        }
+
+        ~basic_string() {
+            deallocate();
+        }
+
+        basic_string &operator=(const basic_string &obj) {
+            if (this != &obj) {
+                assign(obj.data(), obj.size());
+            }
+            return *this;
+        }
+
+        basic_string &operator=(basic_string &&obj) noexcept {
+            if (this != &obj) {
+                deallocate();
+                rep = obj.rep;
+                obj.set_short_size(0);
+            }
+            return *this;
+        }
+
+        basic_string &operator=(const CharT *s) {
+            return assign(s, _string_length(s));
+        }
+
+        basic_string &operator=(view_type view) {
+            return assign(view.data(), view.size());
+        }
+
+        /**
+         * 容量足够时原地覆盖，s 可以指向自身的内容
+         */
+        basic_string &assign(const CharT *s, size_type size) {
+            if (size > capacity()) {
+                basic_string tmp(s, size);
+                swap(tmp);
+                return *this;
+            }
+            MicroSTL::copy(const_cast<CharT *>(s), const_cast<CharT *>(s) + size, data());
+            set_size(size);
+            return *this;
+        }
+
+        // --------------------- 访问 --------------------------
+
+        iterator begin() {
+            return data();
+        }
+
+        const_iterator begin() const {
+            return data();
+        }
+
+        iterator end() {
+            return data() + size();
+        }
+
+        const_iterator end() const {
+            return data() + size();
+        }
+
+        CharT *data() {
+            return is_long() ? rep.l.data : rep.s;
+        }
+
+        const CharT *data() const {
+            return is_long() ? rep.l.data : rep.s;
+        }
+
+        const CharT *c_str() const {
+            return data();
+        }
+
+        size_type size() const {
+            return is_long() ? rep.l.size : SHORT_CAPACITY - static_cast<size_type>(rep.s[SHORT_CAPACITY]);
+        }
+
+        size_type length() const {
+            return size();
+        }
+
+        size_type capacity() const {
+            return is_long() ? rep.l.capacity & ~LONG_FLAG : SHORT_CAPACITY;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        reference operator[](size_type n) {
+            return data()[n];
+        }
+
+        const_reference operator[](size_type n) const {
+            return data()[n];
+        }
+
+        reference at(size_type n) {
+            if (n >= size()) {
+                throw std::out_of_range("basic_string::at");
+            }
+            return data()[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= size()) {
+                throw std::out_of_range("basic_string::at");
+            }
+            return data()[n];
+        }
+
+        reference front() {
+            return data()[0];
+        }
+
+        const_reference front() const {
+            return data()[0];
+        }
+
+        reference back() {
+            return data()[size() - 1];
+        }
+
+        const_reference back() const {
+            return data()[size() - 1];
+        }
+
+        operator view_type() const {
+            return view_type(data(), size());
+        }
+
+        // --------------------- 容量 --------------------------
+
+        void reserve(size_type new_capacity) {
+            if (new_capacity > capacity()) {
+                grow(new_capacity);
+            }
+        }
+
+        /**
+         * 长度足够短时搬回对象内部，否则重新分配为恰好的大小
+         */
+        void shrink_to_fit() {
+            if (is_long() && size() < capacity()) {
+                basic_string tmp(data(), size());
+                swap(tmp);
+            }
+        }
+
+        void clear() {
+            set_size(0);
+        }
+
+        void resize(size_type new_size, CharT c = CharT()) {
+            size_type old_size = size();
+            if (new_size > old_size) {
+                append(new_size - old_size, c);
+            } else {
+                set_size(new_size);
+            }
+        }
+
+        // --------------------- 追加 --------------------------
+
+        /**
+         * 只判断一次长短状态，逐字符追加时不必在 size()、capacity()、data() 中反复分支
+         */
+        void push_back(CharT c) {
+            if (!is_long()) {
+                size_type old_size = SHORT_CAPACITY - static_cast<size_type>(rep.s[SHORT_CAPACITY]);
+                if (old_size < SHORT_CAPACITY) {
+                    rep.s[old_size] = c;
+                    set_short_size(old_size + 1);
+                    return;
+                }
+                grow(old_size + 1);
+            } else if (rep.l.size == (rep.l.capacity & ~LONG_FLAG)) {
+                grow(rep.l.size + 1);
+            }
+            size_type old_size = rep.l.size;
+            rep.l.data[old_size] = c;
+            rep.l.data[old_size + 1] = CharT();
+            rep.l.size = old_size + 1;
+        }
+
+        void pop_back() {
+            set_size(size() - 1);
+        }
+
+        /**
+         * s 可以指向自身的内容：扩容时先复制到新空间，再释放旧空间
+         */
+        basic_string &append(const CharT *s, size_type n) {
+            size_type old_size = size();
+            size_type new_size = old_size + n;
+            if (new_size > capacity()) {
+                size_type old_capacity = capacity();
+                size_type new_capacity = old_capacity * 2 > new_size ? old_capacity * 2 : new_size;
+                CharT *new_data = allocator::allocate(new_capacity + 1);
+                MicroSTL::uninitialized_copy(static_cast<const CharT *>(data()),
+                                             static_cast<const CharT *>(data()) + old_size, new_data);
+                MicroSTL::uninitialized_copy(s, s + n, new_data + old_size);
+                deallocate();
+                set_long(new_data, new_size, new_capacity);
+                return *this;
+            }
+            CharT *p = data();
+            MicroSTL::copy(const_cast<CharT *>(s), const_cast<CharT *>(s) + n, p + old_size);
+            set_size(new_size);
+            return *this;
+        }
+
+        basic_string &append(const CharT *s) {
+            return append(s, _string_length(s));
+        }
+
+        basic_string &append(view_type view) {
+            return append(view.data(), view.size());
+        }
+
+        basic_string &append(const basic_string &obj) {
+            return append(obj.data(), obj.size());
+        }
+
+        basic_string &append(size_type n, CharT c) {
+            size_type old_size = size();
+            if (old_size + n > capacity()) {
+                grow(old_size + n);
+            }
+            CharT *p = data() + old_size;
+            for (size_type i = 0; i < n; ++i) {
+                p[i] = c;
+            }
+            set_size(old_size + n);
+            return *this;
+        }
+
+        basic_string &operator+=(const basic_string &obj) {
+            return append(obj.data(), obj.size());
+        }
+
+        basic_string &operator+=(view_type view) {
+            return append(view.data(), view.size());
+        }
+
+        basic_string &operator+=(const CharT *s) {
+            return append(s);
+        }
+
+        basic_string &operator+=(CharT c) {
+            push_back(c);
+            return *this;
+        }
+
+        // --------------------- 插入与删除 --------------------------
+
+        /**
+         * 在 pos 处插入 [s, s + n)，s 不能指向自身的内容
+         */
+        basic_string &insert(size_type pos, const CharT *s, size_type n) {
+            size_type old_size = size();
+            if (pos > old_size) {
+                throw std::out_of_range("basic_string::insert");
+            }
+            if (old_size + n > capacity()) {
+                grow(old_size + n);
+            }
+            CharT *p = data();
+            MicroSTL::copy_backward(p + pos, p + old_size, p + old_size + n);
+            MicroSTL::copy(const_cast<CharT *>(s), const_cast<CharT *>(s) + n, p + pos);
+            set_size(old_size + n);
+            return *this;
+        }
+
+        basic_string &insert(size_type pos, view_type view) {
+            return insert(pos, view.data(), view.size());
+        }
+
+        basic_string &insert(size_type pos, const CharT *s) {
+            return insert(pos, s, _string_length(s));
+        }
+
+        basic_string &erase(size_type pos = 0, size_type n = npos) {
+            size_type old_size = size();
+            if (pos > old_size) {
+                throw std::out_of_range("basic_string::erase");
+            }
+            size_type rest = old_size - pos;
+            if (n > rest) {
+                n = rest;
+            }
+            CharT *p = data();
+            MicroSTL::copy(p + pos + n, p + old_size, p + pos);
+            set_size(old_size - n);
+            return *this;
+        }
+
+        iterator erase(const_iterator position) {
+            size_type pos = position - begin();
+            erase(pos, 1);
+            return begin() + pos;
+        }
+
+        void swap(basic_string &obj) noexcept {
+            MicroSTL::swap(rep, obj.rep);
+        }
+
+        // --------------------- 查找与比较 --------------------------
+
+        basic_string substr(size_type pos = 0, size_type n = npos) const {
+            return basic_string(view_type(*this).substr(pos, n));
+        }
+
+        size_type find(CharT c, size_type pos = 0) const {
+            return view_type(*this).find(c, pos);
+        }
+
+        size_type find(view_type view, size_type pos = 0) const {
+            return view_type(*this).find(view, pos);
+        }
+
+        size_type rfind(CharT c, size_type pos = npos) const {
+            return view_type(*this).rfind(c, pos);
+        }
+
+        size_type rfind(view_type view, size_type pos = npos) const {
+            return view_type(*this).rfind(view, pos);
+        }
+
+        size_type find_first_of(view_type chars, size_type pos = 0) const {
+            return view_type(*this).find_first_of(chars, pos);
+        }
+
+        size_type find_first_not_of(view_type chars, size_type pos = 0) const {
+            return view_type(*this).find_first_not_of(chars, pos);
+        }
+
+        size_type find_last_of(view_type chars, size_type pos = npos) const {
+            return view_type(*this).find_last_of(chars, pos);
+        }
+
+        size_type find_last_not_of(view_type chars, size_type pos = npos) const {
+            return view_type(*this).find_last_not_of(chars, pos);
+        }
+
+        bool contains(view_type view) const {
+            return find(view) != npos;
+        }
+
+        bool contains(CharT c) const {
+            return find(c) != npos;
+        }
+
+        bool starts_with(view_type view) const {
+            return view_type(*this).starts_with(view);
+        }
+
+        bool starts_with(CharT c) const {
+            return view_type(*this).starts_with(c);
+        }
+
+        bool ends_with(view_type view) const {
+            return view_type(*this).ends_with(view);
+        }
+
+        bool ends_with(CharT c) const {
+            return view_type(*this).ends_with(c);
+        }
+
+        int compare(view_type view) const {
+            return view_type(*this).compare(view);
+        }
+    };
+
+    using string = basic_string<char>;
+    using wstring = basic_string<wchar_t>;
+    using u16string = basic_string<char16_t>;
+    using u32string = basic_string<char32_t>;
+
+    // --------------------- 拼接 --------------------------
+
+    /**
+     * 先按最终长度预留空间，再依次追加，只分配一次
+     */
+    template<typename CharT>
+    inline basic_string<CharT> _string_concat(const CharT *a, size_t a_size, const CharT *b, size_t b_size) {
+        basic_string<CharT> result;
+        result.reserve(a_size + b_size);
+        result.append(a, a_size);
+        result.append(b, b_size);
+        return result;
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return _string_concat(a.data(), a.size(), b.data(), b.size());
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(const basic_string<CharT> &a, const CharT *b) {
+        return _string_concat(a.data(), a.size(), b, _string_length(b));
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(const CharT *a, const basic_string<CharT> &b) {
+        return _string_concat(a, _string_length(a), b.data(), b.size());
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(const basic_string<CharT> &a, CharT b) {
+        return _string_concat(a.data(), a.size(), &b, 1);
+    }
+
+    /**
+     * 左侧是临时对象时直接在其上追加，连续拼接只在容量不足时重新分配
+     */
+    template<typename CharT>
+    inline basic_string<CharT> operator+(basic_string<CharT> &&a, const basic_string<CharT> &b) {
+        a.append(b);
+        return std::move(a);
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(basic_string<CharT> &&a, const CharT *b) {
+        a.append(b);
+        return std::move(a);
+    }
+
+    template<typename CharT>
+    inline basic_string<CharT> operator+(basic_string<CharT> &&a, CharT b) {
+        a.push_back(b);
+        return std::move(a);
+    }
+
+    // --------------------- 比较 --------------------------
+
+    template<typename CharT>
+    inline bool operator==(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return a.size() == b.size() && _string_compare(a.data(), b.data(), a.size()) == 0;
+    }
+
+    template<typename CharT>
+    inline bool operator==(const basic_string<CharT> &a, _string_view_t<CharT> b) {
+        return a.size() == b.size() && _string_compare(a.data(), b.data(), a.size()) == 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(const basic_string<CharT> &a, _string_view_t<CharT> b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(_string_view_t<CharT> a, const basic_string<CharT> &b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(const basic_string<CharT> &a, _string_view_t<CharT> b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(_string_view_t<CharT> a, const basic_string<CharT> &b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(const basic_string<CharT> &a, _string_view_t<CharT> b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(_string_view_t<CharT> a, const basic_string<CharT> &b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(const basic_string<CharT> &a, const basic_string<CharT> &b) {
+        return a.compare(b) >= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(const basic_string<CharT> &a, _string_view_t<CharT> b) {
+        return a.compare(b) >= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(_string_view_t<CharT> a, const basic_string<CharT> &b) {
+        return a.compare(b) >= 0;
+    }
+
+    /**
+     * 透明哈希，可以直接用 basic_string_view 或字符指针查找，不构造临时字符串
+     */
+    template<typename CharT>
+    struct hash<basic_string<CharT>> {
+        using is_transparent = void;
+
+        size_t operator()(basic_string_view<CharT> value) const {
+            return _hash_bytes(value.data(), value.size() * sizeof(CharT));
+        }
+    };
+}
+
+#endif //MICROSTL_STRING_H
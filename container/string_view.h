@@ -0,0 +1,394 @@
+#ifndef MICROSTL_STRING_VIEW_H
+#define MICROSTL_STRING_VIEW_H
+
+#include <cstddef>
+#include <cstring>
+#include <cwchar>
+#include <stdexcept>
+#include <type_traits>
+#include "../algorithm/simd.h"
+#include "../functor/hash.h"
+
+/**
+ * 不持有内存的字符串视图，只记录起始指针与长度：
+ *
+ * - 切片（substr、remove_prefix、remove_suffix）只调整指针与长度，不分配内存也不复制字符
+ * - 视图不保证以 '\0' 结尾，data() 不能直接当作 C 字符串使用
+ * - 查找基于 simd.h 中的内核：单个字符用 simd_find，子串用 simd_search
+ * - 比较按字符的无符号值进行，单字节字符直接使用 memcmp，其余先 simd_mismatch 再比较该位置的字符
+ * - 被引用的字符串必须比视图活得更久
+ */
+
+namespace MicroSTL {
+
+    // --------------------- 字符串基础操作 --------------------------
+
+    inline size_t _string_length(const char *s) {
+        return strlen(s);
+    }
+
+    inline size_t _string_length(const wchar_t *s) {
+        return wcslen(s);
+    }
+
+    template<typename CharT>
+    inline size_t _string_length(const CharT *s) {
+        size_t size = 0;
+        while (s[size] != CharT()) {
+            ++size;
+        }
+        return size;
+    }
+
+    /**
+     * 比较 a、b 的前 size 个字符，返回负数、0、正数
+     */
+    template<typename CharT>
+    inline int _string_compare(const CharT *a, const CharT *b, size_t size) {
+        if (sizeof(CharT) == 1) {
+            return size == 0 ? 0 : memcmp(a, b, size);
+        }
+        size_t position = simd_mismatch(a, b, size);
+        if (position == size) {
+            return 0;
+        }
+        using unsigned_char = typename std::make_unsigned<CharT>::type;
+        return static_cast<unsigned_char>(a[position]) < static_cast<unsigned_char>(b[position]) ? -1 : 1;
+    }
+
+    /**
+     * 长度不同时先比较公共部分，公共部分相等则较短的更小
+     */
+    template<typename CharT>
+    inline int _string_compare(const CharT *a, size_t a_size, const CharT *b, size_t b_size) {
+        int result = _string_compare(a, b, a_size < b_size ? a_size : b_size);
+        if (result != 0) {
+            return result;
+        }
+        return a_size < b_size ? -1 : (a_size == b_size ? 0 : 1);
+    }
+
+    // --------------------- basic_string_view --------------------------
+
+    template<typename CharT>
+    class basic_string_view {
+    public:
+        using value_type = CharT;
+        using pointer = CharT *;
+        using const_pointer = const CharT *;
+        using reference = const CharT &;
+        using const_reference = const CharT &;
+        // 迭代器为原生指针
+        using iterator = const CharT *;
+        using const_iterator = const CharT *;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    protected:
+        const CharT *start;
+        size_type len;
+
+    public:
+        constexpr basic_string_view() noexcept: start(nullptr), len(0) {}
+
+        basic_string_view(const CharT *s) : start(s), len(_string_length(s)) {}
+
+        constexpr basic_string_view(const CharT *s, size_type size) : start(s), len(size) {}
+
+        constexpr basic_string_view(const basic_string_view &obj) noexcept = default;
+
+        basic_string_view &operator=(const basic_string_view &obj) noexcept = default;
+
+        constexpr const_iterator begin() const noexcept {
+            return start;
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return start + len;
+        }
+
+        constexpr const_pointer data() const noexcept {
+            return start;
+        }
+
+        constexpr size_type size() const noexcept {
+            return len;
+        }
+
+        constexpr size_type length() const noexcept {
+            return len;
+        }
+
+        constexpr bool empty() const noexcept {
+            return len == 0;
+        }
+
+        constexpr const_reference operator[](size_type n) const {
+            return start[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= len) {
+                throw std::out_of_range("basic_string_view::at");
+            }
+            return start[n];
+        }
+
+        constexpr const_reference front() const {
+            return start[0];
+        }
+
+        constexpr const_reference back() const {
+            return start[len - 1];
+        }
+
+        // --------------------- 切片 --------------------------
+
+        void remove_prefix(size_type n) {
+            start += n;
+            len -= n;
+        }
+
+        void remove_suffix(size_type n) {
+            len -= n;
+        }
+
+        /**
+         * 从 pos 开始最多 n 个字符，pos 超出长度时抛出 out_of_range
+         */
+        basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+            if (pos > len) {
+                throw std::out_of_range("basic_string_view::substr");
+            }
+            size_type rest = len - pos;
+            return basic_string_view(start + pos, n < rest ? n : rest);
+        }
+
+        void swap(basic_string_view &obj) noexcept {
+            basic_string_view tmp = *this;
+            *this = obj;
+            obj = tmp;
+        }
+
+        // --------------------- 比较 --------------------------
+
+        int compare(basic_string_view obj) const {
+            return _string_compare(start, len, obj.start, obj.len);
+        }
+
+        bool starts_with(basic_string_view obj) const {
+            return len >= obj.len && _string_compare(start, obj.start, obj.len) == 0;
+        }
+
+        bool starts_with(CharT c) const {
+            return len != 0 && start[0] == c;
+        }
+
+        bool ends_with(basic_string_view obj) const {
+            return len >= obj.len && _string_compare(start + len - obj.len, obj.start, obj.len) == 0;
+        }
+
+        bool ends_with(CharT c) const {
+            return len != 0 && start[len - 1] == c;
+        }
+
+        // --------------------- 查找 --------------------------
+
+        size_type find(CharT c, size_type pos = 0) const {
+            if (pos >= len) {
+                return npos;
+            }
+            const CharT *result = simd_find(start + pos, start + len, c);
+            return result == start + len ? npos : static_cast<size_type>(result - start);
+        }
+
+        size_type find(basic_string_view obj, size_type pos = 0) const {
+            if (pos > len) {
+                return npos;
+            }
+            size_type rest = len - pos;
+            size_type result = simd_search(start + pos, rest, obj.start, obj.len);
+            return result == rest && obj.len != 0 ? npos : pos + result;
+        }
+
+        size_type rfind(CharT c, size_type pos = npos) const {
+            if (len == 0) {
+                return npos;
+            }
+            size_type i = pos < len ? pos : len - 1;
+            for (;; --i) {
+                if (start[i] == c) {
+                    return i;
+                }
+                if (i == 0) {
+                    return npos;
+                }
+            }
+        }
+
+        size_type rfind(basic_string_view obj, size_type pos = npos) const {
+            if (obj.len > len) {
+                return npos;
+            }
+            size_type i = len - obj.len;
+            if (pos < i) {
+                i = pos;
+            }
+            for (;; --i) {
+                if (_string_compare(start + i, obj.start, obj.len) == 0) {
+                    return i;
+                }
+                if (i == 0) {
+                    return npos;
+                }
+            }
+        }
+
+        bool contains(basic_string_view obj) const {
+            return find(obj) != npos;
+        }
+
+        bool contains(CharT c) const {
+            return find(c) != npos;
+        }
+
+        /**
+         * 第一个属于 chars 的字符；chars 只有一个字符时退化为 find
+         */
+        size_type find_first_of(basic_string_view chars, size_type pos = 0) const {
+            if (chars.len == 1) {
+                return find(chars.start[0], pos);
+            }
+            for (size_type i = pos; i < len; ++i) {
+                if (chars.contains(start[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_first_not_of(basic_string_view chars, size_type pos = 0) const {
+            for (size_type i = pos; i < len; ++i) {
+                if (!chars.contains(start[i])) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_last_of(basic_string_view chars, size_type pos = npos) const {
+            for (size_type i = pos < len ? pos + 1 : len; i > 0; --i) {
+                if (chars.contains(start[i - 1])) {
+                    return i - 1;
+                }
+            }
+            return npos;
+        }
+
+        size_type find_last_not_of(basic_string_view chars, size_type pos = npos) const {
+            for (size_type i = pos < len ? pos + 1 : len; i > 0; --i) {
+                if (!chars.contains(start[i - 1])) {
+                    return i - 1;
+                }
+            }
+            return npos;
+        }
+    };
+
+    using string_view = basic_string_view<char>;
+    using wstring_view = basic_string_view<wchar_t>;
+    using u16string_view = basic_string_view<char16_t>;
+    using u32string_view = basic_string_view<char32_t>;
+
+    /**
+     * 推导时忽略该参数，使得视图可以和 const CharT *、basic_string 等可以隐式转换的类型直接比较
+     */
+    template<typename T>
+    struct _string_view_identity {
+        using type = T;
+    };
+
+    template<typename CharT>
+    using _string_view_t = typename _string_view_identity<basic_string_view<CharT>>::type;
+
+    template<typename CharT>
+    inline bool operator==(basic_string_view<CharT> a, _string_view_t<CharT> b) {
+        return a.size() == b.size() && _string_compare(a.data(), b.data(), a.size()) == 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(basic_string_view<CharT> a, _string_view_t<CharT> b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(_string_view_t<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<(basic_string_view<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) < 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(basic_string_view<CharT> a, _string_view_t<CharT> b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(_string_view_t<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>(basic_string_view<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) > 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(basic_string_view<CharT> a, _string_view_t<CharT> b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(_string_view_t<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator<=(basic_string_view<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) <= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(basic_string_view<CharT> a, _string_view_t<CharT> b) {
+        return a.compare(b) >= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(_string_view_t<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) >= 0;
+    }
+
+    template<typename CharT>
+    inline bool operator>=(basic_string_view<CharT> a, basic_string_view<CharT> b) {
+        return a.compare(b) >= 0;
+    }
+
+    /**
+     * 按内容哈希，与同样内容的 basic_string 哈希值相同
+     */
+    template<typename CharT>
+    struct hash<basic_string_view<CharT>> {
+        using is_transparent = void;
+
+        size_t operator()(basic_string_view<CharT> value) const {
+            return _hash_bytes(value.data(), value.size() * sizeof(CharT));
+        }
+    };
+}
+
+#endif //MICROSTL_STRING_VIEW_H
@@ -0,0 +1,241 @@
+#ifndef MICROSTL_UNORDERED_MAP_H
+#define MICROSTL_UNORDERED_MAP_H
+
+#include <stdexcept>
+#include <utility>
+#include "hashtable.h"
+
+/**
+ * 基于开放寻址哈希表的 unordered_map，元素为 pair<const Key, T>，直接存放在槽位中：
+ *
+ * - 扩容会移动元素，插入后之前的迭代器、指针、引用都可能失效；删除不会移动其他元素
+ * - Hash 与 KeyEqual 都定义了 is_transparent 时，find / count / contains / erase 接受任意可比较的 key 类型
+ */
+
+namespace MicroSTL {
+
+    template<typename Key, typename T, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+    class unordered_map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = pair<const Key, T>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using table_type = hashtable<value_type, Key, select1st<value_type>, Hash, KeyEqual>;
+        table_type table;
+
+    public:
+        using iterator = typename table_type::iterator;
+        using const_iterator = typename table_type::const_iterator;
+
+        unordered_map() : table() {}
+
+        explicit unordered_map(size_type count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+                : table(count, hash, equal) {}
+
+        template<typename InputIterator>
+        unordered_map(InputIterator first, InputIterator last) : table() {
+            insert(first, last);
+        }
+
+        iterator begin() {
+            return table.begin();
+        }
+
+        const_iterator begin() const {
+            return table.begin();
+        }
+
+        iterator end() {
+            return table.end();
+        }
+
+        const_iterator end() const {
+            return table.end();
+        }
+
+        bool empty() const {
+            return table.empty();
+        }
+
+        size_type size() const {
+            return table.size();
+        }
+
+        size_type bucket_count() const {
+            return table.bucket_count();
+        }
+
+        float load_factor() const {
+            return table.load_factor();
+        }
+
+        float max_load_factor() const {
+            return table.max_load_factor();
+        }
+
+        hasher hash_function() const {
+            return table.hash_function();
+        }
+
+        key_equal key_eq() const {
+            return table.key_eq();
+        }
+
+        void reserve(size_type count) {
+            table.reserve(count);
+        }
+
+        void rehash(size_type count) {
+            table.rehash(count);
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            return table.insert_unique(value);
+        }
+
+        pair<iterator, bool> insert(value_type &&value) {
+            return table.insert_unique(std::move(value));
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                table.insert_unique(*first);
+            }
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            return table.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        /**
+         * key 已存在时不会构造 T
+         */
+        template<typename... Args>
+        pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+            return table.insert_with(key, [&](value_type *slot) {
+                new(slot) value_type(key, T(std::forward<Args>(args)...));
+            });
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> try_emplace(key_type &&key, Args &&... args) {
+            return table.insert_with(key, [&](value_type *slot) {
+                new(slot) value_type(std::move(key), T(std::forward<Args>(args)...));
+            });
+        }
+
+        template<typename M>
+        pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+            pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+            if (!result.second) {
+                result.first->second = std::forward<M>(obj);
+            }
+            return result;
+        }
+
+        T &operator[](const key_type &key) {
+            return try_emplace(key).first->second;
+        }
+
+        T &operator[](key_type &&key) {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        T &at(const key_type &key) {
+            iterator iter = find(key);
+            if (iter == end()) {
+                throw std::out_of_range("unordered_map::at");
+            }
+            return iter->second;
+        }
+
+        const T &at(const key_type &key) const {
+            const_iterator iter = find(key);
+            if (iter == end()) {
+                throw std::out_of_range("unordered_map::at");
+            }
+            return iter->second;
+        }
+
+        iterator find(const key_type &key) {
+            return table.find(key);
+        }
+
+        const_iterator find(const key_type &key) const {
+            return table.find(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        iterator find(const K &key) {
+            return table.find(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        const_iterator find(const K &key) const {
+            return table.find(key);
+        }
+
+        size_type count(const key_type &key) const {
+            return table.count(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        size_type count(const K &key) const {
+            return table.count(key);
+        }
+
+        bool contains(const key_type &key) const {
+            return table.count(key) != 0;
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        bool contains(const K &key) const {
+            return table.count(key) != 0;
+        }
+
+        /**
+         * 返回下一个元素的迭代器
+         */
+        iterator erase(const_iterator position) {
+            return table.erase(position);
+        }
+
+        iterator erase(iterator position) {
+            return table.erase(position);
+        }
+
+        size_type erase(const key_type &key) {
+            return table.erase_key(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        size_type erase(const K &key) {
+            return table.erase_key(key);
+        }
+
+        void clear() {
+            table.clear();
+        }
+
+        void swap(unordered_map &obj) {
+            table.swap(obj.table);
+        }
+    };
+}
+
+#endif //MICROSTL_UNORDERED_MAP_H
@@ -0,0 +1,167 @@
+#ifndef MICROSTL_UNORDERED_SET_H
+#define MICROSTL_UNORDERED_SET_H
+
+#include <utility>
+#include "hashtable.h"
+
+/**
+ * 基于开放寻址哈希表的 unordered_set，元素不可修改，iterator 与 const_iterator 相同
+ *
+ * - 扩容会移动元素，插入后之前的迭代器、指针、引用都可能失效；删除不会移动其他元素
+ * - Hash 与 KeyEqual 都定义了 is_transparent 时，find / count / contains / erase 接受任意可比较的 key 类型
+ */
+
+namespace MicroSTL {
+
+    template<typename Key, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>>
+    class unordered_set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = const value_type &;
+        using const_reference = const value_type &;
+
+    protected:
+        using table_type = hashtable<Key, Key, identity<Key>, Hash, KeyEqual>;
+        table_type table;
+
+    public:
+        using iterator = typename table_type::const_iterator;
+        using const_iterator = typename table_type::const_iterator;
+
+        unordered_set() : table() {}
+
+        explicit unordered_set(size_type count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+                : table(count, hash, equal) {}
+
+        template<typename InputIterator>
+        unordered_set(InputIterator first, InputIterator last) : table() {
+            insert(first, last);
+        }
+
+        iterator begin() const {
+            return table.begin();
+        }
+
+        iterator end() const {
+            return table.end();
+        }
+
+        bool empty() const {
+            return table.empty();
+        }
+
+        size_type size() const {
+            return table.size();
+        }
+
+        size_type bucket_count() const {
+            return table.bucket_count();
+        }
+
+        float load_factor() const {
+            return table.load_factor();
+        }
+
+        float max_load_factor() const {
+            return table.max_load_factor();
+        }
+
+        hasher hash_function() const {
+            return table.hash_function();
+        }
+
+        key_equal key_eq() const {
+            return table.key_eq();
+        }
+
+        void reserve(size_type count) {
+            table.reserve(count);
+        }
+
+        void rehash(size_type count) {
+            table.rehash(count);
+        }
+
+        pair<iterator, bool> insert(const value_type &value) {
+            pair<typename table_type::iterator, bool> result = table.insert_unique(value);
+            return pair<iterator, bool>(result.first, result.second);
+        }
+
+        pair<iterator, bool> insert(value_type &&value) {
+            pair<typename table_type::iterator, bool> result = table.insert_unique(std::move(value));
+            return pair<iterator, bool>(result.first, result.second);
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                table.insert_unique(*first);
+            }
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> emplace(Args &&... args) {
+            pair<typename table_type::iterator, bool> result = table.emplace_unique(std::forward<Args>(args)...);
+            return pair<iterator, bool>(result.first, result.second);
+        }
+
+        iterator find(const key_type &key) const {
+            return table.find(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        iterator find(const K &key) const {
+            return table.find(key);
+        }
+
+        size_type count(const key_type &key) const {
+            return table.count(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        size_type count(const K &key) const {
+            return table.count(key);
+        }
+
+        bool contains(const key_type &key) const {
+            return table.count(key) != 0;
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        bool contains(const K &key) const {
+            return table.count(key) != 0;
+        }
+
+        iterator erase(const_iterator position) {
+            return table.erase(position);
+        }
+
+        size_type erase(const key_type &key) {
+            return table.erase_key(key);
+        }
+
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                typename = typename H::is_transparent, typename = typename E::is_transparent>
+        size_type erase(const K &key) {
+            return table.erase_key(key);
+        }
+
+        void clear() {
+            table.clear();
+        }
+
+        void swap(unordered_set &obj) {
+            table.swap(obj.table);
+        }
+    };
+}
+
+#endif //MICROSTL_UNORDERED_SET_H
@@ -5,6 +5,13 @@
 #include "../memory/construct.h"
 #include "../algorithm/algobase.h"
 #include "../memory/uninitialized.h"
+#include "../utility/hardening.h"
+#include "../utility/trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace MicroSTL {
     template<typename T>
@@ -12,19 +19,76 @@ namespace MicroSTL {
     public:
         using value_type = T;
         using pointer = value_type *;
+        using const_pointer = const value_type *;
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+        // 记录所属容器与版本号，用于检查迭代器失效
+        using iterator = _debug_iterator<vector, T, T &, T *>;
+        using const_iterator = _debug_iterator<vector, T, const T &, const T *>;
+#else
         // 迭代器为原生指针
         using iterator = value_type *;
+        using const_iterator = const value_type *;
+#endif
         using reference = value_type &;
+        using const_reference = const value_type &;
         using size_type = size_t;
         using difference_type = ptrdiff_t;
     protected:
         using allocator = Alloc<value_type>;
         // 使用空间的起点
-        iterator start;
+        pointer start;
         // 使用空间的终点
-        iterator finish;
+        pointer finish;
         // 可用空间的终点
-        iterator end_of_storage;
+        pointer end_of_storage;
+        // 定义 MICROSTL_TRACE 时记录扩容与复制，否则为空
+        [[no_unique_address]] _trace_handle trace;
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+        _debug_invalidation debug_state;
+#endif
+
+        iterator make_iterator(pointer ptr) {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            return iterator(ptr, this);
+#else
+            return ptr;
+#endif
+        }
+
+        const_iterator make_iterator(const_pointer ptr) const {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            return const_iterator(ptr, this);
+#else
+            return ptr;
+#endif
+        }
+
+        /**
+         * 把传入的迭代器还原为指针，并检查它属于本容器；dereference 为 true 时不能是 end()
+         */
+        pointer unwrap(const_iterator iter, bool dereference) const {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            MICROSTL_CHECK(iter.owner == this, "iterator does not belong to this vector");
+            _debug_verify(iter.ptr, iter.generation, dereference);
+            return const_cast<pointer>(iter.ptr);
+#else
+            MICROSTL_CHECK(start <= iter && (dereference ? iter < finish : iter <= finish),
+                           "iterator does not belong to this vector");
+            (void) dereference;
+            return const_cast<pointer>(iter);
+#endif
+        }
+
+        /**
+         * 下标 offset 及之后的迭代器失效，扩容时 offset 为 0
+         */
+        void invalidate_from(size_type offset) {
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+            debug_state.invalidate_from(offset);
+#else
+            (void) offset;
+#endif
+        }
 
         void deallocate() {
             if (start) {
@@ -38,98 +102,263 @@ namespace MicroSTL {
             end_of_storage = finish;
         }
 
-        void insert_aux(iterator position, const T &obj);
+        void insert_aux(pointer position, const T &obj);
+
+        /**
+         * 扩容并在尾部原地构造新元素；旧元素在移动构造不抛异常时移动过去，否则复制，保证强异常安全
+         */
+        template<typename... Args>
+        void realloc_insert(Args &&... args);
 
-        iterator allocate_and_fill(size_type size, const T &value) {
-            iterator result = allocator::allocate(size);
-            uninitialized_fill_n(result, size, value);
+        pointer allocate_and_fill(size_type size, const T &value) {
+            pointer result = allocator::allocate(size);
+            MicroSTL::uninitialized_fill_n(result, size, value);
             return result;
         }
 
     public:
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+
+        size_type _debug_generation() const {
+            return debug_state.current();
+        }
+
+        void _debug_verify(const_pointer ptr, size_type generation, bool dereference) const {
+            // 扩容后 ptr 与 start 不在同一块内存中，按整数计算避免未定义的指针运算
+            size_type offset = (reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(start)) / sizeof(T);
+            MICROSTL_CHECK(debug_state.valid(generation, offset),
+                           "vector iterator invalidated by reallocation, insert or erase");
+            MICROSTL_CHECK(dereference ? offset < size() : offset <= size(), "vector iterator out of range");
+        }
+
+#endif
+
         iterator begin() {
-            return start;
+            return make_iterator(start);
+        };
+
+        const_iterator begin() const {
+            return make_iterator(start);
         };
 
         iterator end() {
-            return finish;
+            return make_iterator(finish);
         };
 
-        size_type size() {
-            return size_type(end() - begin());
+        const_iterator end() const {
+            return make_iterator(finish);
+        };
+
+        pointer data() {
+            return start;
+        }
+
+        const_pointer data() const {
+            return start;
+        }
+
+        size_type size() const {
+            return size_type(finish - start);
         }
 
-        size_type capacity() {
-            return size_type(end_of_storage - begin());
+        size_type capacity() const {
+            return size_type(end_of_storage - start);
         }
 
-        bool empty() {
-            return begin() == end();
+        bool empty() const {
+            return start == finish;
         }
 
         reference operator[](size_type n) {
-            return *(begin() + n);
+            MICROSTL_CHECK(n < size(), "vector::operator[] index out of range");
+            return start[n];
         }
 
-        vector() : start(0), finish(0), end_of_storage(0) {}
+        const_reference operator[](size_type n) const {
+            MICROSTL_CHECK(n < size(), "vector::operator[] index out of range");
+            return start[n];
+        }
+
+        // 构造函数最后的 location 参数由调用处的默认值填充，只在定义 MICROSTL_TRACE 时使用
+        vector(_trace_location location = _trace_location::current())
+                : start(0), finish(0), end_of_storage(0), trace("vector", location) {}
 
-        vector(size_type size, const T &value) {
+        vector(size_type size, const T &value, _trace_location location = _trace_location::current())
+                : trace("vector", location) {
             fill_initialize(size, value);
         }
 
-        vector(long size, const T &value) {
+        vector(long size, const T &value, _trace_location location = _trace_location::current())
+                : trace("vector", location) {
             fill_initialize(size, value);
         }
 
-        vector(int size, const T &value) {
+        vector(int size, const T &value, _trace_location location = _trace_location::current())
+                : trace("vector", location) {
             fill_initialize(size, value);
         }
 
-        explicit vector(size_type size) {
+        explicit vector(size_type size, _trace_location location = _trace_location::current())
+                : trace("vector", location) {
             fill_initialize(size, T());
         }
 
+        vector(const vector &obj, _trace_location location = _trace_location::current())
+                : trace("vector", location) {
+            start = allocator::allocate(obj.size());
+            finish = MicroSTL::uninitialized_copy(obj.start, obj.finish, start);
+            end_of_storage = finish;
+        }
+
+        vector(vector &&obj, _trace_location location = _trace_location::current()) noexcept
+                : start(obj.start), finish(obj.finish), end_of_storage(obj.end_of_storage), trace("vector", location) {
+            obj.start = obj.finish = obj.end_of_storage = nullptr;
+            obj.invalidate_from(0);
+        }
+
         ~vector() {
-            destroy(start, finish);
+            trace.observe(size(), capacity());
+            MicroSTL::destroy(start, finish);
             deallocate();
         }
 
+        vector &operator=(const vector &obj) {
+            if (this != &obj) {
+                vector temp(obj);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        vector &operator=(vector &&obj) noexcept {
+            if (this != &obj) {
+                trace.observe(size(), capacity());
+                MicroSTL::destroy(start, finish);
+                deallocate();
+                start = obj.start;
+                finish = obj.finish;
+                end_of_storage = obj.end_of_storage;
+                obj.start = obj.finish = obj.end_of_storage = nullptr;
+                invalidate_from(0);
+                obj.invalidate_from(0);
+            }
+            return *this;
+        }
+
+        // 只交换存储，trace 仍然属于各自的构造位置；完全加固时双方原有的迭代器都视为失效
+        void swap(vector &obj) {
+            trace.observe(size(), capacity());
+            obj.trace.observe(obj.size(), obj.capacity());
+            invalidate_from(0);
+            obj.invalidate_from(0);
+            MicroSTL::swap(start, obj.start);
+            MicroSTL::swap(finish, obj.finish);
+            MicroSTL::swap(end_of_storage, obj.end_of_storage);
+        }
+
         reference front() {
-            return *begin();
+            MICROSTL_CHECK(!empty(), "vector::front on empty vector");
+            return *start;
+        }
+
+        const_reference front() const {
+            MICROSTL_CHECK(!empty(), "vector::front on empty vector");
+            return *start;
         }
 
         reference back() {
-            return *(end() - 1);
+            MICROSTL_CHECK(!empty(), "vector::back on empty vector");
+            return *(finish - 1);
+        }
+
+        const_reference back() const {
+            MICROSTL_CHECK(!empty(), "vector::back on empty vector");
+            return *(finish - 1);
+        }
+
+        /**
+         * 预留至少 new_capacity 个元素的空间，避免 push_back 过程中反复扩容
+         */
+        void reserve(size_type new_capacity) {
+            if (new_capacity <= capacity()) {
+                return;
+            }
+            trace.reallocate(size() * sizeof(T), new_capacity);
+            invalidate_from(0);
+            pointer new_start = allocator::allocate(new_capacity);
+            pointer new_finish = new_start;
+            try {
+                new_finish = MicroSTL::uninitialized_copy(start, finish, new_start);
+            } catch (...) {
+                MicroSTL::destroy(new_start, new_finish);
+                allocator::deallocate(new_start, new_capacity);
+                throw;
+            }
+            MicroSTL::destroy(start, finish);
+            deallocate();
+            start = new_start;
+            finish = new_finish;
+            end_of_storage = new_start + new_capacity;
         }
 
         void push_back(const T &obj) {
             if (finish != end_of_storage) {
-                construct(finish, obj);
+                MicroSTL::construct(finish, obj);
+                finish++;
+            } else {
+                insert_aux(finish, obj);
+            }
+        }
+
+        /**
+         * 在尾部原地构造元素
+         */
+        template<typename... Args>
+        void emplace_back(Args &&... args) {
+            if (finish != end_of_storage) {
+                new(finish) T(std::forward<Args>(args)...);
                 finish++;
             } else {
-                insert_aux(end(), obj);
+                realloc_insert(std::forward<Args>(args)...);
             }
         }
 
         void pop_back() {
+            MICROSTL_CHECK(!empty(), "vector::pop_back on empty vector");
+            trace.observe(size(), capacity());
+            invalidate_from(size() - 1);
             finish--;
-            destroy(finish);
+            MicroSTL::destroy(finish);
         }
 
-        iterator erase(iterator position) {
-            if (position + 1 != end()) {
-                copy(position + 1, finish, position);
+        iterator erase(const_iterator iter) {
+            pointer position = unwrap(iter, true);
+            trace.observe(size(), capacity());
+            invalidate_from(position - start);
+            if (position + 1 != finish) {
+                trace.linear();
+                trace.copy((finish - position - 1) * sizeof(T));
+                MicroSTL::copy(position + 1, finish, position);
             }
             finish--;
-            destroy(finish);
-            return position;
+            MicroSTL::destroy(finish);
+            return make_iterator(position);
         }
 
-        iterator erase(iterator first, iterator last) {
-            iterator iter = copy(last, finish, first);
-            destroy(iter, finish);
+        iterator erase(const_iterator first_iter, const_iterator last_iter) {
+            pointer first = unwrap(first_iter, false);
+            pointer last = unwrap(last_iter, false);
+            MICROSTL_CHECK(first <= last, "vector::erase with an invalid range");
+            trace.observe(size(), capacity());
+            invalidate_from(first - start);
+            if (last != finish) {
+                trace.linear();
+                trace.copy((finish - last) * sizeof(T));
+            }
+            pointer iter = MicroSTL::copy(last, finish, first);
+            MicroSTL::destroy(iter, finish);
             finish = finish - (last - first);
-            return first;
+            return make_iterator(first);
         }
 
         void clear() {
@@ -148,47 +377,82 @@ namespace MicroSTL {
             return (resize(size, T()));
         }
 
-        void insert(iterator position, size_type size, const T &obj) {
+        /**
+         * 调整长度，新增的元素不做初始化，由调用者随后写入（例如直接 read 进 data()），省去一遍清零
+         */
+        void resize_for_overwrite(size_type new_size) {
+            static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value,
+                          "resize_for_overwrite 只适用于可平凡复制、可平凡默认构造的类型");
+            if (new_size <= size()) {
+                erase(begin() + new_size, end());
+                return;
+            }
+            reserve(new_size);
+            invalidate_from(size());
+            finish = start + new_size;
+        }
+
+        iterator insert(const_iterator iter, const T &obj) {
+            pointer position = unwrap(iter, false);
+            size_type n = position - start;
+            if (finish != end_of_storage && position == finish) {
+                MicroSTL::construct(finish, obj);
+                ++finish;
+            } else {
+                insert_aux(position, obj);
+            }
+            return make_iterator(start + n);
+        }
+
+        void insert(const_iterator iter, size_type size, const T &obj) {
+            pointer position = unwrap(iter, false);
             if (size != 0) {
                 if (size_type(end_of_storage - finish) >= size) {
                     // 空间够用
                     T obj_copy = obj;
                     const size_type elements_after = finish - position;
-                    iterator old_finish = finish;
+                    pointer old_finish = finish;
+                    invalidate_from(position - start);
+                    if (elements_after != 0) {
+                        trace.linear();
+                        trace.copy(elements_after * sizeof(T));
+                    }
 
                     if (elements_after > size) {
-                        uninitialized_copy(finish - size, finish, finish);
+                        MicroSTL::uninitialized_copy(finish - size, finish, finish);
                         finish += size;
-                        copy_backward(position, old_finish - size, old_finish);
-                        fill(position, position + size, obj_copy);
+                        MicroSTL::copy_backward(position, old_finish - size, old_finish);
+                        MicroSTL::fill(position, position + size, obj_copy);
                     } else {
-                        uninitialized_fill_n(finish, size - elements_after, obj_copy);
+                        MicroSTL::uninitialized_fill_n(finish, size - elements_after, obj_copy);
                         finish += size - elements_after;
-                        uninitialized_copy(position, old_finish, finish);
+                        MicroSTL::uninitialized_copy(position, old_finish, finish);
                         finish += elements_after;
-                        fill(position, old_finish, obj_copy);
+                        MicroSTL::fill(position, old_finish, obj_copy);
                     }
                 } else {
                     // 空间不足
                     const size_type old_size = this->size();
                     const size_type len = old_size + std::max(old_size, size);
-                    iterator new_start = allocator::allocate(len);
-                    iterator new_finish = new_start;
+                    trace.reallocate(old_size * sizeof(T), len);
+                    invalidate_from(0);
+                    pointer new_start = allocator::allocate(len);
+                    pointer new_finish = new_start;
 
                     try {
                         // 先拷贝一部分
-                        new_finish = uninitialized_copy(start, position, new_start);
+                        new_finish = MicroSTL::uninitialized_copy(start, position, new_start);
                         // 再插入
-                        new_finish = uninitialized_fill_n(new_finish, size, obj);
+                        new_finish = MicroSTL::uninitialized_fill_n(new_finish, size, obj);
                         // 拷贝剩下的
-                        new_finish = uninitialized_copy(position, finish, new_finish);
+                        new_finish = MicroSTL::uninitialized_copy(position, finish, new_finish);
                     } catch (...) {
-                        destroy(new_start, new_finish);
+                        MicroSTL::destroy(new_start, new_finish);
                         allocator::deallocate(new_start, len);
                         throw;
                     }
 
-                    destroy(start, finish);
+                    MicroSTL::destroy(start, finish);
                     deallocate();
                     start = new_start;
                     finish = new_finish;
@@ -199,33 +463,38 @@ namespace MicroSTL {
     };
 
     template<typename T>
-    void vector<T>::insert_aux(vector::iterator position, const T &obj) {
+    void vector<T>::insert_aux(vector::pointer position, const T &obj) {
         if (finish != end_of_storage) {
-            construct(finish, *(finish - 1));
+            invalidate_from(position - start);
+            MicroSTL::construct(finish, *(finish - 1));
             ++finish;
+            trace.linear();
+            trace.copy((finish - 1 - position) * sizeof(T));
             T obj_copy = obj;
-            copy_backward(position, finish - 2, finish - 1);
+            MicroSTL::copy_backward(position, finish - 2, finish - 1);
             *position = obj_copy;
         } else {
             const size_type old_size = size();
             // 扩展为原先空间的2倍
             const size_type len = old_size != 0 ? 2 * old_size : 1;
-            iterator new_start = allocator::allocate(len);
-            iterator new_finish = new_start;
+            trace.reallocate(old_size * sizeof(T), len);
+            invalidate_from(0);
+            pointer new_start = allocator::allocate(len);
+            pointer new_finish = new_start;
 
             // commit or rollback
             try {
-                new_finish = uninitialized_copy(start, position, new_start);
-                construct(new_finish, obj);
+                new_finish = MicroSTL::uninitialized_copy(start, position, new_start);
+                MicroSTL::construct(new_finish, obj);
                 ++new_finish;
-                new_finish = uninitialized_copy(position, finish, new_finish);
+                new_finish = MicroSTL::uninitialized_copy(position, finish, new_finish);
             } catch (...) {
-                destroy(new_start, new_finish);
+                MicroSTL::destroy(new_start, new_finish);
                 allocator::deallocate(new_start, len);
                 throw;
             }
 
-            destroy(begin(), end());
+            MicroSTL::destroy(start, finish);
             deallocate();
             start = new_start;
             finish = new_finish;
@@ -233,8 +502,47 @@ namespace MicroSTL {
         }
     }
 
+
+    template<typename T>
+    template<typename... Args>
+    void vector<T>::realloc_insert(Args &&... args) {
+        const size_type old_size = size();
+        const size_type len = old_size != 0 ? 2 * old_size : 1;
+        trace.reallocate(old_size * sizeof(T), len);
+        invalidate_from(0);
+        pointer new_start = allocator::allocate(len);
+        pointer new_finish = new_start;
+        // 先构造新元素：args 可能引用旧存储中的元素，旧元素移走之后就不能再用
+        try {
+            new(new_start + old_size) T(std::forward<Args>(args)...);
+        } catch (...) {
+            allocator::deallocate(new_start, len);
+            throw;
+        }
+        try {
+            if constexpr (std::is_trivially_copyable<T>::value) {
+                new_finish = MicroSTL::uninitialized_copy(start, finish, new_start);
+            } else {
+                for (pointer current = start; current != finish; ++current, ++new_finish) {
+                    new(new_finish) T(std::move_if_noexcept(*current));
+                }
+            }
+        } catch (...) {
+            MicroSTL::destroy(new_start, new_finish);
+            MicroSTL::destroy(new_start + old_size);
+            allocator::deallocate(new_start, len);
+            throw;
+        }
+        MicroSTL::destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_start + old_size + 1;
+        end_of_storage = new_start + len;
+    }
 }
 
+#include "vector_bool.h"
+
 #endif //MICROSTL_VECTOR_H
 
 
@@ -0,0 +1,84 @@
+#ifndef MICROSTL_VECTOR_BOOL_H
+#define MICROSTL_VECTOR_BOOL_H
+
+#include "vector.h"
+#include "dynamic_bitset.h"
+
+/**
+ * vector<bool> 的特化：基于 dynamic_bitset，每个元素只占 1 位
+ *
+ * - 与 SGI STL 的 bit_vector 一样，operator[] 与迭代器解引用返回代理对象 _bit_reference，不能取得 bool &
+ * - 在 dynamic_bitset 的基础上补充 vector 风格的接口：front、back、at、insert、erase
+ * - 中间位置的 insert / erase 需要逐位移动其后的所有元素，O(n)
+ */
+
+namespace MicroSTL {
+
+    template<>
+    class vector<bool> : public dynamic_bitset {
+    public:
+        using value_type = bool;
+
+        vector() : dynamic_bitset() {}
+
+        explicit vector(size_type size, bool value = false) : dynamic_bitset(size, value) {}
+
+        reference front() {
+            return (*this)[0];
+        }
+
+        const_reference front() const {
+            return (*this)[0];
+        }
+
+        reference back() {
+            return (*this)[size() - 1];
+        }
+
+        const_reference back() const {
+            return (*this)[size() - 1];
+        }
+
+        reference at(size_type pos) {
+            if (pos >= size()) {
+                throw std::out_of_range("vector<bool>::at");
+            }
+            return (*this)[pos];
+        }
+
+        const_reference at(size_type pos) const {
+            if (pos >= size()) {
+                throw std::out_of_range("vector<bool>::at");
+            }
+            return (*this)[pos];
+        }
+
+        void insert(iterator position, size_type n, bool value) {
+            size_type index = position - begin();
+            size_type old_size = size();
+            resize(old_size + n);
+            MicroSTL::copy_backward(begin() + index, begin() + old_size, end());
+            set(index, n, value);
+        }
+
+        iterator insert(iterator position, bool value) {
+            size_type index = position - begin();
+            insert(position, 1, value);
+            return begin() + index;
+        }
+
+        iterator erase(iterator first, iterator last) {
+            size_type index = first - begin();
+            size_type n = last - first;
+            MicroSTL::copy(last, end(), first);
+            resize(size() - n);
+            return begin() + index;
+        }
+
+        iterator erase(iterator position) {
+            return erase(position, position + 1);
+        }
+    };
+}
+
+#endif //MICROSTL_VECTOR_BOOL_H
@@ -0,0 +1,106 @@
+#ifndef MICROSTL_FUNCTIONAL_H
+#define MICROSTL_FUNCTIONAL_H
+
+namespace MicroSTL {
+
+    // --------------------- 算术运算仿函数 --------------------------
+
+    /**
+     * 加法，数值算法默认的归约方式
+     */
+    template<typename T>
+    struct plus {
+        T operator()(const T &a, const T &b) const {
+            return a + b;
+        }
+    };
+
+    /**
+     * 减法
+     */
+    template<typename T>
+    struct minus {
+        T operator()(const T &a, const T &b) const {
+            return a - b;
+        }
+    };
+
+    /**
+     * 乘法
+     */
+    template<typename T>
+    struct multiplies {
+        T operator()(const T &a, const T &b) const {
+            return a * b;
+        }
+    };
+
+    // --------------------- 关系运算仿函数 --------------------------
+
+    /**
+     * 小于，算法与容器默认的比较方式
+     */
+    template<typename T>
+    struct less {
+        bool operator()(const T &a, const T &b) const {
+            return a < b;
+        }
+    };
+
+    /**
+     * 大于
+     */
+    template<typename T>
+    struct greater {
+        bool operator()(const T &a, const T &b) const {
+            return a > b;
+        }
+    };
+
+    /**
+     * 等于
+     */
+    template<typename T>
+    struct equal_to {
+        bool operator()(const T &a, const T &b) const {
+            return a == b;
+        }
+    };
+
+    /**
+     * 透明的等于，两侧可以是不同的类型，用于哈希表的异构查找
+     */
+    template<>
+    struct equal_to<void> {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        bool operator()(const T &a, const U &b) const {
+            return a == b;
+        }
+    };
+
+    // --------------------- 取值仿函数 --------------------------
+
+    /**
+     * 返回元素本身，set 类容器从元素中取 key
+     */
+    template<typename T>
+    struct identity {
+        const T &operator()(const T &value) const {
+            return value;
+        }
+    };
+
+    /**
+     * 返回 pair 的 first，map 类容器从元素中取 key
+     */
+    template<typename Pair>
+    struct select1st {
+        const typename Pair::first_type &operator()(const Pair &value) const {
+            return value.first;
+        }
+    };
+}
+
+#endif //MICROSTL_FUNCTIONAL_H
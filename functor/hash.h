@@ -0,0 +1,127 @@
+#ifndef MICROSTL_HASH_H
+#define MICROSTL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * 哈希仿函数：
+ *
+ * - 整数、字符、指针直接返回数值本身，由哈希表在使用前统一做一次乘法混合（_hash_mix），
+ *   因此这里不必保证低位分布均匀
+ * - 浮点数按位模式哈希，+0.0 与 -0.0 相等，哈希值也相同
+ * - 字符串按内容哈希，每次读取 8 字节；std::string 的哈希是透明的，可以直接用 std::string_view
+ *   或 const char * 在以 std::string 为 key 的哈希表中查找，不会构造临时字符串
+ */
+
+namespace MicroSTL {
+
+    /**
+     * 64 位乘法取高低两半异或，任意输入位都会影响输出的所有位
+     */
+    inline size_t _hash_mix(size_t value) {
+        const uint64_t k = 0x9E3779B97F4A7C15ull;
+        __uint128_t product = static_cast<__uint128_t>(value) * k;
+        return static_cast<size_t>(static_cast<uint64_t>(product >> 64) ^ static_cast<uint64_t>(product));
+    }
+
+    inline size_t _hash_bytes(const void *data, size_t size) {
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        uint64_t result = 0xC6A4A7935BD1E995ull ^ size;
+        for (; size >= 8; size -= 8, p += 8) {
+            uint64_t word;
+            memcpy(&word, p, 8);
+            result = _hash_mix(result ^ word);
+        }
+        if (size > 0) {
+            uint64_t word = 0;
+            memcpy(&word, p, size);
+            result = _hash_mix(result ^ word);
+        }
+        return static_cast<size_t>(result);
+    }
+
+    template<typename Key>
+    struct hash {
+    };
+
+    template<typename T>
+    struct hash<T *> {
+        size_t operator()(T *p) const {
+            return reinterpret_cast<size_t>(p);
+        }
+    };
+
+#define MICROSTL_INTEGRAL_HASH(type)                    \
+    template<>                                          \
+    struct hash<type> {                                 \
+        size_t operator()(type value) const {           \
+            return static_cast<size_t>(value);          \
+        }                                               \
+    };
+
+    MICROSTL_INTEGRAL_HASH(bool)
+    MICROSTL_INTEGRAL_HASH(char)
+    MICROSTL_INTEGRAL_HASH(signed char)
+    MICROSTL_INTEGRAL_HASH(unsigned char)
+    MICROSTL_INTEGRAL_HASH(wchar_t)
+    MICROSTL_INTEGRAL_HASH(char16_t)
+    MICROSTL_INTEGRAL_HASH(char32_t)
+    MICROSTL_INTEGRAL_HASH(short)
+    MICROSTL_INTEGRAL_HASH(unsigned short)
+    MICROSTL_INTEGRAL_HASH(int)
+    MICROSTL_INTEGRAL_HASH(unsigned int)
+    MICROSTL_INTEGRAL_HASH(long)
+    MICROSTL_INTEGRAL_HASH(unsigned long)
+    MICROSTL_INTEGRAL_HASH(long long)
+    MICROSTL_INTEGRAL_HASH(unsigned long long)
+
+#undef MICROSTL_INTEGRAL_HASH
+
+    template<>
+    struct hash<float> {
+        size_t operator()(float value) const {
+            if (value == 0.0f) {
+                return 0;
+            }
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    };
+
+    template<>
+    struct hash<double> {
+        size_t operator()(double value) const {
+            if (value == 0.0) {
+                return 0;
+            }
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return static_cast<size_t>(bits);
+        }
+    };
+
+    template<>
+    struct hash<std::string_view> {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const {
+            return _hash_bytes(value.data(), value.size());
+        }
+    };
+
+    template<>
+    struct hash<std::string> {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const {
+            return _hash_bytes(value.data(), value.size());
+        }
+    };
+}
+
+#endif //MICROSTL_HASH_H
@@ -262,6 +262,124 @@ namespace MicroSTL {
         using has_trivial_destructor = true_type;
         using is_POD_type = true_type;
     };
+
+    // --------------- 算术类型萃取 --------------
+
+    /**
+     * 对于算术类型（整数、浮点数），一些算法可以采取更激进的策略：
+     * - 排序时可以使用无分支（branchless）的分区方式，比较结果直接参与下标计算
+     * - 基数排序可以把 key 映射为无符号整数，按字节进行分桶
+     *
+     * - is_arithmetic：是否为算术类型
+     * - is_integral：是否为整数类型
+     * - is_signed：是否为有符号类型
+     * - is_floating_point：是否为浮点类型
+     */
+    template<typename T>
+    struct arithmetic_traits {
+        using is_arithmetic = false_type;
+        using is_integral = false_type;
+        using is_signed = false_type;
+        using is_floating_point = false_type;
+    };
+
+    struct _unsigned_integral_traits {
+        using is_arithmetic = true_type;
+        using is_integral = true_type;
+        using is_signed = false_type;
+        using is_floating_point = false_type;
+    };
+
+    struct _signed_integral_traits {
+        using is_arithmetic = true_type;
+        using is_integral = true_type;
+        using is_signed = true_type;
+        using is_floating_point = false_type;
+    };
+
+    struct _floating_point_traits {
+        using is_arithmetic = true_type;
+        using is_integral = false_type;
+        using is_signed = true_type;
+        using is_floating_point = true_type;
+    };
+
+    template<>
+    struct arithmetic_traits<bool> : _unsigned_integral_traits {
+    };
+
+    // char 的符号性由平台决定
+#ifdef __CHAR_UNSIGNED__
+    template<>
+    struct arithmetic_traits<char> : _unsigned_integral_traits {
+    };
+#else
+    template<>
+    struct arithmetic_traits<char> : _signed_integral_traits {
+    };
+#endif
+
+    template<>
+    struct arithmetic_traits<unsigned char> : _unsigned_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<signed char> : _signed_integral_traits {
+    };
+
+#ifdef __WCHAR_UNSIGNED__
+    template<>
+    struct arithmetic_traits<wchar_t> : _unsigned_integral_traits {
+    };
+#else
+    template<>
+    struct arithmetic_traits<wchar_t> : _signed_integral_traits {
+    };
+#endif
+
+    template<>
+    struct arithmetic_traits<short> : _signed_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<unsigned short> : _unsigned_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<int> : _signed_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<unsigned int> : _unsigned_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<long> : _signed_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<unsigned long> : _unsigned_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<long long> : _signed_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<unsigned long long> : _unsigned_integral_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<float> : _floating_point_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<double> : _floating_point_traits {
+    };
+
+    template<>
+    struct arithmetic_traits<long double> : _floating_point_traits {
+    };
 }
 
 #endif //MICROSTL_TYPE_TRAITS_H
@@ -1,6 +1,29 @@
 #ifndef MICROSTL_ALLOC_H
 #define MICROSTL_ALLOC_H
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define MICROSTL_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MICROSTL_ASAN 1
+#endif
+#endif
+
+#ifdef MICROSTL_ASAN
+#include <sanitizer/asan_interface.h>
+#define MICROSTL_POISON(ptr, size) ASAN_POISON_MEMORY_REGION(ptr, size)
+#define MICROSTL_UNPOISON(ptr, size) ASAN_UNPOISON_MEMORY_REGION(ptr, size)
+#else
+#define MICROSTL_POISON(ptr, size) ((void) (ptr), (void) (size))
+#define MICROSTL_UNPOISON(ptr, size) ((void) (ptr), (void) (size))
+#endif
+
 /**
  * stl内存分配策略：
  *
@@ -18,8 +41,46 @@
  *              - 第一级allocator中有用户提供的oom handler
  *              - 如果oom handler失败，则抛出错误
  *      - 分配成功，则修改start_free end_free指针
+ *
+ * 对齐：
+ *
+ * - 内存池按 ALLOC_NATURAL_ALIGN（64 字节）对齐申请，切分时保证每个 block 按自身大小自然对齐，
+ *   即对齐到大小的最低位 1 与 ALLOC_NATURAL_ALIGN 中较小的一个（16 字节的 block 16 对齐，24 字节的 8 对齐，
+ *   64、128 字节的 64 对齐）；因对齐跳过的空隙与池中的零头切成自然对齐的小 block 放入 free list
+ * - 大小为 alignof(T) 整数倍的请求（sizeof(T) * n 总是满足）因此天然按 alignof(T) 对齐，最多 64 字节
+ * - aligned_allocate / aligned_deallocate 处理任意 2 的幂对齐：先把大小补齐到对齐的整数倍，
+ *   能落在 free list 中就使用 free list，否则超过 malloc 默认对齐时改用 aligned_alloc；
+ *   Alloc<T> 总是按 alignof(T) 申请，vector、list 等容器因此可以存放过对齐的类型
+ *
+ * 使用 AddressSanitizer 编译时，空闲 block 中除了 free list 指针之外的部分会被标记为不可访问，
+ * 释放后继续读写会被 ASan 直接报告
+ *
+ * 定义 MICROSTL_ALLOC_DEBUG 时 AllocByFreeList 切换为调试模式（多线程下同样不能使用）：
+ *
+ * - 每个 block 前有 64 字节的头部（所属的存活链表、申请的大小、状态、canary），后有 8 字节的 canary，
+ *   申请大小与 8 字节对齐之间的填充字节也写入固定值；释放时检查，发现越界写入即报告
+ * - 新分配的内存填充 0xCD，释放的内存填充 0xDD（poison），释放时状态置为已释放，再次释放即报告 double free
+ * - 释放的 block 先进入容量为 ALLOC_DEBUG_QUARANTINE 的隔离区，被挤出时检查填充值是否完好（释放后写入），
+ *   之后才回到 free list，延迟复用使得悬空指针更容易被发现
+ * - 释放时的大小必须和申请时一致；超过 MAX_BYTES 的大块同样带头尾检查，直接向 malloc 申请
+ * - 所有存活的 block 按大小分类挂在双向链表上，程序退出时输出尚未释放的内存（泄漏报告）
+ * - 发现错误时向 stderr 输出原因后 abort()
+ *
+ * 容器通过 Alloc<T> 申请内存，后端在编译时由 MICROSTL_ALLOC_BACKEND 选择：
+ *
+ * - 0（MICROSTL_ALLOC_BACKEND_FREELIST，默认）：AllocByFreeList，单个全局内存池，不能在多个线程中同时使用
+ * - 1（MICROSTL_ALLOC_BACKEND_NUMA）：memory/numa_pool.h 中的 AllocByNuma，每个 NUMA 节点一个 arena 加线程缓存，
+ *   容器的节点与小块存储来自当前线程所在节点，不同线程中的容器可以同时分配
+ * - 也可以显式指定后端，如 Alloc<T, AllocByNuma>
  */
 
+#define MICROSTL_ALLOC_BACKEND_FREELIST 0
+#define MICROSTL_ALLOC_BACKEND_NUMA 1
+
+#ifndef MICROSTL_ALLOC_BACKEND
+#define MICROSTL_ALLOC_BACKEND MICROSTL_ALLOC_BACKEND_FREELIST
+#endif
+
 namespace MicroSTL {
     /**
      * 定义函数指针
@@ -64,6 +125,23 @@ namespace MicroSTL {
             free(ptr);
         }
 
+        /**
+         * alignment 为 2 的幂，且不小于 sizeof(void *)
+         */
+        static void *aligned_allocate(size_t size, size_t alignment) {
+            // aligned_alloc 要求大小是对齐的整数倍
+            size = (size + alignment - 1) & ~(alignment - 1);
+            void *res = aligned_alloc(alignment, size);
+            if (res == nullptr) {
+                res = oom_aligned_malloc(size, alignment);
+            }
+            return res;
+        }
+
+        static void aligned_deallocate(void *ptr, size_t, size_t) {
+            free(ptr);
+        }
+
         /**
          * oom handler 接收一个用户自定义的 oom 处理函数指针，并返回原先的 oom 处理函数指针
          */
@@ -99,6 +177,20 @@ namespace MicroSTL {
             }
         }
 
+        static void *oom_aligned_malloc(size_t size, size_t alignment) {
+            void *res;
+            for (;;) {
+                if (oom_user_handler == nullptr) {
+                    throw_bad_alloc();
+                }
+                oom_user_handler();
+                res = aligned_alloc(alignment, size);
+                if (res) {
+                    return res;
+                }
+            }
+        }
+
         /**
          * realloc oom 处理函数
          * 如果用户未定义 oom 处理函数，则直接抛出错误
@@ -133,10 +225,32 @@ namespace MicroSTL {
      * free list个数
      */
     static const int LIST_NUMBER = MAX_BYTES / ALIGN;
+    /**
+     * cache line 大小，并发容器中被不同线程写入的字段按它对齐，避免伪共享
+     */
+    static const size_t CACHE_LINE_SIZE = 64;
+    /**
+     * free list 中的 block 能够保证的最大对齐，也是内存池的对齐
+     */
+    static const size_t ALLOC_NATURAL_ALIGN = 64;
+
+#ifdef MICROSTL_ALLOC_DEBUG
+    /**
+     * 隔离区容纳的 block 数
+     */
+    static const size_t ALLOC_DEBUG_QUARANTINE = 1024;
+    static const unsigned char ALLOC_DEBUG_FRESH = 0xCD;
+    static const unsigned char ALLOC_DEBUG_FREED = 0xDD;
+    static const unsigned char ALLOC_DEBUG_PADDING = 0xFD;
+    static const uint64_t ALLOC_DEBUG_CANARY = 0xFDFDFDFDFDFDFDFDull;
+#endif
 
     class AllocByFreeList {
     public:
         static void *allocate(size_t size) {
+#ifdef MICROSTL_ALLOC_DEBUG
+            return debug_allocate(size);
+#endif
             // 获取到合适的list
             block *volatile *list;
             // 如果当前list没有可用空间，则向内存池申请内存
@@ -156,10 +270,15 @@ namespace MicroSTL {
 
             // 更新free list指针
             *list = result->next_block;
+            MICROSTL_UNPOISON(result, size);
             return result;
         }
 
         static void deallocate(void *ptr, size_t size) {
+#ifdef MICROSTL_ALLOC_DEBUG
+            debug_deallocate(ptr, size);
+            return;
+#endif
             block *data = static_cast<block *>(ptr);
             block *volatile *list;
             // 如果 > 128byte则调用free
@@ -170,16 +289,324 @@ namespace MicroSTL {
                 data->next_block = *list;
                 // 将ptr作为新的list头节点
                 *list = data;
+                // free list 指针之后的部分不应再被访问
+                MICROSTL_POISON(reinterpret_cast<char *>(data) + sizeof(block *), round_up(size) - sizeof(block *));
             }
         }
 
+        /**
+         * 先申请新的 block 并复制原有内容，再释放旧的 block
+         */
         static void *reallocate(void *ptr, size_t old_size, size_t new_size) {
+            void *result = allocate(new_size);
+            memcpy(result, ptr, old_size < new_size ? old_size : new_size);
             deallocate(ptr, old_size);
-            ptr = allocate(new_size);
-            return ptr;
+            return result;
+        }
+
+        /**
+         * 按 alignment（2 的幂）对齐申请，释放时需要传入相同的 size 与 alignment
+         */
+        static void *aligned_allocate(size_t size, size_t alignment) {
+            if (alignment <= ALIGN) {
+                return allocate(size);
+            }
+            size_t padded = (size + alignment - 1) & ~(alignment - 1);
+            if (alignment <= ALLOC_NATURAL_ALIGN && padded <= static_cast<size_t>(MAX_BYTES)) {
+                return allocate(padded);
+            }
+            if (alignment <= alignof(std::max_align_t) && padded > static_cast<size_t>(MAX_BYTES)) {
+                return allocate(size);
+            }
+            return AllocByMalloc::aligned_allocate(size, alignment);
+        }
+
+        static void aligned_deallocate(void *ptr, size_t size, size_t alignment) {
+            if (alignment <= ALIGN) {
+                deallocate(ptr, size);
+                return;
+            }
+            size_t padded = (size + alignment - 1) & ~(alignment - 1);
+            if (alignment <= ALLOC_NATURAL_ALIGN && padded <= static_cast<size_t>(MAX_BYTES)) {
+                deallocate(ptr, padded);
+            } else if (alignment <= alignof(std::max_align_t) && padded > static_cast<size_t>(MAX_BYTES)) {
+                deallocate(ptr, size);
+            } else {
+                AllocByMalloc::aligned_deallocate(ptr, size, alignment);
+            }
+        }
+
+        /**
+         * 大小为 size 的 block 在 free list 中保证的对齐
+         */
+        static size_t natural_alignment(size_t size) {
+            size_t lowest = size & (~size + 1);
+            return lowest < ALLOC_NATURAL_ALIGN ? lowest : ALLOC_NATURAL_ALIGN;
+        }
+
+#ifdef MICROSTL_ALLOC_DEBUG
+
+        /**
+         * 尚未释放的 block 数
+         */
+        static size_t debug_outstanding() {
+            size_t result = 0;
+            for (size_t i = 0; i <= LIST_NUMBER; i++) {
+                result += debug_live_count[i];
+            }
+            return result;
+        }
+
+        /**
+         * 检查并清空隔离区中的所有 block
+         */
+        static void debug_flush_quarantine() {
+            while (debug_quarantine_size != 0) {
+                debug_release_oldest();
+            }
+        }
+
+        /**
+         * 按大小分类输出尚未释放的内存，每类最多列出 8 个 block
+         */
+        static void debug_report(FILE *out) {
+            size_t total = debug_outstanding();
+            if (total == 0) {
+                return;
+            }
+            size_t bytes = 0;
+            for (size_t i = 0; i <= LIST_NUMBER; i++) {
+                bytes += debug_live_bytes[i];
+            }
+            fprintf(out, "MicroSTL alloc debug: %zu blocks (%zu bytes) not freed\n", total, bytes);
+            for (size_t i = 0; i <= LIST_NUMBER; i++) {
+                if (debug_live_count[i] == 0) {
+                    continue;
+                }
+                if (i == LIST_NUMBER) {
+                    fprintf(out, "  size class > %d: %zu blocks, %zu bytes\n", MAX_BYTES, debug_live_count[i],
+                            debug_live_bytes[i]);
+                } else {
+                    fprintf(out, "  size class %zu: %zu blocks, %zu bytes\n", (i + 1) * ALIGN, debug_live_count[i],
+                            debug_live_bytes[i]);
+                }
+                size_t listed = 0;
+                for (debug_header *h = debug_live[i]; h != nullptr && listed < 8; h = h->next, listed++) {
+                    fprintf(out, "    %p size %zu\n", static_cast<void *>(debug_user(h)), h->size);
+                }
+            }
         }
 
+#endif
+
     private:
+#ifdef MICROSTL_ALLOC_DEBUG
+
+        enum : uint32_t {
+            DEBUG_LIVE = 0x4C495645,
+            DEBUG_FREED = 0x46524545
+        };
+
+        /**
+         * 占满一个 cache line，与按 64 字节取整的 block 大小一起保证用户数据的自然对齐不受影响
+         */
+        struct alignas(ALLOC_NATURAL_ALIGN) debug_header {
+            // 存活时为所在分类的双向链表，在 free list 中时 next 为下一个空闲 block
+            debug_header *prev;
+            debug_header *next;
+            size_t size;
+            uint32_t state;
+            uint32_t canary;
+        };
+
+        static const uint32_t DEBUG_HEADER_CANARY = 0xC0FFEE11;
+
+        // 下标 LIST_NUMBER 为超过 MAX_BYTES 的大块
+        static debug_header *debug_live[LIST_NUMBER + 1];
+        static size_t debug_live_count[LIST_NUMBER + 1];
+        static size_t debug_live_bytes[LIST_NUMBER + 1];
+        static debug_header *debug_free_list[LIST_NUMBER];
+        // 隔离区为环形队列
+        static debug_header *debug_quarantine[ALLOC_DEBUG_QUARANTINE];
+        static size_t debug_quarantine_head;
+        static size_t debug_quarantine_size;
+        static bool debug_report_registered;
+
+        [[noreturn]] static void debug_failure(const char *message, const debug_header *h, size_t size) {
+            fprintf(stderr, "MicroSTL alloc debug: %s (block %p, size %zu)\n", message,
+                    static_cast<const void *>(h + 1), size);
+            abort();
+        }
+
+        static char *debug_user(debug_header *h) {
+            return reinterpret_cast<char *>(h + 1);
+        }
+
+        static size_t debug_class(size_t size) {
+            return size > static_cast<size_t>(MAX_BYTES) ? LIST_NUMBER : get_free_list_index(size);
+        }
+
+        /**
+         * 头部 + 对齐后的数据 + 尾部 canary，补齐到 ALLOC_NATURAL_ALIGN 的整数倍
+         */
+        static size_t debug_block_size(size_t size) {
+            size_t bytes = sizeof(debug_header) + round_up(size) + sizeof(uint64_t);
+            return (bytes + ALLOC_NATURAL_ALIGN - 1) & ~(ALLOC_NATURAL_ALIGN - 1);
+        }
+
+        static bool debug_filled(const char *ptr, size_t size, unsigned char value) {
+            for (size_t i = 0; i < size; i++) {
+                if (static_cast<unsigned char>(ptr[i]) != value) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * 填充字节与尾部 canary 是否完好
+         */
+        static bool debug_tail_intact(debug_header *h) {
+            char *user = debug_user(h);
+            size_t rounded = round_up(h->size);
+            uint64_t canary;
+            memcpy(&canary, user + rounded, sizeof(canary));
+            return canary == ALLOC_DEBUG_CANARY && debug_filled(user + h->size, rounded - h->size, ALLOC_DEBUG_PADDING);
+        }
+
+        static debug_header *debug_take(size_t size) {
+            size_t index = debug_class(size);
+            if (index == LIST_NUMBER) {
+                return static_cast<debug_header *>(AllocByMalloc::aligned_allocate(debug_block_size(size),
+                                                                                   ALLOC_NATURAL_ALIGN));
+            }
+            debug_header *result = debug_free_list[index];
+            if (result != nullptr) {
+                debug_free_list[index] = result->next;
+                return result;
+            }
+            // 同一分类的 block 大小相同，按分类中最大的申请大小切分
+            size_t bytes = debug_block_size((index + 1) * ALIGN);
+            int block_nums = 20;
+            char *blocks = chunk_alloc(bytes, block_nums);
+            for (int i = 1; i < block_nums; i++) {
+                debug_header *h = reinterpret_cast<debug_header *>(blocks + i * bytes);
+                h->next = debug_free_list[index];
+                h->state = 0;
+                debug_free_list[index] = h;
+            }
+            return reinterpret_cast<debug_header *>(blocks);
+        }
+
+        static void *debug_allocate(size_t size) {
+            if (!debug_report_registered) {
+                debug_report_registered = true;
+                atexit([] {
+                    debug_report(stderr);
+                });
+            }
+            debug_header *h = debug_take(size);
+            size_t index = debug_class(size);
+            size_t rounded = round_up(size);
+            char *user = debug_user(h);
+            MICROSTL_UNPOISON(user, rounded + sizeof(uint64_t));
+
+            h->size = size;
+            h->state = DEBUG_LIVE;
+            h->canary = DEBUG_HEADER_CANARY;
+            h->prev = nullptr;
+            h->next = debug_live[index];
+            if (h->next != nullptr) {
+                h->next->prev = h;
+            }
+            debug_live[index] = h;
+            ++debug_live_count[index];
+            debug_live_bytes[index] += size;
+
+            memset(user, ALLOC_DEBUG_FRESH, size);
+            memset(user + size, ALLOC_DEBUG_PADDING, rounded - size);
+            memcpy(user + rounded, &ALLOC_DEBUG_CANARY, sizeof(uint64_t));
+            // 在 ASan 下填充与尾部不可访问，越界立即被发现；头部要维护链表，不做标记
+            MICROSTL_POISON(user + size, rounded - size + sizeof(uint64_t));
+            return user;
+        }
+
+        static void debug_deallocate(void *ptr, size_t size) {
+            if (ptr == nullptr) {
+                return;
+            }
+            debug_header *h = reinterpret_cast<debug_header *>(ptr) - 1;
+            if (h->canary != DEBUG_HEADER_CANARY) {
+                debug_failure("invalid pointer or corrupted block header", h, size);
+            }
+            if (h->state == DEBUG_FREED) {
+                debug_failure("double free", h, size);
+            }
+            if (h->state != DEBUG_LIVE) {
+                debug_failure("invalid pointer", h, size);
+            }
+            if (h->size != size) {
+                fprintf(stderr, "MicroSTL alloc debug: allocated with size %zu\n", h->size);
+                debug_failure("deallocate size does not match allocate", h, size);
+            }
+            char *user = debug_user(h);
+            size_t rounded = round_up(size);
+            MICROSTL_UNPOISON(user, rounded + sizeof(uint64_t));
+            if (!debug_tail_intact(h)) {
+                debug_failure("buffer overflow past the end of the block", h, size);
+            }
+
+            size_t index = debug_class(size);
+            if (h->prev != nullptr) {
+                h->prev->next = h->next;
+            } else {
+                debug_live[index] = h->next;
+            }
+            if (h->next != nullptr) {
+                h->next->prev = h->prev;
+            }
+            --debug_live_count[index];
+            debug_live_bytes[index] -= size;
+
+            h->state = DEBUG_FREED;
+            memset(user, ALLOC_DEBUG_FREED, size);
+            MICROSTL_POISON(user, rounded + sizeof(uint64_t));
+
+            if (debug_quarantine_size == ALLOC_DEBUG_QUARANTINE) {
+                debug_release_oldest();
+            }
+            debug_quarantine[(debug_quarantine_head + debug_quarantine_size) % ALLOC_DEBUG_QUARANTINE] = h;
+            ++debug_quarantine_size;
+        }
+
+        /**
+         * 隔离区中最早的 block：检查释放后是否被写入，再交还 free list
+         */
+        static void debug_release_oldest() {
+            debug_header *h = debug_quarantine[debug_quarantine_head];
+            debug_quarantine_head = (debug_quarantine_head + 1) % ALLOC_DEBUG_QUARANTINE;
+            --debug_quarantine_size;
+
+            size_t size = h->size;
+            MICROSTL_UNPOISON(debug_user(h), round_up(size) + sizeof(uint64_t));
+            if (h->state != DEBUG_FREED || h->canary != DEBUG_HEADER_CANARY ||
+                !debug_filled(debug_user(h), size, ALLOC_DEBUG_FREED) || !debug_tail_intact(h)) {
+                debug_failure("block was written after free", h, size);
+            }
+
+            size_t index = debug_class(size);
+            if (index == LIST_NUMBER) {
+                AllocByMalloc::aligned_deallocate(h, debug_block_size(size), ALLOC_NATURAL_ALIGN);
+                return;
+            }
+            // 保留 DEBUG_FREED 状态，在被再次分配之前仍然可以发现 double free
+            h->next = debug_free_list[index];
+            debug_free_list[index] = h;
+            MICROSTL_POISON(debug_user(h), round_up(size) + sizeof(uint64_t));
+        }
+
+#endif
+
         /**
          * free list指针
          * 每个block为8byte，即上面我们定义的 ALIGN 大小
@@ -254,6 +681,7 @@ namespace MicroSTL {
          */
         static char *chunk_alloc(size_t block_size, int &block_nums) {
             char *result;
+            align_pool(natural_alignment(block_size));
             size_t required_total = block_size * block_nums;
             size_t memory_pool_bytes_left = end_free - start_free;
             if (memory_pool_bytes_left >= required_total) {
@@ -274,16 +702,20 @@ namespace MicroSTL {
                 return result;
             }
             // 如果内存池剩余内存连一个block都不能够满足
+            // 先将剩余的内存给管理小块内存的list
+            release_leftover();
 
             // todo 细化内存不足时的处理方式
 
-            // 直接从heap申请内存
-            size_t bytes_to_get = 2 * required_total + round_up(heap_size >> 4);
-            start_free = static_cast<char *>(malloc(bytes_to_get));
+            // 直接从heap申请内存，按 ALLOC_NATURAL_ALIGN 对齐
+            size_t bytes_to_get = (2 * required_total + round_up(heap_size >> 4) + ALLOC_NATURAL_ALIGN - 1) &
+                                  ~(ALLOC_NATURAL_ALIGN - 1);
+            start_free = static_cast<char *>(aligned_alloc(ALLOC_NATURAL_ALIGN, bytes_to_get));
 
             if (start_free == nullptr) {
                 // 调用 AllocByMalloc，尝试 oom handler 机制能否奏效
-                start_free = static_cast<char *>(AllocByMalloc::allocate(required_total));
+                bytes_to_get = (required_total + ALLOC_NATURAL_ALIGN - 1) & ~(ALLOC_NATURAL_ALIGN - 1);
+                start_free = static_cast<char *>(AllocByMalloc::aligned_allocate(bytes_to_get, ALLOC_NATURAL_ALIGN));
             }
             heap_size += bytes_to_get;
             end_free = start_free + bytes_to_get;
@@ -291,6 +723,42 @@ namespace MicroSTL {
             // 内存池扩容完毕，重新尝试分配内存
             return chunk_alloc(block_size, block_nums);
         }
+
+        /**
+         * 把 [ptr, ptr + size) 作为一个 block 放入对应的 free list
+         */
+        static void push_block(char *ptr, size_t size) {
+            block *data = reinterpret_cast<block *>(ptr);
+            block *volatile *list = free_list + get_free_list_index(size);
+            data->next_block = *list;
+            *list = data;
+        }
+
+        /**
+         * 跳过内存池起点之前不满足 alignment 的部分，跳过的空隙切成 ALIGN 大小的 block；
+         * 内存池本身按 ALLOC_NATURAL_ALIGN 对齐，空隙不超过 56 字节
+         */
+        static void align_pool(size_t alignment) {
+            while (start_free != end_free && reinterpret_cast<uintptr_t>(start_free) % alignment != 0) {
+                push_block(start_free, ALIGN);
+                start_free += ALIGN;
+            }
+        }
+
+        /**
+         * 内存池中的零头按从大到小切成自然对齐的 block 放入 free list
+         */
+        static void release_leftover() {
+            while (start_free != end_free) {
+                size_t left = end_free - start_free;
+                size_t size = left < static_cast<size_t>(MAX_BYTES) ? left : static_cast<size_t>(MAX_BYTES);
+                while (reinterpret_cast<uintptr_t>(start_free) % natural_alignment(size) != 0) {
+                    size -= ALIGN;
+                }
+                push_block(start_free, size);
+                start_free += size;
+            }
+        }
     };
 
     AllocByFreeList::block *volatile AllocByFreeList::free_list[LIST_NUMBER] = {nullptr, nullptr, nullptr, nullptr,
@@ -302,29 +770,56 @@ namespace MicroSTL {
     char *AllocByFreeList::end_free = nullptr;
     size_t AllocByFreeList::heap_size = 0;
 
+#ifdef MICROSTL_ALLOC_DEBUG
+    inline AllocByFreeList::debug_header *AllocByFreeList::debug_live[LIST_NUMBER + 1] = {};
+    inline size_t AllocByFreeList::debug_live_count[LIST_NUMBER + 1] = {};
+    inline size_t AllocByFreeList::debug_live_bytes[LIST_NUMBER + 1] = {};
+    inline AllocByFreeList::debug_header *AllocByFreeList::debug_free_list[LIST_NUMBER] = {};
+    inline AllocByFreeList::debug_header *AllocByFreeList::debug_quarantine[ALLOC_DEBUG_QUARANTINE] = {};
+    inline size_t AllocByFreeList::debug_quarantine_head = 0;
+    inline size_t AllocByFreeList::debug_quarantine_size = 0;
+    inline bool AllocByFreeList::debug_report_registered = false;
+#endif
+
+}
+
+// AllocByNuma 依赖上面的 AllocByMalloc 与 free list 的常量，numa_pool.h 中对本文件的 include 会被头文件保护跳过
+#if MICROSTL_ALLOC_BACKEND == MICROSTL_ALLOC_BACKEND_NUMA
+#include "numa_pool.h"
+#endif
+
+namespace MicroSTL {
+
+#if MICROSTL_ALLOC_BACKEND == MICROSTL_ALLOC_BACKEND_NUMA
+    using alloc_backend = AllocByNuma;
+#else
+    using alloc_backend = AllocByFreeList;
+#endif
+
     /**
      * 适配器
-     * 默认使用AllocByFreeList进行内存分配
+     * 默认使用 MICROSTL_ALLOC_BACKEND 选择的后端进行内存分配，按 alignof(T) 对齐；
+     * Backend 需要提供 aligned_allocate / aligned_deallocate
      */
-    template<typename T>
+    template<typename T, typename Backend = alloc_backend>
     class Alloc {
     public:
         static T *allocate(size_t size) {
-            return size == 0 ? nullptr : static_cast<T * >(AllocByFreeList::allocate(size * sizeof(T)));
+            return size == 0 ? nullptr : static_cast<T * >(Backend::aligned_allocate(size * sizeof(T), alignof(T)));
         }
 
         static T *allocate() {
-            return static_cast<T *>(AllocByFreeList::allocate(sizeof(T)));
+            return static_cast<T *>(Backend::aligned_allocate(sizeof(T), alignof(T)));
         }
 
         static void deallocate(T *ptr, size_t size) {
             if (size != 0) {
-                AllocByFreeList::deallocate(ptr, size * sizeof(T));
+                Backend::aligned_deallocate(ptr, size * sizeof(T), alignof(T));
             }
         }
 
         static void deallocate(T *ptr) {
-            AllocByFreeList::deallocate(ptr, sizeof(T));
+            Backend::aligned_deallocate(ptr, sizeof(T), alignof(T));
         }
     };
 
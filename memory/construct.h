@@ -50,7 +50,7 @@ namespace MicroSTL {
     inline void
     _destroy_aux(ForwardIterator first, ForwardIterator last, false_type) {
         for (; first < last; ++first) {
-            destroy(&*first);
+            MicroSTL::destroy(&*first);
         }
     }
 
@@ -0,0 +1,258 @@
+#ifndef MICROSTL_EPOCH_H
+#define MICROSTL_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include "alloc.h"
+
+/**
+ * 基于 epoch 的内存回收，供无锁读取的并发容器使用：
+ *
+ * - 读者在 epoch_guard 的作用域内访问共享节点，进入时发布当前的全局 epoch，离开时置为空闲
+ * - 写者把节点从数据结构中摘下后调用 epoch_retire，节点记下摘下时的全局 epoch，暂存在本线程的待回收列表中
+ * - 所有活跃线程都已进入当前 epoch 时全局 epoch 才能前进；
+ *   待回收节点的 epoch 小于所有活跃线程发布的 epoch 时，已经没有线程可能持有它，可以释放
+ * - 待回收列表满 EPOCH_RECLAIM_THRESHOLD 个后，在最外层的 epoch_guard 离开时尝试回收
+ * - 线程退出时把未回收的节点交给全局列表，由其他线程回收；线程记录本身不释放，留给之后的线程复用
+ * - 内部的内存都来自 AllocByMalloc：AllocByFreeList 没有加锁，不能在多个线程中同时使用
+ */
+
+namespace MicroSTL {
+
+    static const size_t EPOCH_RECLAIM_THRESHOLD = 64;
+
+    static const uint64_t EPOCH_IDLE = UINT64_MAX;
+
+    struct _epoch_retired {
+        void *ptr;
+        void (*deleter)(void *);
+        uint64_t epoch;
+    };
+
+    /**
+     * 由 AllocByMalloc 管理的待回收数组
+     */
+    struct _epoch_retired_list {
+        _epoch_retired *items;
+        size_t count;
+        size_t capacity;
+
+        void push(const _epoch_retired &item) {
+            if (count == capacity) {
+                size_t new_capacity = capacity == 0 ? EPOCH_RECLAIM_THRESHOLD : capacity * 2;
+                items = static_cast<_epoch_retired *>(AllocByMalloc::reallocate(
+                        items, capacity * sizeof(_epoch_retired), new_capacity * sizeof(_epoch_retired)));
+                capacity = new_capacity;
+            }
+            items[count++] = item;
+        }
+
+        /**
+         * 释放 epoch 小于 safe 的节点，其余的保持原有顺序
+         */
+        void reclaim(uint64_t safe) {
+            size_t kept = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (items[i].epoch < safe) {
+                    items[i].deleter(items[i].ptr);
+                } else {
+                    items[kept++] = items[i];
+                }
+            }
+            count = kept;
+        }
+
+        void release() {
+            if (items) {
+                AllocByMalloc::deallocate(items, capacity * sizeof(_epoch_retired));
+            }
+            items = nullptr;
+            count = capacity = 0;
+        }
+    };
+
+    struct _epoch_record {
+        // 只由所属线程写，其他线程在回收时读取；记录由 malloc 分配，用填充代替 alignas 隔开相邻记录
+        std::atomic<uint64_t> epoch;
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+        std::atomic<bool> in_use;
+        _epoch_record *next;
+        unsigned nesting;
+        // 待回收的个数达到该值时尝试回收；回收后仍有剩余时推迟下一次，避免每次离开都扫描整个列表
+        size_t reclaim_at;
+        _epoch_retired_list retired;
+    };
+
+    class _epoch_domain {
+    protected:
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> global;
+        std::atomic<_epoch_record *> records;
+        std::mutex orphan_mutex;
+        _epoch_retired_list orphans;
+
+    public:
+        _epoch_domain() : global(1), records(nullptr), orphan_mutex(), orphans{nullptr, 0, 0} {}
+
+        ~_epoch_domain() {
+            // 进程退出时已经没有读者
+            orphans.reclaim(EPOCH_IDLE);
+            orphans.release();
+        }
+
+        uint64_t current() const {
+            return global.load(std::memory_order_seq_cst);
+        }
+
+        /**
+         * 复用空闲的线程记录，没有时新建一个并挂到链表头部
+         */
+        _epoch_record *acquire_record() {
+            for (_epoch_record *record = records.load(std::memory_order_acquire); record; record = record->next) {
+                bool expected = false;
+                if (!record->in_use.load(std::memory_order_relaxed) &&
+                    record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return record;
+                }
+            }
+            _epoch_record *record = static_cast<_epoch_record *>(AllocByMalloc::allocate(sizeof(_epoch_record)));
+            new(record) _epoch_record();
+            record->epoch.store(EPOCH_IDLE, std::memory_order_relaxed);
+            record->in_use.store(true, std::memory_order_relaxed);
+            record->nesting = 0;
+            record->reclaim_at = EPOCH_RECLAIM_THRESHOLD;
+            record->retired = _epoch_retired_list{nullptr, 0, 0};
+            _epoch_record *head = records.load(std::memory_order_relaxed);
+            do {
+                record->next = head;
+            } while (!records.compare_exchange_weak(head, record, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+            return record;
+        }
+
+        void release_record(_epoch_record *record) {
+            if (record->retired.count != 0) {
+                std::lock_guard<std::mutex> guard(orphan_mutex);
+                for (size_t i = 0; i < record->retired.count; ++i) {
+                    orphans.push(record->retired.items[i]);
+                }
+            }
+            record->retired.release();
+            record->epoch.store(EPOCH_IDLE, std::memory_order_release);
+            record->in_use.store(false, std::memory_order_release);
+        }
+
+        void enter(_epoch_record *record) {
+            if (record->nesting++ == 0) {
+                record->epoch.store(global.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+            }
+        }
+
+        void exit(_epoch_record *record) {
+            if (--record->nesting == 0) {
+                record->epoch.store(EPOCH_IDLE, std::memory_order_release);
+                if (record->retired.count >= record->reclaim_at) {
+                    reclaim(record);
+                }
+            }
+        }
+
+        void retire(_epoch_record *record, void *ptr, void (*deleter)(void *)) {
+            record->retired.push(_epoch_retired{ptr, deleter, current()});
+        }
+
+        /**
+         * 所有活跃线程都处于当前 epoch 时前进一步，返回所有活跃线程中最小的 epoch
+         */
+        uint64_t advance() {
+            uint64_t now = global.load(std::memory_order_seq_cst);
+            uint64_t oldest = EPOCH_IDLE;
+            for (_epoch_record *record = records.load(std::memory_order_acquire); record; record = record->next) {
+                uint64_t epoch = record->epoch.load(std::memory_order_seq_cst);
+                if (epoch < oldest) {
+                    oldest = epoch;
+                }
+            }
+            if (oldest == EPOCH_IDLE || oldest == now) {
+                global.compare_exchange_strong(now, now + 1, std::memory_order_seq_cst);
+            }
+            // 没有活跃线程时，已摘下的节点都可以释放
+            return oldest == EPOCH_IDLE ? now + 1 : oldest;
+        }
+
+        void reclaim(_epoch_record *record) {
+            uint64_t safe = advance();
+            record->retired.reclaim(safe);
+            record->reclaim_at = record->retired.count + EPOCH_RECLAIM_THRESHOLD;
+            std::unique_lock<std::mutex> guard(orphan_mutex, std::try_to_lock);
+            if (guard.owns_lock() && orphans.count != 0) {
+                orphans.reclaim(safe);
+            }
+        }
+    };
+
+    inline _epoch_domain &_epoch_global() {
+        static _epoch_domain domain;
+        return domain;
+    }
+
+    /**
+     * 每个线程第一次使用时获取一条记录，线程退出时归还
+     */
+    struct _epoch_thread {
+        _epoch_record *record;
+
+        _epoch_thread() : record(_epoch_global().acquire_record()) {}
+
+        ~_epoch_thread() {
+            _epoch_global().release_record(record);
+        }
+    };
+
+    inline _epoch_record *_epoch_local() {
+        static thread_local _epoch_thread local;
+        return local.record;
+    }
+
+    // --------------------- 对外接口 --------------------------
+
+    /**
+     * 作用域内读到的共享节点不会被释放，可以嵌套
+     */
+    class epoch_guard {
+        _epoch_record *record;
+
+    public:
+        epoch_guard() : record(_epoch_local()) {
+            _epoch_global().enter(record);
+        }
+
+        epoch_guard(const epoch_guard &) = delete;
+
+        epoch_guard &operator=(const epoch_guard &) = delete;
+
+        ~epoch_guard() {
+            _epoch_global().exit(record);
+        }
+    };
+
+    /**
+     * ptr 已经从数据结构中摘下，等到没有读者可能持有它时调用 deleter(ptr)
+     */
+    inline void epoch_retire(void *ptr, void (*deleter)(void *)) {
+        _epoch_global().retire(_epoch_local(), ptr, deleter);
+    }
+
+    /**
+     * 立即尝试回收本线程待回收的节点，返回仍未回收的个数
+     */
+    inline size_t epoch_reclaim() {
+        _epoch_record *record = _epoch_local();
+        _epoch_global().reclaim(record);
+        return record->retired.count;
+    }
+}
+
+#endif //MICROSTL_EPOCH_H
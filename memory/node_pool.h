@@ -0,0 +1,135 @@
+#ifndef MICROSTL_NODE_POOL_H
+#define MICROSTL_NODE_POOL_H
+
+#include <cstddef>
+#include "alloc.h"
+
+/**
+ * 节点容器（rb_tree 等）专用的 slab 分配器，每个容器实例持有一个：
+ *
+ * - 以 slab 为单位向 alloc_backend（默认为 AllocByFreeList）按节点的对齐申请内存，每个 slab 切分为若干个节点
+ *      - 第一个 slab 容纳 16 个节点，之后每次翻倍，最多 1024 个，小容器不会浪费太多内存
+ *      - 同一个容器的节点集中在少数几块连续内存中，遍历与查找时 cache / TLB 更友好
+ * - 释放的节点进入池内的空闲链表，优先复用，直到容器析构时才把所有 slab 归还
+ * - 只在所属容器内使用，不需要加锁
+ */
+
+namespace MicroSTL {
+
+    template<typename T>
+    class node_pool {
+    public:
+        static const size_t MIN_SLAB_NODES = 16;
+        static const size_t MAX_SLAB_NODES = 1024;
+
+    protected:
+        /**
+         * 空闲的节点复用自身的内存作为链表指针
+         */
+        union slot {
+            slot *next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        /**
+         * slab 的头部，之后紧跟着节点
+         */
+        struct slab {
+            slab *next;
+            size_t bytes;
+        };
+
+        static const size_t HEADER_BYTES = (sizeof(slab) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+
+        slab *slabs;
+        slot *free_slots;
+        // 当前 slab 中尚未切分的部分
+        slot *cursor;
+        slot *cursor_end;
+        size_t next_slab_nodes;
+
+        void grow() {
+            size_t bytes = HEADER_BYTES + next_slab_nodes * sizeof(slot);
+            slab *block = static_cast<slab *>(alloc_backend::aligned_allocate(bytes, alignof(slot)));
+            block->next = slabs;
+            block->bytes = bytes;
+            slabs = block;
+            cursor = reinterpret_cast<slot *>(reinterpret_cast<char *>(block) + HEADER_BYTES);
+            cursor_end = cursor + next_slab_nodes;
+            if (next_slab_nodes < MAX_SLAB_NODES) {
+                next_slab_nodes *= 2;
+            }
+        }
+
+    public:
+        node_pool() : slabs(nullptr), free_slots(nullptr), cursor(nullptr), cursor_end(nullptr),
+                      next_slab_nodes(MIN_SLAB_NODES) {}
+
+        node_pool(const node_pool &) = delete;
+
+        node_pool &operator=(const node_pool &) = delete;
+
+        ~node_pool() {
+            release();
+        }
+
+        /**
+         * 返回未构造的节点内存
+         */
+        T *allocate() {
+            if (free_slots != nullptr) {
+                slot *result = free_slots;
+                free_slots = result->next;
+                return reinterpret_cast<T *>(result);
+            }
+            if (cursor == cursor_end) {
+                grow();
+            }
+            return reinterpret_cast<T *>(cursor++);
+        }
+
+        /**
+         * 节点需要已经析构
+         */
+        void deallocate(T *node) {
+            slot *p = reinterpret_cast<slot *>(node);
+            p->next = free_slots;
+            free_slots = p;
+        }
+
+        /**
+         * 归还所有 slab，之前分配的节点全部失效
+         */
+        void release() {
+            while (slabs != nullptr) {
+                slab *next = slabs->next;
+                alloc_backend::aligned_deallocate(slabs, slabs->bytes, alignof(slot));
+                slabs = next;
+            }
+            free_slots = nullptr;
+            cursor = nullptr;
+            cursor_end = nullptr;
+            next_slab_nodes = MIN_SLAB_NODES;
+        }
+
+        void swap(node_pool &obj) {
+            slab *temp_slabs = slabs;
+            slabs = obj.slabs;
+            obj.slabs = temp_slabs;
+            slot *temp_free = free_slots;
+            free_slots = obj.free_slots;
+            obj.free_slots = temp_free;
+            slot *temp_cursor = cursor;
+            cursor = obj.cursor;
+            obj.cursor = temp_cursor;
+            slot *temp_end = cursor_end;
+            cursor_end = obj.cursor_end;
+            obj.cursor_end = temp_end;
+            size_t temp_nodes = next_slab_nodes;
+            next_slab_nodes = obj.next_slab_nodes;
+            obj.next_slab_nodes = temp_nodes;
+        }
+    };
+}
+
+#endif //MICROSTL_NODE_POOL_H
@@ -0,0 +1,440 @@
+// 放在头文件保护之前：MICROSTL_ALLOC_BACKEND 选择 NUMA 时 alloc.h 会反过来包含本文件，
+// 先包含本文件时也要保证 AllocByNuma 在 alloc.h 的 Alloc<T> 之前定义
+#include "alloc.h"
+
+#ifndef MICROSTL_NUMA_POOL_H
+#define MICROSTL_NUMA_POOL_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * 按 NUMA 节点划分的内存池，接口与 AllocByFreeList 相同，可以在多个线程中同时使用：
+ *
+ * - 每个节点一个 arena，持有与 AllocByFreeList 相同的 16 个 free list，加锁访问
+ * - arena 以 NUMA_CHUNK_BYTES 对齐的 chunk 为单位用 mmap 申请内存，多节点的机器上用 mbind(MPOL_PREFERRED)
+ *   把 chunk 放在所属节点上；mbind 不可用时由切分 block 的本地线程首次写入（first touch）决定位置
+ * - chunk 的头部记录所属节点，任意 block 地址向下对齐即可得到它的节点，释放时不需要额外的参数
+ * - 每个线程持有一个缓存，每个大小分类最多 NUMA_CACHE_BLOCKS 个 block，空了从本节点的 arena 成批补充，
+ *   满了归还一半；释放其他节点的 block 时直接还给它的 arena，不进入本地缓存
+ * - 线程所在的节点由 sched_getcpu 与拓扑表得到，线程被迁移到其他节点后，下一次分配时先清空缓存
+ * - 拓扑从 /sys/devices/system/node 读取；环境变量 MICROSTL_FAKE_NUMA 或 numa_topology::set_fake
+ *   可以指定虚拟的拓扑（类似 numactl 的 cpu 列表，节点之间用 ';' 分隔，如 "0-1;2-3"），
+ *   numa_bind_thread 可以固定当前线程所在的节点，便于在单节点的机器上测试
+ * - 超过 MAX_BYTES 的内存直接使用 malloc
+ * - 定义 MICROSTL_ALLOC_BACKEND=MICROSTL_ALLOC_BACKEND_NUMA 时 Alloc<T> 使用本内存池，所有容器随之按节点分配
+ */
+
+namespace MicroSTL {
+
+    static const size_t NUMA_MAX_NODES = 64;
+    static const size_t NUMA_MAX_CPUS = 1024;
+    static const size_t NUMA_CHUNK_BYTES = 2 * 1024 * 1024;
+    static const size_t NUMA_CACHE_BLOCKS = 64;
+
+    // <numaif.h> 属于 libnuma，这里只需要一个常量
+    static const int NUMA_MPOL_PREFERRED = 1;
+
+    // --------------------- 拓扑 --------------------------
+
+    /**
+     * cpu 到节点的映射表，set_fake 需要在其他线程使用内存池之前调用
+     */
+    class numa_topology {
+    protected:
+        std::atomic<size_t> nodes;
+        uint16_t cpu_node[NUMA_MAX_CPUS];
+        std::atomic<bool> fake;
+
+        numa_topology() : nodes(1), cpu_node(), fake(false) {
+            const char *env = getenv("MICROSTL_FAKE_NUMA");
+            if (env != nullptr && set_fake(env)) {
+                return;
+            }
+            detect();
+        }
+
+        void detect() {
+            size_t found = 0;
+            for (size_t node = 0; node < NUMA_MAX_NODES; node++) {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string cpus;
+                if (!file || !std::getline(file, cpus)) {
+                    continue;
+                }
+                parse(cpus, node, cpu_node);
+                found = node + 1;
+            }
+            nodes.store(found == 0 ? 1 : found);
+        }
+
+        /**
+         * 把 cpu 列表（如 "0-3,8-11"）中的 cpu 在 table 中分配给 node，格式错误时返回 false
+         */
+        static bool parse(const std::string &cpus, size_t node, uint16_t *table) {
+            std::stringstream stream(cpus);
+            std::string range;
+            while (std::getline(stream, range, ',')) {
+                if (range.empty()) {
+                    continue;
+                }
+                char *end = nullptr;
+                unsigned long first = strtoul(range.c_str(), &end, 10);
+                unsigned long last = first;
+                if (*end == '-') {
+                    last = strtoul(end + 1, &end, 10);
+                }
+                if (*end != '\0' || last < first) {
+                    return false;
+                }
+                for (unsigned long cpu = first; cpu <= last && cpu < NUMA_MAX_CPUS; cpu++) {
+                    table[cpu] = static_cast<uint16_t>(node);
+                }
+            }
+            return true;
+        }
+
+    public:
+        static numa_topology &instance() {
+            static numa_topology topology;
+            return topology;
+        }
+
+        size_t node_count() const {
+            return nodes.load(std::memory_order_relaxed);
+        }
+
+        bool is_fake() const {
+            return fake.load(std::memory_order_relaxed);
+        }
+
+        size_t node_of_cpu(size_t cpu) const {
+            return cpu < NUMA_MAX_CPUS ? cpu_node[cpu] : 0;
+        }
+
+        /**
+         * 虚拟拓扑，每个节点一个 cpu 列表，用 ';' 分隔；格式错误或节点数超过 NUMA_MAX_NODES 时不做修改并返回 false
+         */
+        bool set_fake(const std::string &spec) {
+            uint16_t table[NUMA_MAX_CPUS] = {};
+            std::stringstream stream(spec);
+            std::string cpus;
+            size_t count = 0;
+            while (std::getline(stream, cpus, ';')) {
+                if (count == NUMA_MAX_NODES || !parse(cpus, count, table)) {
+                    return false;
+                }
+                count++;
+            }
+            if (count == 0) {
+                return false;
+            }
+            memcpy(cpu_node, table, sizeof(cpu_node));
+            nodes.store(count);
+            fake.store(true);
+            return true;
+        }
+
+        /**
+         * 恢复为系统的真实拓扑
+         */
+        void reset() {
+            memset(cpu_node, 0, sizeof(cpu_node));
+            fake.store(false);
+            detect();
+        }
+    };
+
+    inline thread_local int _numa_thread_node = -1;
+
+    /**
+     * 把当前线程固定在 node 上（只影响内存池的选择，不改变线程的调度），传入 -1 恢复为按 cpu 判断
+     */
+    inline void numa_bind_thread(int node) {
+        _numa_thread_node = node;
+    }
+
+    inline size_t numa_current_node() {
+        numa_topology &topology = numa_topology::instance();
+        size_t count = topology.node_count();
+        if (_numa_thread_node >= 0) {
+            return static_cast<size_t>(_numa_thread_node) % count;
+        }
+        int cpu = sched_getcpu();
+        return cpu < 0 ? 0 : topology.node_of_cpu(static_cast<size_t>(cpu)) % count;
+    }
+
+    // --------------------- 节点的 arena --------------------------
+
+    struct _numa_block {
+        _numa_block *next;
+    };
+
+    /**
+     * chunk 的头部，占用一个 cache line
+     */
+    struct alignas(CACHE_LINE_SIZE) _numa_chunk {
+        size_t node;
+        _numa_chunk *next;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) _numa_arena {
+        std::mutex mutex;
+        _numa_block *free_list[LIST_NUMBER] = {};
+        char *start_free = nullptr;
+        char *end_free = nullptr;
+        _numa_chunk *chunks = nullptr;
+        size_t chunk_count = 0;
+        size_t remote_frees = 0;
+    };
+
+    /**
+     * 某个节点 arena 的统计
+     */
+    struct numa_arena_stats {
+        size_t chunks;
+        size_t remote_frees;
+    };
+
+    class AllocByNuma {
+    public:
+        static void *allocate(size_t size) {
+            if (size > static_cast<size_t>(MAX_BYTES)) {
+                return AllocByMalloc::allocate(size);
+            }
+            _thread_cache &cache = local_cache();
+            cache.follow(numa_current_node());
+            size_t index = class_index(size);
+            if (cache.lists[index] == nullptr) {
+                refill(cache, index);
+            }
+            _numa_block *result = cache.lists[index];
+            cache.lists[index] = result->next;
+            --cache.counts[index];
+            return result;
+        }
+
+        static void deallocate(void *ptr, size_t size) {
+            if (size > static_cast<size_t>(MAX_BYTES)) {
+                AllocByMalloc::deallocate(ptr, size);
+                return;
+            }
+            size_t index = class_index(size);
+            _numa_block *block = static_cast<_numa_block *>(ptr);
+            _thread_cache &cache = local_cache();
+            size_t home = node_of(ptr);
+            if (home != cache.node) {
+                _numa_arena &remote = arena(home);
+                std::lock_guard<std::mutex> lock(remote.mutex);
+                block->next = remote.free_list[index];
+                remote.free_list[index] = block;
+                ++remote.remote_frees;
+                return;
+            }
+            block->next = cache.lists[index];
+            cache.lists[index] = block;
+            if (++cache.counts[index] > NUMA_CACHE_BLOCKS) {
+                drain(cache, index, NUMA_CACHE_BLOCKS / 2);
+            }
+        }
+
+        /**
+         * 按 alignment（2 的幂）对齐申请，供 Alloc<T> 使用。arena 中的 block 只保证 ALIGN 对齐，
+         * 更大的对齐交给 malloc：超过 MAX_BYTES 且不超过 malloc 默认对齐时直接 malloc，否则 aligned_alloc
+         */
+        static void *aligned_allocate(size_t size, size_t alignment) {
+            if (alignment <= ALIGN) {
+                return allocate(size);
+            }
+            if (alignment <= alignof(std::max_align_t) && size > static_cast<size_t>(MAX_BYTES)) {
+                return AllocByMalloc::allocate(size);
+            }
+            return AllocByMalloc::aligned_allocate(size, alignment);
+        }
+
+        static void aligned_deallocate(void *ptr, size_t size, size_t alignment) {
+            if (alignment <= ALIGN) {
+                deallocate(ptr, size);
+            } else if (alignment <= alignof(std::max_align_t) && size > static_cast<size_t>(MAX_BYTES)) {
+                AllocByMalloc::deallocate(ptr, size);
+            } else {
+                AllocByMalloc::aligned_deallocate(ptr, size, alignment);
+            }
+        }
+
+        static void *reallocate(void *ptr, size_t old_size, size_t new_size) {
+            void *result = allocate(new_size);
+            memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+            deallocate(ptr, old_size);
+            return result;
+        }
+
+        /**
+         * 不超过 MAX_BYTES 的 block 所在的节点
+         */
+        static size_t node_of(const void *ptr) {
+            uintptr_t base = reinterpret_cast<uintptr_t>(ptr) & ~(static_cast<uintptr_t>(NUMA_CHUNK_BYTES) - 1);
+            return reinterpret_cast<const _numa_chunk *>(base)->node;
+        }
+
+        static numa_arena_stats stats(size_t node) {
+            _numa_arena &target = arena(node);
+            std::lock_guard<std::mutex> lock(target.mutex);
+            return {target.chunk_count, target.remote_frees};
+        }
+
+        /**
+         * 把当前线程缓存的 block 全部归还给 arena
+         */
+        static void flush_thread_cache() {
+            local_cache().flush();
+        }
+
+    private:
+        struct _thread_cache {
+            size_t node = 0;
+            _numa_block *lists[LIST_NUMBER] = {};
+            size_t counts[LIST_NUMBER] = {};
+
+            /**
+             * 线程换了节点，先归还原节点的 block
+             */
+            void follow(size_t current) {
+                if (current != node) {
+                    flush();
+                    node = current;
+                }
+            }
+
+            void flush() {
+                for (size_t i = 0; i < LIST_NUMBER; i++) {
+                    drain(*this, i, counts[i]);
+                }
+            }
+
+            ~_thread_cache() {
+                flush();
+            }
+        };
+
+        static size_t class_index(size_t size) {
+            return (size + ALIGN - 1) / ALIGN - 1;
+        }
+
+        static _thread_cache &local_cache() {
+            static thread_local _thread_cache cache;
+            return cache;
+        }
+
+        static _numa_arena &arena(size_t node) {
+            static _numa_arena arenas[NUMA_MAX_NODES];
+            return arenas[node % NUMA_MAX_NODES];
+        }
+
+        static size_t refill_count(size_t index) {
+            // 小 block 一次多取一些，与 chunk_alloc 的 20 个相近
+            return (index + 1) * ALIGN <= 32 ? 32 : 16;
+        }
+
+        /**
+         * 从本节点的 arena 取一批 block 放入线程缓存
+         */
+        static void refill(_thread_cache &cache, size_t index) {
+            _numa_arena &local = arena(cache.node);
+            size_t bytes = (index + 1) * ALIGN;
+            size_t wanted = refill_count(index);
+            std::lock_guard<std::mutex> lock(local.mutex);
+            while (cache.counts[index] < wanted && local.free_list[index] != nullptr) {
+                _numa_block *block = local.free_list[index];
+                local.free_list[index] = block->next;
+                block->next = cache.lists[index];
+                cache.lists[index] = block;
+                ++cache.counts[index];
+            }
+            while (cache.counts[index] < wanted) {
+                if (static_cast<size_t>(local.end_free - local.start_free) < bytes) {
+                    grow(local, cache.node);
+                }
+                _numa_block *block = reinterpret_cast<_numa_block *>(local.start_free);
+                local.start_free += bytes;
+                block->next = cache.lists[index];
+                cache.lists[index] = block;
+                ++cache.counts[index];
+            }
+        }
+
+        /**
+         * 归还线程缓存中某个分类的 count 个 block，每个 block 回到所在节点的 arena
+         */
+        static void drain(_thread_cache &cache, size_t index, size_t count) {
+            while (count-- != 0 && cache.lists[index] != nullptr) {
+                _numa_block *block = cache.lists[index];
+                cache.lists[index] = block->next;
+                --cache.counts[index];
+                _numa_arena &home = arena(node_of(block));
+                std::lock_guard<std::mutex> lock(home.mutex);
+                block->next = home.free_list[index];
+                home.free_list[index] = block;
+            }
+        }
+
+        /**
+         * 为 arena 申请新的 chunk，剩余不足一个 block 的内存直接丢弃；调用时已经持有 arena 的锁
+         */
+        static void grow(_numa_arena &target, size_t node) {
+            // 多申请一个 chunk 的空间，再裁掉首尾，保证按 NUMA_CHUNK_BYTES 对齐
+            size_t mapped = 2 * NUMA_CHUNK_BYTES;
+            void *raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (begin + NUMA_CHUNK_BYTES - 1) & ~(static_cast<uintptr_t>(NUMA_CHUNK_BYTES) - 1);
+            if (aligned != begin) {
+                munmap(raw, aligned - begin);
+            }
+            uintptr_t tail = aligned + NUMA_CHUNK_BYTES;
+            if (tail != begin + mapped) {
+                munmap(reinterpret_cast<void *>(tail), begin + mapped - tail);
+            }
+            char *chunk = reinterpret_cast<char *>(aligned);
+            bind(chunk, node);
+
+            _numa_chunk *header = reinterpret_cast<_numa_chunk *>(chunk);
+            header->node = node;
+            header->next = target.chunks;
+            target.chunks = header;
+            ++target.chunk_count;
+            target.start_free = chunk + sizeof(_numa_chunk);
+            target.end_free = chunk + NUMA_CHUNK_BYTES;
+        }
+
+        /**
+         * 真实的多节点拓扑上把 chunk 绑定到 node，失败时（例如容器中禁用了 mbind）退回 first touch
+         */
+        static void bind(char *chunk, size_t node) {
+            numa_topology &topology = numa_topology::instance();
+            if (topology.is_fake() || topology.node_count() < 2) {
+                return;
+            }
+            unsigned long mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {};
+            mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+            syscall(SYS_mbind, chunk, NUMA_CHUNK_BYTES, NUMA_MPOL_PREFERRED, mask, NUMA_MAX_NODES + 1, 0);
+        }
+    };
+}
+
+#endif //MICROSTL_NUMA_POOL_H
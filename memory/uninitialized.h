@@ -15,7 +15,7 @@ namespace MicroSTL {
     _uninitialized_fill_n_aux(ForwardIterator first, Size size, T &obj, false_type) {
         ForwardIterator current = first;
         for (; size > 0; --size, ++current) {
-            construct(&*current, obj);
+            MicroSTL::construct(&*current, obj);
         }
         return current;
     }
@@ -31,7 +31,7 @@ namespace MicroSTL {
     template<typename ForwardIterator, typename Size, typename T>
     inline ForwardIterator
     _uninitialized_fill_n_aux(ForwardIterator first, Size size, T &obj, true_type) {
-        return fill_n(first, size, obj);
+        return MicroSTL::fill_n(first, size, obj);
     }
 
     template<typename ForwardIterator, typename Size, typename T>
@@ -46,7 +46,7 @@ namespace MicroSTL {
     template<typename InputIterator, typename ForwardIterator>
     inline ForwardIterator
     _uninitialized_copy_aux(InputIterator first, InputIterator last, ForwardIterator result, true_type) {
-        return copy(first, last, result);
+        return MicroSTL::copy(first, last, result);
     }
 
     template<typename InputIterator, typename ForwardIterator>
@@ -54,7 +54,7 @@ namespace MicroSTL {
     _uninitialized_copy_aux(InputIterator first, InputIterator last, ForwardIterator result, false_type) {
         ForwardIterator current = result;
         for (; first != last; ++first, ++current) {
-            construct(&*current, *first);
+            MicroSTL::construct(&*current, *first);
         }
         return current;
     }
@@ -74,13 +74,17 @@ namespace MicroSTL {
 
     // 针对 char* 的重载
     inline char *uninitialized_copy(const char *first, const char *last, char *result) {
-        memmove(result, first, last - first);
+        if (first != last) {
+            memmove(result, first, last - first);
+        }
         return result + (last - first);
     }
 
     // 针对 wchar_t* 的重载
     inline wchar_t *uninitialized_copy(const wchar_t *first, const wchar_t *last, wchar_t *result) {
-        memmove(result, first, sizeof(wchar_t) * (last - first));
+        if (first != last) {
+            memmove(result, first, sizeof(wchar_t) * (last - first));
+        }
         return result + (last - first);
     }
 
@@ -89,22 +93,21 @@ namespace MicroSTL {
     template<typename ForwardIterator, typename T>
     inline void
     _uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, T &obj, true_type) {
-        return fill(first, last, obj);
+        return MicroSTL::fill(first, last, obj);
     }
 
     template<typename ForwardIterator, typename T>
     inline void
     _uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, T &obj, false_type) {
-        ForwardIterator current = first;
         for (; first != last; ++first) {
-            construct(&*current, obj);
+            MicroSTL::construct(&*first, obj);
         }
     }
 
-    template<typename ForwardIterator, typename T>
+    template<typename ForwardIterator, typename T, typename T1>
     inline void
-    _uninitialized_fill(ForwardIterator first, ForwardIterator last, T &obj, T *) {
-        using is_POD = typename type_traits<T>::is_POD_type;
+    _uninitialized_fill(ForwardIterator first, ForwardIterator last, T &obj, T1 *) {
+        using is_POD = typename type_traits<T1>::is_POD_type;
         return _uninitialized_fill_aux(first, last, obj, is_POD());
     }
 
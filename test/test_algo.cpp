@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "../algorithm/algo.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+// 生成各种模式的输入
+std::vector<int> make_input(size_t size, int pattern) {
+    std::mt19937 rng(size + pattern);
+    std::vector<int> result(size);
+    for (size_t i = 0; i < size; i++) {
+        switch (pattern) {
+            case 0:
+                result[i] = static_cast<int>(rng());
+                break;
+            case 1:
+                result[i] = static_cast<int>(i);
+                break;
+            case 2:
+                result[i] = static_cast<int>(size - i);
+                break;
+            case 3:
+                result[i] = static_cast<int>(rng() % 4);
+                break;
+            default:
+                // 管风琴形状
+                result[i] = static_cast<int>(i < size / 2 ? i : size - i);
+        }
+    }
+    return result;
+}
+
+TEST(sort, patterns) {
+    for (size_t size: {0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 10000, 100000}) {
+        for (int pattern = 0; pattern < 5; pattern++) {
+            std::vector<int> data = make_input(size, pattern);
+            std::vector<int> expected = data;
+            std::sort(expected.begin(), expected.end());
+            MicroSTL::sort(data.begin(), data.end());
+            EXPECT_EQ(data, expected) << "size " << size << " pattern " << pattern;
+        }
+    }
+}
+
+TEST(sort, vector) {
+    MicroSTL::vector<double> vec;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 5000; i++) {
+        vec.push_back(static_cast<double>(rng()) / 7.0);
+    }
+    MicroSTL::sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(sort, comparator) {
+    std::vector<int> data = make_input(5000, 0);
+    MicroSTL::sort(data.begin(), data.end(), greater<int>());
+    EXPECT_TRUE(std::is_sorted(data.begin(), data.end(), std::greater<int>()));
+
+    // 非默认比较器走普通划分
+    std::vector<int> mod = make_input(5000, 0);
+    auto by_mod = [](int a, int b) { return (a & 0xff) < (b & 0xff); };
+    MicroSTL::sort(mod.begin(), mod.end(), by_mod);
+    EXPECT_TRUE(std::is_sorted(mod.begin(), mod.end(), by_mod));
+}
+
+TEST(sort, string) {
+    std::mt19937 rng(7);
+    std::vector<std::string> data;
+    for (int i = 0; i < 3000; i++) {
+        data.push_back(std::to_string(rng() % 500));
+    }
+    std::vector<std::string> expected = data;
+    std::sort(expected.begin(), expected.end());
+    MicroSTL::sort(data.begin(), data.end());
+    EXPECT_EQ(data, expected);
+}
+
+TEST(sort, killer_input_falls_back_to_heap_sort) {
+    // 大量相等元素与交错的有序段，容易让简单的快排退化
+    std::vector<int> data;
+    for (int i = 0; i < 50000; i++) {
+        data.push_back(i % 2 == 0 ? i : 50000 - i);
+    }
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    MicroSTL::sort(data.begin(), data.end());
+    EXPECT_EQ(data, expected);
+}
+
+TEST(stable_sort, stability) {
+    struct item {
+        int key;
+        int order;
+    };
+    std::mt19937 rng(3);
+    std::vector<item> data;
+    for (int i = 0; i < 10000; i++) {
+        data.push_back({static_cast<int>(rng() % 16), i});
+    }
+    MicroSTL::stable_sort(data.begin(), data.end(), [](const item &a, const item &b) { return a.key < b.key; });
+    for (size_t i = 1; i < data.size(); i++) {
+        ASSERT_LE(data[i - 1].key, data[i].key);
+        if (data[i - 1].key == data[i].key) {
+            ASSERT_LT(data[i - 1].order, data[i].order);
+        }
+    }
+}
+
+TEST(stable_sort, patterns) {
+    for (size_t size: {0, 1, 31, 32, 33, 1000, 10001}) {
+        for (int pattern = 0; pattern < 5; pattern++) {
+            std::vector<int> data = make_input(size, pattern);
+            std::vector<int> expected = data;
+            std::sort(expected.begin(), expected.end());
+            MicroSTL::stable_sort(data.begin(), data.end());
+            EXPECT_EQ(data, expected);
+        }
+    }
+}
+
+TEST(partial_sort, base) {
+    std::vector<int> data = make_input(10000, 0);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    MicroSTL::partial_sort(data.begin(), data.begin() + 100, data.end());
+    EXPECT_TRUE(std::equal(data.begin(), data.begin() + 100, expected.begin()));
+
+    std::vector<int> small = {3, 1, 2};
+    MicroSTL::partial_sort(small.begin(), small.end(), small.end());
+    EXPECT_EQ(small, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(nth_element, base) {
+    for (int pattern = 0; pattern < 5; pattern++) {
+        std::vector<int> data = make_input(20000, pattern);
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end());
+        for (size_t nth: {size_t(0), size_t(1), size_t(777), size_t(10000), size_t(19999)}) {
+            std::vector<int> copy = data;
+            MicroSTL::nth_element(copy.begin(), copy.begin() + nth, copy.end());
+            ASSERT_EQ(copy[nth], expected[nth]);
+            for (size_t i = 0; i < nth; i++) {
+                ASSERT_LE(copy[i], copy[nth]);
+            }
+            for (size_t i = nth + 1; i < copy.size(); i++) {
+                ASSERT_GE(copy[i], copy[nth]);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
 #include "../algorithm/algobase.h"
+#include "../functor/functional.h"
+#include "../container/vector.h"
 
 using namespace MicroSTL;
 
@@ -7,6 +13,158 @@ TEST(示例, 测试相等) {
     EXPECT_EQ(1, 1);
 }
 
+// 各种长度下与朴素实现比较，覆盖向量部分与尾部
+template<typename T>
+void check_find_count(uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    for (size_t size = 0; size < 200; size++) {
+        MicroSTL::vector<T> vec;
+        for (size_t i = 0; i < size; i++) {
+            vec.push_back(static_cast<T>(rng() % 7));
+        }
+        // 直接在原生指针上测试，覆盖 SIMD 的路径
+        T *first = vec.data();
+        T *last = first + vec.size();
+        for (int target = 0; target < 8; target++) {
+            T value = static_cast<T>(target);
+            T *expected_pos = last;
+            ptrdiff_t expected_count = 0;
+            for (T *iter = first; iter != last; ++iter) {
+                if (*iter == value) {
+                    if (expected_pos == last) {
+                        expected_pos = iter;
+                    }
+                    ++expected_count;
+                }
+            }
+            ASSERT_EQ(MicroSTL::find(first, last, value), expected_pos);
+            ASSERT_EQ(MicroSTL::count(first, last, value), expected_count);
+        }
+    }
+}
+
+TEST(find, simd_types) {
+    check_find_count<char>(1);
+    check_find_count<unsigned char>(2);
+    check_find_count<short>(3);
+    check_find_count<int>(4);
+    check_find_count<unsigned int>(5);
+    check_find_count<long long>(6);
+    check_find_count<uint64_t>(7);
+}
+
+TEST(find, value_not_representable) {
+    char buffer[] = "hello, world";
+    // 375 截断为 char 后等于 'w'，但它无法由 char 表示，不应该找到
+    EXPECT_EQ(MicroSTL::find(buffer, buffer + 12, 375), buffer + 12);
+    EXPECT_EQ(MicroSTL::find(buffer, buffer + 12, 'w'), buffer + 7);
+    EXPECT_EQ(MicroSTL::find(buffer, buffer + 12, static_cast<int>('w')), buffer + 7);
+}
+
+TEST(find, generic_iterators) {
+    std::string strings[] = {"a", "b", "c", "d", "e"};
+    EXPECT_EQ(MicroSTL::find(strings, strings + 5, std::string("d")), strings + 3);
+    EXPECT_EQ(MicroSTL::find(strings, strings + 5, std::string("f")), strings + 5);
+    EXPECT_EQ(MicroSTL::count(strings, strings + 5, std::string("a")), 1);
+
+    double values[] = {1.0, -0.0, 2.0};
+    // 浮点数不能按字节比较：-0.0 == 0.0
+    EXPECT_EQ(MicroSTL::find(values, values + 3, 0.0), values + 1);
+    EXPECT_EQ(MicroSTL::count(values, values + 3, 0.0), 1);
+}
+
+TEST(find_if, base) {
+    int values[] = {1, 3, 5, 6, 7};
+    EXPECT_EQ(MicroSTL::find_if(values, values + 5, [](int v) { return v % 2 == 0; }), values + 3);
+    EXPECT_EQ(MicroSTL::find_if(values, values + 5, [](int v) { return v > 10; }), values + 5);
+    EXPECT_EQ(MicroSTL::count_if(values, values + 5, [](int v) { return v > 2; }), 4);
+}
+
+TEST(mismatch, base) {
+    for (size_t size = 0; size < 150; size++) {
+        MicroSTL::vector<int> a;
+        for (size_t i = 0; i < size; i++) {
+            a.push_back(static_cast<int>(i));
+        }
+        for (size_t diff = 0; diff <= size; diff++) {
+            MicroSTL::vector<int> b;
+            for (size_t i = 0; i < size; i++) {
+                b.push_back(a[i]);
+            }
+            if (diff < size) {
+                b[diff] = -1;
+            }
+            pair<int *, int *> result = MicroSTL::mismatch(a.data(), a.data() + size, b.data());
+            ASSERT_EQ(result.first, a.data() + diff);
+            ASSERT_EQ(result.second, b.data() + diff);
+            ASSERT_EQ(MicroSTL::equal(a.data(), a.data() + size, b.data()), diff == size);
+        }
+    }
+}
+
+TEST(equal, predicate) {
+    std::string a = "Hello";
+    std::string b = "hELLO";
+    auto ignore_case = [](char x, char y) { return tolower(x) == tolower(y); };
+    EXPECT_TRUE(MicroSTL::equal(a.begin(), a.end(), b.begin(), ignore_case));
+    EXPECT_FALSE(MicroSTL::equal(a.begin(), a.end(), b.begin()));
+}
+
+TEST(lexicographical_compare, base) {
+    const unsigned char a[] = {1, 2, 3, 200};
+    const unsigned char b[] = {1, 2, 3, 4, 5};
+    EXPECT_FALSE(MicroSTL::lexicographical_compare(a, a + 4, b, b + 5));
+    EXPECT_TRUE(MicroSTL::lexicographical_compare(a, a + 3, b, b + 5));
+    EXPECT_FALSE(MicroSTL::lexicographical_compare(b, b + 3, a, a + 3));
+
+    // 有符号整数：不能按字节比较大小
+    const int c[] = {1, -1, 0};
+    const int d[] = {1, 1, 0};
+    EXPECT_TRUE(MicroSTL::lexicographical_compare(c, c + 3, d, d + 3));
+    EXPECT_FALSE(MicroSTL::lexicographical_compare(d, d + 3, c, c + 3));
+
+    const char e[] = "abc";
+    const char f[] = "abd";
+    EXPECT_TRUE(MicroSTL::lexicographical_compare(e, e + 3, f, f + 3));
+    EXPECT_TRUE(MicroSTL::lexicographical_compare(f, f + 3, e, e + 3, greater<char>()));
+}
+
+#ifdef MICROSTL_SIMD_X86
+
+// 支持 AVX2 的机器上不会走到 SSE2 内核，直接调用以覆盖
+TEST(simd, sse2_kernels) {
+    std::mt19937 rng(9);
+    std::vector<int> a(1000);
+    std::vector<short> s(1000);
+    std::vector<long long> l(1000);
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = static_cast<int>(rng() % 50);
+        s[i] = static_cast<short>(a[i]);
+        l[i] = a[i];
+    }
+    for (int value = 0; value < 50; value++) {
+        ASSERT_EQ(_sse2_find(a.data(), a.data() + a.size(), value), _scalar_find(a.data(), a.data() + a.size(), value));
+        ASSERT_EQ(_sse2_count(s.data(), s.data() + s.size(), static_cast<short>(value)),
+                  _scalar_count(s.data(), s.data() + s.size(), static_cast<short>(value)));
+        ASSERT_EQ(_sse2_find(l.data(), l.data() + l.size(), static_cast<long long>(value)),
+                  _scalar_find(l.data(), l.data() + l.size(), static_cast<long long>(value)));
+    }
+    std::vector<int> b = a;
+    b[777] = -1;
+    EXPECT_EQ(_sse2_mismatch_bytes(reinterpret_cast<const unsigned char *>(a.data()),
+                                   reinterpret_cast<const unsigned char *>(b.data()), a.size() * sizeof(int)) / 4, 777);
+}
+
+#endif
+
+TEST(cpu_features, detect) {
+    const cpu_features &features = get_cpu_features();
+#if defined(__x86_64__)
+    EXPECT_TRUE(features.sse2);
+#endif
+    EXPECT_EQ(&features, &get_cpu_features());
+}
+
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
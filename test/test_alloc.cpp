@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <utility>
+#include <vector>
 #include "../memory/alloc.h"
+#include "../memory/node_pool.h"
 
 using namespace MicroSTL;
 
@@ -47,6 +50,10 @@ TEST(AllocByMalloc, set_oom_user_handler) {
 AllocByFreeList alloc;
 
 TEST(AllocByFreeList, allocate) {
+#ifdef MICROSTL_ALLOC_DEBUG
+    // 调试模式下相邻的 block 之间隔着尾部 canary 与下一个 block 的头部，越界写入不会落到下一个 block 上
+    GTEST_SKIP() << "block layout differs in MICROSTL_ALLOC_DEBUG mode";
+#endif
     char *ptr1 = static_cast<char *>(alloc.allocate(8));
     char *ptr2 = static_cast<char *>(alloc.allocate(8));
     strcpy(ptr1, "aaaaaaaaAaaaaa");
@@ -64,6 +71,75 @@ TEST(AllocByFreeList, deallocate) {
     EXPECT_NE(ptr_first_char, 'b');
 }
 
+TEST(AllocByFreeList, natural_alignment) {
+    // 交替申请不同大小，让内存池的起点经常不满足下一个分类的对齐
+    std::vector<std::pair<void *, size_t>> blocks;
+    for (int round = 0; round < 50; round++) {
+        for (size_t size = 8; size <= 128; size += 8) {
+            void *ptr = AllocByFreeList::allocate(size);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % AllocByFreeList::natural_alignment(size), 0) << size;
+            blocks.emplace_back(ptr, size);
+        }
+    }
+    EXPECT_EQ(AllocByFreeList::natural_alignment(24), 8);
+    EXPECT_EQ(AllocByFreeList::natural_alignment(48), 16);
+    EXPECT_EQ(AllocByFreeList::natural_alignment(128), 64);
+    for (auto &item: blocks) {
+        AllocByFreeList::deallocate(item.first, item.second);
+    }
+}
+
+TEST(AllocByFreeList, aligned_allocate) {
+    for (size_t alignment = 8; alignment <= 4096; alignment *= 2) {
+        for (size_t size: {1, 24, 64, 100, 128, 129, 1000, 5000}) {
+            char *ptr = static_cast<char *>(AllocByFreeList::aligned_allocate(size, alignment));
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0) << size << " " << alignment;
+            memset(ptr, 1, size);
+            AllocByFreeList::aligned_deallocate(ptr, size, alignment);
+        }
+    }
+}
+
+TEST(Alloc, over_aligned) {
+    struct alignas(64) line {
+        char bytes[64];
+    };
+    struct alignas(256) page {
+        char bytes[256];
+    };
+    for (size_t n = 1; n <= 4; n++) {
+        line *lines = Alloc<line>::allocate(n);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(lines) % 64, 0);
+        Alloc<line>::deallocate(lines, n);
+        page *pages = Alloc<page>::allocate(n);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(pages) % 256, 0);
+        Alloc<page>::deallocate(pages, n);
+    }
+}
+
+TEST(node_pool, allocate_and_reuse) {
+    struct node {
+        node *next;
+        long value[3];
+    };
+    node_pool<node> pool;
+    node *nodes[100];
+    for (auto &item : nodes) {
+        item = pool.allocate();
+        item->value[0] = 1;
+    }
+    // 同一个 slab 内的节点连续
+    EXPECT_EQ(nodes[1], nodes[0] + 1);
+    pool.deallocate(nodes[42]);
+    EXPECT_EQ(pool.allocate(), nodes[42]);
+
+    node_pool<node> other;
+    other.swap(pool);
+    EXPECT_EQ(other.allocate(), nodes[99] + 1);
+    other.release();
+    EXPECT_TRUE(other.allocate() != nullptr);
+}
+
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
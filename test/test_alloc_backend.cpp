@@ -0,0 +1,94 @@
+#undef MICROSTL_ALLOC_BACKEND
+#define MICROSTL_ALLOC_BACKEND MICROSTL_ALLOC_BACKEND_NUMA
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <type_traits>
+#include "../container/list.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+// 在单节点的机器上用虚拟拓扑测试，每个用例结束时恢复
+class alloc_backend_numa : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(numa_topology::instance().set_fake("0;1"));
+    }
+
+    void TearDown() override {
+        AllocByNuma::flush_thread_cache();
+        numa_bind_thread(-1);
+        numa_topology::instance().reset();
+    }
+};
+
+TEST_F(alloc_backend_numa, selected_by_macro) {
+    EXPECT_TRUE((std::is_same<alloc_backend, AllocByNuma>::value));
+    // 仍然可以显式指定其他后端
+    int *ptr = Alloc<int, AllocByFreeList>::allocate(4);
+    ptr[3] = 1;
+    Alloc<int, AllocByFreeList>::deallocate(ptr, 4);
+}
+
+TEST_F(alloc_backend_numa, containers_use_local_node) {
+    for (int node = 0; node < 2; node++) {
+        numa_bind_thread(node);
+        list<int> values;
+        for (int i = 0; i < 100; i++) {
+            values.push_back(i);
+        }
+        for (int &value: values) {
+            EXPECT_EQ(AllocByNuma::node_of(&value), static_cast<size_t>(node));
+        }
+        // 不超过 MAX_BYTES 的存储同样来自本节点
+        vector<int> small;
+        small.reserve(16);
+        small.push_back(node);
+        EXPECT_EQ(AllocByNuma::node_of(small.data()), static_cast<size_t>(node));
+    }
+}
+
+TEST_F(alloc_backend_numa, over_aligned_elements) {
+    struct alignas(32) wide {
+        double value[4];
+    };
+    vector<wide> vec;
+    for (int i = 0; i < 10; i++) {
+        vec.push_back(wide{{double(i), 0, 0, 0}});
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.data()) % 32, 0);
+    }
+    EXPECT_EQ(vec[9].value[0], 9);
+}
+
+TEST_F(alloc_backend_numa, containers_in_threads) {
+    // AllocByFreeList 不能在多个线程中同时使用，AllocByNuma 可以
+    std::thread threads[4];
+    bool local[4] = {};
+    for (int t = 0; t < 4; t++) {
+        threads[t] = std::thread([t, &local] {
+            numa_bind_thread(t % 2);
+            bool all_local = true;
+            for (int round = 0; round < 20; round++) {
+                list<int> values;
+                for (int i = 0; i < 500; i++) {
+                    values.push_back(i);
+                }
+                all_local = all_local && AllocByNuma::node_of(&values.front()) == static_cast<size_t>(t % 2);
+                values.sort();
+            }
+            local[t] = all_local;
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    for (bool all_local: local) {
+        EXPECT_TRUE(all_local);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+#undef MICROSTL_ALLOC_DEBUG
+#define MICROSTL_ALLOC_DEBUG
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include "../memory/alloc.h"
+#include "../container/vector.h"
+#include "../container/list.h"
+
+using namespace MicroSTL;
+
+TEST(alloc_debug, fill_patterns) {
+    unsigned char *ptr = static_cast<unsigned char *>(AllocByFreeList::allocate(13));
+    for (int i = 0; i < 13; i++) {
+        EXPECT_EQ(ptr[i], ALLOC_DEBUG_FRESH);
+    }
+    memset(ptr, 1, 13);
+    AllocByFreeList::deallocate(ptr, 13);
+    AllocByFreeList::debug_flush_quarantine();
+}
+
+TEST(alloc_debug, reuse_is_delayed) {
+    void *first = AllocByFreeList::allocate(24);
+    AllocByFreeList::deallocate(first, 24);
+    // 隔离区中的 block 不会立即被复用
+    void *second = AllocByFreeList::allocate(24);
+    EXPECT_NE(first, second);
+    AllocByFreeList::deallocate(second, 24);
+    AllocByFreeList::debug_flush_quarantine();
+}
+
+TEST(alloc_debug, large_blocks) {
+    char *ptr = static_cast<char *>(AllocByFreeList::allocate(1000));
+    memset(ptr, 'x', 1000);
+    void *copy = AllocByFreeList::reallocate(ptr, 1000, 2000);
+    EXPECT_EQ(static_cast<char *>(copy)[999], 'x');
+    AllocByFreeList::deallocate(copy, 2000);
+    AllocByFreeList::debug_flush_quarantine();
+}
+
+TEST(alloc_debug, alignment) {
+    // 头部不影响 block 的自然对齐
+    for (size_t size = 8; size <= 128; size += 8) {
+        void *ptr = AllocByFreeList::allocate(size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % AllocByFreeList::natural_alignment(size), 0) << size;
+        AllocByFreeList::deallocate(ptr, size);
+    }
+    void *ptr = AllocByFreeList::aligned_allocate(40, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0);
+    AllocByFreeList::aligned_deallocate(ptr, 40, 64);
+    AllocByFreeList::debug_flush_quarantine();
+}
+
+TEST(alloc_debug, outstanding) {
+    size_t before = AllocByFreeList::debug_outstanding();
+    void *a = AllocByFreeList::allocate(8);
+    void *b = AllocByFreeList::allocate(300);
+    EXPECT_EQ(AllocByFreeList::debug_outstanding(), before + 2);
+
+    FILE *out = tmpfile();
+    AllocByFreeList::debug_report(out);
+    rewind(out);
+    std::string report;
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), out) != nullptr) {
+        report += buffer;
+    }
+    fclose(out);
+    EXPECT_NE(report.find("not freed"), std::string::npos);
+    EXPECT_NE(report.find("size class 8:"), std::string::npos);
+    EXPECT_NE(report.find("size class > 128:"), std::string::npos);
+
+    AllocByFreeList::deallocate(a, 8);
+    AllocByFreeList::deallocate(b, 300);
+    EXPECT_EQ(AllocByFreeList::debug_outstanding(), before);
+}
+
+TEST(alloc_debug, containers) {
+    size_t before = AllocByFreeList::debug_outstanding();
+    {
+        vector<int> vec;
+        for (int i = 0; i < 100; i++) {
+            vec.push_back(i);
+        }
+        vec.erase(vec.begin(), vec.begin() + 50);
+        list<std::string> lst;
+        for (int i = 0; i < 100; i++) {
+            lst.push_back(std::to_string(i));
+        }
+        lst.sort();
+        EXPECT_EQ(vec.size(), 50);
+        EXPECT_EQ(lst.size(), 100);
+    }
+    EXPECT_EQ(AllocByFreeList::debug_outstanding(), before);
+}
+
+TEST(alloc_debug_death, double_free) {
+    EXPECT_DEATH({
+        void *ptr = AllocByFreeList::allocate(16);
+        AllocByFreeList::deallocate(ptr, 16);
+        AllocByFreeList::deallocate(ptr, 16);
+    }, "double free");
+}
+
+TEST(alloc_debug_death, size_mismatch) {
+    EXPECT_DEATH({
+        void *ptr = AllocByFreeList::allocate(16);
+        AllocByFreeList::deallocate(ptr, 32);
+    }, "size does not match");
+}
+
+// 使用 AddressSanitizer 编译时，越界与释放后写入在发生时就会被 ASan 报告
+TEST(alloc_debug_death, overflow) {
+    EXPECT_DEATH({
+        char *ptr = static_cast<char *>(AllocByFreeList::allocate(10));
+        // 写入对齐填充
+        ptr[10] = 0;
+        AllocByFreeList::deallocate(ptr, 10);
+    }, "buffer overflow|use-after-poison");
+    EXPECT_DEATH({
+        char *ptr = static_cast<char *>(AllocByFreeList::allocate(200));
+        ptr[200] = 0;
+        AllocByFreeList::deallocate(ptr, 200);
+    }, "buffer overflow|use-after-poison");
+}
+
+TEST(alloc_debug_death, write_after_free) {
+    EXPECT_DEATH({
+        char *ptr = static_cast<char *>(AllocByFreeList::allocate(32));
+        AllocByFreeList::deallocate(ptr, 32);
+        ptr[3] = 1;
+        AllocByFreeList::debug_flush_quarantine();
+    }, "written after free|use-after-poison");
+}
+
+TEST(alloc_debug_death, invalid_pointer) {
+    EXPECT_DEATH({
+        char *ptr = static_cast<char *>(AllocByFreeList::allocate(64));
+        AllocByFreeList::deallocate(ptr + 8, 56);
+    }, "invalid pointer");
+}
+
+TEST(alloc_debug_death, leak_report) {
+    EXPECT_DEATH({
+        AllocByFreeList::allocate(40);
+        AllocByFreeList::debug_report(stderr);
+        abort();
+    }, "size class 40: 1 blocks, 40 bytes");
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "../container/btree.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+using int_btree = btree<int, int, identity<int>, less<int>>;
+// 节点只能放 4 个元素，几百个元素就有多层，容易覆盖分裂、借用与合并的各种情况
+using small_btree = btree<int, int, identity<int>, less<int>, 32>;
+using string_btree = btree<std::string, std::string, identity<std::string>, less<std::string>, 128>;
+
+template<typename Tree>
+void expect_same(const Tree &tree, const std::set<typename Tree::key_type> &expected) {
+    EXPECT_TRUE(tree.verify());
+    EXPECT_EQ(tree.size(), expected.size());
+    auto iter = tree.begin();
+    for (auto &value : expected) {
+        EXPECT_EQ(*iter, value);
+        ++iter;
+    }
+    EXPECT_TRUE(iter == tree.end());
+}
+
+TEST(btree, capacity) {
+    EXPECT_EQ(small_btree::LEAF_CAPACITY, 4);
+    EXPECT_EQ(small_btree::INTERNAL_CAPACITY, 4);
+    EXPECT_GE(int_btree::LEAF_CAPACITY, 50);
+}
+
+TEST(btree, insert_random) {
+    small_btree tree;
+    std::set<int> expected;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 5000; i++) {
+        int value = static_cast<int>(rng() % 3000);
+        EXPECT_EQ(tree.insert_unique(value).second, expected.insert(value).second);
+        if (i % 500 == 0) {
+            EXPECT_TRUE(tree.verify());
+        }
+    }
+    expect_same(tree, expected);
+    EXPECT_GE(tree.height(), 5);
+}
+
+TEST(btree, erase_random) {
+    small_btree tree;
+    std::set<int> expected;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 3000; i++) {
+        int value = static_cast<int>(rng() % 2000);
+        tree.insert_unique(value);
+        expected.insert(value);
+    }
+    for (int i = 0; i < 3000; i++) {
+        int value = static_cast<int>(rng() % 2000);
+        EXPECT_EQ(tree.erase(value), expected.erase(value));
+        if (i % 300 == 0) {
+            EXPECT_TRUE(tree.verify());
+        }
+    }
+    expect_same(tree, expected);
+    while (!tree.empty()) {
+        tree.erase(tree.begin());
+        ASSERT_TRUE(tree.verify());
+    }
+    EXPECT_EQ(tree.memory_usage(), 0);
+    EXPECT_TRUE(tree.begin() == tree.end());
+}
+
+TEST(btree, mixed_operations) {
+    small_btree tree;
+    std::set<int> expected;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 20000; i++) {
+        int value = static_cast<int>(rng() % 500);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(tree.erase(value), expected.erase(value));
+        } else {
+            EXPECT_EQ(tree.insert_unique(value).second, expected.insert(value).second);
+        }
+    }
+    expect_same(tree, expected);
+}
+
+TEST(btree, iterate_backward) {
+    small_btree tree;
+    for (int i = 0; i < 200; i++) {
+        tree.insert_unique(i);
+    }
+    auto iter = tree.end();
+    for (int i = 199; i >= 0; i--) {
+        EXPECT_EQ(*--iter, i);
+    }
+    EXPECT_TRUE(iter == tree.begin());
+}
+
+TEST(btree, bounds) {
+    small_btree tree;
+    for (int i = 0; i < 100; i++) {
+        tree.insert_unique(i * 10);
+    }
+    EXPECT_EQ(*tree.lower_bound(15), 20);
+    EXPECT_EQ(*tree.lower_bound(20), 20);
+    EXPECT_EQ(*tree.upper_bound(20), 30);
+    EXPECT_EQ(*tree.lower_bound(-5), 0);
+    EXPECT_TRUE(tree.lower_bound(991) == tree.end());
+    EXPECT_TRUE(tree.upper_bound(990) == tree.end());
+    EXPECT_TRUE(tree.find(15) == tree.end());
+    EXPECT_EQ(tree.count(40), 1);
+    // 每个叶子末尾之后的位置都应该规范化到下一个叶子的开头
+    for (int i = 0; i < 99; i++) {
+        EXPECT_EQ(*tree.upper_bound(i * 10), (i + 1) * 10);
+        EXPECT_EQ(*tree.lower_bound(i * 10 + 1), (i + 1) * 10);
+    }
+}
+
+TEST(btree, append_fills_nodes) {
+    small_btree hinted;
+    small_btree random;
+    vector<int> values;
+    for (int i = 0; i < 1000; i++) {
+        hinted.insert_unique(hinted.end(), i);
+        random.insert_unique(i * 7 % 1000);
+        values.push_back(i);
+    }
+    small_btree bulk;
+    bulk.insert_unique(values.begin(), values.end());
+    EXPECT_TRUE(hinted.verify());
+    EXPECT_TRUE(bulk.verify());
+    // 顺序追加时节点几乎全满，与直接建树相差无几
+    EXPECT_LE(hinted.memory_usage(), bulk.memory_usage() * 11 / 10);
+    EXPECT_LT(hinted.memory_usage(), random.memory_usage());
+}
+
+TEST(btree, build_from_sorted) {
+    for (int size = 0; size < 400; size += 7) {
+        vector<int> values;
+        for (int i = 0; i < size; i++) {
+            values.push_back(i * 2);
+        }
+        small_btree tree;
+        tree.insert_unique(values.begin(), values.end());
+        std::set<int> expected(values.begin(), values.end());
+        expect_same(tree, expected);
+        // 建好的树可以继续插入和删除
+        for (int i = 0; i < size; i += 3) {
+            tree.insert_unique(i * 2 + 1);
+            expected.insert(i * 2 + 1);
+            tree.erase(i * 2);
+            expected.erase(i * 2);
+        }
+        expect_same(tree, expected);
+    }
+
+    int unsorted[] = {5, 3, 9, 1, 3};
+    small_btree tree;
+    tree.insert_unique(unsorted, unsorted + 5);
+    expect_same(tree, std::set<int>{1, 3, 5, 9});
+}
+
+TEST(btree, string_keys) {
+    string_btree tree;
+    std::set<std::string> expected;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 3000; i++) {
+        std::string value = "key-" + std::to_string(rng() % 1500);
+        if (i % 4 == 3) {
+            EXPECT_EQ(tree.erase(value), expected.erase(value));
+        } else {
+            tree.insert_unique(value);
+            expected.insert(value);
+        }
+    }
+    expect_same(tree, expected);
+}
+
+TEST(btree, copy_move_swap) {
+    string_btree tree;
+    for (int i = 0; i < 500; i++) {
+        tree.insert_unique(std::to_string(i));
+    }
+    auto copy = tree;
+    EXPECT_TRUE(copy.verify());
+    EXPECT_EQ(copy.size(), 500);
+    EXPECT_EQ(copy.memory_usage(), copy.memory_usage());
+    EXPECT_TRUE(copy.find("42") != copy.end());
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(moved.verify());
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(copy.verify());
+
+    string_btree other;
+    other.insert_unique("x");
+    other.swap(moved);
+    EXPECT_EQ(other.size(), 500);
+    EXPECT_EQ(moved.size(), 1);
+
+    copy = other;
+    EXPECT_EQ(copy.size(), 500);
+    copy.clear();
+    EXPECT_TRUE(copy.verify());
+    copy.insert_unique("after clear");
+    EXPECT_EQ(copy.size(), 1);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "../container/btree_map.h"
+#include "../container/btree_set.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(btree_map, insert_and_find) {
+    btree_map<int, std::string> m;
+    EXPECT_TRUE(m.insert(MicroSTL::make_pair(1, std::string("one"))).second);
+    EXPECT_FALSE(m.insert(MicroSTL::make_pair(1, std::string("uno"))).second);
+    EXPECT_TRUE(m.emplace(2, "two").second);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.find(1)->second, "one");
+    EXPECT_TRUE(m.find(3) == m.end());
+    EXPECT_TRUE(m.contains(2));
+    EXPECT_EQ(m.count(2), 1);
+}
+
+TEST(btree_map, subscript_and_at) {
+    btree_map<std::string, int> m;
+    m["a"] = 1;
+    m["b"] += 2;
+    m["a"] += 10;
+    EXPECT_EQ(m.at("a"), 11);
+    EXPECT_EQ(m.at("b"), 2);
+    EXPECT_THROW(m.at("c"), std::out_of_range);
+    EXPECT_EQ(m.size(), 2);
+}
+
+TEST(btree_map, ordered_iteration) {
+    btree_map<int, int> m;
+    std::map<int, int> expected;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 20000; i++) {
+        int k = static_cast<int>(rng() % 5000);
+        m[k] += i;
+        expected[k] += i;
+    }
+    EXPECT_EQ(m.size(), expected.size());
+    auto iter = m.begin();
+    for (auto &item : expected) {
+        EXPECT_EQ(iter->first, item.first);
+        EXPECT_EQ(iter->second, item.second);
+        ++iter;
+    }
+    for (int i = 0; i < 5000; i += 2) {
+        EXPECT_EQ(m.erase(i), expected.erase(i));
+    }
+    EXPECT_EQ(m.size(), expected.size());
+    EXPECT_EQ(m.begin()->first, expected.begin()->first);
+}
+
+TEST(btree_map, sorted_range_and_hint) {
+    vector<pair<int, int>> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(pair<int, int>(i, i * 3));
+    }
+    btree_map<int, int> m(values.begin(), values.end());
+    EXPECT_EQ(m.size(), 10000);
+    EXPECT_EQ(m.at(30), 90);
+    EXPECT_EQ(m.lower_bound(5000)->second, 15000);
+
+    btree_map<int, int> hinted;
+    for (int i = 0; i < 10000; i++) {
+        hinted.emplace_hint(hinted.end(), i, i);
+    }
+    EXPECT_EQ(hinted.size(), 10000);
+    EXPECT_EQ((--hinted.end())->first, 9999);
+    // 顺序构造的两种方式节点都接近全满
+    EXPECT_LE(hinted.memory_usage(), m.memory_usage() * 11 / 10);
+}
+
+TEST(btree_set, basic) {
+    btree_set<int> s;
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(s.insert(i * 7 % 1000).second);
+    }
+    EXPECT_FALSE(s.insert(5).second);
+    EXPECT_EQ(s.size(), 1000);
+    int expected = 0;
+    for (int value : s) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(*s.lower_bound(500), 500);
+    EXPECT_EQ(*s.upper_bound(500), 501);
+    EXPECT_EQ(s.erase(500), 1);
+    EXPECT_FALSE(s.contains(500));
+    s.erase(s.begin());
+    EXPECT_EQ(*s.begin(), 1);
+
+    btree_set<int> other;
+    other.swap(s);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(other.size(), 998);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../container/concurrent_unordered_map.h"
+#include "../memory/epoch.h"
+
+using namespace MicroSTL;
+
+TEST(concurrent_unordered_map, insert_find_and_assign) {
+    concurrent_unordered_map<int, std::string> m;
+    EXPECT_TRUE(m.insert(1, "one"));
+    EXPECT_FALSE(m.insert(1, "uno"));
+    std::string value;
+    EXPECT_TRUE(m.find(1, value));
+    EXPECT_EQ(value, "one");
+    EXPECT_FALSE(m.insert_or_assign(1, "uno"));
+    EXPECT_TRUE(m.insert_or_assign(2, "two"));
+    size_t length = 0;
+    EXPECT_TRUE(m.find(1, [&](const std::string &v) {
+        length = v.size();
+        value = v;
+    }));
+    EXPECT_EQ(value, "uno");
+    EXPECT_EQ(length, 3);
+    EXPECT_FALSE(m.find(3, value));
+    EXPECT_TRUE(m.contains(2));
+    EXPECT_EQ(m.size(), 2);
+}
+
+TEST(concurrent_unordered_map, update_and_erase) {
+    concurrent_unordered_map<std::string, long> m;
+    m.insert("hits", 0);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(m.update("hits", [](long &v) {
+            ++v;
+        }));
+    }
+    EXPECT_FALSE(m.update("misses", [](long &v) {
+        ++v;
+    }));
+    long hits = 0;
+    m.find("hits", hits);
+    EXPECT_EQ(hits, 100);
+    EXPECT_EQ(m.erase("hits"), 1);
+    EXPECT_EQ(m.erase("hits"), 0);
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(concurrent_unordered_map, grows_incrementally) {
+    concurrent_unordered_map<int, int> m;
+    size_t initial = m.bucket_count();
+    for (int i = 0; i < 100000; i++) {
+        ASSERT_TRUE(m.insert(i, i * 3));
+    }
+    EXPECT_GT(m.bucket_count(), initial);
+    EXPECT_EQ(m.size(), 100000);
+    for (int i = 0; i < 100000; i++) {
+        int value = -1;
+        ASSERT_TRUE(m.find(i, value));
+        ASSERT_EQ(value, i * 3);
+    }
+    long sum = 0;
+    size_t visited = 0;
+    m.for_each([&](const pair<const int, int> &kv) {
+        sum += kv.second;
+        ++visited;
+    });
+    EXPECT_EQ(visited, 100000);
+    EXPECT_EQ(sum, 3L * 99999 * 100000 / 2);
+    for (int i = 0; i < 100000; i += 2) {
+        ASSERT_EQ(m.erase(i), 1);
+    }
+    EXPECT_EQ(m.size(), 50000);
+}
+
+TEST(concurrent_unordered_map, readers_and_writers) {
+    const int writers = 4;
+    const int readers = 4;
+    const int per_writer = 20000;
+    concurrent_unordered_map<int, std::string> m;
+    std::atomic<bool> done(false);
+    std::atomic<long> mismatches(0);
+    std::thread threads[writers + readers];
+    for (int w = 0; w < writers; w++) {
+        threads[w] = std::thread([&, w] {
+            for (int i = 0; i < per_writer; i++) {
+                int k = w * per_writer + i;
+                m.insert_or_assign(k, std::to_string(k));
+                // 值始终是 key 的十进制表示，读者可以校验
+                if (i % 4 == 0) {
+                    m.insert_or_assign(k / 2, std::to_string(k / 2));
+                }
+                if (i % 8 == 0) {
+                    m.erase(k);
+                }
+            }
+        });
+    }
+    for (int r = 0; r < readers; r++) {
+        threads[writers + r] = std::thread([&, r] {
+            int k = r;
+            while (!done.load()) {
+                m.find(k, [&](const std::string &v) {
+                    if (v != std::to_string(k)) {
+                        ++mismatches;
+                    }
+                });
+                k = (k + 7919) % (writers * per_writer);
+            }
+        });
+    }
+    for (int w = 0; w < writers; w++) {
+        threads[w].join();
+    }
+    done.store(true);
+    for (int r = 0; r < readers; r++) {
+        threads[writers + r].join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+
+    size_t expected = 0;
+    for (int k = 0; k < writers * per_writer; k++) {
+        std::string value;
+        bool present = m.find(k, value);
+        if (present) {
+            ASSERT_EQ(value, std::to_string(k));
+            ++expected;
+        }
+    }
+    EXPECT_EQ(m.size(), expected);
+}
+
+TEST(epoch, retired_objects_are_reclaimed) {
+    static std::atomic<int> freed(0);
+    freed = 0;
+    {
+        epoch_guard guard;
+        for (int i = 0; i < 10; i++) {
+            epoch_retire(new int(i), [](void *ptr) {
+                delete static_cast<int *>(ptr);
+                ++freed;
+            });
+        }
+        // 仍在 guard 内，本线程可能持有这些对象
+        epoch_reclaim();
+        EXPECT_EQ(freed.load(), 0);
+    }
+    for (int i = 0; i < 3 && epoch_reclaim() != 0; i++) {
+    }
+    EXPECT_EQ(freed.load(), 10);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "../container/deque.h"
+#include "../algorithm/algo.h"
+
+using namespace MicroSTL;
+
+TEST(deque, push_and_pop_both_ends) {
+    deque<int> d;
+    EXPECT_TRUE(d.empty());
+    for (int i = 0; i < 1000; i++) {
+        d.push_back(i);
+        d.push_front(-i - 1);
+    }
+    ASSERT_EQ(d.size(), 2000);
+    EXPECT_EQ(d.front(), -1000);
+    EXPECT_EQ(d.back(), 999);
+    for (int i = 0; i < 2000; i++) {
+        ASSERT_EQ(d[i], i - 1000);
+    }
+    for (int i = 0; i < 1000; i++) {
+        d.pop_front();
+        d.pop_back();
+    }
+    EXPECT_TRUE(d.empty());
+    d.push_back(7);
+    EXPECT_EQ(d.front(), 7);
+}
+
+TEST(deque, references_stable_across_growth) {
+    deque<std::string> d;
+    d.push_back("anchor");
+    std::string *anchor = &d.front();
+    for (int i = 0; i < 5000; i++) {
+        d.push_back(std::to_string(i));
+        d.emplace_front(3, 'x');
+    }
+    EXPECT_EQ(anchor, &d[5000]);
+    EXPECT_EQ(*anchor, "anchor");
+}
+
+TEST(deque, iterator_arithmetic) {
+    deque<int> d;
+    for (int i = 0; i < 1000; i++) {
+        d.push_back(i);
+    }
+    auto it = d.begin();
+    EXPECT_EQ(*(it + 500), 500);
+    EXPECT_EQ(*(d.end() - 1), 999);
+    EXPECT_EQ(d.end() - d.begin(), 1000);
+    EXPECT_EQ((d.begin() + 700) - (d.begin() + 3), 697);
+    it += 999;
+    it -= 998;
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(it[300], 301);
+    EXPECT_TRUE(d.begin() < d.end());
+    deque<int>::const_iterator cit = d.begin();
+    int sum = 0;
+    for (; cit != d.end(); ++cit) {
+        sum += *cit;
+    }
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(deque, works_with_algorithms) {
+    deque<int> d;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 5000; i++) {
+        d.push_front(static_cast<int>(rng() % 10000));
+    }
+    MicroSTL::sort(d.begin(), d.end());
+    for (size_t i = 1; i < d.size(); i++) {
+        ASSERT_LE(d[i - 1], d[i]);
+    }
+    deque<int> copy(d);
+    EXPECT_TRUE(copy == d);
+    MicroSTL::stable_sort(copy.begin(), copy.end(), greater<int>());
+    EXPECT_EQ(copy.front(), d.back());
+}
+
+TEST(deque, insert_and_erase_match_std) {
+    deque<int> d;
+    std::deque<int> expected;
+    std::mt19937 rng(9);
+    for (int i = 0; i < 4000; i++) {
+        size_t op = rng() % 4;
+        if (op < 2 || expected.empty()) {
+            size_t position = expected.empty() ? 0 : rng() % (expected.size() + 1);
+            auto it = d.insert(d.begin() + position, i);
+            expected.insert(expected.begin() + position, i);
+            ASSERT_EQ(*it, i);
+        } else if (op == 2) {
+            size_t position = rng() % expected.size();
+            d.erase(d.begin() + position);
+            expected.erase(expected.begin() + position);
+        } else {
+            size_t from = rng() % expected.size();
+            size_t to = from + rng() % (expected.size() - from + 1);
+            if (to - from > 50) {
+                to = from + 50;
+            }
+            d.erase(d.begin() + from, d.begin() + to);
+            expected.erase(expected.begin() + from, expected.begin() + to);
+        }
+        ASSERT_EQ(d.size(), expected.size());
+    }
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(d[i], expected[i]);
+    }
+}
+
+TEST(deque, constructors_resize_and_clear) {
+    deque<int> filled(300, 5);
+    EXPECT_EQ(filled.size(), 300);
+    EXPECT_EQ(filled.at(299), 5);
+    EXPECT_THROW(filled.at(300), std::out_of_range);
+    deque<int> counted(10, 3);
+    EXPECT_EQ(counted.size(), 10);
+    int values[] = {1, 2, 3, 4};
+    deque<int> ranged(values, values + 4);
+    EXPECT_EQ(ranged.back(), 4);
+
+    deque<std::string> strings(700, "s");
+    strings.resize(1000, "t");
+    EXPECT_EQ(strings[999], "t");
+    strings.resize(10);
+    EXPECT_EQ(strings.size(), 10);
+    deque<std::string> moved(std::move(strings));
+    EXPECT_EQ(moved.size(), 10);
+    EXPECT_TRUE(strings.empty());
+    strings.push_back("reuse");
+    EXPECT_EQ(strings.front(), "reuse");
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    moved.push_front("a");
+    EXPECT_EQ(moved.back(), "a");
+    moved = strings;
+    EXPECT_EQ(moved.front(), "reuse");
+}
+
+TEST(deque, recenters_map_for_queue_usage) {
+    // 一端进一端出，map 应该反复移到中间而不是无限增长
+    deque<long> d;
+    for (long i = 0; i < 200000; i++) {
+        d.push_back(i);
+        if (d.size() > 100) {
+            ASSERT_EQ(d.front(), i - 100);
+            d.pop_front();
+        }
+    }
+    EXPECT_EQ(d.size(), 100);
+    EXPECT_EQ(d.back(), 199999);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../container/dynamic_bitset.h"
+#include "../container/vector.h"
+#include "../algorithm/algo.h"
+
+using namespace MicroSTL;
+
+static std::vector<bool> random_bits(size_t size, unsigned seed, int percent) {
+    std::mt19937 gen(seed);
+    std::vector<bool> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = static_cast<int>(gen() % 100) < percent;
+    }
+    return result;
+}
+
+static dynamic_bitset to_bitset(const std::vector<bool> &bits) {
+    dynamic_bitset result;
+    for (bool bit: bits) {
+        result.push_back(bit);
+    }
+    return result;
+}
+
+TEST(dynamic_bitset, set_reset_flip) {
+    dynamic_bitset b(200);
+    EXPECT_EQ(b.size(), 200);
+    EXPECT_EQ(b.num_words(), 4);
+    EXPECT_TRUE(b.none());
+    b.set(3).set(64).set(199);
+    EXPECT_TRUE(b.test(3));
+    EXPECT_TRUE(b[64]);
+    EXPECT_EQ(b.count(), 3);
+    b.reset(64);
+    EXPECT_FALSE(b[64]);
+    b.flip(5);
+    EXPECT_TRUE(b[5]);
+    EXPECT_THROW(b.test(200), std::out_of_range);
+
+    b.reset();
+    b.set(60, 70, true);
+    EXPECT_EQ(b.count(), 70);
+    EXPECT_FALSE(b[59]);
+    EXPECT_TRUE(b[60]);
+    EXPECT_TRUE(b[129]);
+    EXPECT_FALSE(b[130]);
+    b.flip(0, 200);
+    EXPECT_EQ(b.count(), 130);
+    b.reset(0, 60);
+    EXPECT_EQ(b.count(), 70);
+    EXPECT_THROW(b.set(150, 51, true), std::out_of_range);
+
+    // 超出长度的位不计入 count
+    b.set();
+    EXPECT_EQ(b.count(), 200);
+    EXPECT_TRUE(b.all());
+    b.flip();
+    EXPECT_TRUE(b.none());
+}
+
+TEST(dynamic_bitset, resize_and_push_back) {
+    dynamic_bitset b(10, true);
+    EXPECT_EQ(b.count(), 10);
+    b.resize(100, true);
+    EXPECT_EQ(b.count(), 100);
+    b.resize(70);
+    EXPECT_EQ(b.count(), 70);
+    b.resize(130, false);
+    EXPECT_EQ(b.count(), 70);
+    b.pop_back();
+    EXPECT_EQ(b.size(), 129);
+    b.clear();
+    EXPECT_TRUE(b.empty());
+    for (int i = 0; i < 1000; i++) {
+        b.push_back(i % 3 == 0);
+    }
+    EXPECT_EQ(b.count(), 334);
+    EXPECT_GE(b.capacity(), 1000);
+}
+
+TEST(dynamic_bitset, count_and_find_match_reference) {
+    for (int percent: {0, 1, 50, 99}) {
+        std::vector<bool> expected = random_bits(5000 + percent, percent, percent);
+        dynamic_bitset b = to_bitset(expected);
+        size_t count = 0;
+        for (bool bit: expected) {
+            count += bit;
+        }
+        ASSERT_EQ(b.count(), count);
+
+        std::vector<size_t> positions;
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (expected[i]) {
+                positions.push_back(i);
+            }
+        }
+        std::vector<size_t> found;
+        for (size_t i = b.find_first(); i != dynamic_bitset::npos; i = b.find_next(i)) {
+            found.push_back(i);
+        }
+        ASSERT_EQ(found, positions);
+        std::vector<size_t> visited;
+        b.for_each_set([&visited](size_t i) { visited.push_back(i); });
+        ASSERT_EQ(visited, positions);
+    }
+}
+
+TEST(dynamic_bitset, bulk_operations) {
+    std::vector<bool> x = random_bits(1003, 1, 50);
+    std::vector<bool> y = random_bits(1003, 2, 30);
+    dynamic_bitset a = to_bitset(x);
+    dynamic_bitset b = to_bitset(y);
+    dynamic_bitset and_result = a & b;
+    dynamic_bitset or_result = a | b;
+    dynamic_bitset xor_result = a ^ b;
+    dynamic_bitset andnot_result = a - b;
+    dynamic_bitset not_result = ~a;
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSERT_EQ(and_result[i], x[i] && y[i]);
+        ASSERT_EQ(or_result[i], x[i] || y[i]);
+        ASSERT_EQ(xor_result[i], x[i] != y[i]);
+        ASSERT_EQ(andnot_result[i], x[i] && !y[i]);
+        ASSERT_EQ(not_result[i], !x[i]);
+    }
+    EXPECT_EQ(not_result.count(), 1003 - a.count());
+    EXPECT_EQ((a ^ a).count(), 0);
+    EXPECT_EQ(a, to_bitset(x));
+    EXPECT_NE(a, b);
+
+    // 长度不同的位图不能逐字运算
+    dynamic_bitset shorter = to_bitset(random_bits(70, 3, 50));
+    EXPECT_THROW(a &= shorter, std::invalid_argument);
+    EXPECT_THROW(a |= shorter, std::invalid_argument);
+    EXPECT_THROW(a ^= shorter, std::invalid_argument);
+    EXPECT_THROW(a -= shorter, std::invalid_argument);
+    EXPECT_THROW(a & shorter, std::invalid_argument);
+    EXPECT_THROW(shorter | a, std::invalid_argument);
+    EXPECT_EQ(a, to_bitset(x));
+}
+
+TEST(dynamic_bitset, iterator_with_algorithms) {
+    dynamic_bitset b(300);
+    MicroSTL::fill(b.begin() + 100, b.begin() + 200, true);
+    EXPECT_EQ(b.count(), 100);
+    EXPECT_EQ(MicroSTL::count(b.begin(), b.end(), true), 100);
+    EXPECT_EQ(MicroSTL::find(b.begin(), b.end(), true) - b.begin(), 100);
+
+    dynamic_bitset c(300);
+    MicroSTL::copy(b.begin() + 100, b.begin() + 150, c.begin() + 1);
+    EXPECT_EQ(c.find_first(), 1);
+    EXPECT_EQ(c.count(), 50);
+    MicroSTL::iter_swap(c.begin(), c.begin() + 1);
+    EXPECT_TRUE(c[0]);
+    EXPECT_FALSE(c[1]);
+
+    const dynamic_bitset &cref = c;
+    size_t ones = 0;
+    for (bool bit: cref) {
+        ones += bit;
+    }
+    EXPECT_EQ(ones, 50);
+    dynamic_bitset::iterator it = b.end();
+    it -= 101;
+    EXPECT_TRUE(*it);
+    EXPECT_FALSE(it[1]);
+    EXPECT_EQ(b.end() - it, 101);
+}
+
+TEST(vector_bool, packed_specialization) {
+    vector<bool> v;
+    for (int i = 0; i < 130; i++) {
+        v.push_back(i % 2 == 0);
+    }
+    EXPECT_EQ(v.size(), 130);
+    // 130 位只占 3 个字，容量按字翻倍
+    EXPECT_EQ(v.capacity(), 256u);
+    EXPECT_EQ(v.num_words(), 3u);
+    EXPECT_TRUE(v.front());
+    EXPECT_FALSE(v.back());
+    v.back() = true;
+    EXPECT_TRUE(v[129]);
+    EXPECT_THROW(v.at(130), std::out_of_range);
+
+    v.insert(v.begin() + 1, true);
+    EXPECT_EQ(v.size(), 131);
+    EXPECT_TRUE(v[0]);
+    EXPECT_TRUE(v[1]);
+    EXPECT_FALSE(v[2]);
+    v.insert(v.begin(), 3, false);
+    EXPECT_EQ(v.size(), 134);
+    EXPECT_EQ(v.find_first(), 3);
+    v.erase(v.begin(), v.begin() + 4);
+    EXPECT_EQ(v.size(), 130);
+    for (size_t i = 0; i < 129; i++) {
+        ASSERT_EQ(v[i], i % 2 == 0) << i;
+    }
+    EXPECT_TRUE(v[129]);
+    v.erase(v.end() - 1);
+    EXPECT_EQ(v.count(), 65);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
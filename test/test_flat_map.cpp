@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "../adaptor/flat_map.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(flat_map, insert_and_find) {
+    flat_map<int, std::string> m;
+    EXPECT_TRUE(m.insert(MicroSTL::make_pair(1, std::string("one"))).second);
+    EXPECT_FALSE(m.insert(MicroSTL::make_pair(1, std::string("uno"))).second);
+    EXPECT_TRUE(m.emplace(2, "two").second);
+    EXPECT_TRUE(m.try_emplace(0, 3, 'z').second);
+    EXPECT_EQ(m.size(), 3);
+    EXPECT_EQ(m.find(1)->second, "one");
+    EXPECT_EQ((*m.begin()).second, "zzz");
+    EXPECT_TRUE(m.find(3) == m.end());
+    EXPECT_TRUE(m.contains(2));
+    EXPECT_EQ(m.count(2), 1);
+}
+
+TEST(flat_map, subscript_and_at) {
+    flat_map<std::string, int> m;
+    m["b"] = 1;
+    m["a"] += 2;
+    m["b"] += 10;
+    EXPECT_EQ(m.at("a"), 2);
+    EXPECT_EQ(m.at("b"), 11);
+    EXPECT_THROW(m.at("c"), std::out_of_range);
+    const flat_map<std::string, int> &cm = m;
+    EXPECT_EQ(cm.at("b"), 11);
+    EXPECT_EQ(m.keys()[0], "a");
+    EXPECT_EQ(m.values()[0], 2);
+}
+
+TEST(flat_map, iterator_modifies_value) {
+    flat_map<int, int> m;
+    for (int i = 0; i < 5; i++) {
+        m[i] = i;
+    }
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        it->second *= 10;
+    }
+    int sum = 0;
+    for (auto kv: m) {
+        sum += kv.second;
+    }
+    EXPECT_EQ(sum, 100);
+    flat_map<int, int>::const_iterator it = m.begin() + 2;
+    EXPECT_EQ(it->first, 2);
+    EXPECT_EQ(m.end() - m.begin(), 5);
+    EXPECT_EQ(m.begin()[4].second, 40);
+}
+
+TEST(flat_map, batch_insert_keeps_first) {
+    flat_map<int, int> m;
+    m[5] = 50;
+    vector<pair<int, int>> batch;
+    batch.push_back(MicroSTL::make_pair(3, 1));
+    batch.push_back(MicroSTL::make_pair(5, 2));
+    batch.push_back(MicroSTL::make_pair(3, 3));
+    batch.push_back(MicroSTL::make_pair(9, 4));
+    batch.push_back(MicroSTL::make_pair(1, 5));
+    m.insert(batch.begin(), batch.end());
+    ASSERT_EQ(m.size(), 4);
+    EXPECT_EQ(m.at(1), 5);
+    EXPECT_EQ(m.at(3), 1);
+    EXPECT_EQ(m.at(5), 50);
+    EXPECT_EQ(m.at(9), 4);
+}
+
+TEST(flat_map, matches_std_map) {
+    std::mt19937 rng(7);
+    flat_map<long, long> m;
+    std::map<long, long> expected;
+    for (int round = 0; round < 8; round++) {
+        vector<pair<long, long>> batch;
+        for (int i = 0; i < 1000; i++) {
+            long k = static_cast<long>(rng() % 30000);
+            batch.push_back(MicroSTL::make_pair(k, static_cast<long>(i)));
+            expected.emplace(k, static_cast<long>(i));
+        }
+        m.insert(batch.begin(), batch.end());
+        ASSERT_EQ(m.size(), expected.size());
+    }
+    for (long k = -1; k <= 30001; k++) {
+        auto lower = m.lower_bound(k);
+        auto expected_lower = expected.lower_bound(k);
+        ASSERT_EQ(lower == m.end(), expected_lower == expected.end());
+        if (lower != m.end()) {
+            ASSERT_EQ(lower->first, expected_lower->first);
+            ASSERT_EQ(lower->second, expected_lower->second);
+        }
+        auto upper = m.upper_bound(k);
+        auto expected_upper = expected.upper_bound(k);
+        ASSERT_EQ(upper == m.end(), expected_upper == expected.end());
+        if (upper != m.end()) {
+            ASSERT_EQ(upper->first, expected_upper->first);
+        }
+    }
+    for (long k = 0; k < 30000; k += 4) {
+        ASSERT_EQ(m.erase(k), expected.erase(k));
+    }
+    auto it = expected.begin();
+    for (auto kv: m) {
+        ASSERT_EQ(kv.first, it->first);
+        ASSERT_EQ(kv.second, it->second);
+        ++it;
+    }
+}
+
+TEST(flat_map, erase_range_and_swap) {
+    flat_map<int, std::string> m;
+    for (int i = 0; i < 10; i++) {
+        m[i] = std::to_string(i);
+    }
+    auto range = m.equal_range(4);
+    EXPECT_EQ(range.second - range.first, 1);
+    auto it = m.erase(m.lower_bound(2), m.lower_bound(6));
+    EXPECT_EQ(it->second, "6");
+    EXPECT_EQ(m.size(), 6);
+    flat_map<int, std::string> other(m);
+    other.clear();
+    other[100] = "x";
+    m.swap(other);
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(other.size(), 6);
+    flat_map<int, std::string> moved(std::move(other));
+    EXPECT_EQ(moved.at(9), "9");
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
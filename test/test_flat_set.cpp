@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "../adaptor/flat_set.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(flat_set, insert_and_find) {
+    flat_set<int> s;
+    EXPECT_TRUE(s.insert(3).second);
+    EXPECT_TRUE(s.insert(1).second);
+    EXPECT_FALSE(s.insert(3).second);
+    EXPECT_TRUE(s.emplace(2).second);
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_EQ(*s.begin(), 1);
+    EXPECT_TRUE(s.contains(2));
+    EXPECT_EQ(s.count(4), 0);
+    EXPECT_TRUE(s.find(4) == s.end());
+}
+
+TEST(flat_set, batch_insert_merges_and_dedups) {
+    flat_set<int> s;
+    int first[] = {5, 1, 9, 1, 5};
+    s.insert(first, first + 5);
+    ASSERT_EQ(s.size(), 3);
+    int second[] = {7, 3, 9, 3, 11, 0};
+    s.insert(second, second + 6);
+    int expected[] = {0, 1, 3, 5, 7, 9, 11};
+    ASSERT_EQ(s.size(), 7);
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(s.data()[i], expected[i]);
+    }
+    // 新元素都大于原有元素
+    int third[] = {13, 12, 12};
+    s.insert(third, third + 3);
+    EXPECT_EQ(s.size(), 9);
+    EXPECT_EQ(s.data().back(), 13);
+}
+
+TEST(flat_set, matches_std_set) {
+    std::mt19937 rng(11);
+    flat_set<int> s;
+    std::set<int> expected;
+    for (int round = 0; round < 10; round++) {
+        vector<int> batch;
+        for (int i = 0; i < 1000; i++) {
+            batch.push_back(static_cast<int>(rng() % 20000));
+        }
+        s.insert(batch.begin(), batch.end());
+        expected.insert(batch.begin(), batch.end());
+        ASSERT_EQ(s.size(), expected.size());
+    }
+    // 元素超过 FLAT_EYTZINGER_MIN_SIZE，批量插入后使用 Eytzinger 索引
+    for (int k = -1; k <= 20001; k++) {
+        auto lower = s.lower_bound(k);
+        auto expected_lower = expected.lower_bound(k);
+        ASSERT_EQ(lower == s.end(), expected_lower == expected.end());
+        if (lower != s.end()) {
+            ASSERT_EQ(*lower, *expected_lower);
+        }
+        auto upper = s.upper_bound(k);
+        auto expected_upper = expected.upper_bound(k);
+        ASSERT_EQ(upper == s.end(), expected_upper == expected.end());
+        if (upper != s.end()) {
+            ASSERT_EQ(*upper, *expected_upper);
+        }
+    }
+    // 单点删除后索引失效，退化为二分查找
+    for (int k = 0; k < 20000; k += 3) {
+        ASSERT_EQ(s.erase(k), expected.erase(k));
+    }
+    for (int k = 0; k < 20000; k++) {
+        ASSERT_EQ(s.contains(k), expected.count(k) == 1);
+    }
+    auto it = expected.begin();
+    for (int k: s) {
+        ASSERT_EQ(k, *it++);
+    }
+}
+
+TEST(flat_set, greater_and_strings) {
+    flat_set<int, greater<int>> s;
+    for (int i = 0; i < 2000; i++) {
+        s.insert(i);
+    }
+    s.rebuild_index();
+    EXPECT_EQ(*s.begin(), 1999);
+    EXPECT_EQ(*s.lower_bound(500), 500);
+    EXPECT_EQ(*s.upper_bound(500), 499);
+    EXPECT_TRUE(s.upper_bound(0) == s.end());
+
+    flat_set<std::string> words;
+    std::string batch[] = {"pear", "apple", "fig", "apple"};
+    words.insert(batch, batch + 4);
+    EXPECT_EQ(words.size(), 3);
+    EXPECT_EQ(*words.begin(), "apple");
+    EXPECT_TRUE(words.contains("fig"));
+}
+
+TEST(flat_set, erase_range_copy_and_swap) {
+    flat_set<int> s;
+    for (int i = 0; i < 10; i++) {
+        s.insert(i);
+    }
+    auto it = s.erase(s.lower_bound(2), s.lower_bound(5));
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(s.size(), 7);
+    flat_set<int> copy(s);
+    flat_set<int> other;
+    other.insert(42);
+    copy.swap(other);
+    EXPECT_EQ(copy.size(), 1);
+    EXPECT_EQ(other.size(), 7);
+    flat_set<int> moved(std::move(other));
+    EXPECT_EQ(moved.size(), 7);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
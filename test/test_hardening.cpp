@@ -0,0 +1,59 @@
+#undef MICROSTL_HARDENING
+#define MICROSTL_HARDENING MICROSTL_HARDENING_CHEAP
+
+#include <gtest/gtest.h>
+#include "../container/vector.h"
+#include "../container/list.h"
+
+using namespace MicroSTL;
+
+TEST(hardening, vector_bounds) {
+    vector<int> vec(4, 1);
+    EXPECT_EQ(vec[3], 1);
+    EXPECT_DEATH(vec[4], "index out of range");
+    const vector<int> &cref = vec;
+    EXPECT_DEATH(cref[100], "index out of range");
+}
+
+TEST(hardening, vector_empty) {
+    vector<int> vec;
+    EXPECT_DEATH(vec.front(), "front on empty vector");
+    EXPECT_DEATH(vec.back(), "back on empty vector");
+    EXPECT_DEATH(vec.pop_back(), "pop_back on empty vector");
+    vec.push_back(1);
+    vec.pop_back();
+    EXPECT_TRUE(vec.empty());
+}
+
+TEST(hardening, vector_foreign_iterator) {
+    vector<int> a(4, 1);
+    vector<int> b(4, 2);
+    EXPECT_DEATH(a.erase(b.begin()), "does not belong to this vector");
+    EXPECT_DEATH(a.insert(b.begin() + 1, 3), "does not belong to this vector");
+    EXPECT_DEATH(a.erase(a.end()), "does not belong to this vector");
+    EXPECT_DEATH(a.erase(a.begin() + 2, a.begin() + 1), "invalid range");
+    // 合法的边界：在 end() 插入、删除空区间
+    a.insert(a.end(), 5);
+    a.erase(a.end(), a.end());
+    EXPECT_EQ(a.size(), 5);
+    EXPECT_EQ(a.back(), 5);
+}
+
+TEST(hardening, list_checks) {
+    list<int> l;
+    EXPECT_DEATH(l.front(), "front on empty list");
+    EXPECT_DEATH(l.back(), "back on empty list");
+    EXPECT_DEATH(l.pop_front(), "pop_front on empty list");
+    EXPECT_DEATH(l.pop_back(), "pop_back on empty list");
+    EXPECT_DEATH(l.erase(l.end()), "erase\\(end\\(\\)\\)");
+    l.push_back(1);
+    l.push_back(2);
+    l.pop_front();
+    EXPECT_EQ(l.front(), 2);
+    EXPECT_EQ(l.back(), 2);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
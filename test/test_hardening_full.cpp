@@ -0,0 +1,135 @@
+#undef MICROSTL_HARDENING
+#define MICROSTL_HARDENING MICROSTL_HARDENING_FULL
+
+#include <gtest/gtest.h>
+#include "../container/vector.h"
+#include "../container/list.h"
+#include "../algorithm/algo.h"
+
+using namespace MicroSTL;
+
+TEST(hardening_full, vector_reallocation) {
+    vector<int> vec;
+    vec.push_back(1);
+    vector<int>::iterator first = vec.begin();
+    EXPECT_EQ(*first, 1);
+    // 容量为 1，再插入一个元素需要扩容，之前的迭代器全部失效
+    vec.push_back(2);
+    EXPECT_DEATH(*first, "invalidated");
+    EXPECT_EQ(*vec.begin(), 1);
+
+    vec.reserve(16);
+    first = vec.begin();
+    // 不扩容的 push_back 不影响已有元素的迭代器
+    vec.push_back(3);
+    EXPECT_EQ(*first, 1);
+    vec.reserve(32);
+    EXPECT_DEATH(*first, "invalidated");
+}
+
+TEST(hardening_full, vector_insert_erase) {
+    vector<int> vec;
+    vec.reserve(16);
+    for (int i = 0; i < 8; i++) {
+        vec.push_back(i);
+    }
+    vector<int>::iterator a = vec.begin() + 1;
+    vector<int>::iterator b = vec.begin() + 5;
+    vector<int>::iterator c = vec.begin() + 6;
+
+    // 删除下标 5：之前的迭代器仍然有效，之后（含）的失效
+    vector<int>::iterator next = vec.erase(b);
+    EXPECT_EQ(*a, 1);
+    EXPECT_EQ(*next, 6);
+    EXPECT_DEATH(*b, "invalidated");
+    EXPECT_DEATH(*c, "invalidated");
+
+    // 在下标 3 插入，之后又在下标 6 删除：a 仍然有效
+    vector<int>::iterator d = vec.begin() + 4;
+    vec.insert(vec.begin() + 3, 100);
+    vec.erase(vec.begin() + 6);
+    EXPECT_EQ(*a, 1);
+    EXPECT_DEATH(*d, "invalidated");
+
+    // pop_back 只让最后一个元素失效
+    vector<int>::iterator last = vec.end() - 1;
+    vector<int>::iterator second = vec.begin() + 2;
+    vec.pop_back();
+    EXPECT_EQ(*second, 2);
+    EXPECT_DEATH(*last, "invalidated");
+
+    vec.clear();
+    EXPECT_DEATH(*a, "invalidated");
+}
+
+TEST(hardening_full, vector_iterators) {
+    vector<int> a(4, 1);
+    vector<int> b(4, 2);
+    EXPECT_DEATH(*a.end(), "out of range");
+    EXPECT_DEATH((void) (a.begin() == b.begin()), "different containers");
+    EXPECT_DEATH(a.erase(b.begin()), "does not belong to this vector");
+    vector<int>::iterator singular;
+    EXPECT_DEATH(*singular, "singular");
+
+    vector<int>::const_iterator first = a.begin();
+    EXPECT_EQ(a.end() - first, 4);
+    EXPECT_EQ(first[3], 1);
+
+    // 迭代器可以直接交给算法使用
+    for (int i = 0; i < 4; i++) {
+        b[i] = 4 - i;
+    }
+    MicroSTL::sort(b.begin(), b.end());
+    EXPECT_EQ(b.front(), 1);
+    EXPECT_EQ(b.back(), 4);
+
+    a.swap(b);
+    EXPECT_DEATH(*first, "invalidated");
+}
+
+TEST(hardening_full, list_ownership) {
+    list<int> a;
+    list<int> b;
+    for (int i = 0; i < 4; i++) {
+        a.push_back(i);
+        b.push_back(i + 10);
+    }
+    EXPECT_DEATH(a.insert(b.begin(), 1), "does not belong to this list");
+    EXPECT_DEATH(a.erase(b.begin()), "does not belong to this list");
+    EXPECT_DEATH(*a.end(), "end\\(\\)");
+
+    list<int>::iterator erased = a.begin();
+    a.erase(erased);
+    EXPECT_DEATH(*erased, "erased node");
+    EXPECT_DEATH(++erased, "erased node");
+
+    // 节点内存被新节点复用后，旧迭代器仍然失效
+    list<int>::iterator reused = a.begin();
+    a.erase(reused);
+    a.push_front(100);
+    EXPECT_DEATH(*reused, "erased node");
+    a.front() = 1;
+
+    // splice 之后节点属于目标链表
+    list<int>::iterator moved = b.begin();
+    a.splice(a.end(), b, moved);
+    EXPECT_EQ(a.back(), 10);
+    EXPECT_DEATH(b.erase(moved), "does not belong to this list");
+    a.erase(moved);
+    EXPECT_EQ(a.back(), 3);
+
+    // swap 只交换头节点，迭代器跟随元素
+    list<int>::iterator first = a.begin();
+    a.swap(b);
+    b.erase(first);
+    EXPECT_EQ(b.front(), 2);
+
+    b.sort();
+    b.reverse();
+    EXPECT_EQ(b.front(), 3);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
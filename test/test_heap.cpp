@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../algorithm/heap.h"
+
+using namespace MicroSTL;
+
+std::vector<int> random_input(size_t size) {
+    std::mt19937 rng(size);
+    std::vector<int> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = static_cast<int>(rng() % 1000);
+    }
+    return result;
+}
+
+TEST(heap, make_heap) {
+    for (size_t size: {0, 1, 2, 3, 10, 100, 1000}) {
+        std::vector<int> data = random_input(size);
+        MicroSTL::make_heap(data.data(), data.data() + size);
+        EXPECT_TRUE(MicroSTL::is_heap(data.data(), data.data() + size));
+        EXPECT_TRUE(std::is_heap(data.begin(), data.end()));
+    }
+}
+
+TEST(heap, push_heap_and_pop_heap) {
+    std::vector<int> input = random_input(500);
+    std::vector<int> data;
+    for (int x: input) {
+        data.push_back(x);
+        MicroSTL::push_heap(data.data(), data.data() + data.size());
+        ASSERT_TRUE(MicroSTL::is_heap(data.data(), data.data() + data.size()));
+    }
+
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    for (int x: expected) {
+        EXPECT_EQ(data.front(), x);
+        MicroSTL::pop_heap(data.data(), data.data() + data.size());
+        EXPECT_EQ(data.back(), x);
+        data.pop_back();
+        ASSERT_TRUE(MicroSTL::is_heap(data.data(), data.data() + data.size()));
+    }
+}
+
+TEST(heap, sort_heap) {
+    std::vector<int> data = random_input(1000);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    MicroSTL::make_heap(data.data(), data.data() + data.size());
+    MicroSTL::sort_heap(data.data(), data.data() + data.size());
+    EXPECT_EQ(data, expected);
+}
+
+TEST(heap, comparator) {
+    std::vector<int> data = random_input(1000);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    MicroSTL::make_heap(data.data(), data.data() + data.size(), greater<int>());
+    EXPECT_TRUE(MicroSTL::is_heap(data.data(), data.data() + data.size(), greater<int>()));
+    EXPECT_EQ(data.front(), expected.back());
+    MicroSTL::sort_heap(data.data(), data.data() + data.size(), greater<int>());
+    EXPECT_EQ(data, expected);
+}
+
+TEST(heap, is_heap) {
+    int heap[] = {9, 5, 8, 1, 2, 7};
+    int not_heap[] = {9, 5, 8, 6, 2, 7, 10};
+    EXPECT_TRUE(MicroSTL::is_heap(heap, heap + 6));
+    EXPECT_FALSE(MicroSTL::is_heap(not_heap, not_heap + 7));
+}
+
+// 多叉堆的内部实现
+template<size_t Arity>
+void check_arity(size_t size) {
+    std::vector<int> data = random_input(size);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    _make_heap<Arity>(data.data(), data.data() + size, less<int>());
+    ASSERT_TRUE((_is_heap<Arity>(data.data(), data.data() + size, less<int>())));
+    _sort_heap<Arity>(data.data(), data.data() + size, less<int>());
+    EXPECT_EQ(data, expected);
+}
+
+TEST(heap, arity) {
+    for (size_t size: {0, 1, 2, 3, 4, 5, 17, 100, 1001}) {
+        check_arity<3>(size);
+        check_arity<4>(size);
+        check_arity<8>(size);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,13 +1,147 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
 #include "../container/list.h"
 
 using namespace MicroSTL;
 
-TEST(示例, 测试相等) {
-    EXPECT_EQ(1, 1);
+template<typename T>
+static std::vector<T> to_vector(const list<T> &l) {
+    std::vector<T> result;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+TEST(list, push_pop_and_iterate) {
+    list<int> l;
+    EXPECT_TRUE(l.empty());
+    for (int i = 0; i < 5; i++) {
+        l.push_back(i);
+    }
+    l.push_front(-1);
+    EXPECT_EQ(l.size(), 6);
+    EXPECT_EQ(l.front(), -1);
+    EXPECT_EQ(l.back(), 4);
+    EXPECT_EQ(to_vector(l), (std::vector<int>{-1, 0, 1, 2, 3, 4}));
+
+    auto it = l.end();
+    --it;
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(*(it--), 4);
+    EXPECT_EQ(*it, 3);
+
+    l.pop_front();
+    l.pop_back();
+    EXPECT_EQ(to_vector(l), (std::vector<int>{0, 1, 2, 3}));
+    l.clear();
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(list, insert_erase_remove_unique) {
+    list<std::string> l;
+    l.push_back("a");
+    l.push_back("c");
+    auto it = l.begin();
+    ++it;
+    it = l.insert(it, "b");
+    EXPECT_EQ(*it, "b");
+    it = l.erase(l.begin());
+    EXPECT_EQ(*it, "b");
+
+    list<int> n;
+    int values[] = {1, 1, 2, 3, 3, 3, 1, 4, 4};
+    for (int v: values) {
+        n.push_back(v);
+    }
+    n.unique();
+    EXPECT_EQ(to_vector(n), (std::vector<int>{1, 2, 3, 1, 4}));
+    n.remove(1);
+    EXPECT_EQ(to_vector(n), (std::vector<int>{2, 3, 4}));
+}
+
+TEST(list, splice_merge_reverse) {
+    list<int> a;
+    list<int> b;
+    for (int i = 0; i < 3; i++) {
+        a.push_back(i);
+        b.push_back(10 + i);
+    }
+    a.splice(a.end(), b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(to_vector(a), (std::vector<int>{0, 1, 2, 10, 11, 12}));
+
+    auto third = a.begin();
+    ++++third;
+    b.splice(b.begin(), a, third);
+    EXPECT_EQ(to_vector(b), (std::vector<int>{2}));
+    EXPECT_EQ(a.size(), 5);
+
+    list<int> x;
+    list<int> y;
+    for (int i = 0; i < 10; i += 2) {
+        x.push_back(i);
+        y.push_back(i + 1);
+    }
+    y.push_back(20);
+    x.merge(y);
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(to_vector(x), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 20}));
+    x.reverse();
+    EXPECT_EQ(x.front(), 20);
+    EXPECT_EQ(x.back(), 0);
+}
+
+TEST(list, sort) {
+    std::mt19937 gen(7);
+    for (int size: {0, 1, 2, 3, 17, 1000}) {
+        list<int> l;
+        std::vector<int> expected;
+        for (int i = 0; i < size; i++) {
+            int v = static_cast<int>(gen() % 100);
+            l.push_back(v);
+            expected.push_back(v);
+        }
+        l.sort();
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(to_vector(l), expected) << size;
+    }
+}
+
+TEST(list, copy_and_swap) {
+    list<std::string> a;
+    a.push_back("x");
+    a.push_back("y");
+    list<std::string> b(a);
+    b.push_back("z");
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(b.size(), 3);
+    a = b;
+    EXPECT_EQ(to_vector(a), (std::vector<std::string>{"x", "y", "z"}));
+    list<std::string> c;
+    c.swap(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(c.size(), 3);
+}
+
+TEST(list, over_aligned) {
+    struct alignas(64) padded {
+        int value;
+    };
+    list<padded> lst;
+    for (int i = 0; i < 10; i++) {
+        lst.push_back(padded{i});
+    }
+    int expected = 0;
+    for (auto &item: lst) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&item) % 64, 0);
+        EXPECT_EQ(item.value, expected++);
+    }
 }
 
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
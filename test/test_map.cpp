@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "../container/map.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(map, insert_and_find) {
+    map<int, std::string> m;
+    EXPECT_TRUE(m.insert(MicroSTL::make_pair(1, std::string("one"))).second);
+    EXPECT_FALSE(m.insert(MicroSTL::make_pair(1, std::string("uno"))).second);
+    EXPECT_TRUE(m.emplace(2, "two").second);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.find(1)->second, "one");
+    EXPECT_TRUE(m.find(3) == m.end());
+    EXPECT_TRUE(m.contains(2));
+    EXPECT_EQ(m.count(2), 1);
+}
+
+TEST(map, subscript_and_at) {
+    map<std::string, int> m;
+    m["a"] = 1;
+    m["b"] += 2;
+    m["a"] += 10;
+    EXPECT_EQ(m.at("a"), 11);
+    EXPECT_EQ(m.at("b"), 2);
+    EXPECT_THROW(m.at("c"), std::out_of_range);
+    EXPECT_EQ(m.size(), 2);
+}
+
+TEST(map, ordered_iteration) {
+    map<int, int> m;
+    std::map<int, int> expected;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 3000; i++) {
+        int k = static_cast<int>(rng() % 1000);
+        m[k] += i;
+        expected[k] += i;
+    }
+    EXPECT_EQ(m.size(), expected.size());
+    auto iter = m.begin();
+    for (auto &item : expected) {
+        EXPECT_EQ(iter->first, item.first);
+        EXPECT_EQ(iter->second, item.second);
+        ++iter;
+    }
+}
+
+TEST(map, hint_and_sorted_range) {
+    vector<pair<int, int>> values;
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(pair<int, int>(i, i * i));
+    }
+    map<int, int> m(values.begin(), values.end());
+    EXPECT_EQ(m.size(), 1000);
+    EXPECT_EQ(m.at(30), 900);
+
+    map<int, int> hinted;
+    for (int i = 0; i < 1000; i++) {
+        hinted.emplace_hint(hinted.end(), i, i);
+    }
+    EXPECT_EQ(hinted.size(), 1000);
+    EXPECT_EQ((--hinted.end())->first, 999);
+}
+
+TEST(map, erase_and_bounds) {
+    map<int, int> m;
+    for (int i = 0; i < 100; i++) {
+        m[i] = i;
+    }
+    EXPECT_EQ(m.erase(50), 1);
+    EXPECT_EQ(m.erase(50), 0);
+    m.erase(m.find(10));
+    EXPECT_EQ(m.lower_bound(50)->first, 51);
+    EXPECT_EQ(m.upper_bound(51)->first, 52);
+    m.erase(m.lower_bound(60), m.lower_bound(70));
+    EXPECT_EQ(m.size(), 88);
+    EXPECT_EQ(m.lower_bound(60)->first, 70);
+    m.erase(m.begin(), m.end());
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(multimap, equal_keys) {
+    multimap<int, std::string> m;
+    m.insert(MicroSTL::make_pair(1, std::string("a")));
+    m.insert(MicroSTL::make_pair(2, std::string("b")));
+    m.insert(MicroSTL::make_pair(1, std::string("c")));
+    m.emplace(1, "d");
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_EQ(m.count(1), 3);
+    // 相等的 key 保持插入顺序
+    auto range = m.equal_range(1);
+    std::string order;
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        order += iter->second;
+    }
+    EXPECT_EQ(order, "acd");
+    EXPECT_EQ(m.erase(1), 3);
+    EXPECT_EQ(m.size(), 1);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
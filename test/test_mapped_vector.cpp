@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../container/mapped_vector.h"
+#include "../algorithm/algo.h"
+
+using namespace MicroSTL;
+
+struct record {
+    int id;
+    double value;
+};
+
+// 每个用例使用独立的临时文件，结束时删除
+class mapped_vector_test : public testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        char name[] = "/tmp/microstl_mapped_XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override {
+        unlink(path.c_str());
+    }
+
+    off_t file_size() const {
+        struct stat info;
+        stat(path.c_str(), &info);
+        return info.st_size;
+    }
+};
+
+TEST_F(mapped_vector_test, push_back_and_reopen) {
+    {
+        mapped_vector<record> vec(path.c_str());
+        EXPECT_TRUE(vec.is_open());
+        EXPECT_TRUE(vec.empty());
+        for (int i = 0; i < 10000; i++) {
+            vec.push_back(record{i, i * 0.5});
+        }
+        EXPECT_EQ(vec.size(), 10000);
+        EXPECT_GE(vec.capacity(), 10000);
+        EXPECT_EQ(vec[1234].id, 1234);
+        EXPECT_EQ(vec.back().value, 9999 * 0.5);
+    }
+    // 关闭时文件截断为 size() 个元素
+    EXPECT_EQ(file_size(), static_cast<off_t>(10000 * sizeof(record)));
+
+    const mapped_vector<record> reader(path.c_str(), map_mode::read_only);
+    EXPECT_TRUE(reader.read_only());
+    EXPECT_EQ(reader.size(), 10000);
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ(reader[i].id, i);
+    }
+    EXPECT_THROW(reader.at(10000), std::out_of_range);
+}
+
+TEST_F(mapped_vector_test, read_only_rejects_modification) {
+    {
+        mapped_vector<int> vec(path.c_str());
+        vec.push_back(1);
+    }
+    mapped_vector<int> reader(path.c_str(), map_mode::read_only);
+    EXPECT_THROW(reader.push_back(2), std::logic_error);
+    EXPECT_THROW(reader.pop_back(), std::logic_error);
+    EXPECT_THROW(reader.clear(), std::logic_error);
+    EXPECT_EQ(reader.size(), 1);
+}
+
+TEST_F(mapped_vector_test, shared_between_mappings) {
+    mapped_vector<int> writer(path.c_str(), map_mode::truncate);
+    writer.resize(1000, 7);
+    writer[10] = 42;
+    writer.flush();
+    // 另一个只读映射看到同一份 page cache 中的数据；打开期间文件长度为容量
+    mapped_vector<int> reader(path.c_str(), map_mode::read_only);
+    ASSERT_GE(reader.size(), 1000);
+    EXPECT_EQ(reader[10], 42);
+    writer[11] = 43;
+    EXPECT_EQ(reader[11], 43);
+}
+
+TEST_F(mapped_vector_test, algorithms) {
+    mapped_vector<int> vec(path.c_str());
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back((i * 7919) % 1000);
+    }
+    MicroSTL::sort(vec.begin(), vec.end());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(vec[i], i);
+    }
+    EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 999 * 1000 / 2);
+}
+
+TEST_F(mapped_vector_test, insert_erase_resize) {
+    mapped_vector<int> vec(path.c_str());
+    for (int i = 0; i < 10; i++) {
+        vec.push_back(i);
+    }
+    vec.insert(vec.begin(), -1);
+    vec.erase(vec.begin() + 5, vec.begin() + 8);
+    EXPECT_EQ(vec.size(), 8);
+    EXPECT_EQ(vec.front(), -1);
+    EXPECT_EQ(vec[5], 7);
+
+    // 追加自身的一段，扩容后区间地址会变化
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 8);
+    vec.append(vec.begin(), vec.end());
+    EXPECT_EQ(vec.size(), 16);
+    EXPECT_EQ(vec[8], -1);
+    EXPECT_EQ(vec[15], 9);
+
+    vec.resize(4);
+    vec.resize(6);
+    EXPECT_EQ(vec[5], 0);
+    vec.shrink_to_fit();
+    EXPECT_EQ(file_size(), static_cast<off_t>(6 * sizeof(int)));
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(file_size(), 0);
+    vec.push_back(5);
+    EXPECT_EQ(vec[0], 5);
+}
+
+TEST_F(mapped_vector_test, move_and_errors) {
+    mapped_vector<int> vec(path.c_str());
+    vec.push_back(1);
+    mapped_vector<int> moved(std::move(vec));
+    EXPECT_FALSE(vec.is_open());
+    EXPECT_EQ(moved[0], 1);
+    moved.close();
+    EXPECT_FALSE(moved.is_open());
+
+    EXPECT_THROW(mapped_vector<int>("/nonexistent/microstl", map_mode::read_only), std::system_error);
+    // 3 字节的文件不能按 int 打开
+    FILE *file = fopen(path.c_str(), "w");
+    fputs("abc", file);
+    fclose(file);
+    EXPECT_THROW(mapped_vector<int>(path.c_str()), std::runtime_error);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
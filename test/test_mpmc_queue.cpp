@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../container/mpmc_queue.h"
+
+using namespace MicroSTL;
+
+TEST(mpmc_queue, single_thread) {
+    mpmc_queue<std::string> q(3);
+    EXPECT_EQ(q.capacity(), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(q.try_push(std::to_string(i)));
+    }
+    EXPECT_FALSE(q.try_push("x"));
+    std::string out;
+    for (int round = 0; round < 10; round++) {
+        ASSERT_TRUE(q.try_pop(out));
+        ASSERT_EQ(out, std::to_string(round));
+        ASSERT_TRUE(q.try_emplace(std::to_string(round + 4)));
+    }
+    EXPECT_EQ(q.size(), 4);
+}
+
+TEST(mpmc_queue, batch_operations) {
+    mpmc_queue<int> q(8);
+    int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(q.push_batch(values, 10), 8);
+    EXPECT_EQ(q.push_batch(values, 1), 0);
+    int out[10];
+    EXPECT_EQ(q.pop_batch(out, 5), 5);
+    EXPECT_EQ(out[4], 5);
+    EXPECT_EQ(q.push_batch(values, 10), 5);
+    EXPECT_EQ(q.pop_batch(out, 10), 8);
+    EXPECT_EQ(out[0], 6);
+    EXPECT_EQ(out[7], 5);
+    EXPECT_EQ(q.pop_batch(out, 10), 0);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, many_producers_many_consumers) {
+    const int producers = 4;
+    const int consumers = 4;
+    const long per_producer = 50000;
+    mpmc_queue<long> q(128);
+    std::atomic<long> consumed(0);
+    std::atomic<long> sum(0);
+    std::thread threads[producers + consumers];
+    for (int p = 0; p < producers; p++) {
+        threads[p] = std::thread([&, p] {
+            long batch[4];
+            for (long i = 0; i < per_producer;) {
+                long value = p * per_producer + i;
+                if (p % 2 == 0) {
+                    long n = per_producer - i < 4 ? per_producer - i : 4;
+                    for (long j = 0; j < n; j++) {
+                        batch[j] = value + j;
+                    }
+                    size_t pushed = q.push_batch(batch, n);
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                    i += static_cast<long>(pushed);
+                } else if (q.try_push(value)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads[producers + c] = std::thread([&, c] {
+            long buffer[8];
+            while (consumed.load() < producers * per_producer) {
+                size_t n;
+                if (c % 2 == 0) {
+                    n = q.pop_batch(buffer, 8);
+                } else {
+                    n = q.try_pop(buffer[0]) ? 1 : 0;
+                }
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < n; i++) {
+                    sum += buffer[i];
+                }
+                consumed += static_cast<long>(n);
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    long total = producers * per_producer;
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(q.empty());
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
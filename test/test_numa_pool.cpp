@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../memory/numa_pool.h"
+
+using namespace MicroSTL;
+
+// 在单节点的机器上用虚拟拓扑测试，每个用例结束时恢复
+class numa_pool : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(numa_topology::instance().set_fake("0;1"));
+    }
+
+    void TearDown() override {
+        AllocByNuma::flush_thread_cache();
+        numa_bind_thread(-1);
+        numa_topology::instance().reset();
+    }
+};
+
+TEST_F(numa_pool, fake_topology) {
+    numa_topology &topology = numa_topology::instance();
+    EXPECT_TRUE(topology.set_fake("0-1,4;2-3;5"));
+    EXPECT_TRUE(topology.is_fake());
+    EXPECT_EQ(topology.node_count(), 3);
+    EXPECT_EQ(topology.node_of_cpu(0), 0);
+    EXPECT_EQ(topology.node_of_cpu(4), 0);
+    EXPECT_EQ(topology.node_of_cpu(3), 1);
+    EXPECT_EQ(topology.node_of_cpu(5), 2);
+
+    // 格式错误时保持原有拓扑
+    EXPECT_FALSE(topology.set_fake("0-x;1"));
+    EXPECT_FALSE(topology.set_fake("3-1"));
+    EXPECT_FALSE(topology.set_fake(""));
+    EXPECT_EQ(topology.node_count(), 3);
+
+    topology.reset();
+    EXPECT_FALSE(topology.is_fake());
+    EXPECT_GE(topology.node_count(), 1);
+}
+
+TEST_F(numa_pool, current_node) {
+    int cpu = sched_getcpu();
+    ASSERT_GE(cpu, 0);
+    // 把当前 cpu 放到节点 1
+    std::string spec = ";" + std::to_string(cpu);
+    ASSERT_TRUE(numa_topology::instance().set_fake(spec));
+    EXPECT_EQ(numa_current_node(), 1);
+    numa_bind_thread(0);
+    EXPECT_EQ(numa_current_node(), 0);
+    numa_bind_thread(-1);
+    EXPECT_EQ(numa_current_node(), 1);
+}
+
+TEST_F(numa_pool, local_allocation) {
+    for (int node = 0; node < 2; node++) {
+        numa_bind_thread(node);
+        std::vector<void *> blocks;
+        for (size_t size = 1; size <= 128; size += 7) {
+            void *ptr = AllocByNuma::allocate(size);
+            memset(ptr, 0xAB, size);
+            EXPECT_EQ(AllocByNuma::node_of(ptr), node);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % ALIGN, 0);
+            blocks.push_back(ptr);
+        }
+        size_t size = 1;
+        for (void *ptr: blocks) {
+            AllocByNuma::deallocate(ptr, size);
+            size += 7;
+        }
+        EXPECT_GE(AllocByNuma::stats(node).chunks, 1);
+    }
+}
+
+TEST_F(numa_pool, reuse_after_free) {
+    numa_bind_thread(0);
+    void *first = AllocByNuma::allocate(24);
+    AllocByNuma::deallocate(first, 24);
+    EXPECT_EQ(AllocByNuma::allocate(24), first);
+    AllocByNuma::deallocate(first, 24);
+}
+
+TEST_F(numa_pool, remote_free) {
+    numa_bind_thread(1);
+    void *ptr = AllocByNuma::allocate(48);
+    ASSERT_EQ(AllocByNuma::node_of(ptr), 1);
+
+    size_t before = AllocByNuma::stats(1).remote_frees;
+    std::thread other([ptr] {
+        numa_bind_thread(0);
+        AllocByNuma::deallocate(ptr, 48);
+        // 节点 0 的线程不会拿到节点 1 的 block
+        void *local = AllocByNuma::allocate(48);
+        EXPECT_EQ(AllocByNuma::node_of(local), 0);
+        AllocByNuma::deallocate(local, 48);
+    });
+    other.join();
+    EXPECT_EQ(AllocByNuma::stats(1).remote_frees, before + 1);
+}
+
+TEST_F(numa_pool, migration_flushes_cache) {
+    numa_bind_thread(0);
+    void *ptr = AllocByNuma::allocate(16);
+    AllocByNuma::deallocate(ptr, 16);
+    numa_bind_thread(1);
+    void *moved = AllocByNuma::allocate(16);
+    EXPECT_EQ(AllocByNuma::node_of(moved), 1);
+    AllocByNuma::deallocate(moved, 16);
+}
+
+TEST_F(numa_pool, large_and_reallocate) {
+    numa_bind_thread(0);
+    char *ptr = static_cast<char *>(AllocByNuma::allocate(100));
+    strcpy(ptr, "numa");
+    ptr = static_cast<char *>(AllocByNuma::reallocate(ptr, 100, 4096));
+    EXPECT_STREQ(ptr, "numa");
+    ptr = static_cast<char *>(AllocByNuma::reallocate(ptr, 4096, 8));
+    EXPECT_EQ(memcmp(ptr, "numa", 4), 0);
+    AllocByNuma::deallocate(ptr, 8);
+}
+
+TEST_F(numa_pool, threads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t] {
+            numa_bind_thread(t % 2);
+            std::vector<void *> blocks;
+            for (int round = 0; round < 50; round++) {
+                for (int i = 0; i < 200; i++) {
+                    void *ptr = AllocByNuma::allocate(8 + i % 120);
+                    *static_cast<int *>(ptr) = t;
+                    blocks.push_back(ptr);
+                }
+                for (size_t i = 0; i < blocks.size(); i++) {
+                    EXPECT_EQ(*static_cast<int *>(blocks[i]), t);
+                    EXPECT_EQ(AllocByNuma::node_of(blocks[i]), t % 2);
+                    AllocByNuma::deallocate(blocks[i], 8 + i % 120);
+                }
+                blocks.clear();
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../algorithm/numeric.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+template<typename T>
+std::vector<T> random_input(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<T> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = static_cast<T>(static_cast<int>(rng() % 200) - 100);
+    }
+    return result;
+}
+
+// 只有前进能力的迭代器，用于测试非随机访问的路径
+struct forward_int_iterator {
+    using iterator_category = forward_iterator_tag;
+    using value_type = int;
+    using difference_type = ptrdiff_t;
+    using pointer = int *;
+    using reference = int &;
+
+    int *ptr;
+
+    int &operator*() const { return *ptr; }
+
+    forward_int_iterator &operator++() {
+        ++ptr;
+        return *this;
+    }
+
+    bool operator==(const forward_int_iterator &obj) const { return ptr == obj.ptr; }
+
+    bool operator!=(const forward_int_iterator &obj) const { return ptr != obj.ptr; }
+};
+
+// 各种长度，覆盖向量主循环、单块循环与标量尾部
+const size_t sizes[] = {0, 1, 3, 7, 8, 31, 32, 33, 64, 100, 127, 128, 129, 1000};
+
+template<typename T>
+void check_exact_kernels() {
+    for (size_t size: sizes) {
+        std::vector<T> a = random_input<T>(size, size);
+        std::vector<T> b = random_input<T>(size, size + 1);
+        EXPECT_EQ(MicroSTL::accumulate(a.data(), a.data() + size, T(3)),
+                  std::accumulate(a.begin(), a.end(), T(3)));
+        EXPECT_EQ(MicroSTL::reduce(a.data(), a.data() + size, T(3)),
+                  std::accumulate(a.begin(), a.end(), T(3)));
+        EXPECT_EQ(MicroSTL::inner_product(a.data(), a.data() + size, b.data(), T(1)),
+                  std::inner_product(a.begin(), a.end(), b.begin(), T(1)));
+        EXPECT_EQ(MicroSTL::transform_reduce(a.data(), a.data() + size, b.data(), T(1)),
+                  std::inner_product(a.begin(), a.end(), b.begin(), T(1)));
+
+        std::vector<T> expected(size);
+        std::vector<T> result(size);
+        std::partial_sum(a.begin(), a.end(), expected.begin());
+        EXPECT_EQ(MicroSTL::partial_sum(a.data(), a.data() + size, result.data()), result.data() + size);
+        EXPECT_EQ(result, expected);
+        MicroSTL::inclusive_scan(a.data(), a.data() + size, result.data());
+        EXPECT_EQ(result, expected);
+
+        std::exclusive_scan(a.begin(), a.end(), expected.begin(), T(5));
+        MicroSTL::exclusive_scan(a.data(), a.data() + size, result.data(), T(5));
+        EXPECT_EQ(result, expected);
+
+        // 原地扫描
+        std::vector<T> in_place = a;
+        MicroSTL::exclusive_scan(in_place.data(), in_place.data() + size, in_place.data(), T(5));
+        EXPECT_EQ(in_place, expected);
+        in_place = a;
+        std::inclusive_scan(a.begin(), a.end(), expected.begin());
+        MicroSTL::inclusive_scan(in_place.data(), in_place.data() + size, in_place.data());
+        EXPECT_EQ(in_place, expected);
+    }
+}
+
+TEST(numeric, integer_kernels) {
+    check_exact_kernels<int8_t>();
+    check_exact_kernels<uint16_t>();
+    check_exact_kernels<int>();
+    check_exact_kernels<unsigned>();
+    check_exact_kernels<int64_t>();
+    check_exact_kernels<uint64_t>();
+}
+
+template<typename T>
+void check_floating_kernels() {
+    for (size_t size: sizes) {
+        std::vector<T> a = random_input<T>(size, size);
+        std::vector<T> b = random_input<T>(size, size + 1);
+        for (size_t i = 0; i < size; i++) {
+            a[i] /= 8;
+        }
+        // 元素都是 1/8 的整数倍，求和没有舍入误差
+        EXPECT_EQ(MicroSTL::reduce(a.data(), a.data() + size, T(1)), std::accumulate(a.begin(), a.end(), T(1)));
+        EXPECT_EQ(MicroSTL::transform_reduce(a.data(), a.data() + size, b.data(), T(0)),
+                  std::inner_product(a.begin(), a.end(), b.begin(), T(0)));
+        EXPECT_EQ(MicroSTL::accumulate(a.data(), a.data() + size, T(1)), std::accumulate(a.begin(), a.end(), T(1)));
+
+        std::vector<T> expected(size);
+        std::vector<T> result(size);
+        std::inclusive_scan(a.begin(), a.end(), expected.begin(), std::plus<T>(), T(2));
+        MicroSTL::inclusive_scan(a.data(), a.data() + size, result.data(), plus<T>(), T(2));
+        EXPECT_EQ(result, expected);
+        std::exclusive_scan(a.begin(), a.end(), expected.begin(), T(2));
+        MicroSTL::exclusive_scan(a.data(), a.data() + size, a.data(), T(2));
+        EXPECT_EQ(a, expected);
+    }
+}
+
+TEST(numeric, floating_kernels) {
+    check_floating_kernels<float>();
+    check_floating_kernels<double>();
+}
+
+TEST(numeric, accumulate_is_ordered) {
+    // 浮点数的 accumulate 必须按顺序计算
+    std::vector<float> data(1000, 1e-8f);
+    data[0] = 1.0f;
+    EXPECT_EQ(MicroSTL::accumulate(data.data(), data.data() + data.size(), 0.0f),
+              std::accumulate(data.begin(), data.end(), 0.0f));
+}
+
+TEST(numeric, custom_operation) {
+    std::vector<int> data = random_input<int>(100, 1);
+    EXPECT_EQ(MicroSTL::accumulate(data.data(), data.data() + 10, 1, multiplies<int>()),
+              std::accumulate(data.begin(), data.begin() + 10, 1, std::multiplies<int>()));
+    EXPECT_EQ(MicroSTL::reduce(data.data(), data.data() + data.size(), 0, [](int a, int b) { return a > b ? a : b; }),
+              *std::max_element(data.begin(), data.end()));
+    EXPECT_EQ(MicroSTL::transform_reduce(data.data(), data.data() + data.size(), 0L, plus<long>(),
+                                         [](int x) { return long(x) * x; }),
+              std::transform_reduce(data.begin(), data.end(), 0L, std::plus<long>(),
+                                    [](int x) { return long(x) * x; }));
+
+    std::vector<int> expected(data.size());
+    std::vector<int> result(data.size());
+    std::partial_sum(data.begin(), data.end(), expected.begin(), std::minus<int>());
+    MicroSTL::partial_sum(data.data(), data.data() + data.size(), result.data(), minus<int>());
+    EXPECT_EQ(result, expected);
+}
+
+TEST(numeric, forward_iterator) {
+    std::vector<int> data = random_input<int>(100, 2);
+    forward_int_iterator first = {data.data()};
+    forward_int_iterator last = {data.data() + data.size()};
+    int sum = std::accumulate(data.begin(), data.end(), 0);
+    EXPECT_EQ(MicroSTL::accumulate(first, last, 0), sum);
+    EXPECT_EQ(MicroSTL::reduce(first, last), sum);
+    EXPECT_EQ(MicroSTL::parallel_reduce(first, last, 0), sum);
+
+    std::vector<int> result(data.size());
+    forward_int_iterator out = {result.data()};
+    MicroSTL::parallel_inclusive_scan(first, last, out);
+    EXPECT_EQ(result.back(), sum);
+}
+
+TEST(numeric, vector) {
+    MicroSTL::vector<double> data;
+    for (int i = 1; i <= 100; i++) {
+        data.push_back(i);
+    }
+    EXPECT_EQ(MicroSTL::reduce(data.begin(), data.end()), 5050);
+    EXPECT_EQ(MicroSTL::inner_product(data.begin(), data.end(), data.begin(), 0.0), 338350);
+}
+
+TEST(numeric, scalar_kernels) {
+    std::vector<int> a = random_input<int>(100, 3);
+    std::vector<int> b = random_input<int>(100, 4);
+    EXPECT_EQ(_unrolled_sum(a.data(), a.size()), std::accumulate(a.begin(), a.end(), 0));
+    EXPECT_EQ(_unrolled_dot(a.data(), b.data(), a.size()), std::inner_product(a.begin(), a.end(), b.begin(), 0));
+}
+
+TEST(numeric, parallel_reduce) {
+    std::vector<int64_t> data = random_input<int64_t>(300000, 5);
+    int64_t expected = std::accumulate(data.begin(), data.end(), int64_t(7));
+    for (unsigned threads: {0u, 1u, 2u, 3u, 8u}) {
+        EXPECT_EQ(MicroSTL::parallel_reduce(data.data(), data.data() + data.size(), int64_t(7),
+                                            plus<int64_t>(), threads), expected);
+    }
+    EXPECT_EQ(MicroSTL::parallel_reduce(data.data(), data.data() + 10, int64_t(7)),
+              std::accumulate(data.begin(), data.begin() + 10, int64_t(7)));
+}
+
+TEST(numeric, parallel_scan) {
+    for (size_t size: {size_t(0), size_t(1000), size_t(300001)}) {
+        std::vector<int> data = random_input<int>(size, 6);
+        std::vector<int> expected(size);
+        std::vector<int> result(size);
+        for (unsigned threads: {1u, 2u, 3u, 8u}) {
+            std::inclusive_scan(data.begin(), data.end(), expected.begin());
+            EXPECT_EQ(MicroSTL::parallel_inclusive_scan(data.data(), data.data() + size, result.data(),
+                                                        plus<int>(), threads), result.data() + size);
+            EXPECT_EQ(result, expected);
+
+            std::exclusive_scan(data.begin(), data.end(), expected.begin(), 11);
+            MicroSTL::parallel_exclusive_scan(data.data(), data.data() + size, result.data(), 11,
+                                              plus<int>(), threads);
+            EXPECT_EQ(result, expected);
+
+            // 原地扫描
+            result = data;
+            MicroSTL::parallel_exclusive_scan(result.data(), result.data() + size, result.data(), 11,
+                                              plus<int>(), threads);
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
+
+TEST(numeric, parallel_scan_custom_operation) {
+    std::vector<unsigned> data = random_input<unsigned>(200000, 7);
+    std::vector<unsigned> expected(data.size());
+    std::vector<unsigned> result(data.size());
+    auto op = [](unsigned a, unsigned b) { return a ^ b; };
+    std::inclusive_scan(data.begin(), data.end(), expected.begin(), op);
+    MicroSTL::parallel_inclusive_scan(data.data(), data.data() + data.size(), result.data(), op, 4);
+    EXPECT_EQ(result, expected);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
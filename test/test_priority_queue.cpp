@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../adaptor/priority_queue.h"
+
+using namespace MicroSTL;
+
+std::vector<int> random_input(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<int> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = static_cast<int>(rng() % 10000);
+    }
+    return result;
+}
+
+template<typename Queue>
+std::vector<int> drain(Queue &queue) {
+    std::vector<int> result;
+    while (!queue.empty()) {
+        result.push_back(queue.top());
+        queue.pop();
+    }
+    return result;
+}
+
+template<size_t Arity>
+void check_push_pop() {
+    std::vector<int> input = random_input(1000, 1);
+    priority_queue<int, vector<int>, less<int>, Arity> queue;
+    EXPECT_TRUE(queue.empty());
+    for (int x: input) {
+        queue.push(x);
+    }
+    EXPECT_EQ(queue.size(), input.size());
+
+    std::sort(input.begin(), input.end(), std::greater<int>());
+    EXPECT_EQ(drain(queue), input);
+}
+
+TEST(priority_queue, push_and_pop) {
+    check_push_pop<2>();
+    check_push_pop<3>();
+    check_push_pop<4>();
+    check_push_pop<8>();
+}
+
+TEST(priority_queue, min_heap) {
+    std::vector<int> input = random_input(500, 2);
+    priority_queue<int, vector<int>, greater<int>, 4> queue(input.begin(), input.end());
+    std::sort(input.begin(), input.end());
+    EXPECT_EQ(drain(queue), input);
+}
+
+TEST(priority_queue, emplace) {
+    priority_queue<std::string, vector<std::string>, less<std::string>, 4> queue;
+    queue.emplace(3, 'b');
+    queue.emplace("c");
+    queue.emplace(2, 'a');
+    EXPECT_EQ(queue.top(), "c");
+    queue.pop();
+    EXPECT_EQ(queue.top(), "bbb");
+    queue.pop();
+    EXPECT_EQ(queue.top(), "aa");
+}
+
+struct pointee_less {
+    bool operator()(const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) const {
+        return *a < *b;
+    }
+};
+
+TEST(priority_queue, move_only) {
+    priority_queue<std::unique_ptr<int>, vector<std::unique_ptr<int>>, pointee_less, 4> queue;
+    std::vector<int> input = random_input(300, 5);
+    for (int x: input) {
+        queue.emplace(new int(x));
+    }
+    queue.push(std::make_unique<int>(20000));
+    EXPECT_EQ(*queue.top(), 20000);
+    queue.pop();
+
+    std::sort(input.begin(), input.end(), std::greater<int>());
+    for (int x: input) {
+        ASSERT_EQ(*queue.top(), x);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * 记录复制次数，移动构造为 noexcept，扩容时应当移动而不是复制
+ */
+struct counted {
+    static int copies;
+    int value;
+
+    explicit counted(int v) : value(v) {}
+
+    counted(const counted &obj) : value(obj.value) {
+        ++copies;
+    }
+
+    counted(counted &&obj) noexcept: value(obj.value) {}
+
+    counted &operator=(const counted &obj) {
+        value = obj.value;
+        ++copies;
+        return *this;
+    }
+
+    counted &operator=(counted &&obj) noexcept {
+        value = obj.value;
+        return *this;
+    }
+
+    bool operator<(const counted &obj) const {
+        return value < obj.value;
+    }
+};
+
+int counted::copies = 0;
+
+TEST(priority_queue, emplace_does_not_copy) {
+    counted::copies = 0;
+    priority_queue<counted> queue;
+    for (int i = 0; i < 1000; i++) {
+        queue.emplace((i * 7919) % 1000);
+    }
+    for (int i = 999; i >= 0; i--) {
+        ASSERT_EQ(queue.top().value, i);
+        queue.pop();
+    }
+    EXPECT_EQ(counted::copies, 0);
+}
+
+TEST(priority_queue, push_range) {
+    // 覆盖逐个上浮与整体建堆两条路径
+    for (size_t existing: {0, 10, 1000}) {
+        for (size_t added: {0, 1, 5, 1000}) {
+            std::vector<int> a = random_input(existing, 3);
+            std::vector<int> b = random_input(added, 4);
+            priority_queue<int, vector<int>, less<int>, 4> queue(a.begin(), a.end());
+            queue.push_range(b.begin(), b.end());
+            EXPECT_EQ(queue.size(), existing + added);
+
+            a.insert(a.end(), b.begin(), b.end());
+            std::sort(a.begin(), a.end(), std::greater<int>());
+            EXPECT_EQ(drain(queue), a);
+        }
+    }
+}
+
+TEST(priority_queue, interleaved) {
+    std::vector<int> input = random_input(2000, 5);
+    priority_queue<int, vector<int>, less<int>, 4> queue;
+    std::vector<int> reference;
+    for (size_t i = 0; i < input.size(); i++) {
+        queue.push(input[i]);
+        reference.push_back(input[i]);
+        std::push_heap(reference.begin(), reference.end());
+        if (i % 3 == 2) {
+            ASSERT_EQ(queue.top(), reference.front());
+            queue.pop();
+            std::pop_heap(reference.begin(), reference.end());
+            reference.pop_back();
+        }
+    }
+    EXPECT_EQ(queue.size(), reference.size());
+}
+
+TEST(priority_queue, swap) {
+    priority_queue<int> a;
+    priority_queue<int> b;
+    a.push(1);
+    b.push(2);
+    b.push(3);
+    a.swap(b);
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(a.top(), 3);
+    EXPECT_EQ(b.top(), 1);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
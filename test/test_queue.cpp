@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../adaptor/queue.h"
+#include "../adaptor/stack.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(queue, fifo_order) {
+    queue<int> q;
+    EXPECT_TRUE(q.empty());
+    for (int i = 0; i < 1000; i++) {
+        q.push(i);
+    }
+    EXPECT_EQ(q.size(), 1000);
+    EXPECT_EQ(q.front(), 0);
+    EXPECT_EQ(q.back(), 999);
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(q.front(), i);
+        q.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(queue, emplace_and_swap) {
+    queue<std::string> a;
+    queue<std::string> b;
+    a.emplace(3, 'a');
+    b.push("b");
+    b.push("c");
+    a.swap(b);
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(a.front(), "b");
+    EXPECT_EQ(b.front(), "aaa");
+}
+
+TEST(stack, lifo_order) {
+    stack<int> s;
+    for (int i = 0; i < 1000; i++) {
+        s.push(i);
+    }
+    for (int i = 999; i >= 0; i--) {
+        ASSERT_EQ(s.top(), i);
+        s.pop();
+    }
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(stack, vector_as_sequence) {
+    stack<std::string, vector<std::string>> s;
+    s.emplace("x");
+    s.push("y");
+    s.top() += "z";
+    EXPECT_EQ(s.top(), "yz");
+    s.pop();
+    EXPECT_EQ(s.top(), "x");
+    EXPECT_EQ(s.size(), 1);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
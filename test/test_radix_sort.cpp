@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include "../algorithm/radix_sort.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+template<typename T>
+std::vector<T> random_input(size_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> result(size);
+    for (size_t i = 0; i < size; i++) {
+        result[i] = static_cast<T>(rng());
+    }
+    return result;
+}
+
+TEST(radix_sort, unsigned_keys) {
+    for (size_t size: {0, 1, 63, 64, 65, 1000, 100000}) {
+        std::vector<uint32_t> data = random_input<uint32_t>(size, size);
+        std::vector<uint32_t> expected = data;
+        std::sort(expected.begin(), expected.end());
+        radix_sort(data.begin(), data.end());
+        EXPECT_EQ(data, expected);
+
+        std::vector<uint64_t> data64 = random_input<uint64_t>(size, size + 1);
+        std::vector<uint64_t> expected64 = data64;
+        std::sort(expected64.begin(), expected64.end());
+        radix_sort(data64.begin(), data64.end());
+        EXPECT_EQ(data64, expected64);
+    }
+}
+
+TEST(radix_sort, signed_keys) {
+    std::vector<int> data = random_input<int>(10000, 1);
+    data.push_back(INT32_MIN);
+    data.push_back(INT32_MAX);
+    data.push_back(0);
+    data.push_back(-1);
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    radix_sort(data.begin(), data.end());
+    EXPECT_EQ(data, expected);
+
+    std::vector<short> shorts = random_input<short>(5000, 2);
+    std::vector<short> expected_shorts = shorts;
+    std::sort(expected_shorts.begin(), expected_shorts.end());
+    radix_sort(shorts.begin(), shorts.end());
+    EXPECT_EQ(shorts, expected_shorts);
+}
+
+TEST(radix_sort, floating_keys) {
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> dist(0, 1e6);
+    std::vector<double> data;
+    for (int i = 0; i < 20000; i++) {
+        data.push_back(dist(rng));
+    }
+    data.push_back(0.0);
+    data.push_back(-INFINITY);
+    data.push_back(INFINITY);
+    data.push_back(1e-310);
+    std::vector<double> expected = data;
+    std::sort(expected.begin(), expected.end());
+    radix_sort(data.begin(), data.end());
+    EXPECT_EQ(data, expected);
+
+    std::vector<float> floats;
+    for (int i = 0; i < 20000; i++) {
+        floats.push_back(static_cast<float>(dist(rng)));
+    }
+    std::vector<float> expected_floats = floats;
+    std::sort(expected_floats.begin(), expected_floats.end());
+    radix_sort(floats.begin(), floats.end());
+    EXPECT_EQ(floats, expected_floats);
+}
+
+TEST(radix_sort, micro_vector) {
+    MicroSTL::vector<uint64_t> vec;
+    // 时间戳：高位全部相同，这些趟会被跳过
+    for (uint64_t i = 0; i < 50000; i++) {
+        vec.push_back(1700000000000000000ull + (i * 7919) % 50000);
+    }
+    radix_sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(radix_sort_by, stable) {
+    struct record {
+        uint32_t key;
+        std::string payload;
+    };
+    std::mt19937 rng(4);
+    std::vector<record> data;
+    for (int i = 0; i < 5000; i++) {
+        data.push_back({static_cast<uint32_t>(rng() % 300), std::to_string(i)});
+    }
+    std::vector<record> expected = data;
+    std::stable_sort(expected.begin(), expected.end(), [](const record &a, const record &b) {
+        return a.key < b.key;
+    });
+    radix_sort_by(data.begin(), data.end(), [](const record &r) { return r.key; });
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(data[i].key, expected[i].key);
+        ASSERT_EQ(data[i].payload, expected[i].payload);
+    }
+}
+
+TEST(parallel_radix_sort, base) {
+    std::vector<uint64_t> data = random_input<uint64_t>(300000, 5);
+    std::vector<uint64_t> expected = data;
+    std::sort(expected.begin(), expected.end());
+    parallel_radix_sort(data.begin(), data.end(), 4);
+    EXPECT_EQ(data, expected);
+
+    std::vector<int> small_range = random_input<int>(200000, 6);
+    for (int &value: small_range) {
+        value %= 1000;
+    }
+    std::vector<int> expected_small = small_range;
+    std::sort(expected_small.begin(), expected_small.end());
+    parallel_radix_sort(small_range.begin(), small_range.end(), 3);
+    EXPECT_EQ(small_range, expected_small);
+}
+
+TEST(parallel_radix_sort_by, stable) {
+    struct record {
+        double key;
+        int order;
+    };
+    std::mt19937 rng(8);
+    std::vector<record> data;
+    for (int i = 0; i < 200000; i++) {
+        data.push_back({static_cast<double>(static_cast<int>(rng() % 2000) - 1000) / 4, i});
+    }
+    parallel_radix_sort_by(data.begin(), data.end(), [](const record &r) { return r.key; }, 4);
+    for (size_t i = 1; i < data.size(); i++) {
+        ASSERT_LE(data[i - 1].key, data[i].key);
+        if (data[i - 1].key == data[i].key) {
+            ASSERT_LT(data[i - 1].order, data[i].order);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
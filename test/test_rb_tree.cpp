@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "../container/rb_tree.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+using int_tree = rb_tree<int, int, identity<int>, less<int>>;
+
+TEST(rb_tree, insert_unique_random) {
+    int_tree tree;
+    std::set<int> expected;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 5000; i++) {
+        int value = static_cast<int>(rng() % 2000);
+        EXPECT_EQ(tree.insert_unique(value).second, expected.insert(value).second);
+    }
+    EXPECT_TRUE(tree.verify());
+    EXPECT_EQ(tree.size(), expected.size());
+    auto iter = tree.begin();
+    for (int value : expected) {
+        EXPECT_EQ(*iter++, value);
+    }
+    EXPECT_TRUE(iter == tree.end());
+}
+
+TEST(rb_tree, erase_random) {
+    int_tree tree;
+    std::multiset<int> expected;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 4000; i++) {
+        int value = static_cast<int>(rng() % 500);
+        tree.insert_equal(value);
+        expected.insert(value);
+    }
+    for (int i = 0; i < 300; i++) {
+        int value = static_cast<int>(rng() % 500);
+        EXPECT_EQ(tree.erase(value), expected.erase(value));
+        if (i % 50 == 0) {
+            EXPECT_TRUE(tree.verify());
+        }
+    }
+    EXPECT_TRUE(tree.verify());
+    EXPECT_EQ(tree.size(), expected.size());
+    while (!tree.empty()) {
+        tree.erase(tree.begin());
+    }
+    EXPECT_TRUE(tree.verify());
+    EXPECT_TRUE(tree.begin() == tree.end());
+}
+
+TEST(rb_tree, iterate_backward) {
+    int_tree tree;
+    for (int i = 0; i < 100; i++) {
+        tree.insert_unique(i);
+    }
+    auto iter = tree.end();
+    for (int i = 99; i >= 0; i--) {
+        EXPECT_EQ(*--iter, i);
+    }
+    EXPECT_TRUE(iter == tree.begin());
+}
+
+TEST(rb_tree, hinted_insert) {
+    int_tree tree;
+    for (int i = 0; i < 1000; i++) {
+        tree.insert_unique(tree.end(), i);
+    }
+    EXPECT_TRUE(tree.verify());
+    EXPECT_EQ(tree.size(), 1000);
+
+    // 降序插入时以 begin() 为提示
+    int_tree reverse;
+    for (int i = 1000; i > 0; i--) {
+        reverse.insert_unique(reverse.begin(), i);
+    }
+    EXPECT_TRUE(reverse.verify());
+    EXPECT_EQ(*reverse.begin(), 1);
+
+    // 错误的提示不影响结果
+    std::mt19937 rng(3);
+    int_tree random;
+    for (int i = 0; i < 1000; i++) {
+        random.insert_equal(random.begin(), static_cast<int>(rng() % 100));
+        random.insert_unique(random.end(), static_cast<int>(rng() % 100) + 1000);
+    }
+    EXPECT_TRUE(random.verify());
+
+    // 在两个元素之间插入
+    int_tree middle;
+    middle.insert_unique(10);
+    middle.insert_unique(30);
+    auto iter = middle.insert_unique(middle.find(30), 20);
+    EXPECT_EQ(*iter, 20);
+    EXPECT_EQ(*middle.insert_unique(middle.find(30), 20), 20);
+    EXPECT_EQ(middle.size(), 3);
+    EXPECT_TRUE(middle.verify());
+}
+
+TEST(rb_tree, build_from_sorted) {
+    for (int size = 0; size < 300; size++) {
+        vector<int> values;
+        for (int i = 0; i < size; i++) {
+            values.push_back(i * 2);
+        }
+        int_tree tree;
+        tree.insert_unique(values.begin(), values.end());
+        EXPECT_TRUE(tree.verify()) << size;
+        EXPECT_EQ(tree.size(), size);
+        EXPECT_TRUE(tree.find(size) == tree.end() || size % 2 == 0);
+    }
+
+    // 非严格递增时 insert_equal 仍然可以 O(n) 建树，insert_unique 退化为逐个插入
+    int values[] = {1, 1, 2, 3, 3, 3, 4};
+    int_tree equal;
+    equal.insert_equal(values, values + 7);
+    EXPECT_TRUE(equal.verify());
+    EXPECT_EQ(equal.count(3), 3);
+    int_tree unique;
+    unique.insert_unique(values, values + 7);
+    EXPECT_TRUE(unique.verify());
+    EXPECT_EQ(unique.size(), 4);
+
+    int unsorted[] = {5, 3, 9, 1};
+    int_tree tree;
+    tree.insert_unique(unsorted, unsorted + 4);
+    EXPECT_TRUE(tree.verify());
+    EXPECT_EQ(*tree.begin(), 1);
+}
+
+TEST(rb_tree, bounds) {
+    int_tree tree;
+    for (int i = 0; i < 10; i++) {
+        tree.insert_equal(i * 10);
+        tree.insert_equal(i * 10);
+    }
+    EXPECT_EQ(*tree.lower_bound(15), 20);
+    EXPECT_EQ(*tree.upper_bound(20), 30);
+    EXPECT_TRUE(tree.lower_bound(100) == tree.end());
+    EXPECT_EQ(tree.count(40), 2);
+    EXPECT_EQ(tree.count(45), 0);
+    EXPECT_TRUE(tree.find(45) == tree.end());
+}
+
+TEST(rb_tree, copy_move_swap) {
+    rb_tree<std::string, std::string, identity<std::string>, less<std::string>> tree;
+    for (int i = 0; i < 200; i++) {
+        tree.insert_unique(std::to_string(i));
+    }
+    auto copy = tree;
+    EXPECT_TRUE(copy.verify());
+    EXPECT_EQ(copy.size(), 200);
+    EXPECT_TRUE(copy.find("42") != copy.end());
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(moved.verify());
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(copy.verify());
+
+    decltype(tree) other;
+    other.insert_unique("x");
+    other.swap(moved);
+    EXPECT_EQ(other.size(), 200);
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_TRUE(other.verify());
+    EXPECT_TRUE(moved.verify());
+
+    copy = other;
+    EXPECT_EQ(copy.size(), 200);
+    copy.clear();
+    EXPECT_TRUE(copy.verify());
+    copy.insert_unique("after clear");
+    EXPECT_EQ(copy.size(), 1);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
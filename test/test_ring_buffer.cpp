@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "../container/ring_buffer.h"
+#include "../container/spsc_queue.h"
+#include "../container/vector.h"
+
+using namespace MicroSTL;
+
+TEST(ring_buffer, capacity_is_power_of_two) {
+    ring_buffer<int> r(5);
+    EXPECT_EQ(r.capacity(), 8);
+    EXPECT_TRUE(r.empty());
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(r.push_back(i));
+    }
+    EXPECT_TRUE(r.full());
+    EXPECT_FALSE(r.push_back(8));
+    EXPECT_EQ(r.front(), 0);
+    EXPECT_EQ(r.back(), 7);
+}
+
+TEST(ring_buffer, wraps_around) {
+    ring_buffer<std::string> r(4);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 100; round++) {
+        while (r.emplace_back(std::to_string(next))) {
+            next++;
+        }
+        std::string value;
+        ASSERT_TRUE(r.pop_front(value));
+        ASSERT_EQ(value, std::to_string(expected++));
+        r.pop_front();
+        expected++;
+    }
+    EXPECT_EQ(r.size(), 2);
+    EXPECT_EQ(r[0], std::to_string(expected));
+    EXPECT_EQ(r[1], std::to_string(expected + 1));
+}
+
+TEST(ring_buffer, overwrite_copy_and_clear) {
+    ring_buffer<int> r(4);
+    for (int i = 0; i < 10; i++) {
+        r.push_overwrite(i);
+    }
+    EXPECT_EQ(r.size(), 4);
+    EXPECT_EQ(r.front(), 6);
+    ring_buffer<int> copy(r);
+    EXPECT_EQ(copy.back(), 9);
+    r.clear();
+    EXPECT_TRUE(r.empty());
+    int out;
+    EXPECT_FALSE(r.pop_front(out));
+    r = copy;
+    EXPECT_EQ(r.size(), 4);
+}
+
+TEST(spsc_queue, single_thread) {
+    spsc_queue<std::string> q(4);
+    EXPECT_TRUE(q.try_push("a"));
+    EXPECT_TRUE(q.try_emplace(2, 'b'));
+    EXPECT_EQ(q.size(), 2);
+    EXPECT_EQ(*q.front(), "a");
+    q.pop();
+    std::string out;
+    EXPECT_TRUE(q.try_pop(out));
+    EXPECT_EQ(out, "bb");
+    EXPECT_FALSE(q.try_pop(out));
+    EXPECT_EQ(q.front(), nullptr);
+
+    std::string batch[] = {"1", "2", "3", "4", "5"};
+    EXPECT_EQ(q.push_batch(batch, 5), 4);
+    EXPECT_FALSE(q.try_push("6"));
+    vector<std::string> result(3, std::string());
+    EXPECT_EQ(q.pop_batch(result.begin(), 3), 3);
+    EXPECT_EQ(result[2], "3");
+    // 析构时还剩一个元素
+}
+
+TEST(spsc_queue, two_threads_preserve_order) {
+    const long count = 100000;
+    spsc_queue<long> q(256);
+    std::thread producer([&] {
+        long batch[8];
+        for (long i = 0; i < count;) {
+            if (i % 3 == 0) {
+                long n = count - i < 8 ? count - i : 8;
+                for (long j = 0; j < n; j++) {
+                    batch[j] = i + j;
+                }
+                i += static_cast<long>(q.push_batch(batch, n));
+            } else if (q.try_push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    long expected = 0;
+    long buffer[16];
+    while (expected < count) {
+        size_t n = q.pop_batch(buffer, 16);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++) {
+            ASSERT_EQ(buffer[i], expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
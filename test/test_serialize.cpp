@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../utility/serialize.h"
+
+using namespace MicroSTL;
+
+struct point {
+    int x;
+    int y;
+    double weight;
+};
+
+/**
+ * 内存中的临时文件，读写位置在每个用例开始时为 0
+ */
+static int temp_fd() {
+    return memfd_create("microstl_serialize", 0);
+}
+
+TEST(serialize, vector_round_trip) {
+    vector<point> vec;
+    for (int i = 0; i < 5000; i++) {
+        vec.push_back(point{i, -i, i * 0.25});
+    }
+    int fd = temp_fd();
+    write_vector(fd, vec);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), static_cast<off_t>(serialized_size(vec)));
+    lseek(fd, 0, SEEK_SET);
+    vector<point> copy = read_vector<point>(fd);
+    ASSERT_EQ(copy.size(), vec.size());
+    for (size_t i = 0; i < vec.size(); i++) {
+        EXPECT_EQ(copy[i].x, vec[i].x);
+        EXPECT_EQ(copy[i].weight, vec[i].weight);
+    }
+
+    // 空 vector 只有头部
+    lseek(fd, 0, SEEK_SET);
+    write_vector(fd, vector<point>());
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_TRUE(read_vector<point>(fd).empty());
+    close(fd);
+}
+
+TEST(serialize, view_over_buffer) {
+    vector<int> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i * i);
+    }
+    vector<unsigned char> buffer;
+    buffer.resize_for_overwrite(serialized_size(vec));
+    EXPECT_EQ(serialize(vec, buffer.data()), buffer.size());
+
+    serial_view<int> view(buffer.data(), buffer.size());
+    EXPECT_EQ(view.size(), 100);
+    // 元素直接引用缓冲区
+    EXPECT_EQ(reinterpret_cast<const unsigned char *>(view.data()), buffer.data() + SERIAL_HEADER_BYTES);
+    EXPECT_EQ(view[9], 81);
+    int sum = 0;
+    for (int value: view) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 328350);
+    vector<int> owned = view.to_vector();
+    EXPECT_EQ(owned[99], 9801);
+}
+
+TEST(serialize, header_checks) {
+    vector<int> vec(10, 1);
+    vector<unsigned char> buffer;
+    buffer.resize_for_overwrite(serialized_size(vec));
+    serialize(vec, buffer.data());
+
+    // 元素大小不同
+    EXPECT_THROW(serial_view<long>(buffer.data(), buffer.size()), serial_error);
+    // 长度不足
+    EXPECT_THROW(serial_view<int>(buffer.data(), buffer.size() - 1), serial_error);
+    EXPECT_THROW(serial_view<int>(buffer.data(), 10), serial_error);
+    // 版本号不支持
+    buffer[4] = 99;
+    EXPECT_THROW(serial_view<int>(buffer.data(), buffer.size()), serial_error);
+    buffer[4] = SERIAL_VERSION;
+    // 魔数错误
+    buffer[0] = 0;
+    EXPECT_THROW(serial_view<int>(buffer.data(), buffer.size()), serial_error);
+
+    // 截断的文件
+    int fd = temp_fd();
+    write_vector(fd, vec);
+    ftruncate(fd, SERIAL_HEADER_BYTES + 8);
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(read_vector<int>(fd), serial_error);
+    // vector 与 list 的格式不能混用
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(read_list<int>(fd), serial_error);
+    close(fd);
+}
+
+TEST(serialize, forged_count) {
+    vector<long> vec(1, 7);
+    vector<unsigned char> buffer;
+    buffer.resize_for_overwrite(serialized_size(vec));
+    serialize(vec, buffer.data());
+    serial_header header;
+    memcpy(&header, buffer.data(), sizeof(header));
+
+    // count * sizeof(T) 溢出为很小的值，管道不能定位，只能靠溢出检查
+    header.count = (uint64_t(1) << 61) + 1;
+    memcpy(buffer.data(), &header, sizeof(header));
+    int pipe_fd[2];
+    ASSERT_EQ(pipe(pipe_fd), 0);
+    ASSERT_EQ(write(pipe_fd[1], buffer.data(), buffer.size()), static_cast<ssize_t>(buffer.size()));
+    close(pipe_fd[1]);
+    EXPECT_THROW(read_vector<long>(pipe_fd[0]), serial_error);
+    close(pipe_fd[0]);
+
+    // 不溢出但超过文件剩余的字节数，读取前就拒绝，不按伪造的个数申请内存
+    header.count = uint64_t(1) << 40;
+    memcpy(buffer.data(), &header, sizeof(header));
+    int fd = temp_fd();
+    ASSERT_EQ(write(fd, buffer.data(), buffer.size()), static_cast<ssize_t>(buffer.size()));
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(read_vector<long>(fd), serial_error);
+    header.kind = static_cast<uint16_t>(serial_kind::list);
+    memcpy(buffer.data(), &header, sizeof(header));
+    pwrite(fd, buffer.data(), SERIAL_HEADER_BYTES, 0);
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(read_list<long>(fd), serial_error);
+    close(fd);
+}
+
+TEST(serialize, mapped_file_view) {
+    vector<double> vec;
+    for (int i = 0; i < 10000; i++) {
+        vec.push_back(i / 2.0);
+    }
+    char name[] = "/tmp/microstl_serial_XXXXXX";
+    int fd = mkstemp(name);
+    write_vector(fd, vec);
+    close(fd);
+    {
+        serial_file file(name);
+        serial_view<double> view = file.view<double>();
+        EXPECT_EQ(view.size(), 10000);
+        EXPECT_EQ(view[9999], 4999.5);
+    }
+    unlink(name);
+}
+
+TEST(serialize, list_stream) {
+    list<point> lst;
+    // 超过一个批次
+    for (int i = 0; i < 10000; i++) {
+        lst.push_back(point{i, i + 1, 0.5});
+    }
+    int fd = temp_fd();
+    // 前面已有其他数据时头部仍能回填
+    write_vector(fd, vector<int>(3, 7));
+    write_list(fd, lst);
+    lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(read_vector<int>(fd).size(), 3);
+    list<point> copy = read_list<point>(fd);
+    EXPECT_EQ(copy.size(), 10000);
+    int expected = 0;
+    for (auto &item: copy) {
+        EXPECT_EQ(item.x, expected);
+        EXPECT_EQ(item.y, expected + 1);
+        expected++;
+    }
+    close(fd);
+}
+
+TEST(vector, resize_for_overwrite) {
+    vector<int> vec(3, 1);
+    vec.resize_for_overwrite(100);
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec[2], 1);
+    vec[99] = 5;
+    vec.resize_for_overwrite(2);
+    EXPECT_EQ(vec.size(), 2);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
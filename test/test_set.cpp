@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include "../container/set.h"
+
+using namespace MicroSTL;
+
+TEST(set, insert_and_find) {
+    set<int> s;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(s.insert(i).second);
+        EXPECT_FALSE(s.insert(i).second);
+    }
+    EXPECT_EQ(s.size(), 100);
+    EXPECT_TRUE(s.contains(50));
+    EXPECT_FALSE(s.contains(100));
+    EXPECT_EQ(*s.find(7), 7);
+    EXPECT_TRUE(s.emplace(100).second);
+}
+
+TEST(set, ordered_iteration) {
+    set<std::string> s;
+    std::set<std::string> expected;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 1000; i++) {
+        std::string value = std::to_string(rng() % 500);
+        s.insert(value);
+        expected.insert(value);
+    }
+    EXPECT_EQ(s.size(), expected.size());
+    auto iter = s.begin();
+    for (auto &value : expected) {
+        EXPECT_EQ(*iter++, value);
+    }
+    EXPECT_TRUE(iter == s.end());
+}
+
+TEST(set, sorted_range_and_erase) {
+    int values[] = {1, 3, 5, 7, 9, 11};
+    set<int> s(values, values + 6);
+    EXPECT_EQ(s.size(), 6);
+    EXPECT_EQ(*s.lower_bound(4), 5);
+    EXPECT_EQ(*s.upper_bound(5), 7);
+    EXPECT_EQ(s.erase(5), 1);
+    s.erase(s.begin());
+    EXPECT_EQ(*s.begin(), 3);
+    s.clear();
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(multiset, equal_values) {
+    multiset<int> s;
+    for (int i = 0; i < 10; i++) {
+        s.insert(i % 3);
+    }
+    EXPECT_EQ(s.count(0), 4);
+    EXPECT_EQ(s.count(1), 3);
+    auto range = s.equal_range(2);
+    int count = 0;
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        EXPECT_EQ(*iter, 2);
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(s.erase(0), 4);
+    EXPECT_EQ(s.size(), 6);
+
+    multiset<int> other;
+    other.swap(s);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(other.size(), 6);
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../container/shared_vector.h"
+
+using namespace MicroSTL;
+
+// 统计存活的元素个数，用于检查旧版本是否被释放
+struct tracked {
+    static std::atomic<int> alive;
+    int value;
+
+    tracked(int v) : value(v) {
+        ++alive;
+    }
+
+    tracked(const tracked &obj) : value(obj.value) {
+        ++alive;
+    }
+
+    tracked &operator=(const tracked &) = default;
+
+    ~tracked() {
+        --alive;
+    }
+};
+
+std::atomic<int> tracked::alive(0);
+
+TEST(shared_vector, copy_is_shared) {
+    vector<std::string> source;
+    source.push_back("a");
+    source.push_back("b");
+    shared_vector<std::string> first(source);
+    EXPECT_EQ(first.size(), 2);
+    EXPECT_EQ(first[1], "b");
+    EXPECT_EQ(first.use_count(), 1);
+
+    shared_vector<std::string> second = first;
+    EXPECT_TRUE(second.same_storage(first));
+    EXPECT_EQ(first.use_count(), 2);
+    EXPECT_EQ(second.data(), first.data());
+
+    // 修改只发生在私有副本上
+    vector<std::string> draft = second.to_vector();
+    draft.push_back("c");
+    shared_vector<std::string> third(draft);
+    EXPECT_EQ(first.size(), 2);
+    EXPECT_EQ(third.size(), 3);
+    EXPECT_EQ(third.back(), "c");
+    EXPECT_THROW(third.at(3), std::out_of_range);
+
+    shared_vector<std::string> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(shared_vector, released_by_last_owner) {
+    {
+        vector<tracked> source;
+        for (int i = 0; i < 10; i++) {
+            source.push_back(tracked(i));
+        }
+        shared_vector<tracked> snapshot(source);
+        EXPECT_EQ(tracked::alive, 20);
+        {
+            shared_vector<tracked> copy = snapshot;
+            shared_vector<tracked> moved = std::move(copy);
+            EXPECT_EQ(tracked::alive, 20);
+        }
+        EXPECT_EQ(snapshot.use_count(), 1);
+    }
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(atomic_shared_vector, publish_and_reclaim) {
+    {
+        atomic_shared_vector<tracked> cell;
+        EXPECT_TRUE(cell.load().empty());
+
+        vector<tracked> source(5, tracked(1));
+        cell.store(shared_vector<tracked>(source));
+        source.clear();
+        shared_vector<tracked> reader = cell.load();
+        EXPECT_EQ(reader.size(), 5);
+        EXPECT_EQ(reader.use_count(), 2);
+
+        // 发布新版本后，旧版本仍由 reader 持有
+        cell.update([](vector<tracked> &draft) {
+            draft.push_back(tracked(2));
+        });
+        epoch_reclaim();
+        EXPECT_EQ(reader.size(), 5);
+        EXPECT_EQ(reader[0].value, 1);
+        EXPECT_EQ(cell.load().size(), 6);
+        EXPECT_EQ(tracked::alive, 11);
+
+        // 最后一个读者释放后，旧版本在 epoch 回收时析构
+        reader = shared_vector<tracked>();
+        epoch_reclaim();
+        EXPECT_EQ(tracked::alive, 6);
+
+        shared_vector<tracked> stale = cell.load();
+        cell.store(shared_vector<tracked>());
+        EXPECT_FALSE(cell.compare_exchange(stale, shared_vector<tracked>()));
+        shared_vector<tracked> now = cell.load();
+        EXPECT_TRUE(now.empty());
+        stale = shared_vector<tracked>();
+        epoch_reclaim();
+        EXPECT_EQ(tracked::alive, 0);
+    }
+    EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(atomic_shared_vector, concurrent_readers) {
+    const int versions = 200;
+    atomic_shared_vector<long> cell(shared_vector<long>(vector<long>(64, 0)));
+    std::atomic<bool> done(false);
+    std::atomic<long> observed(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&] {
+            long last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                shared_vector<long> snapshot = cell.load();
+                // 同一个版本的所有元素相同，版本号单调不减
+                long version = snapshot.front();
+                for (long value: snapshot) {
+                    ASSERT_EQ(value, version);
+                }
+                ASSERT_GE(version, last);
+                last = version;
+                observed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        for (long v = 1; v <= versions; v++) {
+            cell.update([v](vector<long> &draft) {
+                for (auto &value: draft) {
+                    value = v;
+                }
+            });
+            std::this_thread::yield();
+        }
+        epoch_reclaim();
+    });
+    writer.join();
+    done.store(true, std::memory_order_release);
+    for (auto &reader: readers) {
+        reader.join();
+    }
+    EXPECT_EQ(cell.load().front(), versions);
+    EXPECT_GT(observed.load(), 0);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../container/soa_vector.h"
+#include "../algorithm/algo.h"
+
+using namespace MicroSTL;
+
+TEST(soa_vector, push_back_and_columns) {
+    soa_vector<int, double, std::string> v;
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 100; i++) {
+        v.emplace_back(i, i * 0.5, std::to_string(i));
+    }
+    v.push_back(std::make_tuple(100, 50.0, std::string("100")));
+    EXPECT_EQ(v.size(), 101);
+    EXPECT_GE(v.capacity(), 101);
+
+    // 每一列是独立的连续数组
+    auto ids = v.column<0>();
+    auto weights = v.column<1>();
+    EXPECT_EQ(ids.size(), 101);
+    EXPECT_EQ(ids.data(), v.data<0>());
+    for (size_t i = 0; i < ids.size(); i++) {
+        ASSERT_EQ(ids[i], static_cast<int>(i));
+        ASSERT_EQ(weights[i], i * 0.5);
+    }
+    EXPECT_EQ(v.column<2>()[42], "42");
+
+    auto [id, weight, name] = v[7];
+    EXPECT_EQ(id, 7);
+    EXPECT_EQ(weight, 3.5);
+    EXPECT_EQ(name, "7");
+    name = "seven";
+    EXPECT_EQ(v.column<2>()[7], "seven");
+    std::get<0>(v.back()) = -1;
+    EXPECT_EQ(v.data<0>()[100], -1);
+    EXPECT_THROW(v.at(101), std::out_of_range);
+}
+
+TEST(soa_vector, erase) {
+    soa_vector<int, std::string> v;
+    for (int i = 0; i < 10; i++) {
+        v.emplace_back(i, std::to_string(i));
+    }
+    auto it = v.erase(v.begin() + 2);
+    EXPECT_EQ(std::get<0>(*it), 3);
+    v.erase(v.begin() + 5, v.begin() + 7);
+    EXPECT_EQ(v.size(), 7);
+    int expected[] = {0, 1, 3, 4, 5, 8, 9};
+    for (size_t i = 0; i < v.size(); i++) {
+        ASSERT_EQ(std::get<0>(v[i]), expected[i]);
+        ASSERT_EQ(std::get<1>(v[i]), std::to_string(expected[i]));
+    }
+    v.erase_unordered(0);
+    EXPECT_EQ(v.size(), 6);
+    EXPECT_EQ(std::get<0>(v[0]), 9);
+    EXPECT_EQ(std::get<1>(v[0]), "9");
+    v.pop_back();
+    EXPECT_EQ(std::get<0>(v.back()), 5);
+}
+
+TEST(soa_vector, copy_move_resize) {
+    soa_vector<int, std::string> v(3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(std::get<0>(v[2]), 0);
+    EXPECT_EQ(std::get<1>(v[2]), "");
+    v[1] = std::make_tuple(5, std::string("five"));
+
+    soa_vector<int, std::string> copy(v);
+    EXPECT_EQ(std::get<1>(copy[1]), "five");
+    std::get<1>(copy[1]) = "changed";
+    EXPECT_EQ(std::get<1>(v[1]), "five");
+
+    soa_vector<int, std::string> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(std::get<1>(moved[1]), "changed");
+    copy = moved;
+    EXPECT_EQ(copy.size(), 3);
+
+    v.resize(1);
+    EXPECT_EQ(v.size(), 1);
+    v.resize(20);
+    EXPECT_EQ(std::get<1>(v[19]), "");
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(soa_vector, iterator_with_algorithms) {
+    soa_vector<int, char> v;
+    int keys[] = {5, 3, 9, 1, 7};
+    for (int key: keys) {
+        v.emplace_back(key, static_cast<char>('a' + key));
+    }
+    int sum = 0;
+    for (auto [key, tag]: v) {
+        sum += key;
+        EXPECT_EQ(tag, 'a' + key);
+    }
+    EXPECT_EQ(sum, 25);
+    EXPECT_EQ(v.end() - v.begin(), 5);
+
+    // 行按 key 排序，各列同步移动
+    MicroSTL::iter_swap(v.begin(), v.begin() + 3);
+    EXPECT_EQ(std::get<0>(v[0]), 1);
+    EXPECT_EQ(std::get<1>(v[0]), 'b');
+    EXPECT_EQ(std::get<0>(v[3]), 5);
+
+    const soa_vector<int, char> &cref = v;
+    soa_vector<int, char>::const_iterator first = cref.begin();
+    EXPECT_EQ(std::get<0>(*(first + 2)), 9);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../container/string.h"
+#include "../container/unordered_set.h"
+
+using namespace MicroSTL;
+
+TEST(string, small_string_stays_inline) {
+    EXPECT_EQ(sizeof(string), 3 * sizeof(void *));
+    string s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.capacity(), 23);
+    EXPECT_STREQ(s.c_str(), "");
+
+    string full("abcdefghijklmnopqrstuvw");
+    EXPECT_EQ(full.size(), 23);
+    EXPECT_EQ(full.capacity(), 23);
+    EXPECT_STREQ(full.c_str(), "abcdefghijklmnopqrstuvw");
+    // 内容存放在对象内部
+    EXPECT_GE(full.data(), reinterpret_cast<const char *>(&full));
+    EXPECT_LT(full.data(), reinterpret_cast<const char *>(&full + 1));
+
+    full.push_back('x');
+    EXPECT_EQ(full.size(), 24);
+    EXPECT_GE(full.capacity(), 46);
+    EXPECT_STREQ(full.c_str(), "abcdefghijklmnopqrstuvwx");
+
+    wstring w(L"12345");
+    EXPECT_EQ(w.capacity(), 5);
+    EXPECT_EQ(w.size(), 5);
+    w += L'6';
+    EXPECT_EQ(w, L"123456");
+}
+
+TEST(string, append_and_concat) {
+    string s;
+    std::string expected;
+    for (int i = 0; i < 200; i++) {
+        std::string piece = std::to_string(i);
+        s += piece.c_str();
+        expected += piece;
+        ASSERT_EQ(s.size(), expected.size());
+        ASSERT_STREQ(s.c_str(), expected.c_str());
+    }
+    string a("hello");
+    string b = a + ", " + "world" + '!';
+    EXPECT_EQ(b, "hello, world!");
+    EXPECT_EQ("<" + a + ">", "<hello>");
+    EXPECT_EQ(a + a, "hellohello");
+    a.append(10, '.');
+    EXPECT_EQ(a, "hello..........");
+
+    // 追加自身的内容
+    string self("abcdefghijklmnopqrst");
+    self.append(self.data(), self.size());
+    EXPECT_EQ(self, "abcdefghijklmnopqrstabcdefghijklmnopqrst");
+    self.append(self);
+    EXPECT_EQ(self.size(), 80);
+}
+
+TEST(string, copy_move_assign) {
+    string small("short");
+    string large(100, 'z');
+    string c1(small);
+    string c2(large);
+    EXPECT_EQ(c1, small);
+    EXPECT_EQ(c2, large);
+    EXPECT_NE(c2.data(), large.data());
+
+    string m(std::move(c2));
+    EXPECT_EQ(m, large);
+    EXPECT_TRUE(c2.empty());
+    c2 = "reused";
+    EXPECT_EQ(c2, "reused");
+
+    m = small;
+    EXPECT_EQ(m, "short");
+    EXPECT_GE(m.capacity(), 100);
+    m.shrink_to_fit();
+    EXPECT_EQ(m.capacity(), 23);
+    EXPECT_EQ(m, "short");
+
+    c1 = std::move(large);
+    EXPECT_EQ(c1.size(), 100);
+    c1.swap(small);
+    EXPECT_EQ(c1, "short");
+    EXPECT_EQ(small.size(), 100);
+}
+
+TEST(string, insert_erase_resize) {
+    string s("hello world");
+    s.insert(5, ",");
+    EXPECT_EQ(s, "hello, world");
+    s.insert(0, "[a much longer prefix] ");
+    EXPECT_EQ(s, "[a much longer prefix] hello, world");
+    s.erase(0, 23);
+    EXPECT_EQ(s, "hello, world");
+    s.erase(s.begin() + 5);
+    EXPECT_EQ(s, "hello world");
+    s.erase(5);
+    EXPECT_EQ(s, "hello");
+    s.resize(8, '!');
+    EXPECT_EQ(s, "hello!!!");
+    s.resize(2);
+    EXPECT_EQ(s, "he");
+    s.pop_back();
+    EXPECT_EQ(s, "h");
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_THROW(s.insert(1, "x"), std::out_of_range);
+    EXPECT_THROW(s.at(0), std::out_of_range);
+}
+
+TEST(string, find_and_compare) {
+    string s("the quick brown fox jumps over the lazy dog");
+    EXPECT_EQ(s.find("the"), 0);
+    EXPECT_EQ(s.find("the", 1), 31);
+    EXPECT_EQ(s.rfind("the"), 31);
+    EXPECT_EQ(s.find('z'), 37);
+    EXPECT_EQ(s.find("cat"), string::npos);
+    EXPECT_TRUE(s.contains("fox"));
+    EXPECT_TRUE(s.starts_with("the quick"));
+    EXPECT_TRUE(s.ends_with("dog"));
+    EXPECT_EQ(s.substr(4, 5), "quick");
+
+    string_view v = s;
+    EXPECT_EQ(v.substr(10, 5), "brown");
+    EXPECT_EQ(v, s);
+    EXPECT_LT(string("apple"), string("banana"));
+    EXPECT_LT(string("apple"), "apples");
+    EXPECT_GT("b", string("apple"));
+    EXPECT_GE(string("b"), string_view("b"));
+    EXPECT_EQ(string("abc").compare("abd"), -1);
+}
+
+TEST(string, transparent_hash) {
+    hash<string> h;
+    string key("a key that does not fit inline");
+    EXPECT_EQ(h(key), h(string_view("a key that does not fit inline")));
+    EXPECT_EQ(h(key), hash<string_view>()(key));
+
+    unordered_set<string, hash<string>, equal_to<void>> set;
+    for (int i = 0; i < 100; i++) {
+        set.insert(string(std::to_string(i).c_str()));
+    }
+    EXPECT_EQ(set.size(), 100);
+    EXPECT_NE(set.find(string("42")), set.end());
+    EXPECT_EQ(set.find(string("100")), set.end());
+    // 异构查找不构造临时字符串
+    EXPECT_NE(set.find(string_view("42")), set.end());
+    EXPECT_TRUE(set.contains(string_view("99")));
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
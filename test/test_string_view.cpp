@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../container/string_view.h"
+
+using namespace MicroSTL;
+
+TEST(string_view, construct_and_slice) {
+    const char *text = "key=value; other";
+    string_view v(text);
+    EXPECT_EQ(v.size(), 16);
+    EXPECT_EQ(v.data(), text);
+    EXPECT_EQ(v.front(), 'k');
+    EXPECT_EQ(v.back(), 'r');
+
+    string_view key = v.substr(0, v.find('='));
+    EXPECT_EQ(key, "key");
+    EXPECT_EQ(key.data(), text);
+
+    string_view rest = v;
+    rest.remove_prefix(4);
+    rest.remove_suffix(7);
+    EXPECT_EQ(rest, "value");
+    EXPECT_EQ(v.substr(11), "other");
+    EXPECT_EQ(v.substr(16), "");
+    EXPECT_THROW(v.substr(17), std::out_of_range);
+    EXPECT_THROW(v.at(16), std::out_of_range);
+}
+
+TEST(string_view, find) {
+    string_view v("abcabcabd");
+    EXPECT_EQ(v.find('c'), 2);
+    EXPECT_EQ(v.find('c', 3), 5);
+    EXPECT_EQ(v.find('z'), string_view::npos);
+    EXPECT_EQ(v.find("abd"), 6);
+    EXPECT_EQ(v.find("abc", 1), 3);
+    EXPECT_EQ(v.find(""), 0);
+    EXPECT_EQ(v.find("", 9), 9);
+    EXPECT_EQ(v.find("", 10), string_view::npos);
+    EXPECT_EQ(v.find("abcabcabdx"), string_view::npos);
+    EXPECT_EQ(v.rfind('a'), 6);
+    EXPECT_EQ(v.rfind('a', 5), 3);
+    EXPECT_EQ(v.rfind("abc"), 3);
+    EXPECT_EQ(v.rfind("abc", 2), 0);
+    EXPECT_EQ(v.rfind("x"), string_view::npos);
+    EXPECT_EQ(v.find_first_of("dc"), 2);
+    EXPECT_EQ(v.find_last_of("ab"), 7);
+    EXPECT_EQ(string_view("  x  ").find_first_not_of(" "), 2);
+    EXPECT_EQ(string_view("  x  ").find_last_not_of(" "), 2);
+    EXPECT_TRUE(v.contains("cab"));
+    EXPECT_TRUE(v.starts_with("abc"));
+    EXPECT_TRUE(v.ends_with('d'));
+    EXPECT_FALSE(v.ends_with("abc"));
+}
+
+/**
+ * 与 std::string_view 逐个位置比较，覆盖向量化循环与标量收尾的边界
+ */
+TEST(string_view, find_matches_std) {
+    std::string text;
+    for (int i = 0; i < 300; i++) {
+        text.push_back(static_cast<char>('a' + (i * 7 + i / 13) % 3));
+    }
+    const char *needles[] = {"ab", "abc", "cba", "aaa", "abcabcab", "bcabcabcabcabcabcabcabcabcabcabcabcabc", "ccccc"};
+    for (const char *needle: needles) {
+        for (size_t pos = 0; pos <= text.size(); pos += 5) {
+            std::string_view expected(text);
+            string_view actual(text.data(), text.size());
+            size_t e = expected.find(needle, pos);
+            size_t a = actual.find(needle, pos);
+            ASSERT_EQ(a, e == std::string_view::npos ? string_view::npos : e) << needle << " " << pos;
+            e = expected.rfind(needle, pos);
+            a = actual.rfind(needle, pos);
+            ASSERT_EQ(a, e == std::string_view::npos ? string_view::npos : e) << needle << " " << pos;
+        }
+    }
+}
+
+TEST(string_view, compare) {
+    EXPECT_LT(string_view("abc"), string_view("abd"));
+    EXPECT_LT(string_view("ab"), string_view("abc"));
+    EXPECT_GT(string_view("b"), "abc");
+    EXPECT_LE("abc", string_view("abc"));
+    EXPECT_EQ(string_view("abc").compare("abc"), 0);
+    EXPECT_NE(string_view("abc"), "abd");
+    // 按无符号字符比较
+    EXPECT_LT(string_view("a"), string_view("\xff"));
+
+    u16string_view a(u"héllo");
+    u16string_view b(u"hello");
+    EXPECT_GT(a, b);
+    EXPECT_EQ(a.find(u"llo"), 2);
+    wstring_view w(L"wide string");
+    EXPECT_EQ(w.find(L"str"), 5);
+    EXPECT_EQ(w.find(L'g'), 10);
+}
+
+TEST(string_view, hash) {
+    hash<string_view> h;
+    std::string a = "hello world";
+    std::string b = "hello world";
+    EXPECT_EQ(h(string_view(a.data(), a.size())), h(string_view(b.data(), b.size())));
+    EXPECT_NE(h("hello"), h("hellp"));
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+#define MICROSTL_TRACE
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include "../container/vector.h"
+#include "../container/list.h"
+
+using namespace MicroSTL;
+
+static const trace_site *site_at(unsigned line) {
+    return trace_registry::instance().find("test_trace.cpp", line);
+}
+
+TEST(trace, vector_reallocation) {
+    unsigned line = __LINE__ + 2;
+    {
+        vector<int> v;
+        for (int i = 0; i < 100; i++) {
+            v.push_back(i);
+        }
+    }
+    const trace_site *site = site_at(line);
+    ASSERT_NE(site, nullptr);
+    EXPECT_STREQ(site->container, "vector");
+    EXPECT_EQ(site->instances.load(), 1);
+    // 容量依次为 1、2、4 ... 128，每次扩容复制原有的全部元素
+    EXPECT_EQ(site->reallocations.load(), 8);
+    EXPECT_EQ(site->bytes_copied.load(), 127 * sizeof(int));
+    EXPECT_EQ(site->peak_size.load(), 100);
+    EXPECT_EQ(site->peak_capacity.load(), 128);
+    EXPECT_EQ(site->linear_ops.load(), 0);
+}
+
+TEST(trace, vector_reserve_and_shift) {
+    unsigned line = __LINE__ + 1;
+    vector<int> v;
+    v.reserve(16);
+    for (int i = 0; i < 5; i++) {
+        v.push_back(i);
+    }
+    // 在头部插入需要移动全部 5 个元素，删除头部再移动 5 个
+    v.insert(v.begin(), -1);
+    v.erase(v.begin());
+    v.insert(v.end(), 2, 7);
+    v.clear();
+    const trace_site *site = site_at(line);
+    ASSERT_NE(site, nullptr);
+    EXPECT_EQ(site->reallocations.load(), 1);
+    EXPECT_EQ(site->linear_ops.load(), 2);
+    EXPECT_EQ(site->bytes_copied.load(), 10 * sizeof(int));
+}
+
+TEST(trace, sites_are_keyed_by_construction) {
+    unsigned line = __LINE__ + 2;
+    for (int i = 0; i < 3; i++) {
+        vector<std::string> a(4, std::string("x"));
+        vector<std::string> b(a);
+        b.push_back("y");
+    }
+    const trace_site *site = site_at(line);
+    const trace_site *copy_site = site_at(line + 1);
+    ASSERT_NE(site, nullptr);
+    ASSERT_NE(copy_site, nullptr);
+    EXPECT_EQ(site->instances.load(), 3);
+    EXPECT_EQ(site->reallocations.load(), 0);
+    EXPECT_EQ(copy_site->instances.load(), 3);
+    EXPECT_EQ(copy_site->reallocations.load(), 3);
+    EXPECT_EQ(copy_site->peak_size.load(), 5);
+}
+
+TEST(trace, list_size_is_linear) {
+    unsigned line = __LINE__ + 1;
+    list<int> l;
+    for (int i = 0; i < 20; i++) {
+        l.push_back(i);
+        EXPECT_EQ(l.size(), i + 1);
+    }
+    const trace_site *site = site_at(line);
+    ASSERT_NE(site, nullptr);
+    EXPECT_STREQ(site->container, "list");
+    EXPECT_EQ(site->linear_ops.load(), 20);
+}
+
+TEST(trace, report) {
+    unsigned line = __LINE__ + 2;
+    for (int i = 0; i < 2; i++) {
+        vector<int> v;
+        for (int j = 0; j < 1000; j++) {
+            v.push_back(j);
+        }
+    }
+    FILE *out = tmpfile();
+    ASSERT_NE(out, nullptr);
+    trace_report(out);
+    rewind(out);
+    std::string text;
+    char buffer[512];
+    while (fgets(buffer, sizeof(buffer), out)) {
+        text += buffer;
+    }
+    fclose(out);
+    EXPECT_NE(text.find("MicroSTL trace report"), std::string::npos);
+    EXPECT_NE(text.find("test_trace.cpp:" + std::to_string(line)), std::string::npos);
+    EXPECT_NE(text.find("hint: reserve(1000)"), std::string::npos);
+}
+
+int main(int argc, char *argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../container/unordered_map.h"
+
+using namespace MicroSTL;
+
+TEST(unordered_map, insert_and_find) {
+    unordered_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(map.insert(pair<const int, int>(i, i * 2)).second);
+    }
+    EXPECT_FALSE(map.insert(pair<const int, int>(5, 0)).second);
+    EXPECT_EQ(map.size(), 1000);
+    for (int i = 0; i < 1000; i++) {
+        auto iter = map.find(i);
+        ASSERT_NE(iter, map.end());
+        EXPECT_EQ(iter->first, i);
+        EXPECT_EQ(iter->second, i * 2);
+    }
+    EXPECT_EQ(map.find(1000), map.end());
+    EXPECT_EQ(map.count(999), 1);
+    EXPECT_EQ(map.count(-1), 0);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+}
+
+TEST(unordered_map, subscript_and_try_emplace) {
+    unordered_map<std::string, int> map;
+    map["a"] = 1;
+    map["b"] += 2;
+    map["a"] += 10;
+    EXPECT_EQ(map["a"], 11);
+    EXPECT_EQ(map["b"], 2);
+    EXPECT_EQ(map.size(), 2);
+
+    EXPECT_FALSE(map.try_emplace("a", 100).second);
+    EXPECT_EQ(map.at("a"), 11);
+    EXPECT_TRUE(map.try_emplace("c", 3).second);
+    EXPECT_TRUE(map.emplace("d", 4).second);
+    EXPECT_FALSE(map.insert_or_assign("d", 40).second);
+    EXPECT_EQ(map.at("d"), 40);
+    EXPECT_THROW(map.at("x"), std::out_of_range);
+}
+
+TEST(unordered_map, erase) {
+    unordered_map<int, int> map;
+    for (int i = 0; i < 1000; i++) {
+        map[i] = i;
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_EQ(map.erase(i), 1);
+    }
+    EXPECT_EQ(map.erase(0), 0);
+    EXPECT_EQ(map.size(), 500);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.contains(i), i % 2 == 1);
+    }
+
+    // 通过迭代器删除全部元素
+    size_t visited = 0;
+    for (auto iter = map.begin(); iter != map.end();) {
+        iter = map.erase(iter);
+        visited++;
+    }
+    EXPECT_EQ(visited, 500);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+// 与 std::unordered_map 对比随机的插入、删除、查找
+TEST(unordered_map, random_operations) {
+    unordered_map<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> expected;
+    std::mt19937_64 rng(1);
+    for (int round = 0; round < 200000; round++) {
+        // key 范围较小，保证频繁地命中与删除
+        uint64_t key = rng() % 5000;
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                map[key] = round;
+                expected[key] = round;
+                break;
+            case 2:
+                ASSERT_EQ(map.erase(key), expected.erase(key));
+                break;
+            default: {
+                auto iter = map.find(key);
+                auto expected_iter = expected.find(key);
+                ASSERT_EQ(iter == map.end(), expected_iter == expected.end());
+                if (iter != map.end()) {
+                    ASSERT_EQ(iter->second, expected_iter->second);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(map.size(), expected.size());
+    size_t count = 0;
+    for (auto &item: map) {
+        EXPECT_EQ(expected.at(item.first), item.second);
+        count++;
+    }
+    EXPECT_EQ(count, expected.size());
+}
+
+// 大量删除后查找不会变慢：槽位被置空而不是留下墓碑
+TEST(unordered_map, erase_does_not_leave_tombstones) {
+    unordered_map<int, int> map;
+    map.reserve(1000);
+    size_t buckets = map.bucket_count();
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 1000; i++) {
+            map[round * 1000 + i] = i;
+        }
+        for (int i = 0; i < 1000; i++) {
+            map.erase(round * 1000 + i);
+        }
+    }
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.bucket_count(), buckets);
+}
+
+TEST(unordered_map, reserve_and_rehash) {
+    unordered_map<int, int> map;
+    map.reserve(1000);
+    size_t buckets = map.bucket_count();
+    EXPECT_GE(buckets * map.max_load_factor(), 1000);
+    for (int i = 0; i < 1000; i++) {
+        map[i] = i;
+    }
+    EXPECT_EQ(map.bucket_count(), buckets);
+
+    for (int i = 0; i < 990; i++) {
+        map.erase(i);
+    }
+    map.rehash(0);
+    EXPECT_LT(map.bucket_count(), buckets);
+    for (int i = 990; i < 1000; i++) {
+        EXPECT_EQ(map.at(i), i);
+    }
+}
+
+TEST(unordered_map, heterogeneous_lookup) {
+    unordered_map<std::string, int, hash<std::string>, equal_to<void>> map;
+    map["hello"] = 1;
+    map["a long key that does not fit in sso"] = 2;
+    EXPECT_EQ(map.find("hello")->second, 1);
+    EXPECT_EQ(map.find(std::string_view("a long key that does not fit in sso"))->second, 2);
+    EXPECT_TRUE(map.contains("hello"));
+    EXPECT_EQ(map.count(std::string_view("world")), 0);
+    EXPECT_EQ(map.erase("hello"), 1);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(unordered_map, copy_and_move) {
+    unordered_map<int, std::string> map;
+    for (int i = 0; i < 100; i++) {
+        map[i] = std::to_string(i);
+    }
+    unordered_map<int, std::string> copy(map);
+    EXPECT_EQ(copy.size(), 100);
+    copy[0] = "changed";
+    EXPECT_EQ(map[0], "0");
+    EXPECT_EQ(copy.at(99), "99");
+
+    unordered_map<int, std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.find(1), copy.end());
+
+    copy = moved;
+    EXPECT_EQ(copy.at(0), "changed");
+    map.swap(copy);
+    EXPECT_EQ(map.at(0), "changed");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    map[5] = "5";
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(unordered_map, range_constructor) {
+    std::vector<pair<const int, int>> items;
+    for (int i = 0; i < 50; i++) {
+        items.push_back(pair<const int, int>(i % 25, i));
+    }
+    unordered_map<int, int> map(items.begin(), items.end());
+    EXPECT_EQ(map.size(), 25);
+    EXPECT_EQ(map.at(3), 3);
+}
+
+TEST(hash, functor) {
+    EXPECT_EQ(hash<int>()(42), hash<int>()(42));
+    EXPECT_EQ(hash<double>()(0.0), hash<double>()(-0.0));
+    EXPECT_EQ(hash<std::string>()("abc"), hash<std::string_view>()("abc"));
+    EXPECT_NE(hash<std::string>()("abc"), hash<std::string>()("abd"));
+    EXPECT_NE(_hash_mix(1), _hash_mix(2));
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
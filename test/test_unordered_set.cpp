@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include "../container/unordered_set.h"
+
+using namespace MicroSTL;
+
+TEST(unordered_set, insert_and_find) {
+    unordered_set<int> set;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(set.insert(i).second);
+        EXPECT_FALSE(set.insert(i).second);
+    }
+    EXPECT_EQ(set.size(), 100);
+    EXPECT_TRUE(set.contains(50));
+    EXPECT_FALSE(set.contains(100));
+    EXPECT_EQ(*set.find(7), 7);
+    EXPECT_TRUE(set.emplace(100).second);
+}
+
+TEST(unordered_set, iterate) {
+    unordered_set<std::string> set;
+    for (int i = 0; i < 200; i++) {
+        set.insert(std::to_string(i));
+    }
+    std::unordered_set<std::string> seen(set.begin(), set.end());
+    EXPECT_EQ(seen.size(), 200);
+    EXPECT_TRUE(seen.count("199"));
+}
+
+TEST(unordered_set, random_operations) {
+    unordered_set<unsigned> set;
+    std::unordered_set<unsigned> expected;
+    std::mt19937 rng(2);
+    for (int round = 0; round < 100000; round++) {
+        unsigned key = rng() % 3000;
+        if (rng() % 2) {
+            ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+        } else {
+            ASSERT_EQ(set.erase(key), expected.erase(key));
+        }
+    }
+    EXPECT_EQ(set.size(), expected.size());
+    for (unsigned key: set) {
+        EXPECT_TRUE(expected.count(key));
+    }
+}
+
+TEST(unordered_set, heterogeneous_lookup) {
+    unordered_set<std::string, hash<std::string>, equal_to<void>> set;
+    set.insert("apple");
+    EXPECT_TRUE(set.contains("apple"));
+    EXPECT_NE(set.find(std::string_view("apple")), set.end());
+    EXPECT_EQ(set.erase("apple"), 1);
+    EXPECT_TRUE(set.empty());
+}
+
+int main(int argc, char *argv[]) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -9,7 +9,7 @@ TEST(vector, base) {
     EXPECT_EQ(*(vec.end() - 1), 'A');
     EXPECT_EQ(vec.front(), 'A');
     EXPECT_EQ(vec.back(), 'A');
-    EXPECT_NE(*vec.end(), 'A');
+    EXPECT_EQ(vec.end() - vec.begin(), 10);
     // 初始容量 = begin - end
     EXPECT_EQ(vec.capacity(), 10);
     EXPECT_EQ(vec.empty(), false);
@@ -88,6 +88,19 @@ TEST(vector, insert) {
 }
 
 
+TEST(vector, over_aligned) {
+    struct alignas(32) lane {
+        float values[8];
+    };
+    vector<lane> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(lane{{static_cast<float>(i)}});
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.data()) % 32, 0);
+    }
+    EXPECT_EQ(vec[99].values[0], 99.0f);
+}
+
+
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
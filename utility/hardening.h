@@ -0,0 +1,282 @@
+#ifndef MICROSTL_HARDENING_H
+#define MICROSTL_HARDENING_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * 容器的加固级别，编译时通过 MICROSTL_HARDENING 选择：
+ *
+ * - 0（MICROSTL_HARDENING_NONE，默认）：不做任何检查
+ * - 1（MICROSTL_HARDENING_CHEAP）：O(1) 的断言，下标越界、对空容器取首尾元素或 pop、
+ *   传给 vector 的迭代器不在本容器范围内、list 删除 end()；可以在线上的灰度机器中常开
+ * - 2（MICROSTL_HARDENING_FULL）：在 1 的基础上跟踪迭代器失效。vector 的迭代器换成记录所属容器与版本号的类，
+ *   解引用或传回容器时检查是否已经因为扩容、插入、删除而失效；list 的节点记录所属链表，
+ *   检查迭代器是否属于当前链表、是否指向已删除的节点；节点在全局登记表中有编号，迭代器记下创建时的编号，
+ *   检查时只查登记表，不读取可能已经释放的节点，节点内存被复用后编号不同，同样能够发现
+ * - 检查失败时向 stderr 输出失败的条件与位置后 abort()，不抛出异常，便于在崩溃现场保留 core dump
+ */
+
+#define MICROSTL_HARDENING_NONE 0
+#define MICROSTL_HARDENING_CHEAP 1
+#define MICROSTL_HARDENING_FULL 2
+
+#ifndef MICROSTL_HARDENING
+#define MICROSTL_HARDENING MICROSTL_HARDENING_NONE
+#endif
+
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../iterator/iterator.h"
+
+#endif
+
+namespace MicroSTL {
+
+    [[noreturn]] inline void _hardening_failure(const char *message, const char *condition, const char *file,
+                                                int line) {
+        fprintf(stderr, "MicroSTL hardening: %s (%s) at %s:%d\n", message, condition, file, line);
+        abort();
+    }
+}
+
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_CHEAP
+#define MICROSTL_CHECK(condition, message) \
+    (__builtin_expect(!(condition), 0) ? MicroSTL::_hardening_failure(message, #condition, __FILE__, __LINE__) : (void) 0)
+#else
+#define MICROSTL_CHECK(condition, message) ((void) 0)
+#endif
+
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+#define MICROSTL_DEBUG_CHECK(condition, message) MICROSTL_CHECK(condition, message)
+#else
+#define MICROSTL_DEBUG_CHECK(condition, message) ((void) 0)
+#endif
+
+#if MICROSTL_HARDENING >= MICROSTL_HARDENING_FULL
+
+namespace MicroSTL {
+
+    // --------------------- 连续存储的失效记录 --------------------------
+
+    /**
+     * 迭代器创建时记下当时的版本号 generation，容器每次让某个下标及其之后的迭代器失效时版本号加一，并记录该下标；
+     * 版本号为 g、下标为 offset 的迭代器有效，当且仅当 g 之后的所有失效下标都大于 offset。
+     *
+     * 只需要「g 之后失效下标的最小值」：新记录的下标不大于栈顶时栈顶不会再成为最小值，可以弹出，
+     * 因此栈中的下标从底到顶严格递增，查询时二分找到第一条版本号大于 g 的记录即可。扩容的失效下标为 0，会清空整个栈
+     */
+    class _debug_invalidation {
+    protected:
+        size_t generation;
+        // (版本号, 失效下标)
+        std::vector<std::pair<size_t, size_t>> events;
+
+    public:
+        _debug_invalidation() : generation(0) {}
+
+        size_t current() const {
+            return generation;
+        }
+
+        void invalidate_from(size_t offset) {
+            ++generation;
+            while (!events.empty() && events.back().second >= offset) {
+                events.pop_back();
+            }
+            events.emplace_back(generation, offset);
+        }
+
+        bool valid(size_t iterator_generation, size_t offset) const {
+            auto first = std::upper_bound(events.begin(), events.end(), iterator_generation,
+                                          [](size_t value, const std::pair<size_t, size_t> &event) {
+                                              return value < event.first;
+                                          });
+            return first == events.end() || offset < first->second;
+        }
+    };
+
+    // --------------------- 存活节点登记表 --------------------------
+
+    /**
+     * 节点式容器的存活节点，节点地址到编号的映射；编号从 1 开始全局递增，同一地址被释放后再分配会得到新的编号，
+     * 0 表示地址上没有存活的节点。不同线程中的容器共用一张表，加锁访问
+     */
+    class _debug_node_registry {
+    protected:
+        std::mutex mutex;
+        std::unordered_map<const void *, size_t> nodes;
+        size_t next_serial;
+
+        _debug_node_registry() : next_serial(1) {}
+
+    public:
+        static _debug_node_registry &instance() {
+            static _debug_node_registry registry;
+            return registry;
+        }
+
+        size_t add(const void *node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t serial = next_serial++;
+            nodes[node] = serial;
+            return serial;
+        }
+
+        void remove(const void *node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            nodes.erase(node);
+        }
+
+        size_t serial(const void *node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto iter = nodes.find(node);
+            return iter == nodes.end() ? 0 : iter->second;
+        }
+    };
+
+    // --------------------- 带检查的随机访问迭代器 --------------------------
+
+    /**
+     * 原生指针加上所属容器与创建时的版本号，Container 需要提供 _debug_verify(ptr, generation, dereference)
+     */
+    template<typename Container, typename T, typename Ref, typename Ptr>
+    struct _debug_iterator {
+        using iterator_category = random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+        using self = _debug_iterator<Container, T, Ref, Ptr>;
+
+        Ptr ptr;
+        const Container *owner;
+        size_t generation;
+
+        _debug_iterator() : ptr(nullptr), owner(nullptr), generation(0) {}
+
+        _debug_iterator(Ptr p, const Container *container)
+                : ptr(p), owner(container), generation(container->_debug_generation()) {}
+
+        _debug_iterator(const _debug_iterator &) = default;
+
+        _debug_iterator &operator=(const _debug_iterator &) = default;
+
+        // iterator 可以转换为 const_iterator
+        template<typename R, typename P,
+                typename = typename std::enable_if<
+                        std::is_same<_debug_iterator<Container, T, R, P>, _debug_iterator<Container, T, T &, T *>>::value &&
+                        !std::is_same<Ref, T &>::value>::type>
+        _debug_iterator(const _debug_iterator<Container, T, R, P> &iter)
+                : ptr(iter.ptr), owner(iter.owner), generation(iter.generation) {}
+
+        Ref operator*() const {
+            MICROSTL_CHECK(owner != nullptr, "dereferencing a singular iterator");
+            owner->_debug_verify(ptr, generation, true);
+            return *ptr;
+        }
+
+        Ptr operator->() const {
+            return &operator*();
+        }
+
+        Ref operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        self &operator++() {
+            ++ptr;
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++ptr;
+            return tmp;
+        }
+
+        self &operator--() {
+            --ptr;
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --ptr;
+            return tmp;
+        }
+
+        self &operator+=(difference_type n) {
+            ptr += n;
+            return *this;
+        }
+
+        self &operator-=(difference_type n) {
+            ptr -= n;
+            return *this;
+        }
+
+        self operator+(difference_type n) const {
+            self tmp = *this;
+            return tmp += n;
+        }
+
+        friend self operator+(difference_type n, const self &iter) {
+            return iter + n;
+        }
+
+        self operator-(difference_type n) const {
+            self tmp = *this;
+            return tmp -= n;
+        }
+
+        template<typename R, typename P>
+        difference_type operator-(const _debug_iterator<Container, T, R, P> &iter) const {
+            MICROSTL_CHECK(owner == iter.owner, "subtracting iterators of different containers");
+            return ptr - iter.ptr;
+        }
+
+        template<typename R, typename P>
+        bool operator==(const _debug_iterator<Container, T, R, P> &iter) const {
+            MICROSTL_CHECK(owner == iter.owner, "comparing iterators of different containers");
+            return ptr == iter.ptr;
+        }
+
+        template<typename R, typename P>
+        bool operator!=(const _debug_iterator<Container, T, R, P> &iter) const {
+            return !(*this == iter);
+        }
+
+        template<typename R, typename P>
+        bool operator<(const _debug_iterator<Container, T, R, P> &iter) const {
+            MICROSTL_CHECK(owner == iter.owner, "comparing iterators of different containers");
+            return ptr < iter.ptr;
+        }
+
+        template<typename R, typename P>
+        bool operator>(const _debug_iterator<Container, T, R, P> &iter) const {
+            return iter < *this;
+        }
+
+        template<typename R, typename P>
+        bool operator<=(const _debug_iterator<Container, T, R, P> &iter) const {
+            return !(iter < *this);
+        }
+
+        template<typename R, typename P>
+        bool operator>=(const _debug_iterator<Container, T, R, P> &iter) const {
+            return !(*this < iter);
+        }
+    };
+}
+
+#endif
+
+#endif //MICROSTL_HARDENING_H
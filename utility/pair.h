@@ -0,0 +1,51 @@
+#ifndef MICROSTL_PAIR_H
+#define MICROSTL_PAIR_H
+
+#include <utility>
+
+namespace MicroSTL {
+
+    template<typename T1, typename T2>
+    struct pair {
+        using first_type = T1;
+        using second_type = T2;
+
+        T1 first;
+        T2 second;
+
+        pair() : first(T1()), second(T2()) {}
+
+        pair(const T1 &a, const T2 &b) : first(a), second(b) {}
+
+        template<typename U1, typename U2>
+        pair(U1 &&a, U2 &&b) : first(std::forward<U1>(a)), second(std::forward<U2>(b)) {}
+
+        template<typename U1, typename U2>
+        pair(const pair<U1, U2> &obj) : first(obj.first), second(obj.second) {}
+    };
+
+    template<typename T1, typename T2>
+    inline bool operator==(const pair<T1, T2> &a, const pair<T1, T2> &b) {
+        return a.first == b.first && a.second == b.second;
+    }
+
+    template<typename T1, typename T2>
+    inline bool operator!=(const pair<T1, T2> &a, const pair<T1, T2> &b) {
+        return !(a == b);
+    }
+
+    /**
+     * 先比较 first，first 相等时再比较 second
+     */
+    template<typename T1, typename T2>
+    inline bool operator<(const pair<T1, T2> &a, const pair<T1, T2> &b) {
+        return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+    }
+
+    template<typename T1, typename T2>
+    inline pair<T1, T2> make_pair(const T1 &a, const T2 &b) {
+        return pair<T1, T2>(a, b);
+    }
+}
+
+#endif //MICROSTL_PAIR_H
@@ -0,0 +1,435 @@
+#ifndef MICROSTL_SERIALIZE_H
+#define MICROSTL_SERIALIZE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include "../container/list.h"
+#include "../container/vector.h"
+
+/**
+ * 可平凡复制元素的 vector / list 的二进制序列化：
+ *
+ * - 格式为 64 字节的头部加上元素数组本身：头部记录魔数、版本、字节序、容器种类、元素大小与对齐、元素个数；
+ *   头部占满 64 字节，缓冲区或 mmap 的起点对齐时负载也按 alignof(T)（最多 64）对齐
+ * - write_vector 用一次 writev 写出头部与负载，不逐个编码元素；read_vector 先读头部，
+ *   再用 resize_for_overwrite 得到未初始化的存储，把负载直接 read 进去
+ * - serial_view 在缓冲区上校验头部后直接把负载当作 const T 数组使用，不复制；
+ *   serial_file 把整个文件只读映射后提供 serial_view，多个进程可以共享同一份 page cache
+ * - list 不连续，write_list / read_list 以 SERIAL_STREAM_BYTES 大小的缓冲区分批写出与读入；
+ *   头部中的个数在写完后回填，不需要先调用 O(n) 的 size()，因此输出必须是可以 pwrite 的文件
+ * - 格式不符（魔数、版本、字节序、元素大小或对齐、长度不足）时抛出 serial_error，系统调用失败时抛出 std::system_error
+ */
+
+namespace MicroSTL {
+
+    static const uint32_t SERIAL_MAGIC = 0x4C54534D;  // "MSTL"
+    static const uint16_t SERIAL_VERSION = 1;
+    static const uint16_t SERIAL_BYTE_ORDER = 0x0102;
+    static const size_t SERIAL_HEADER_BYTES = 64;
+    static const size_t SERIAL_STREAM_BYTES = 64 * 1024;
+
+    enum class serial_kind : uint16_t {
+        vector = 1,
+        list = 2
+    };
+
+    class serial_error : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    struct serial_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t byte_order;
+        uint16_t kind;
+        uint16_t reserved;
+        uint32_t element_size;
+        uint32_t element_align;
+        uint32_t reserved2;
+        uint64_t count;
+        unsigned char padding[SERIAL_HEADER_BYTES - 32];
+    };
+
+    static_assert(sizeof(serial_header) == SERIAL_HEADER_BYTES, "serial_header 的大小必须为 64 字节");
+
+    template<typename T>
+    inline serial_header _serial_make_header(serial_kind kind, uint64_t count) {
+        serial_header header;
+        memset(&header, 0, sizeof(header));
+        header.magic = SERIAL_MAGIC;
+        header.version = SERIAL_VERSION;
+        header.byte_order = SERIAL_BYTE_ORDER;
+        header.kind = static_cast<uint16_t>(kind);
+        header.element_size = sizeof(T);
+        header.element_align = alignof(T);
+        header.count = count;
+        return header;
+    }
+
+    /**
+     * 检查头部是否由同样布局的 T 写出
+     */
+    template<typename T>
+    inline void _serial_check_header(const serial_header &header, serial_kind kind) {
+        if (header.magic != SERIAL_MAGIC) {
+            throw serial_error("serial: bad magic");
+        }
+        if (header.byte_order != SERIAL_BYTE_ORDER) {
+            throw serial_error("serial: byte order mismatch");
+        }
+        if (header.version != SERIAL_VERSION) {
+            throw serial_error("serial: unsupported version " + std::to_string(header.version));
+        }
+        if (header.kind != static_cast<uint16_t>(kind)) {
+            throw serial_error("serial: container kind mismatch");
+        }
+        if (header.element_size != sizeof(T) || header.element_align != alignof(T)) {
+            throw serial_error("serial: element size " + std::to_string(header.element_size) + " / align " +
+                               std::to_string(header.element_align) + " does not match " +
+                               std::to_string(sizeof(T)) + " / " + std::to_string(alignof(T)));
+        }
+    }
+
+    template<typename T>
+    inline void _serial_check_type() {
+        static_assert(std::is_trivially_copyable<T>::value, "只有可平凡复制的类型可以直接按字节序列化");
+    }
+
+    // --------------------- 文件描述符读写 --------------------------
+
+    /**
+     * 写出全部 iovec，处理部分写入与 EINTR
+     */
+    inline void _serial_writev(int fd, struct iovec *iov, int count) {
+        while (count > 0) {
+            ssize_t written = writev(fd, iov, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "serial: writev");
+            }
+            size_t left = static_cast<size_t>(written);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    inline void _serial_write(int fd, const void *data, size_t bytes) {
+        struct iovec iov = {const_cast<void *>(data), bytes};
+        _serial_writev(fd, &iov, 1);
+    }
+
+    /**
+     * 读满 bytes 字节，提前遇到文件结尾时抛出 serial_error
+     */
+    inline void _serial_read(int fd, void *data, size_t bytes) {
+        char *out = static_cast<char *>(data);
+        while (bytes > 0) {
+            ssize_t got = read(fd, out, bytes);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "serial: read");
+            }
+            if (got == 0) {
+                throw serial_error("serial: unexpected end of input");
+            }
+            out += got;
+            bytes -= static_cast<size_t>(got);
+        }
+    }
+
+    /**
+     * 头部中的元素个数来自输入，不可信：负载的字节数不能溢出 size_t；fd 可以定位时（普通文件），
+     * 负载也不能超过文件中剩余的字节数，避免按伪造的个数申请内存
+     */
+    template<typename T>
+    inline void _serial_check_count(int fd, uint64_t count) {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw serial_error("serial: element count overflows");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            return;
+        }
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (offset < 0 || offset > info.st_size) {
+            return;
+        }
+        if (count > static_cast<uint64_t>(info.st_size - offset) / sizeof(T)) {
+            throw serial_error("serial: input shorter than payload");
+        }
+    }
+
+    // --------------------- vector --------------------------
+
+    template<typename T>
+    inline size_t serialized_size(const vector<T> &vec) {
+        return SERIAL_HEADER_BYTES + vec.size() * sizeof(T);
+    }
+
+    /**
+     * 写入 out，out 至少需要 serialized_size(vec) 字节，返回写入的字节数
+     */
+    template<typename T>
+    inline size_t serialize(const vector<T> &vec, void *out) {
+        _serial_check_type<T>();
+        serial_header header = _serial_make_header<T>(serial_kind::vector, vec.size());
+        memcpy(out, &header, sizeof(header));
+        if (!vec.empty()) {
+            memcpy(static_cast<char *>(out) + SERIAL_HEADER_BYTES, vec.data(), vec.size() * sizeof(T));
+        }
+        return serialized_size(vec);
+    }
+
+    /**
+     * 头部与负载由一次 writev 写出
+     */
+    template<typename T>
+    inline void write_vector(int fd, const vector<T> &vec) {
+        _serial_check_type<T>();
+        serial_header header = _serial_make_header<T>(serial_kind::vector, vec.size());
+        struct iovec iov[2] = {{&header, sizeof(header)},
+                               {const_cast<T *>(vec.data()), vec.size() * sizeof(T)}};
+        _serial_writev(fd, iov, vec.empty() ? 1 : 2);
+    }
+
+    /**
+     * 负载直接读入未初始化的存储
+     */
+    template<typename T>
+    inline vector<T> read_vector(int fd) {
+        _serial_check_type<T>();
+        serial_header header;
+        _serial_read(fd, &header, sizeof(header));
+        _serial_check_header<T>(header, serial_kind::vector);
+        _serial_check_count<T>(fd, header.count);
+        vector<T> result;
+        result.resize_for_overwrite(header.count);
+        if (header.count != 0) {
+            _serial_read(fd, result.data(), header.count * sizeof(T));
+        }
+        return result;
+    }
+
+    // --------------------- 零复制视图 --------------------------
+
+    /**
+     * 缓冲区中序列化的 vector，元素直接引用缓冲区；缓冲区需要比视图活得久
+     */
+    template<typename T>
+    class serial_view {
+    public:
+        using value_type = T;
+        using const_iterator = const T *;
+        using iterator = const_iterator;
+        using size_type = size_t;
+
+    protected:
+        const T *start;
+        size_type count;
+
+    public:
+        serial_view() : start(nullptr), count(0) {}
+
+        /**
+         * 校验头部与长度；负载没有按 alignof(T) 对齐时抛出 serial_error，此时应复制到对齐的缓冲区后再解析
+         */
+        serial_view(const void *data, size_t bytes) {
+            _serial_check_type<T>();
+            if (bytes < SERIAL_HEADER_BYTES) {
+                throw serial_error("serial: buffer shorter than header");
+            }
+            serial_header header;
+            memcpy(&header, data, sizeof(header));
+            _serial_check_header<T>(header, serial_kind::vector);
+            if (header.count > (bytes - SERIAL_HEADER_BYTES) / sizeof(T)) {
+                throw serial_error("serial: buffer shorter than payload");
+            }
+            const char *payload = static_cast<const char *>(data) + SERIAL_HEADER_BYTES;
+            if (reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0) {
+                throw serial_error("serial: payload is not aligned for the element type");
+            }
+            start = reinterpret_cast<const T *>(payload);
+            count = header.count;
+        }
+
+        const_iterator begin() const {
+            return start;
+        }
+
+        const_iterator end() const {
+            return start + count;
+        }
+
+        const T *data() const {
+            return start;
+        }
+
+        size_type size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        const T &operator[](size_type n) const {
+            MICROSTL_CHECK(n < count, "serial_view index out of range");
+            return start[n];
+        }
+
+        /**
+         * 复制为拥有存储的 vector
+         */
+        vector<T> to_vector() const {
+            vector<T> result;
+            result.resize_for_overwrite(count);
+            if (count != 0) {
+                memcpy(result.data(), start, count * sizeof(T));
+            }
+            return result;
+        }
+    };
+
+    /**
+     * 只读映射整个文件，view<T>() 返回文件中序列化的 vector 的零复制视图
+     */
+    class serial_file {
+    protected:
+        void *base;
+        size_t bytes;
+
+    public:
+        explicit serial_file(const char *path) : base(nullptr), bytes(0) {
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "serial: open");
+            }
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "serial: fstat");
+            }
+            bytes = static_cast<size_t>(info.st_size);
+            if (bytes != 0) {
+                base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+                if (base == MAP_FAILED) {
+                    int error = errno;
+                    close(fd);
+                    throw std::system_error(error, std::generic_category(), "serial: mmap");
+                }
+            }
+            // 映射建立后文件描述符可以关闭
+            close(fd);
+        }
+
+        serial_file(const serial_file &) = delete;
+
+        serial_file &operator=(const serial_file &) = delete;
+
+        ~serial_file() {
+            if (base != nullptr) {
+                munmap(base, bytes);
+            }
+        }
+
+        const void *data() const {
+            return base;
+        }
+
+        size_t size() const {
+            return bytes;
+        }
+
+        template<typename T>
+        serial_view<T> view() const {
+            return serial_view<T>(base, bytes);
+        }
+    };
+
+    // --------------------- list --------------------------
+
+    /**
+     * 分批写出 list，fd 需要支持 lseek / pwrite（普通文件），写完后回填头部中的元素个数
+     */
+    template<typename T>
+    inline void write_list(int fd, const list<T> &lst) {
+        _serial_check_type<T>();
+        off_t header_offset = lseek(fd, 0, SEEK_CUR);
+        if (header_offset < 0) {
+            throw std::system_error(errno, std::generic_category(), "serial: lseek");
+        }
+        serial_header header = _serial_make_header<T>(serial_kind::list, 0);
+        _serial_write(fd, &header, sizeof(header));
+
+        const size_t batch = SERIAL_STREAM_BYTES / sizeof(T) == 0 ? 1 : SERIAL_STREAM_BYTES / sizeof(T);
+        vector<T> buffer;
+        buffer.reserve(batch);
+        uint64_t count = 0;
+        for (auto it = lst.begin(); it != lst.end(); ++it) {
+            buffer.push_back(*it);
+            if (buffer.size() == batch) {
+                _serial_write(fd, buffer.data(), buffer.size() * sizeof(T));
+                buffer.clear();
+            }
+            ++count;
+        }
+        if (!buffer.empty()) {
+            _serial_write(fd, buffer.data(), buffer.size() * sizeof(T));
+        }
+
+        header.count = count;
+        if (pwrite(fd, &header, sizeof(header), header_offset) != static_cast<ssize_t>(sizeof(header))) {
+            throw std::system_error(errno, std::generic_category(), "serial: pwrite");
+        }
+    }
+
+    template<typename T>
+    inline list<T> read_list(int fd) {
+        _serial_check_type<T>();
+        serial_header header;
+        _serial_read(fd, &header, sizeof(header));
+        _serial_check_header<T>(header, serial_kind::list);
+        _serial_check_count<T>(fd, header.count);
+
+        const size_t batch = SERIAL_STREAM_BYTES / sizeof(T) == 0 ? 1 : SERIAL_STREAM_BYTES / sizeof(T);
+        vector<T> buffer;
+        list<T> result;
+        uint64_t left = header.count;
+        while (left != 0) {
+            size_t n = left < batch ? static_cast<size_t>(left) : batch;
+            buffer.resize_for_overwrite(n);
+            _serial_read(fd, buffer.data(), n * sizeof(T));
+            for (size_t i = 0; i < n; i++) {
+                result.push_back(buffer[i]);
+            }
+            left -= n;
+        }
+        return result;
+    }
+}
+
+#endif //MICROSTL_SERIALIZE_H
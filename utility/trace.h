@@ -0,0 +1,238 @@
+#ifndef MICROSTL_TRACE_H
+#define MICROSTL_TRACE_H
+
+#include <cstddef>
+
+/**
+ * 容器操作的跟踪与统计，编译时定义 MICROSTL_TRACE 才开启：
+ *
+ * - 容器的构造函数多接收一个默认参数 _trace_location，默认值在调用处求值，得到构造容器的源码位置
+ * - 同一位置构造的所有容器共用一条 trace_site 统计：实例数、扩容次数、扩容与移动元素复制的字节数、
+ *   O(n) 操作的次数（vector 在中间插入删除、list::size()）、单个实例的最大长度与最大容量
+ * - 程序退出时把所有位置的统计输出到 stderr，按复制字节数与 O(n) 操作次数排序，
+ *   并给出建议（扩容频繁时 reserve、频繁调用 list::size() 时缓存长度或换用 vector）
+ * - 统计由原子变量累加，位置的登记加锁，多线程中可以使用；统计本身不释放，退出时仍可安全访问
+ * - 未定义 MICROSTL_TRACE 时 _trace_location、_trace_handle 都是空类型，所有记录函数为空，
+ *   容器中的 _trace_handle 成员用 [[no_unique_address]] 声明，不改变容器的大小
+ */
+
+#ifdef MICROSTL_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#endif
+
+namespace MicroSTL {
+
+#ifdef MICROSTL_TRACE
+
+    using _trace_location = std::source_location;
+
+    // --------------------- 统计 --------------------------
+
+    struct trace_site {
+        const char *container;
+        std::string file;
+        std::string function;
+        unsigned line;
+        unsigned column;
+
+        std::atomic<size_t> instances{0};
+        std::atomic<size_t> reallocations{0};
+        std::atomic<size_t> bytes_copied{0};
+        std::atomic<size_t> linear_ops{0};
+        std::atomic<size_t> peak_size{0};
+        std::atomic<size_t> peak_capacity{0};
+    };
+
+    inline void _trace_update_max(std::atomic<size_t> &target, size_t value) {
+        size_t current = target.load(std::memory_order_relaxed);
+        while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * 所有调用位置的登记表，第一次使用时创建并注册退出时的报告，之后不再释放
+     */
+    class trace_registry {
+    protected:
+        using key_type = std::tuple<std::string, unsigned, unsigned, std::string>;
+
+        std::mutex mutex;
+        std::map<key_type, trace_site *> sites;
+
+        trace_registry() = default;
+
+    public:
+        static trace_registry &instance() {
+            static trace_registry *registry = [] {
+                trace_registry *result = new trace_registry();
+                std::atexit([] {
+                    trace_registry::instance().report(stderr);
+                });
+                return result;
+            }();
+            return *registry;
+        }
+
+        trace_site *site(const char *container, const _trace_location &location) {
+            key_type key(location.file_name(), location.line(), location.column(), container);
+            std::lock_guard<std::mutex> lock(mutex);
+            trace_site *&result = sites[key];
+            if (result == nullptr) {
+                result = new trace_site();
+                result->container = container;
+                result->file = location.file_name();
+                result->function = location.function_name();
+                result->line = location.line();
+                result->column = location.column();
+            }
+            return result;
+        }
+
+        /**
+         * 查找某个文件某一行构造的容器的统计，file 只需是路径的后缀；没有时返回 nullptr
+         */
+        const trace_site *find(const char *file, unsigned line) {
+            std::string suffix(file);
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &item: sites) {
+                const std::string &name = item.second->file;
+                if (item.second->line == line && name.size() >= suffix.size() &&
+                    name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                    return item.second;
+                }
+            }
+            return nullptr;
+        }
+
+        void report(FILE *out) {
+            // 按复制字节数、O(n) 操作次数从大到小排列
+            std::multimap<std::pair<size_t, size_t>, const trace_site *, std::greater<>> sorted;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto &item: sites) {
+                    const trace_site *site = item.second;
+                    sorted.emplace(std::make_pair(site->bytes_copied.load(), site->linear_ops.load()), site);
+                }
+            }
+            if (sorted.empty()) {
+                return;
+            }
+
+            fprintf(out, "MicroSTL trace report: %zu construction sites\n", sorted.size());
+            fprintf(out, "%-8s %10s %10s %14s %10s %10s %10s  %s\n", "type", "instances", "reallocs",
+                    "bytes_copied", "linear_ops", "peak_size", "peak_cap", "site");
+            for (auto &item: sorted) {
+                const trace_site *site = item.second;
+                size_t instances = site->instances.load();
+                size_t reallocations = site->reallocations.load();
+                size_t linear_ops = site->linear_ops.load();
+                fprintf(out, "%-8s %10zu %10zu %14zu %10zu %10zu %10zu  %s:%u (%s)\n", site->container, instances,
+                        reallocations, site->bytes_copied.load(), linear_ops, site->peak_size.load(),
+                        site->peak_capacity.load(), site->file.c_str(), site->line, site->function.c_str());
+                // 平均每个实例扩容 4 次以上，说明从很小的容量一路翻倍上来
+                if (reallocations >= 4 * instances && reallocations != 0) {
+                    fprintf(out, "%-8s hint: reserve(%zu) after construction\n", "", site->peak_size.load());
+                }
+                if (linear_ops > instances && linear_ops >= 16) {
+                    fprintf(out, "%-8s hint: %zu O(n) operations, consider another structure\n", "", linear_ops);
+                }
+            }
+        }
+    };
+
+    // --------------------- 容器中的记录句柄 --------------------------
+
+    /**
+     * 每个容器实例持有一个句柄；最大长度与最大容量先记在句柄里，析构时再合并到 trace_site，避免在热路径上写原子变量
+     */
+    class _trace_handle {
+    protected:
+        trace_site *site;
+        size_t peak_size;
+        size_t peak_capacity;
+
+    public:
+        _trace_handle(const char *container, const _trace_location &location)
+                : site(trace_registry::instance().site(container, location)), peak_size(0), peak_capacity(0) {
+            site->instances.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _trace_handle(const _trace_handle &) = delete;
+
+        _trace_handle &operator=(const _trace_handle &) = delete;
+
+        ~_trace_handle() {
+            _trace_update_max(site->peak_size, peak_size);
+            _trace_update_max(site->peak_capacity, peak_capacity);
+        }
+
+        /**
+         * 重新分配了存储，旧存储中的 bytes 字节被复制到新存储
+         */
+        void reallocate(size_t bytes, size_t new_capacity) {
+            site->reallocations.fetch_add(1, std::memory_order_relaxed);
+            site->bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+            peak_capacity = std::max(peak_capacity, new_capacity);
+        }
+
+        /**
+         * 在原有存储中移动元素，例如在中间插入或删除
+         */
+        void copy(size_t bytes) const {
+            site->bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void linear() const {
+            site->linear_ops.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * 在长度可能变小之前调用，记录最大长度
+         */
+        void observe(size_t size, size_t capacity) {
+            peak_size = std::max(peak_size, size);
+            peak_capacity = std::max(peak_capacity, capacity);
+        }
+    };
+
+    inline void trace_report(FILE *out) {
+        trace_registry::instance().report(out);
+    }
+
+#else
+
+    struct _trace_location {
+        static constexpr _trace_location current() noexcept {
+            return _trace_location();
+        }
+    };
+
+    class _trace_handle {
+    public:
+        constexpr _trace_handle(const char *, const _trace_location &) noexcept {}
+
+        void reallocate(size_t, size_t) const noexcept {}
+
+        void copy(size_t) const noexcept {}
+
+        void linear() const noexcept {}
+
+        void observe(size_t, size_t) const noexcept {}
+    };
+
+#endif
+}
+
+#endif //MICROSTL_TRACE_H